@@ -94,15 +94,14 @@ class TrafficEnv(Env):
             for loopid in self.loops:
                 traci.inductionloop.subscribe(loopid, self.loop_variables)
             self.sumo_running = True
-        else: # Reset vehicles in simulation
-            if self.ego_veh.vehID in traci.vehicle.getIDList():
-                traci.vehicle.remove(vehID=self.ego_veh.vehID, reason=2)
-            traci.simulation.clearPending()
+            self.sumo_deltaT = traci.simulation.getDeltaT()/1000. # Simulation timestep in seconds
+            for i in range(800):
+                traci.simulationStep()
+            traci.simulation.saveSnapshot("warmup")
+        else: # Reset to the state after the warm-up
+            traci.simulation.loadSnapshot("warmup")
 
         self.sumo_step = 0
-        self.sumo_deltaT = traci.simulation.getDeltaT()/1000. # Simulation timestep in seconds
-        for i in range(800):
-            traci.simulationStep()
         self.ego_veh = random.choice(self.ego_vehicles)
         self.ego_veh_collision = False
         self.braking_time = 0.
@@ -110,7 +110,10 @@ RODUAFrame::addImportOptions() {
     oc.addDescription("astar.landmark-distances", "Processing", "Initialize lookup table for astar ALT-variant from the given file");
 
     oc.doRegister("astar.save-landmark-distances", new Option_FileName());
-    oc.addDescription("astar.save-landmark-distances", "Processing", "Save lookup table for astar ALT-variant to the given file");
+    oc.addDescription("astar.save-landmark-distances", "Processing", "Save lookup table for astar ALT-variant to the given file (binary if it ends with '.bin')");
+
+    oc.doRegister("astar.auto-landmarks", new Option_Integer(0));
+    oc.addDescription("astar.auto-landmarks", "Processing", "Select landmarks for astar ALT-variant automatically until there are INT landmarks");
 }
 
 
@@ -201,7 +204,7 @@ RODUAFrame::checkOptions() {
         return false;
     }
 
-    if (oc.isDefault("routing-algorithm") && (oc.isSet("astar.all-distances") || oc.isSet("astar.landmark-distances") || oc.isSet("astar.save-landmark-distances"))) {
+    if (oc.isDefault("routing-algorithm") && (oc.isSet("astar.all-distances") || oc.isSet("astar.landmark-distances") || oc.isSet("astar.save-landmark-distances") || oc.getInt("astar.auto-landmarks") > 0)) {
         oc.set("routing-algorithm", "astar");
     }
 
@@ -129,13 +129,14 @@ computeRoutes(RONet& net, ROLoader& loader, OptionsCont& oc) {
                 const AStar::LookupTable* lookup = 0;
                 if (oc.isSet("astar.all-distances")) {
                     lookup = new AStar::FLT(oc.getString("astar.all-distances"), (int)ROEdge::getAllEdges().size());
-                } else if (oc.isSet("astar.landmark-distances")) {
+                } else if (oc.isSet("astar.landmark-distances") || oc.getInt("astar.auto-landmarks") > 0) {
                     CHRouterWrapper<ROEdge, ROVehicle, prohibited_withPermissions<ROEdge, ROVehicle> > router(
                         ROEdge::getAllEdges(), true, &ROEdge::getTravelTimeStatic,
                         begin, end, std::numeric_limits<int>::max(), 1);
                     ROVehicle defaultVehicle(SUMOVehicleParameter(), 0, net.getVehicleTypeSecure(DEFAULT_VTYPE_ID), &net);
-                    lookup = new AStar::LMLT(oc.getString("astar.landmark-distances"), ROEdge::getAllEdges(), &router, &defaultVehicle,
-                                             oc.isSet("astar.save-landmark-distances") ? oc.getString("astar.save-landmark-distances") : "", oc.getInt("routing-threads"));
+                    lookup = new AStar::LMLT(oc.isSet("astar.landmark-distances") ? oc.getString("astar.landmark-distances") : "", ROEdge::getAllEdges(), &router, &defaultVehicle,
+                                             oc.isSet("astar.save-landmark-distances") ? oc.getString("astar.save-landmark-distances") : "", oc.getInt("routing-threads"),
+                                             oc.getInt("astar.auto-landmarks"));
                 }
                 router = new AStar(ROEdge::getAllEdges(), oc.getBool("ignore-errors"), &ROEdge::getTravelTimeStatic, lookup);
             } else {
@@ -143,13 +144,14 @@ computeRoutes(RONet& net, ROLoader& loader, OptionsCont& oc) {
                 const AStar::LookupTable* lookup = 0;
                 if (oc.isSet("astar.all-distances")) {
                     lookup = new AStar::FLT(oc.getString("astar.all-distances"), (int)ROEdge::getAllEdges().size());
-                } else if (oc.isSet("astar.landmark-distances")) {
+                } else if (oc.isSet("astar.landmark-distances") || oc.getInt("astar.auto-landmarks") > 0) {
                     CHRouterWrapper<ROEdge, ROVehicle, noProhibitions<ROEdge, ROVehicle> > router(
                         ROEdge::getAllEdges(), true, &ROEdge::getTravelTimeStatic,
                         begin, end, std::numeric_limits<int>::max(), 1);
                     ROVehicle defaultVehicle(SUMOVehicleParameter(), 0, net.getVehicleTypeSecure(DEFAULT_VTYPE_ID), &net);
-                    lookup = new AStar::LMLT(oc.getString("astar.landmark-distances"), ROEdge::getAllEdges(), &router, &defaultVehicle,
-                                             oc.isSet("astar.save-landmark-distances") ? oc.getString("astar.save-landmark-distances") : "", oc.getInt("routing-threads"));
+                    lookup = new AStar::LMLT(oc.isSet("astar.landmark-distances") ? oc.getString("astar.landmark-distances") : "", ROEdge::getAllEdges(), &router, &defaultVehicle,
+                                             oc.isSet("astar.save-landmark-distances") ? oc.getString("astar.save-landmark-distances") : "", oc.getInt("routing-threads"),
+                                             oc.getInt("astar.auto-landmarks"));
                 }
                 router = new AStar(ROEdge::getAllEdges(), oc.getBool("ignore-errors"), &ROEdge::getTravelTimeStatic, lookup);
             }
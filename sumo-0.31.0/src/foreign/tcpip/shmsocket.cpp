@@ -0,0 +1,269 @@
+/****************************************************************************/
+/// @file    shmsocket.cpp
+/// @date    Oct 2017
+/// @version $Id$
+///
+// A socket like transport for TraCI using shared memory
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+#include "shmsocket.h"
+
+#ifdef BUILD_TCPIP
+
+
+#ifndef WIN32
+	#include <sys/types.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <errno.h>
+	#include <fcntl.h>
+	#include <sched.h>
+	#include <signal.h>
+	#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+
+namespace
+{
+	const unsigned int MAGIC = 0x53554d4f;
+	const unsigned int VERSION = 1;
+	const std::size_t CLIENT_ATTACHED = 16;
+	const std::size_t CLOSED = 20;
+	const std::size_t SERVER_PID = 24;
+	const std::size_t CLIENT_PID = 28;
+	const std::size_t TO_SERVER_WRITTEN = 64;
+	const std::size_t TO_SERVER_READ = 128;
+	const std::size_t TO_CLIENT_WRITTEN = 192;
+	const std::size_t TO_CLIENT_READ = 256;
+	const std::size_t DATA = 320;
+	/// number of unsuccessful polls before yielding
+	const int SPIN_TRIES = 2000;
+	/// number of unsuccessful polls before sleeping
+	const int YIELD_TRIES = 20000;
+}
+
+
+namespace tcpip
+{
+#ifndef WIN32
+	// ----------------------------------------------------------------------
+	ShmSocket::
+		ShmSocket(const std::string& name, std::size_t capacity)
+		throw( SocketException )
+		: Socket(0),
+		name_(name[0] == '/' ? name : "/" + name),
+		capacity_(capacity),
+		memory_(0),
+		size_(DATA + 2 * capacity),
+		spinTries_(sysconf(_SC_NPROCESSORS_ONLN) > 1 ? SPIN_TRIES : 0)
+	{
+		shm_unlink(name_.c_str());
+		const int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+		if (fd < 0)
+			throw SocketException("tcpip::ShmSocket @ shm_open: " + std::string(strerror(errno)));
+		if (ftruncate(fd, (off_t)size_) < 0)
+		{
+			const std::string msg = strerror(errno);
+			::close(fd);
+			shm_unlink(name_.c_str());
+			throw SocketException("tcpip::ShmSocket @ ftruncate: " + msg);
+		}
+		void* const mem = mmap(0, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (mem == MAP_FAILED)
+		{
+			shm_unlink(name_.c_str());
+			throw SocketException("tcpip::ShmSocket @ mmap: " + std::string(strerror(errno)));
+		}
+		memory_ = static_cast<unsigned char*>(mem);
+		*reinterpret_cast<unsigned long long*>(memory_ + 8) = capacity_;
+		*reinterpret_cast<unsigned int*>(memory_ + 4) = VERSION;
+		*reinterpret_cast<unsigned int*>(memory_ + SERVER_PID) = (unsigned int)getpid();
+		// the client only attaches after seeing the magic number
+		__sync_synchronize();
+		*reinterpret_cast<volatile unsigned int*>(memory_) = MAGIC;
+	}
+
+
+	// ----------------------------------------------------------------------
+	ShmSocket::
+		~ShmSocket()
+	{
+		close();
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		ShmSocket::
+		waitForClient()
+		throw( SocketException )
+	{
+		int tries = YIELD_TRIES;
+		while (*reinterpret_cast<volatile unsigned int*>(memory_ + CLIENT_ATTACHED) == 0)
+			wait(tries);
+		__sync_synchronize();
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		ShmSocket::
+		close()
+	{
+		if (memory_ != 0)
+		{
+			*reinterpret_cast<volatile unsigned int*>(memory_ + CLOSED) = 1;
+			munmap(memory_, size_);
+			memory_ = 0;
+			shm_unlink(name_.c_str());
+		}
+	}
+
+
+	// ----------------------------------------------------------------------
+	volatile unsigned long long&
+		ShmSocket::
+		counter(std::size_t offset)
+		const
+	{
+		return *reinterpret_cast<volatile unsigned long long*>(memory_ + offset);
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		ShmSocket::
+		wait(int& tries)
+		const throw( SocketException )
+	{
+		++tries;
+		if (tries < spinTries_)
+			return;
+		if (*reinterpret_cast<volatile unsigned int*>(memory_ + CLOSED) != 0)
+			throw SocketException("tcpip::ShmSocket: peer shutdown");
+		if (tries < YIELD_TRIES)
+		{
+			sched_yield();
+			return;
+		}
+		const pid_t client = (pid_t)*reinterpret_cast<volatile unsigned int*>(memory_ + CLIENT_PID);
+		if (client != 0 && kill(client, 0) < 0 && errno == ESRCH)
+			throw SocketException("tcpip::ShmSocket: peer vanished");
+		usleep(50);
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		ShmSocket::
+		send( const std::vector<unsigned char> &buffer)
+		throw( SocketException )
+	{
+		if (memory_ == 0)
+			throw SocketException("tcpip::ShmSocket::send @ socket not initialized");
+		printBufferOnVerbose(buffer, "Send");
+		volatile unsigned long long& written = counter(TO_CLIENT_WRITTEN);
+		const volatile unsigned long long& read = counter(TO_CLIENT_READ);
+		unsigned char* const ring = memory_ + DATA + capacity_;
+		std::size_t pos = 0;
+		int tries = 0;
+		while (pos < buffer.size())
+		{
+			const unsigned long long w = written;
+			const std::size_t space = capacity_ - (std::size_t)(w - read);
+			if (space == 0)
+			{
+				wait(tries);
+				continue;
+			}
+			tries = 0;
+			const std::size_t offset = (std::size_t)(w % capacity_);
+			const std::size_t n = std::min(std::min(space, buffer.size() - pos), capacity_ - offset);
+			// make sure the free space is not read before the client released it
+			__sync_synchronize();
+			memcpy(ring + offset, &buffer[pos], n);
+			__sync_synchronize();
+			written = w + n;
+			pos += n;
+		}
+	}
+
+
+	// ----------------------------------------------------------------------
+	void
+		ShmSocket::
+		receiveComplete(unsigned char * buffer, std::size_t len)
+		const
+	{
+		const volatile unsigned long long& written = counter(TO_SERVER_WRITTEN);
+		volatile unsigned long long& read = counter(TO_SERVER_READ);
+		const unsigned char* const ring = memory_ + DATA;
+		int tries = 0;
+		while (len > 0)
+		{
+			const unsigned long long r = read;
+			const std::size_t available = (std::size_t)(written - r);
+			if (available == 0)
+			{
+				wait(tries);
+				continue;
+			}
+			tries = 0;
+			const std::size_t offset = (std::size_t)(r % capacity_);
+			const std::size_t n = std::min(std::min(available, len), capacity_ - offset);
+			__sync_synchronize();
+			memcpy(buffer, ring + offset, n);
+			__sync_synchronize();
+			read = r + n;
+			len -= n;
+			buffer += n;
+		}
+	}
+
+#else
+
+	// ----------------------------------------------------------------------
+	ShmSocket::
+		ShmSocket(const std::string& name, std::size_t capacity)
+		throw( SocketException )
+		: Socket(0),
+		name_(name),
+		capacity_(capacity),
+		memory_(0),
+		size_(0),
+		spinTries_(0)
+	{
+		throw SocketException("tcpip::ShmSocket: shared memory connections are not supported on this platform");
+	}
+
+	ShmSocket::~ShmSocket() {}
+	void ShmSocket::waitForClient() throw( SocketException ) {}
+	void ShmSocket::close() {}
+	volatile unsigned long long& ShmSocket::counter(std::size_t offset) const { return *reinterpret_cast<volatile unsigned long long*>(memory_ + offset); }
+	void ShmSocket::wait(int& tries) const throw( SocketException ) {}
+	void ShmSocket::send( const std::vector<unsigned char> &buffer) throw( SocketException ) {}
+	void ShmSocket::receiveComplete(unsigned char * buffer, std::size_t len) const {}
+
+#endif
+
+}	// namespace tcpip
+
+
+#endif // BUILD_TCPIP
@@ -0,0 +1,100 @@
+/****************************************************************************/
+/// @file    shmsocket.h
+/// @date    Oct 2017
+/// @version $Id$
+///
+// A socket like transport for TraCI using shared memory
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+#ifndef shmsocket_h
+#define shmsocket_h
+
+#include "socket.h"
+
+#ifdef BUILD_TCPIP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+
+namespace tcpip
+{
+	/** A Socket replacement for a client on the same host.
+	 *
+	 * The messages use the same framing as on a TCP connection but are
+	 * exchanged through two ring buffers in a POSIX shared memory segment,
+	 * one for each direction. Waiting for data first polls the ring and
+	 * falls back to yielding and sleeping, so neither a system call nor a
+	 * copy through the kernel is needed as long as both sides are busy.
+	 *
+	 * Layout of the segment (native byte order, offsets in bytes):
+	 *  0 magic (uint32), 4 version (uint32), 8 capacity of each ring (uint64),
+	 *  16 client attached (uint32), 20 closed (uint32), 24 server pid (uint32),
+	 *  28 client pid (uint32), 64 client->server written (uint64),
+	 *  128 client->server read (uint64), 192 server->client written (uint64),
+	 *  256 server->client read (uint64), 320 client->server data,
+	 *  320 + capacity server->client data.
+	 * The read and written counters only grow, the position within a ring
+	 * is the counter modulo its capacity.
+	 *
+	 * Only available on POSIX systems.
+	 */
+	class ShmSocket : public Socket
+	{
+	public:
+		/// Creates the shared memory segment with the given name (replacing an existing one)
+		ShmSocket(const std::string& name, std::size_t capacity = 1 << 22) throw( SocketException );
+
+		/// Destructor, removes the segment
+		virtual ~ShmSocket();
+
+		/// Waits until a client attached to the segment
+		void waitForClient() throw( SocketException );
+
+		/// Writes the complete buffer into the ring to the client
+		virtual void send( const std::vector<unsigned char> &buffer) throw( SocketException );
+
+		/// Tells the client that the connection was closed and removes the segment
+		virtual void close();
+
+	protected:
+		/// Reads \p len bytes from the ring from the client
+		virtual void receiveComplete(unsigned char * const buffer, std::size_t len) const;
+
+	private:
+		/// Polls, yields or sleeps depending on the number of unsuccessful tries, throws if the client is gone
+		void wait(int& tries) const throw( SocketException );
+
+		/// Returns the counter at the given offset of the segment
+		volatile unsigned long long& counter(std::size_t offset) const;
+
+		/// The name of the segment
+		std::string name_;
+		/// The capacity of each ring
+		std::size_t capacity_;
+		/// The mapped segment
+		unsigned char* memory_;
+		/// The size of the mapped segment
+		std::size_t size_;
+		/// The number of polls before yielding (no busy polling on a single processor)
+		int spinTries_;
+	};
+
+}	// namespace tcpip
+
+
+#endif // BUILD_TCPIP
+
+#endif
@@ -86,7 +86,7 @@ namespace tcpip
 		Socket(int port);
 
 		/// Destructor
-		~Socket();
+		virtual ~Socket();
 
 		/// Connects to host_:port_
 		void connect() throw( SocketException );
@@ -94,13 +94,13 @@ namespace tcpip
 		/// Wait for a incoming connection to port_
         Socket* accept(const bool create = false) throw(SocketException);
 
-		void send( const std::vector<unsigned char> &buffer) throw( SocketException );
+		virtual void send( const std::vector<unsigned char> &buffer) throw( SocketException );
 		void sendExact( const Storage & ) throw( SocketException );
 		/// Receive up to \p bufSize available bytes from Socket::socket_
 		std::vector<unsigned char> receive( int bufSize = 2048 ) throw( SocketException );
 		/// Receive a complete TraCI message from Socket::socket_
 		bool receiveExact( Storage &) throw( SocketException );
-		void close();
+		virtual void close();
 		int port();
 		void set_blocking(bool) throw( SocketException );
 		bool is_blocking() throw();
@@ -115,7 +115,7 @@ namespace tcpip
 		static const int lengthLen;
 
 		/// Receive \p len bytes from Socket::socket_
-		void receiveComplete(unsigned char * const buffer, std::size_t len) const;
+		virtual void receiveComplete(unsigned char * const buffer, std::size_t len) const;
 		/// Receive up to \p len available bytes from Socket::socket_
 		size_t recvAndCheck(unsigned char * const buffer, std::size_t len) const;
 		/// Print \p label and \p buffer to stderr if Socket::verbose_ is set
@@ -133,9 +133,9 @@ GUILane::releaseVehicles() const {
 
 
 void
-GUILane::planMovements(const SUMOTime t) {
+GUILane::planMovements(const SUMOTime t, PlanStage stage) {
     AbstractMutex::ScopedLocker locker(myLock);
-    MSLane::planMovements(t);
+    MSLane::planMovements(t, stage);
 }
 
 
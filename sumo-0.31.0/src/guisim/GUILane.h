@@ -130,7 +130,7 @@ public:
 
     /** the same as in MSLane, but locks the access for the visualisation
         first; the access will be granted at the end of this method */
-    void planMovements(const SUMOTime t);
+    void planMovements(const SUMOTime t, PlanStage stage = PLAN_COMPLETE);
 
     /** the same as in MSLane, but locks the access for the visualisation
         first; the access will be granted at the end of this method */
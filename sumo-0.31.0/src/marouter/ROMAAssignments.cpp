@@ -59,6 +59,14 @@ ROMAAssignments::ROMAAssignments(const SUMOTime begin, const SUMOTime end, const
                                  SUMOAbstractRouter<ROEdge, ROVehicle>& router)
     : myBegin(begin), myEnd(end), myAdditiveTraffic(additiveTraffic), myAdaptionFactor(adaptionFactor), myNet(net), myMatrix(matrix), myRouter(router) {
     myDefaultVehicle = new ROVehicle(SUMOVehicleParameter(), 0, net.getVehicleTypeSecure(DEFAULT_VTYPE_ID), &net);
+    for (std::vector<ODCell*>::const_iterator i = matrix.getCells().begin(); i != matrix.getCells().end(); ++i) {
+        if (mySources.count((*i)->origin) == 0) {
+            mySources[(*i)->origin] = net.getEdge((*i)->origin + "-source");
+        }
+        if (mySinks.count((*i)->destination) == 0) {
+            mySinks[(*i)->destination] = net.getEdge((*i)->destination + "-sink");
+        }
+    }
 }
 
 
@@ -196,7 +204,7 @@ ROMAAssignments::getKPaths(const int kPaths, const double penalty) {
         myPenalties.clear();
         for (int k = 0; k < kPaths; k++) {
             ConstROEdgeVector edges;
-            myRouter.compute(myNet.getEdge(c->origin + "-source"), myNet.getEdge(c->destination + "-sink"), myDefaultVehicle, 0, edges);
+            myRouter.compute(mySources[c->origin], mySinks[c->destination], myDefaultVehicle, 0, edges);
             for (ConstROEdgeVector::iterator e = edges.begin(); e != edges.end(); e++) {
                 myPenalties[*e] = penalty;
             }
@@ -207,6 +215,55 @@ ROMAAssignments::getKPaths(const int kPaths, const double penalty) {
 }
 
 
+bool
+ROMAAssignments::computeOrigin(SUMOAbstractRouter<ROEdge, ROVehicle>& router, std::vector<ODCell*>::const_iterator first,
+                               std::vector<ODCell*>::const_iterator last, const SUMOTime time, const int numIter) {
+    const ROEdge* const source = mySources.find((*first)->origin)->second;
+    bool newRoute = false;
+    router.setBulkMode(false);
+    for (std::vector<ODCell*>::const_iterator i = first; i != last; ++i) {
+        ODCell* const c = *i;
+        ConstROEdgeVector edges;
+        router.compute(source, mySinks.find(c->destination)->second, myDefaultVehicle, time, edges);
+        router.setBulkMode(true);
+        newRoute |= addRoute(edges, c->pathsVector, c->origin + c->destination + toString(c->pathsVector.size()),
+                             numIter > 0 ? c->vehicleNumber / numIter : 0.);
+    }
+    router.setBulkMode(false);
+    return newRoute;
+}
+
+
+bool
+ROMAAssignments::computeOrigins(std::vector<ODCell*>::const_iterator first, std::vector<ODCell*>::const_iterator last,
+                                const SUMOTime time, const int numIter) {
+    bool newRoute = false;
+    std::vector<RoutingTask*> tasks;
+    while (first != last) {
+        std::vector<ODCell*>::const_iterator originEnd = first + 1;
+        while (originEnd != last && (*originEnd)->origin == (*first)->origin) {
+            ++originEnd;
+        }
+        if (myNet.getThreadPool().size() > 0) {
+            tasks.push_back(new RoutingTask(*this, first, originEnd, time, numIter));
+            myNet.getThreadPool().add(tasks.back());
+            first = originEnd;
+            continue;
+        }
+        newRoute |= computeOrigin(myRouter, first, originEnd, time, numIter);
+        first = originEnd;
+    }
+    if (!tasks.empty()) {
+        myNet.getThreadPool().waitAll(false);
+        for (std::vector<RoutingTask*>::const_iterator i = tasks.begin(); i != tasks.end(); ++i) {
+            newRoute |= (*i)->hasNewRoute();
+            delete *i;
+        }
+    }
+    return newRoute;
+}
+
+
 void
 ROMAAssignments::resetFlows() {
     const double begin = STEPS2TIME(MIN2(myBegin, myMatrix.getCells().front()->begin));
@@ -251,43 +308,9 @@ ROMAAssignments::incremental(const int numIter, const bool verbose) {
             if (verbose) {
                 WRITE_MESSAGE("  starting iteration " + toString(t));
             }
-            std::string lastOrigin = "";
-            int workerIndex = 0;
-            for (std::vector<ODCell*>::const_iterator i = myMatrix.getCells().begin() + (*offset); i != cellsEnd; i++) {
-                ODCell* const c = *i;
-                const double linkFlow = c->vehicleNumber / numIter;
-                const SUMOTime begin = myAdditiveTraffic ? myBegin : c->begin;
-#ifdef HAVE_FOX
-                if (myNet.getThreadPool().size() > 0) {
-                    if (lastOrigin != c->origin) {
-                        workerIndex++;
-                        if (workerIndex == myNet.getThreadPool().size()) {
-                            workerIndex = 0;
-                        }
-                        myNet.getThreadPool().add(new RONet::BulkmodeTask(false), workerIndex);
-                        lastOrigin = c->origin;
-                        myNet.getThreadPool().add(new RoutingTask(*this, c, begin, linkFlow), workerIndex);
-                        myNet.getThreadPool().add(new RONet::BulkmodeTask(true), workerIndex);
-                    } else {
-                        myNet.getThreadPool().add(new RoutingTask(*this, c, begin, linkFlow), workerIndex);
-                    }
-                    continue;
-                }
-#endif
-                if (lastOrigin != c->origin) {
-                    myRouter.setBulkMode(false);
-                    lastOrigin = c->origin;
-                }
-                ConstROEdgeVector edges;
-                myRouter.compute(myNet.getEdge(c->origin + "-source"), myNet.getEdge(c->destination + "-sink"), myDefaultVehicle, begin, edges);
-                myRouter.setBulkMode(true);
-                addRoute(edges, c->pathsVector, c->origin + c->destination + toString(c->pathsVector.size()), linkFlow);
-            }
-#ifdef HAVE_FOX
-            if (myNet.getThreadPool().size() > 0) {
-                myNet.getThreadPool().waitAll();
-            }
-#endif
+            // all cells of the interval share the begin time
+            computeOrigins(myMatrix.getCells().begin() + (*offset), cellsEnd, myAdditiveTraffic ? myBegin : intervalStart, numIter);
+            // distribute the flows in the order of the cells to get the same results with any number of threads
             for (std::vector<ODCell*>::const_iterator i = myMatrix.getCells().begin() + (*offset); i != cellsEnd; i++) {
                 ODCell* const c = *i;
                 const double linkFlow = c->vehicleNumber / numIter;
@@ -296,7 +319,7 @@ ROMAAssignments::incremental(const int numIter, const bool verbose) {
                 const double intervalLengthInHours = STEPS2TIME(end - begin) / 3600.;
                 const ConstROEdgeVector& edges = c->pathsVector.back()->getEdgeVector();
                 for (ConstROEdgeVector::const_iterator e = edges.begin(); e != edges.end(); e++) {
-                    ROMAEdge* edge = static_cast<ROMAEdge*>(myNet.getEdge((*e)->getID()));
+                    ROMAEdge* edge = static_cast<ROMAEdge*>(const_cast<ROEdge*>(*e));
                     const double newFlow = edge->getFlow(STEPS2TIME(begin)) + linkFlow;
                     edge->setFlow(STEPS2TIME(begin), STEPS2TIME(end), newFlow);
                     double travelTime = capacityConstraintFunction(edge, newFlow / intervalLengthInHours);
@@ -347,7 +370,7 @@ ROMAAssignments::sue(const int maxOuterIteration, const int maxInnerIteration, c
                     const double pathFlow = r->getProbability() * c->vehicleNumber;
                     // assign edge flow deltas
                     for (ConstROEdgeVector::const_iterator e = r->getEdgeVector().begin(); e != r->getEdgeVector().end(); e++) {
-                        ROMAEdge* edge = static_cast<ROMAEdge*>(myNet.getEdge((*e)->getID()));
+                        ROMAEdge* edge = static_cast<ROMAEdge*>(const_cast<ROEdge*>(*e));
                         edge->setHelpFlow(STEPS2TIME(begin), STEPS2TIME(end), edge->getHelpFlow(STEPS2TIME(begin)) + pathFlow);
                     }
                 }
@@ -392,14 +415,7 @@ ROMAAssignments::sue(const int maxOuterIteration, const int maxInnerIteration, c
         }
         // check for a new route, if none available, break
         // several modifications about when a route is new and when to break are in the original script
-        bool newRoute = false;
-        for (std::vector<ODCell*>::const_iterator i = myMatrix.getCells().begin(); i != myMatrix.getCells().end(); ++i) {
-            ODCell* c = *i;
-            ConstROEdgeVector edges;
-            myRouter.compute(myNet.getEdge(c->origin + "-source"), myNet.getEdge(c->destination + "-sink"), myDefaultVehicle, 0, edges);
-            newRoute |= addRoute(edges, c->pathsVector, c->origin + c->destination + toString(c->pathsVector.size()), 0);
-        }
-        if (!newRoute) {
+        if (!computeOrigins(myMatrix.getCells().begin(), myMatrix.getCells().end(), 0, 0)) {
             break;
         }
     }
@@ -442,14 +458,10 @@ ROMAAssignments::getTravelTime(const ROEdge* const e, const ROVehicle* const v,
 }
 
 
-#ifdef HAVE_FOX
 // ---------------------------------------------------------------------------
 // ROMAAssignments::RoutingTask-methods
 // ---------------------------------------------------------------------------
 void
-ROMAAssignments::RoutingTask::run(FXWorkerThread* context) {
-    ConstROEdgeVector edges;
-    static_cast<RONet::WorkerThread*>(context)->getVehicleRouter().compute(myAssign.myNet.getEdge(myCell->origin + "-source"), myAssign.myNet.getEdge(myCell->destination + "-sink"), myAssign.myDefaultVehicle, myBegin, edges);
-    myAssign.addRoute(edges, myCell->pathsVector, myCell->origin + myCell->destination + toString(myCell->pathsVector.size()), myLinkFlow);
+ROMAAssignments::RoutingTask::run(SUMOWorkerThread* context) {
+    myNewRoute = myAssign.computeOrigin(static_cast<RONet::WorkerThread*>(context)->getVehicleRouter(), myFirst, myLast, myTime, myNumIter);
 }
-#endif
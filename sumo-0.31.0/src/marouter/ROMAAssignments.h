@@ -34,6 +34,7 @@
 
 #include <utils/vehicle/SUMOAbstractRouter.h>
 #include <utils/common/SUMOTime.h>
+#include <utils/common/SUMOWorkerThread.h>
 
 // ===========================================================================
 // class declarations
@@ -132,6 +133,28 @@ private:
     /// @brief get the k shortest paths
     void getKPaths(const int kPaths, const double penalty);
 
+    /** @brief computes the routes of the given cells which all share the same origin
+     *
+     * The router is put into bulk mode after the first query, so routers
+     *  which support it grow a single shortest path tree from the origin
+     *  instead of starting a new search for every destination.
+     *
+     * @param[in] router The router to use
+     * @param[in] first The first cell of the origin
+     * @param[in] last The cell after the last cell of the origin
+     * @param[in] time The time to route for
+     * @param[in] numIter The number of iterations the vehicles of a cell are distributed on (0 adds the routes without flow)
+     * @return Whether a new route was added to one of the cells
+     */
+    bool computeOrigin(SUMOAbstractRouter<ROEdge, ROVehicle>& router, std::vector<ODCell*>::const_iterator first,
+                       std::vector<ODCell*>::const_iterator last, const SUMOTime time, const int numIter);
+
+    /** @brief computes the routes of all origins among the given cells (in parallel if threads are available)
+     * @return Whether a new route was added to one of the cells
+     */
+    bool computeOrigins(std::vector<ODCell*>::const_iterator first, std::vector<ODCell*>::const_iterator last,
+                        const SUMOTime time, const int numIter);
+
 private:
     const SUMOTime myBegin;
     const SUMOTime myEnd;
@@ -143,23 +166,31 @@ private:
     static std::map<const ROEdge* const, double> myPenalties;
     ROVehicle* myDefaultVehicle;
 
-#ifdef HAVE_FOX
+    /// @brief the source and sink edges of the districts (to avoid building the edge ids for every cell)
+    std::map<std::string, const ROEdge*> mySources;
+    std::map<std::string, const ROEdge*> mySinks;
+
 private:
-    class RoutingTask : public FXWorkerThread::Task {
+    class RoutingTask : public SUMOWorkerThread::Task {
     public:
-        RoutingTask(ROMAAssignments& assign, ODCell* c, const SUMOTime begin, const double linkFlow)
-            : myAssign(assign), myCell(c), myBegin(begin), myLinkFlow(linkFlow) {}
-        void run(FXWorkerThread* context);
+        RoutingTask(ROMAAssignments& assign, std::vector<ODCell*>::const_iterator first, std::vector<ODCell*>::const_iterator last,
+                    const SUMOTime time, const int numIter)
+            : myAssign(assign), myFirst(first), myLast(last), myTime(time), myNumIter(numIter), myNewRoute(false) {}
+        void run(SUMOWorkerThread* context);
+        bool hasNewRoute() const {
+            return myNewRoute;
+        }
     private:
         ROMAAssignments& myAssign;
-        ODCell* const myCell;
-        const SUMOTime myBegin;
-        const double myLinkFlow;
+        const std::vector<ODCell*>::const_iterator myFirst;
+        const std::vector<ODCell*>::const_iterator myLast;
+        const SUMOTime myTime;
+        const int myNumIter;
+        bool myNewRoute;
     private:
         /// @brief Invalidated assignment operator.
         RoutingTask& operator=(const RoutingTask&);
     };
-#endif
 
 
 private:
@@ -28,6 +28,7 @@
 #include <config.h>
 #endif
 
+#include <algorithm>
 #include <queue>
 #include <vector>
 #include <map>
@@ -49,10 +50,18 @@
 #include "MEVehicle.h"
 
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const int MELoop::BUCKET_NUMBER = 1024;
+
+
 // ===========================================================================
 // method definitions
 // ===========================================================================
-MELoop::MELoop(const SUMOTime recheckInterval) : myFullRecheckInterval(recheckInterval), myLinkRecheckInterval(TIME2STEPS(1)) {
+MELoop::MELoop(const SUMOTime recheckInterval) :
+    myLeaderCars(BUCKET_NUMBER), myCurrentStep(0), myLeaderCarIndex(0), myBucketWidth(DELTA_T),
+    myFullRecheckInterval(recheckInterval), myLinkRecheckInterval(TIME2STEPS(1)) {
 }
 
 MELoop::~MELoop() {
@@ -68,18 +77,35 @@ MELoop::~MELoop() {
 
 void
 MELoop::simulate(SUMOTime tMax) {
-    while (!myLeaderCars.empty()) {
-        const SUMOTime time = myLeaderCars.begin()->first;
-        assert(time > tMax - DELTA_T);
-        if (time > tMax) {
+    const long long lastStep = getStep(tMax);
+    while (true) {
+        // the current bucket is a heap, cars which are added while checking are pushed onto it
+        std::vector<LeaderCar>& bucket = myLeaderCars[myCurrentStep % BUCKET_NUMBER];
+        while (!bucket.empty()) {
+            const LeaderCar car = bucket.front();
+            if (car.time > tMax) {
+                return;
+            }
+            std::pop_heap(bucket.begin(), bucket.end(), LeaderCarComparator());
+            bucket.pop_back();
+            if (car.veh != 0) {
+                checkCar(car.veh);
+            }
+        }
+        if (myCurrentStep >= lastStep) {
             return;
         }
-        std::vector<MEVehicle*> vehs = myLeaderCars[time];
-        myLeaderCars.erase(time);
-        for (std::vector<MEVehicle*>::const_iterator i = vehs.begin(); i != vehs.end(); ++i) {
-            checkCar(*i);
-            assert(myLeaderCars.empty() || myLeaderCars.begin()->first >= time);
+        myCurrentStep++;
+        // move the far cars which came within the range of the ring
+        while (!myFarLeaderCars.empty() && myFarLeaderCars.begin()->first < myCurrentStep + BUCKET_NUMBER) {
+            const std::vector<LeaderCar> cars = myFarLeaderCars.begin()->second;
+            myFarLeaderCars.erase(myFarLeaderCars.begin());
+            for (std::vector<LeaderCar>::const_iterator i = cars.begin(); i != cars.end(); ++i) {
+                insertLeaderCar(*i);
+            }
         }
+        std::vector<LeaderCar>& next = myLeaderCars[myCurrentStep % BUCKET_NUMBER];
+        std::make_heap(next.begin(), next.end(), LeaderCarComparator());
     }
 }
 
@@ -203,11 +229,31 @@ MELoop::teleportVehicle(MEVehicle* veh, MESegment* const toSegment) {
 
 void
 MELoop::addLeaderCar(MEVehicle* veh, MSLink* link) {
-    myLeaderCars[veh->getEventTime()].push_back(veh);
+    LeaderCar car;
+    car.time = veh->getEventTime();
+    car.index = myLeaderCarIndex++;
+    car.veh = veh;
+    insertLeaderCar(car);
     setApproaching(veh, link);
 }
 
 
+void
+MELoop::insertLeaderCar(const LeaderCar& car) {
+    const long long step = getStep(car.time);
+    if (step <= myCurrentStep) {
+        // events in the past are executed with the current step
+        std::vector<LeaderCar>& bucket = myLeaderCars[myCurrentStep % BUCKET_NUMBER];
+        bucket.push_back(car);
+        std::push_heap(bucket.begin(), bucket.end(), LeaderCarComparator());
+    } else if (step < myCurrentStep + BUCKET_NUMBER) {
+        myLeaderCars[step % BUCKET_NUMBER].push_back(car);
+    } else {
+        myFarLeaderCars[step].push_back(car);
+    }
+}
+
+
 void
 MELoop::setApproaching(MEVehicle* veh, MSLink* link) {
     if (link != 0) {
@@ -223,8 +269,22 @@ MELoop::setApproaching(MEVehicle* veh, MSLink* link) {
 
 void
 MELoop::removeLeaderCar(MEVehicle* v) {
-    std::vector<MEVehicle*>& cands = myLeaderCars[v->getEventTime()];
-    cands.erase(find(cands.begin(), cands.end(), v));
+    const long long step = MAX2(getStep(v->getEventTime()), myCurrentStep);
+    std::vector<LeaderCar>& cands = step < myCurrentStep + BUCKET_NUMBER ? myLeaderCars[step % BUCKET_NUMBER] : myFarLeaderCars[step];
+    for (std::vector<LeaderCar>::iterator i = cands.begin(); i != cands.end(); ++i) {
+        if (i->veh == v) {
+            if (step == myCurrentStep) {
+                // keep the heap intact, the entry is skipped when it reaches the top
+                i->veh = 0;
+            } else {
+                // the order of later buckets is restored from the insertion index
+                *i = cands.back();
+                cands.pop_back();
+            }
+            return;
+        }
+    }
+    assert(false);
 }
 
 
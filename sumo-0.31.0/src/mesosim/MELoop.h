@@ -52,9 +52,20 @@ class OptionsCont;
 /**
  * @class MELoop
  * @brief The main mesocopic simulation loop
+ *
+ * The leader cars (the first vehicles of the segment queues) are kept in a
+ *  calendar queue: a ring of buckets which each hold the cars with an event
+ *  time within one simulation step. Only the bucket of the current step is
+ *  ordered (as a heap by event time and insertion order), cars in later
+ *  buckets are just appended. Cars with an event time beyond the range of
+ *  the ring are kept in a map from the step to the cars and moved into the
+ *  ring when it comes within range.
  */
 class MELoop {
 public:
+    /// @brief The number of buckets (steps) in the ring of leader cars
+    static const int BUCKET_NUMBER;
+
     /// SUMO constructor
     MELoop(const SUMOTime recheckInterval);
 
@@ -143,8 +154,49 @@ private:
     void teleportVehicle(MEVehicle* veh, MESegment* const toSegment);
 
 private:
-    /// @brief leader cars in the segments sorted by exit time
-    std::map<SUMOTime, std::vector<MEVehicle*> > myLeaderCars;
+    /// @brief A leader car together with its event time and the running number of its insertion
+    struct LeaderCar {
+        /// @brief the event time at insertion
+        SUMOTime time;
+        /// @brief the running number of the insertion (tie breaker for equal times)
+        long long index;
+        /// @brief the car (0 if it was removed from the heap of the current step)
+        MEVehicle* veh;
+    };
+
+    /// @brief Sorts the leader cars by event time and insertion (the earliest on top of the heap)
+    struct LeaderCarComparator {
+        bool operator()(const LeaderCar& c1, const LeaderCar& c2) const {
+            if (c1.time == c2.time) {
+                return c1.index > c2.index;
+            }
+            return c1.time > c2.time;
+        }
+    };
+
+    /// @brief Returns the step whose bucket holds the given event time (the step the event is executed at)
+    long long getStep(SUMOTime time) const {
+        return time <= 0 ? 0 : (time + myBucketWidth - 1) / myBucketWidth;
+    }
+
+    /// @brief Inserts the car into the bucket for its event time (or into the far cars)
+    void insertLeaderCar(const LeaderCar& car);
+
+private:
+    /// @brief the ring of leader cars in the segments, one bucket per step
+    std::vector<std::vector<LeaderCar> > myLeaderCars;
+
+    /// @brief leader cars beyond the range of the ring by step
+    std::map<long long, std::vector<LeaderCar> > myFarLeaderCars;
+
+    /// @brief the step of the current bucket (which is a heap, all earlier buckets are empty)
+    long long myCurrentStep;
+
+    /// @brief the running number of inserted leader cars
+    long long myLeaderCarIndex;
+
+    /// @brief the duration of the step covered by one bucket
+    const SUMOTime myBucketWidth;
 
     /// @brief mapping from internal edge ids to their initial segments
     std::vector<MESegment*> myEdges2FirstSegments;
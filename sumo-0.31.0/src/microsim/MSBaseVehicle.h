@@ -65,6 +65,7 @@ public:
     double getPreviousSpeed() const;
 
     friend class GUIBaseVehicle;
+    friend class MSSimulationContext;
 
     /** @brief Constructor
      * @param[in] pars The vehicle description
@@ -56,6 +56,8 @@ class CState;
  *
  */
 class MSCModel_NonInteracting {
+    friend class MSSimulationContext;
+
 public:
 
     /// @brief Constructor (it should not be necessary to construct more than one instance)
@@ -261,6 +261,8 @@ MSEdge::rebuildAllowedLanes() {
         myMinimumPermissions &= (*i)->getPermissions();
         myCombinedPermissions |= (*i)->getPermissions();
     }
+    // the best lanes of the vehicles depend on the permissions
+    MSVehicle::clearBestLanesCache();
 }
 
 
@@ -329,11 +331,9 @@ MSEdge::allowedLanes(const MSEdge* destination, SUMOVehicleClass vclass) const {
     } else {
         // this vclass is requested for the first time. rebuild all destinations
         // go through connected edges
-#ifdef HAVE_FOX
         if (MSDevice_Routing::isParallel()) {
             MSDevice_Routing::lock();
         }
-#endif
         for (AllowedLanesCont::const_iterator i1 = myAllowed.begin(); i1 != myAllowed.end(); ++i1) {
             const MSEdge* edge = i1->first;
             const std::vector<MSLane*>* lanes = i1->second;
@@ -364,11 +364,9 @@ MSEdge::allowedLanes(const MSEdge* destination, SUMOVehicleClass vclass) const {
                 myClassedAllowed[vclass][edge] = 0;
             }
         }
-#ifdef HAVE_FOX
         if (MSDevice_Routing::isParallel()) {
             MSDevice_Routing::unlock();
         }
-#endif
         return myClassedAllowed[vclass][destination];
     }
 }
@@ -929,11 +927,9 @@ MSEdge::getSuccessors(SUMOVehicleClass vClass) const {
     if (vClass == SVC_IGNORING || !MSNet::getInstance()->hasPermissions() || myFunction == EDGEFUNC_CONNECTOR) {
         return mySuccessors;
     }
-#ifdef HAVE_FOX
     if (MSDevice_Routing::isParallel()) {
         MSDevice_Routing::lock();
     }
-#endif
     std::map<SUMOVehicleClass, MSEdgeVector>::iterator i = myClassesSuccessorMap.find(vClass);
     if (i == myClassesSuccessorMap.end()) {
         // instantiate vector
@@ -952,11 +948,9 @@ MSEdge::getSuccessors(SUMOVehicleClass vClass) const {
         }
     }
     // can use cached value
-#ifdef HAVE_FOX
     if (MSDevice_Routing::isParallel()) {
         MSDevice_Routing::unlock();
     }
-#endif
     return i->second;
 }
 
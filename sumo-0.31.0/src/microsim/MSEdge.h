@@ -79,6 +79,8 @@ typedef std::vector<MSEdge*> MSEdgeVector;
 typedef std::vector<const MSEdge*> ConstMSEdgeVector;
 
 class MSEdge : public Named, public Parameterised {
+    friend class MSSimulationContext;
+
 public:
     /** @brief Suceeding edges (keys) and allowed lanes to reach these edges (values). */
     typedef std::map< const MSEdge*, std::vector<MSLane*>* > AllowedLanesCont;
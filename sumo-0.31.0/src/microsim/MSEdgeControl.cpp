@@ -38,6 +38,7 @@
 #include "MSVehicle.h"
 #include <iostream>
 #include <vector>
+#include <algorithm>
 
 
 // ===========================================================================
@@ -46,6 +47,7 @@
 MSEdgeControl::MSEdgeControl(const std::vector< MSEdge* >& edges)
     : myEdges(edges),
       myLanes(MSLane::dictSize()),
+      myActiveLaneBits(MSLane::dictSize(), false),
       myLastLaneChange(MSEdge::dictSize()) {
     // build the usage definitions for lanes
     for (std::vector< MSEdge* >::const_iterator i = myEdges.begin(); i != myEdges.end(); ++i) {
@@ -55,7 +57,6 @@ MSEdgeControl::MSEdgeControl(const std::vector< MSEdge* >& edges)
             myLanes[pos].lane = *(lanes.begin());
             myLanes[pos].firstNeigh = lanes.end();
             myLanes[pos].lastNeigh = lanes.end();
-            myLanes[pos].amActive = false;
             myLanes[pos].haveNeighbors = false;
         } else {
             for (std::vector<MSLane*>::const_iterator j = lanes.begin(); j != lanes.end(); ++j) {
@@ -63,7 +64,6 @@ MSEdgeControl::MSEdgeControl(const std::vector< MSEdge* >& edges)
                 myLanes[pos].lane = *j;
                 myLanes[pos].firstNeigh = (j + 1);
                 myLanes[pos].lastNeigh = lanes.end();
-                myLanes[pos].amActive = false;
                 myLanes[pos].haveNeighbors = true;
             }
             myLastLaneChange[(*i)->getNumericalID()] = -1;
@@ -78,60 +78,158 @@ MSEdgeControl::~MSEdgeControl() {
 
 void
 MSEdgeControl::patchActiveLanes() {
-    for (std::set<MSLane*, Named::ComparatorIdLess>::iterator i = myChangedStateLanes.begin(); i != myChangedStateLanes.end(); ++i) {
-        LaneUsage& lu = myLanes[(*i)->getNumericalID()];
+    // the lanes are activated sorted by id, the order of the active lanes influences the simulation
+    std::sort(myChangedStateLanes.begin(), myChangedStateLanes.end(), Named::ComparatorIdLess());
+    myChangedStateLanes.erase(std::unique(myChangedStateLanes.begin(), myChangedStateLanes.end()), myChangedStateLanes.end());
+    std::vector<MSLane*> toAdd;
+    for (std::vector<MSLane*>::iterator i = myChangedStateLanes.begin(); i != myChangedStateLanes.end(); ++i) {
+        const int index = (*i)->getNumericalID();
         // if the lane was inactive but is now...
-        if (!lu.amActive && (*i)->getVehicleNumber() > 0) {
+        if (!myActiveLaneBits[index] && (*i)->getVehicleNumber() > 0) {
             // ... add to active lanes and mark as such
-            if (lu.haveNeighbors) {
-                myActiveLanes.push_front(*i);
-            } else {
-                myActiveLanes.push_back(*i);
-            }
-            lu.amActive = true;
+            toAdd.push_back(*i);
+            myActiveLaneBits[index] = true;
         }
     }
+    addActiveLanes(toAdd);
     myChangedStateLanes.clear();
 }
 
+
+void
+MSEdgeControl::addActiveLanes(const std::vector<MSLane*>& lanes) {
+    int numFront = 0;
+    for (std::vector<MSLane*>::const_iterator i = lanes.begin(); i != lanes.end(); ++i) {
+        if (myLanes[(*i)->getNumericalID()].haveNeighbors) {
+            numFront++;
+        }
+    }
+    if (numFront == 0) {
+        myActiveLanes.insert(myActiveLanes.end(), lanes.begin(), lanes.end());
+        return;
+    }
+    // lanes with neighbors go to the front, the latest first
+    std::vector<MSLane*> active;
+    active.reserve(myActiveLanes.size() + lanes.size());
+    for (std::vector<MSLane*>::const_reverse_iterator i = lanes.rbegin(); i != lanes.rend(); ++i) {
+        if (myLanes[(*i)->getNumericalID()].haveNeighbors) {
+            active.push_back(*i);
+        }
+    }
+    active.insert(active.end(), myActiveLanes.begin(), myActiveLanes.end());
+    for (std::vector<MSLane*>::const_iterator i = lanes.begin(); i != lanes.end(); ++i) {
+        if (!myLanes[(*i)->getNumericalID()].haveNeighbors) {
+            active.push_back(*i);
+        }
+    }
+    myActiveLanes.swap(active);
+}
+
+
 void
 MSEdgeControl::planMovements(SUMOTime t) {
-    for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end();) {
+#ifdef HAVE_FOX
+    if (MSGlobals::gNumSimThreads > 1) {
+        planMovementsParallel(t);
+        return;
+    }
+#endif
+    std::vector<MSLane*>::iterator keep = myActiveLanes.begin();
+    for (std::vector<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
         if ((*i)->getVehicleNumber() == 0) {
-            myLanes[(*i)->getNumericalID()].amActive = false;
-            i = myActiveLanes.erase(i);
+            myActiveLaneBits[(*i)->getNumericalID()] = false;
         } else {
             (*i)->planMovements(t);
-            ++i;
+            *keep++ = *i;
         }
     }
+    myActiveLanes.erase(keep, myActiveLanes.end());
 }
 
 
+#ifdef HAVE_FOX
+void
+MSEdgeControl::planMovementsParallel(SUMOTime t) {
+    if (myThreadPool.size() == 0) {
+        // fill the lazily computed lane caches before they are queried concurrently
+        for (MSEdgeVector::const_iterator i = myEdges.begin(); i != myEdges.end(); ++i) {
+            const std::vector<MSLane*>& lanes = (*i)->getLanes();
+            for (std::vector<MSLane*>::const_iterator j = lanes.begin(); j != lanes.end(); ++j) {
+                (*j)->getLogicalPredecessorLane();
+            }
+        }
+        while (myThreadPool.size() < MSGlobals::gNumSimThreads) {
+            new FXWorkerThread(myThreadPool);
+        }
+    }
+    int numVehicles = 0;
+    std::vector<MSLane*>::iterator keep = myActiveLanes.begin();
+    for (std::vector<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
+        if ((*i)->getVehicleNumber() == 0) {
+            myActiveLaneBits[(*i)->getNumericalID()] = false;
+        } else {
+            numVehicles += (*i)->getVehicleNumber();
+            *keep++ = *i;
+        }
+    }
+    myActiveLanes.erase(keep, myActiveLanes.end());
+    // there is no work stealing, so each thread gets one task with
+    // consecutive lanes holding about the same number of vehicles
+    const int numThreads = myThreadPool.size();
+    int numAssigned = 0;
+    int threadIndex = 0;
+    PlanTask* task = 0;
+    for (std::vector<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
+        if (task == 0) {
+            task = new PlanTask(t);
+        }
+        task->add(*i);
+        numAssigned += (*i)->getVehicleNumber();
+        if (numAssigned * numThreads >= numVehicles * (threadIndex + 1)) {
+            myThreadPool.add(task, threadIndex++);
+            task = 0;
+        }
+    }
+    myThreadPool.waitAll();
+    // approach registrations and right-of-way decisions depend on the order
+    for (std::vector<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
+        (*i)->planMovements(t, MSLane::PLAN_REGISTER);
+    }
+}
+
+
+void
+MSEdgeControl::PlanTask::run(FXWorkerThread* /* context */) {
+    for (std::vector<MSLane*>::iterator i = myLanes.begin(); i != myLanes.end(); ++i) {
+        (*i)->planMovements(myTime, MSLane::PLAN_SPECULATIVE);
+    }
+}
+#endif
+
+
 void
 MSEdgeControl::executeMovements(SUMOTime t) {
     myWithVehicles2Integrate.clear();
-    for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end();) {
+    std::vector<MSLane*>::iterator keep = myActiveLanes.begin();
+    for (std::vector<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
         if ((*i)->getVehicleNumber() == 0 || (*i)->executeMovements(t, myWithVehicles2Integrate)) {
-            myLanes[(*i)->getNumericalID()].amActive = false;
-            i = myActiveLanes.erase(i);
+            myActiveLaneBits[(*i)->getNumericalID()] = false;
         } else {
-            ++i;
+            *keep++ = *i;
         }
     }
+    myActiveLanes.erase(keep, myActiveLanes.end());
+    std::vector<MSLane*> toAdd;
     for (std::vector<MSLane*>::iterator i = myWithVehicles2Integrate.begin(); i != myWithVehicles2Integrate.end(); ++i) {
         if ((*i)->integrateNewVehicle(t)) {
-            LaneUsage& lu = myLanes[(*i)->getNumericalID()];
-            if (!lu.amActive) {
-                if (lu.haveNeighbors) {
-                    myActiveLanes.push_front(*i);
-                } else {
-                    myActiveLanes.push_back(*i);
-                }
-                lu.amActive = true;
+            const int index = (*i)->getNumericalID();
+            if (!myActiveLaneBits[index]) {
+                toAdd.push_back(*i);
+                myActiveLaneBits[index] = true;
             }
         }
     }
+    addActiveLanes(toAdd);
     if (MSGlobals::gLateralResolution > 0) {
         // multiple vehicle shadows may have entered an inactive lane and would
         // not be sorted otherwise
@@ -145,8 +243,8 @@ MSEdgeControl::executeMovements(SUMOTime t) {
 void
 MSEdgeControl::changeLanes(SUMOTime t) {
     std::vector<MSLane*> toAdd;
-    for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end();) {
-        LaneUsage& lu = myLanes[(*i)->getNumericalID()];
+    for (std::vector<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end();) {
+        const LaneUsage& lu = myLanes[(*i)->getNumericalID()];
         if (lu.haveNeighbors) {
             MSEdge& edge = (*i)->getEdge();
             if (myLastLaneChange[edge.getNumericalID()] != t) {
@@ -154,14 +252,14 @@ MSEdgeControl::changeLanes(SUMOTime t) {
                 edge.changeLanes(t);
                 const std::vector<MSLane*>& lanes = edge.getLanes();
                 for (std::vector<MSLane*>::const_iterator i = lanes.begin(); i != lanes.end(); ++i) {
-                    LaneUsage& lu = myLanes[(*i)->getNumericalID()];
+                    const int index = (*i)->getNumericalID();
                     //if ((*i)->getID() == "disabled") {
                     //    std::cout << SIMTIME << " vehicles=" << toString((*i)->getVehiclesSecure()) << "\n";
                     //    (*i)->releaseVehicles();
                     //}
-                    if ((*i)->getVehicleNumber() > 0 && !lu.amActive) {
+                    if ((*i)->getVehicleNumber() > 0 && !myActiveLaneBits[index]) {
                         toAdd.push_back(*i);
-                        lu.amActive = true;
+                        myActiveLaneBits[index] = true;
                     }
                 }
             }
@@ -170,16 +268,14 @@ MSEdgeControl::changeLanes(SUMOTime t) {
             i = myActiveLanes.end();
         }
     }
-    for (std::vector<MSLane*>::iterator i = toAdd.begin(); i != toAdd.end(); ++i) {
-        myActiveLanes.push_front(*i);
-    }
+    addActiveLanes(toAdd);
 }
 
 
 void
 MSEdgeControl::detectCollisions(SUMOTime timestep, const std::string& stage) {
     // Detections is made by the edge's lanes, therefore hand over.
-    for (std::list<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
+    for (std::vector<MSLane*>::iterator i = myActiveLanes.begin(); i != myActiveLanes.end(); ++i) {
         (*i)->detectCollisions(timestep, stage);
     }
 }
@@ -197,7 +293,7 @@ MSEdgeControl::getEdgeNames() const {
 
 void
 MSEdgeControl::gotActive(MSLane* l) {
-    myChangedStateLanes.insert(l);
+    myChangedStateLanes.push_back(l);
 }
 
 void
@@ -211,5 +307,23 @@ MSEdgeControl::setAdditionalRestrictions() {
 }
 
 
+void
+MSEdgeControl::clearState() {
+    for (MSEdgeVector::const_iterator i = myEdges.begin(); i != myEdges.end(); ++i) {
+        const std::vector<MSLane*>& lanes = (*i)->getLanes();
+        for (std::vector<MSLane*>::const_iterator j = lanes.begin(); j != lanes.end(); ++j) {
+            (*j)->clearState();
+            myActiveLaneBits[(*j)->getNumericalID()] = false;
+        }
+        if ((*i)->hasLaneChanger()) {
+            myLastLaneChange[(*i)->getNumericalID()] = -1;
+        }
+    }
+    myActiveLanes.clear();
+    myWithVehicles2Integrate.clear();
+    myChangedStateLanes.clear();
+}
+
+
 /****************************************************************************/
 
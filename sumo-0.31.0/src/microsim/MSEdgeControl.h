@@ -44,6 +44,10 @@
 #include <utils/common/SUMOTime.h>
 #include <utils/common/Named.h>
 
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXWorkerThread.h>
+#endif
+
 
 // ===========================================================================
 // class declarations
@@ -105,6 +109,10 @@ public:
      * ApproachingVehicleInformation for all links
      *
      * This method goes through all active lanes calling their "planMovements" method.
+     *
+     * When running with several threads, the lanes are planned speculatively in
+     *  parallel first and the plans are registered at the links in the sequential
+     *  order afterwards, so the results do not depend on the number of threads.
      * @see MSLane::planMovements
      */
     void planMovements(SUMOTime t);
@@ -178,6 +186,17 @@ public:
     /// @brief apply additional restrictions
     void setAdditionalRestrictions();
 
+    /// @brief Returns the number of active lanes (valid after planning the movements)
+    int getActiveLaneNumber() const {
+        return (int)myActiveLanes.size();
+    }
+
+    /** @brief Empties all lanes and forgets the active ones before quick-loading state
+     *
+     * The vehicles themselves are deleted by MSVehicleControl::clearState
+     */
+    void clearState();
+
 
 public:
     /**
@@ -198,12 +217,59 @@ public:
         std::vector<MSLane*>::const_iterator firstNeigh;
         /// @brief The end of this lane's edge's lane container
         std::vector<MSLane*>::const_iterator lastNeigh;
-        /// @brief Information whether this lane is active
-        bool amActive;
         /// @brief Information whether this lane belongs to a multi-lane edge
         bool haveNeighbors;
     };
 
+private:
+    /** @brief Adds lanes which got active to myActiveLanes
+     *
+     * Lanes of edges with a lane changer are put to the front (the last given
+     *  first), the others are appended.
+     * @param[in] lanes The lanes to add (not yet active)
+     */
+    void addActiveLanes(const std::vector<MSLane*>& lanes);
+
+
+#ifdef HAVE_FOX
+    /**
+     * @class PlanTask
+     * @brief Speculatively plans the movements on a set of lanes in a worker thread
+     */
+    class PlanTask : public FXWorkerThread::Task {
+    public:
+        /// @brief Constructor
+        PlanTask(const SUMOTime t) : myTime(t) {}
+
+        /// @brief Adds a lane to plan
+        void add(MSLane* lane) {
+            myLanes.push_back(lane);
+        }
+
+        /// @brief Plans the movements on all assigned lanes
+        void run(FXWorkerThread* context);
+
+    private:
+        /// @brief The current time step
+        const SUMOTime myTime;
+
+        /// @brief The lanes to plan
+        std::vector<MSLane*> myLanes;
+
+    private:
+        /// @brief Invalidated assignment operator
+        PlanTask& operator=(const PlanTask&);
+    };
+
+
+    /** @brief Plans the movements using the thread pool
+     * @param[in] t The current time step
+     * @see planMovements
+     */
+    void planMovementsParallel(SUMOTime t);
+#endif
+
+
 private:
     /// @brief Loaded edges
     MSEdgeVector myEdges;
@@ -214,18 +280,30 @@ private:
     /// @brief Information about lanes' number of vehicles and neighbors
     LaneUsageVector myLanes;
 
-    /// @brief The list of active (not empty) lanes
-    std::list<MSLane*> myActiveLanes;
+    /** @brief The active (not empty) lanes
+     *
+     * Lanes of edges with a lane changer come first. Lanes which become
+     *  empty are removed while iterating for planning or executing the movements.
+     */
+    std::vector<MSLane*> myActiveLanes;
+
+    /// @brief Whether the lane with the respective numerical id is in myActiveLanes
+    std::vector<bool> myActiveLaneBits;
 
     /// @brief A storage for lanes which shall be integrated because vehicles have moved onto them
     std::vector<MSLane*> myWithVehicles2Integrate;
 
-    /// @brief Lanes which changed the state without informing the control
-    std::set<MSLane*, Named::ComparatorIdLess> myChangedStateLanes;
+    /// @brief Lanes which changed the state without informing the control (may contain duplicates)
+    std::vector<MSLane*> myChangedStateLanes;
 
     /// @brief The list of active (not empty) lanes
     std::vector<SUMOTime> myLastLaneChange;
 
+#ifdef HAVE_FOX
+    /// @brief The worker threads for planning the movements (started on first use)
+    FXWorkerThread::Pool myThreadPool;
+#endif
+
 private:
     /// @brief Copy constructor.
     MSEdgeControl(const MSEdgeControl&);
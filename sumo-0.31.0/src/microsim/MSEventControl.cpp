@@ -39,40 +39,101 @@
 #include "MSNet.h"
 
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const int MSEventControl::WHEEL_SIZE = 1024;
+
+
 // ===========================================================================
 // member definitions
 // ===========================================================================
 MSEventControl::MSEventControl()
-    : currentTimeStep(-1), myEvents() {}
+    : currentTimeStep(-1), myWheel(WHEEL_SIZE), mySlotWidth(DELTA_T),
+      myNextSlot(0), myWheelEventNumber(0), myEventIndex(0) {}
 
 
 MSEventControl::~MSEventControl() {
     // delete the events
-    while (!myEvents.empty()) {
-        Event e = myEvents.top();
-        delete e.first;
-        myEvents.pop();
+    while (!myDueEvents.empty()) {
+        delete myDueEvents.top().event.first;
+        myDueEvents.pop();
+    }
+    for (std::vector<std::vector<QueuedEvent> >::iterator i = myWheel.begin(); i != myWheel.end(); ++i) {
+        for (std::vector<QueuedEvent>::iterator j = i->begin(); j != i->end(); ++j) {
+            delete j->event.first;
+        }
+    }
+    while (!myFarEvents.empty()) {
+        delete myFarEvents.top().event.first;
+        myFarEvents.pop();
     }
 }
 
 
 void
 MSEventControl::addEvent(Command* operation, SUMOTime execTimeStep) {
-    myEvents.push(Event(operation, execTimeStep));
+    insert(QueuedEvent(Event(operation, execTimeStep), myEventIndex++));
+}
+
+
+void
+MSEventControl::insert(const QueuedEvent& event) {
+    const SUMOTime time = event.event.second;
+    if (time < 0 || getSlot(time) < myNextSlot) {
+        // the slot was already collected (or the event shall be executed at sim start)
+        myDueEvents.push(event);
+    } else if (getSlot(time) < myNextSlot + WHEEL_SIZE) {
+        myWheel[getSlot(time) % WHEEL_SIZE].push_back(event);
+        myWheelEventNumber++;
+    } else {
+        myFarEvents.push(event);
+    }
+}
+
+
+void
+MSEventControl::collectDue(SUMOTime limit) {
+    if (limit <= 0) {
+        return;
+    }
+    // all slots starting before the limit have to be collected
+    const long long limitSlot = (limit - 1) / mySlotWidth + 1;
+    while (myNextSlot < limitSlot) {
+        if (myWheelEventNumber == 0) {
+            // skip the empty slots
+            myNextSlot = limitSlot;
+            break;
+        }
+        std::vector<QueuedEvent>& slot = myWheel[myNextSlot % WHEEL_SIZE];
+        for (std::vector<QueuedEvent>::const_iterator i = slot.begin(); i != slot.end(); ++i) {
+            myDueEvents.push(*i);
+        }
+        myWheelEventNumber -= (int)slot.size();
+        slot.clear();
+        myNextSlot++;
+    }
+    // move the far events which are now within the range of the wheel (or already due)
+    while (!myFarEvents.empty() && getSlot(myFarEvents.top().event.second) < myNextSlot + WHEEL_SIZE) {
+        const QueuedEvent event = myFarEvents.top();
+        myFarEvents.pop();
+        insert(event);
+    }
 }
 
 
 void
 MSEventControl::execute(SUMOTime execTime) {
     // Execute all events that are scheduled for execTime.
-    while (!myEvents.empty()) {
-        Event currEvent = myEvents.top();
-        if (currEvent.second < 0) {
-            currEvent.second = execTime;
+    collectDue(execTime + DELTA_T);
+    while (!myDueEvents.empty()) {
+        QueuedEvent currEvent = myDueEvents.top();
+        if (currEvent.event.second < 0) {
+            currEvent.event.second = execTime;
         }
-        if (currEvent.second < execTime + DELTA_T) {
-            Command* command = currEvent.first;
-            myEvents.pop();
+        if (currEvent.event.second < execTime + DELTA_T) {
+            Command* command = currEvent.event.first;
+            myDueEvents.pop();
             SUMOTime time = 0;
             try {
                 time = command->execute(execTime);
@@ -87,10 +148,10 @@ MSEventControl::execute(SUMOTime execTime) {
                 if (time < 0) {
                     WRITE_WARNING("Command returned negative repeat number; will be deleted.");
                 }
-                delete currEvent.first;
+                delete command;
             } else {
-                currEvent.second += time;
-                myEvents.push(currEvent);
+                currEvent.event.second += time;
+                insert(currEvent);
             }
         } else {
             break;
@@ -101,9 +162,58 @@ MSEventControl::execute(SUMOTime execTime) {
 
 bool
 MSEventControl::isEmpty() {
-    return myEvents.empty();
+    return myDueEvents.empty() && myWheelEventNumber == 0 && myFarEvents.empty();
+}
+
+std::map<long long, SUMOTime>
+MSEventControl::getEventTimes() const {
+    std::map<long long, SUMOTime> result;
+    EventCont due = myDueEvents;
+    while (!due.empty()) {
+        result[due.top().index] = due.top().event.second;
+        due.pop();
+    }
+    for (std::vector<std::vector<QueuedEvent> >::const_iterator i = myWheel.begin(); i != myWheel.end(); ++i) {
+        for (std::vector<QueuedEvent>::const_iterator j = i->begin(); j != i->end(); ++j) {
+            result[j->index] = j->event.second;
+        }
+    }
+    EventCont far = myFarEvents;
+    while (!far.empty()) {
+        result[far.top().index] = far.top().event.second;
+        far.pop();
+    }
+    return result;
 }
 
+
+void
+MSEventControl::setEventTimes(const std::map<long long, SUMOTime>& times, SUMOTime currentTime) {
+    std::vector<QueuedEvent> events;
+    while (!myDueEvents.empty()) {
+        events.push_back(myDueEvents.top());
+        myDueEvents.pop();
+    }
+    for (std::vector<std::vector<QueuedEvent> >::iterator i = myWheel.begin(); i != myWheel.end(); ++i) {
+        events.insert(events.end(), i->begin(), i->end());
+        i->clear();
+    }
+    myWheelEventNumber = 0;
+    while (!myFarEvents.empty()) {
+        events.push_back(myFarEvents.top());
+        myFarEvents.pop();
+    }
+    myNextSlot = currentTime < 0 ? 0 : getSlot(currentTime);
+    for (std::vector<QueuedEvent>::iterator i = events.begin(); i != events.end(); ++i) {
+        std::map<long long, SUMOTime>::const_iterator time = times.find(i->index);
+        if (time != times.end()) {
+            i->event.second = time->second;
+        }
+        insert(*i);
+    }
+}
+
+
 void
 MSEventControl::setCurrentTimeStep(SUMOTime time) {
     currentTimeStep = time;
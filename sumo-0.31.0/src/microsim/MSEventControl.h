@@ -53,12 +53,22 @@ class Command;
 /**
  * @class MSEventControl
  * @brief Stores time-dependant events and executes them at the proper time
+ *
+ * Events within the next WHEEL_SIZE slots (of DELTA_T at construction) are
+ *  kept in a timing wheel which allows to add and collect them in constant
+ *  time. Events further in the future are kept in a heap and moved into the
+ *  wheel when they come within range. Events which are due are executed
+ *  ordered by their execution time and (for equal times) by the order in which
+ *  they were added.
  */
 class MSEventControl {
 public:
     /// @brief Combination of an event and the time it shall be executed at
     typedef std::pair< Command*, SUMOTime > Event;
 
+    /// @brief The number of slots of the timing wheel
+    static const int WHEEL_SIZE;
+
 
 public:
     /// @brief Default constructor.
@@ -114,29 +124,93 @@ public:
     void setCurrentTimeStep(SUMOTime time);
 
 
+    /** @brief Returns the execution times of all queued events
+     *
+     * The events are identified by the running number of their insertion
+     *  which is kept when a recurring event is readded. So the times are only
+     *  valid for this instance (e.g. for in-memory snapshots).
+     *
+     * @return The map of event numbers to execution times
+     */
+    std::map<long long, SUMOTime> getEventTimes() const;
+
+
+    /** @brief Reschedules the queued events to the given times
+     *
+     * Events which are not contained in the map (because they were added later)
+     *  keep their execution time. Events which were deleted in the meantime
+     *  cannot be restored. The timing wheel is rebuilt starting at the given time.
+     *
+     * @param[in] times The execution times as returned by getEventTimes
+     * @param[in] currentTime The new current simulation time
+     */
+    void setEventTimes(const std::map<long long, SUMOTime>& times, SUMOTime currentTime);
+
+
 protected:
+    /// @brief An event together with the running number of its insertion (for stable ordering)
+    struct QueuedEvent {
+        QueuedEvent(const Event& _event, long long _index) : event(_event), index(_index) {}
+        /// @brief the command and its execution time
+        Event event;
+        /// @brief the running number of the insertion
+        long long index;
+    };
+
     /** @brief Sort-criterion for events.
      *
-     * Sorts events by their execution time
+     * Sorts events by their execution time and the order of insertion
      */
     class EventSortCrit {
     public:
         /// @brief compares two events
-        bool operator()(const Event& e1, const Event& e2) const {
-            return e1.second > e2.second;
+        bool operator()(const QueuedEvent& e1, const QueuedEvent& e2) const {
+            if (e1.event.second == e2.event.second) {
+                return e1.index > e2.index;
+            }
+            return e1.event.second > e2.event.second;
         }
     };
 
 
 private:
     /// @brief Container for time-dependant events, e.g. traffic-light-change.
-    typedef std::priority_queue< Event, std::vector< Event >, EventSortCrit > EventCont;
+    typedef std::priority_queue< QueuedEvent, std::vector< QueuedEvent >, EventSortCrit > EventCont;
+
+    /// @brief inserts the event into the wheel, the heap of far events or the due events
+    void insert(const QueuedEvent& event);
+
+    /// @brief moves all events before the given time from the wheel and the far events into the due events
+    void collectDue(SUMOTime limit);
+
+    /// @brief returns the wheel slot of the given (non-negative) time
+    long long getSlot(SUMOTime time) const {
+        return time / mySlotWidth;
+    }
 
     /// The current TimeStep
     SUMOTime currentTimeStep;
 
-    /// @brief Event-container, holds executable events.
-    EventCont myEvents;
+    /// @brief The events which were collected for execution, ordered by time
+    EventCont myDueEvents;
+
+    /// @brief The timing wheel of events in the slots [myNextSlot, myNextSlot + WHEEL_SIZE)
+    std::vector<std::vector<QueuedEvent> > myWheel;
+
+    /// @brief The events beyond the range of the wheel
+    EventCont myFarEvents;
+
+    /// @brief The duration covered by one slot of the wheel
+    const SUMOTime mySlotWidth;
+
+    /// @brief The first slot which has not been collected yet
+    long long myNextSlot;
+
+    /// @brief The number of events in the wheel
+    int myWheelEventNumber;
+
+    /// @brief The running number of added events
+    long long myEventIndex;
 
     /// get the Current TimeStep used in addEvent.
     SUMOTime getCurrentTimeStep();
@@ -263,6 +263,9 @@ MSFrame::fillOptions() {
     oc.doRegister("ignore-accidents", new Option_Bool(false));
     oc.addDescription("ignore-accidents", "Processing", "Do not check whether accidents occur");
 
+    oc.doRegister("threads", new Option_Integer(1));
+    oc.addDescription("threads", "Processing", "Defines the number of threads for planning the vehicle movements");
+
     oc.doRegister("collision.action", new Option_String("teleport"));
     oc.addDescription("collision.action", "Processing", "How to deal with collisions: [none,warn,teleport,remove]");
 
@@ -344,6 +347,12 @@ MSFrame::fillOptions() {
     oc.doRegister("astar.landmark-distances", new Option_FileName());
     oc.addDescription("astar.landmark-distances", "Processing", "Initialize lookup table for astar ALT-variant from the given file");
 
+    oc.doRegister("astar.save-landmark-distances", new Option_FileName());
+    oc.addDescription("astar.save-landmark-distances", "Processing", "Save lookup table for astar ALT-variant to the given file (binary if it ends with '.bin')");
+
+    oc.doRegister("astar.auto-landmarks", new Option_Integer(0));
+    oc.addDescription("astar.auto-landmarks", "Processing", "Select landmarks for astar ALT-variant automatically until there are INT landmarks");
+
     // devices
     oc.addOptionSubTopic("Emissions");
     oc.doRegister("phemlight-path", new Option_FileName("./PHEMlight/"));
@@ -359,7 +368,7 @@ MSFrame::fillOptions() {
     oc.addDescription("duration-log.disable", "Report", "Disable performance reports for individual simulation steps");
 
     oc.doRegister("duration-log.statistics", new Option_Bool(false));
-    oc.addDescription("duration-log.statistics", "Report", "Enable statistics on vehicle trips");
+    oc.addDescription("duration-log.statistics", "Report", "Enable statistics on vehicle trips and the durations of the movement phases");
 
     oc.doRegister("no-step-log", new Option_Bool(false));
     oc.addDescription("no-step-log", "Report", "Disable console output of current simulation step");
@@ -372,6 +381,10 @@ MSFrame::fillOptions() {
     oc.addDescription("remote-port", "TraCI Server", "Enables TraCI Server if set");
     oc.doRegister("num-clients", new Option_Integer(1));
     oc.addDescription("num-clients", "TraCI Server", "Expected number of connecting clients");
+    oc.doRegister("remote-shm", new Option_String());
+    oc.addDescription("remote-shm", "TraCI Server", "Enables TraCI Server for a single local client using the named shared memory segment instead of a socket");
+    oc.doRegister("remote-legacy-subscriptions", new Option_Bool(false));
+    oc.addDescription("remote-legacy-subscriptions", "TraCI Server", "Evaluates all subscriptions by dispatching get commands (slower, for comparison)");
 #ifdef HAVE_PYTHON
     oc.doRegister("python-script", new Option_String());
     oc.addDescription("python-script", "TraCI Server", "Runs TraCI script with embedded python");
@@ -519,6 +532,16 @@ MSFrame::checkOptions() {
         WRITE_ERROR("You can either restart or quit on end.");
         ok = false;
     }
+    if (oc.getInt("threads") < 1) {
+        WRITE_ERROR("The number of threads must be positive.");
+        ok = false;
+    }
+#ifndef HAVE_FOX
+    if (oc.getInt("threads") > 1) {
+        WRITE_ERROR("Parallel simulation is only possible when compiled with Fox.");
+        ok = false;
+    }
+#endif
     if (oc.getBool("meso-junction-control.limited") && !oc.getBool("meso-junction-control")) {
         oc.set("meso-junction-control", "true");
     }
@@ -602,6 +625,7 @@ MSFrame::setMSGlobals(OptionsCont& oc) {
     MSGlobals::gLaneChangeDuration = string2time(oc.getString("lanechange.duration"));
     MSGlobals::gLateralResolution = oc.getFloat("lateral-resolution");
     MSGlobals::gStateLoaded = oc.isSet("load-state");
+    MSGlobals::gNumSimThreads = oc.getInt("threads");
     MSGlobals::gUseMesoSim = oc.getBool("mesosim");
     MSGlobals::gMesoLimitedJunctionControl = oc.getBool("meso-junction-control.limited");
     MSGlobals::gMesoOvertaking = oc.getBool("meso-overtaking");
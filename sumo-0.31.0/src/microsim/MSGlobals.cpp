@@ -64,5 +64,7 @@ MELoop* MSGlobals::gMesoNet;
 bool MSGlobals::gSemiImplicitEulerUpdate;
 
 SUMOTime MSGlobals::gWaitingTimeMemory;
+
+int MSGlobals::gNumSimThreads;
 /****************************************************************************/
 
@@ -94,6 +94,9 @@ public:
     /// Information whether a state has been loaded
     static bool gStateLoaded;
 
+    /// The number of threads planning the vehicle movements
+    static int gNumSimThreads;
+
     /** Information whether mesosim shall be used */
     static bool gUseMesoSim;
 
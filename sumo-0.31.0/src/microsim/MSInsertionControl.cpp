@@ -36,6 +36,8 @@
 #include <algorithm>
 #include <cassert>
 #include <iterator>
+#include <utils/options/OptionsCont.h>
+#include <utils/iodevices/OutputDevice.h>
 #include <microsim/devices/MSDevice_Routing.h>
 #include "MSGlobals.h"
 #include "MSVehicle.h"
@@ -75,13 +77,13 @@ MSInsertionControl::add(SUMOVehicle* veh) {
 
 
 bool
-MSInsertionControl::add(SUMOVehicleParameter* const pars) {
+MSInsertionControl::add(SUMOVehicleParameter* const pars, int index) {
     if (myFlowIDs.count(pars->id) > 0) {
         return false;
     }
     Flow flow;
     flow.pars = pars;
-    flow.index = 0;
+    flow.index = index;
     myFlows.push_back(flow);
     myFlowIDs.insert(pars->id);
     return true;
@@ -301,5 +303,47 @@ MSInsertionControl::getPendingEmits(const MSLane* lane) {
     return myPendingEmitsForLane[lane];
 }
 
+
+void
+MSInsertionControl::saveState(OutputDevice& out) {
+    for (std::vector<Flow>::const_iterator i = myFlows.begin(); i != myFlows.end(); ++i) {
+        const SUMOVehicleParameter* const pars = i->pars;
+        pars->write(out, OptionsCont::getOptions(), SUMO_TAG_FLOWSTATE);
+        out.writeAttr(SUMO_ATTR_BEGIN, time2string(pars->depart));
+        if (pars->repetitionProbability > 0) {
+            out.writeAttr(SUMO_ATTR_PROB, pars->repetitionProbability);
+            if (pars->repetitionEnd != SUMOTime_MAX) {
+                out.writeAttr(SUMO_ATTR_END, time2string(pars->repetitionEnd));
+            }
+        } else {
+            out.writeAttr(SUMO_ATTR_PERIOD, time2string(pars->repetitionOffset));
+            out.writeAttr(SUMO_ATTR_NUMBER, pars->repetitionNumber);
+        }
+        out.writeAttr(SUMO_ATTR_ROUTE, pars->routeid);
+        out.writeAttr(SUMO_ATTR_DONE, pars->repetitionsDone);
+        out.writeAttr(SUMO_ATTR_INDEX, i->index);
+        pars->writeParams(out);
+        out.closeTag();
+    }
+}
+
+
+void
+MSInsertionControl::clearState() {
+    for (std::vector<Flow>::iterator i = myFlows.begin(); i != myFlows.end(); ++i) {
+        delete(i->pars);
+    }
+    myFlows.clear();
+    myFlowIDs.clear();
+    while (!myAllVeh.isEmpty()) {
+        myAllVeh.pop();
+    }
+    myPendingEmits.clear();
+    myEmitCandidates.clear();
+    myAbortedEmits.clear();
+    myPendingEmitsForLane.clear();
+    myPendingEmitsUpdateTime = SUMOTime_MIN;
+}
+
 /****************************************************************************/
 
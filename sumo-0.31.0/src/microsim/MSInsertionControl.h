@@ -45,6 +45,7 @@
 class MSVehicle;
 class MSVehicleControl;
 class SUMOVehicleParameter;
+class OutputDevice;
 
 
 // ===========================================================================
@@ -112,9 +113,10 @@ public:
     /** @brief Adds parameter for a vehicle flow for departure
      *
      * @param[in] flow The flow to add for later insertion
+     * @param[in] index The running index of the next vehicle (non-zero when loading state)
      * @return whether it could be added (no other flow with the same id was present)
      */
-    bool add(SUMOVehicleParameter* const pars);
+    bool add(SUMOVehicleParameter* const pars, int index = 0);
 
 
     /** @brief Returns the number of waiting vehicles
@@ -153,6 +155,17 @@ public:
     /// @brief return the number of pending emits for the given lane
     int getPendingEmits(const MSLane* lane);
 
+    /** @brief Saves the state of all active flows
+     * @param[in] out The (possibly binary) device to write the state into
+     */
+    void saveState(OutputDevice& out);
+
+    /** @brief Removes all flows and forgets all vehicles waiting for insertion
+     *
+     * The vehicles themselves are deleted by MSVehicleControl::clearState
+     */
+    void clearState();
+
 private:
     /** @brief Tries to emit the vehicle
      *
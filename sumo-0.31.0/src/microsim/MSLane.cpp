@@ -44,6 +44,7 @@
 #include <iterator>
 #include <exception>
 #include <climits>
+#include <limits>
 #include <set>
 #include <utils/common/UtilExceptions.h>
 #include <utils/common/StdDefs.h>
@@ -70,6 +71,10 @@
 #include "MSLeaderInfo.h"
 #include "MSVehicle.h"
 
+#ifdef HAVE_FOX
+#include <utils/foxtools/FXConditionalLock.h>
+#endif
+
 //#define DEBUG_INSERTION
 //#define DEBUG_PLAN_MOVE
 //#define DEBUG_CONTEXT
@@ -937,6 +942,10 @@ MSLane::safeInsertionSpeed(const MSVehicle* veh, const MSLeaderInfo& leaders, do
 // ------ Handling vehicles lapping into lanes ------
 const MSLeaderInfo&
 MSLane::getLastVehicleInformation(const MSVehicle* ego, double latOffset, double minPos, bool allowCached) const {
+#ifdef HAVE_FOX
+    // the leaders on the lanes ahead are queried concurrently when planning in parallel
+    FXConditionalLock lock(myLeaderInfoMutex, MSGlobals::gNumSimThreads > 1);
+#endif
     if (myLeaderInfoTime < MSNet::getInstance()->getCurrentTimeStep() || ego != 0 || minPos > 0 || !allowCached) {
         myLeaderInfoTmp = MSLeaderInfo(this, ego, latOffset);
         AnyVehicleIterator last = anyVehiclesBegin();
@@ -1041,7 +1050,7 @@ MSLane::getFirstVehicleInformation(const MSVehicle* ego, double latOffset, bool
 
 // ------  ------
 void
-MSLane::planMovements(SUMOTime t) {
+MSLane::planMovements(SUMOTime t, PlanStage stage) {
     assert(myVehicles.size() != 0);
     double cumulatedVehLength = 0.;
     MSLeaderInfo ahead(this);
@@ -1075,7 +1084,17 @@ MSLane::planMovements(SUMOTime t) {
             std::cout << "   plan move for: " << (*veh)->getID() << " ahead=" << ahead.toString() << "\n";
         }
 #endif
-        (*veh)->planMove(t, ahead, cumulatedVehLength);
+        switch (stage) {
+            case PLAN_SPECULATIVE:
+                (*veh)->planMoveSpeculative(t, ahead);
+                break;
+            case PLAN_REGISTER:
+                (*veh)->registerPlannedMove(t, ahead, cumulatedVehLength);
+                break;
+            default:
+                (*veh)->planMove(t, ahead, cumulatedVehLength);
+                break;
+        }
         cumulatedVehLength += (*veh)->getVehicleType().getLengthWithGap();
         ahead.addLeader(*veh, false, 0);
     }
@@ -1119,21 +1138,49 @@ MSLane::detectCollisions(SUMOTime timestep, const std::string& stage) {
         // other on the same lane
         // instead, a moving-window approach is used where all vehicles that
         // overlap in the longitudinal direction receive pairwise checks
-        // XXX for efficiency, all lanes of an edge should be checked together
-        // (lanechanger-style)
-
-        // XXX quick hack: check each in myVehicles against all others
+        std::vector<MSVehicle*>& vehs = myCollisionVehicles;
+        std::vector<double>& positions = myCollisionPositions;
+        // the vehicles (as indices into vehs) sorted by their front position
+        std::vector<std::pair<double, int> >& sorted = myCollisionSorted;
+        std::vector<int>& candidates = myCollisionCandidates;
+        vehs.clear();
+        positions.clear();
+        sorted.clear();
+        // the maximum distance between the front and the back of a vehicle on this lane
+        double maxExtent = 0;
+        // the maximum minGap of a vehicle on this lane
+        double maxMinGap = 0;
+        bool haveOpposite = false;
         for (AnyVehicleIterator veh = anyVehiclesBegin(); veh != anyVehiclesEnd(); ++veh) {
-            MSVehicle* follow = (MSVehicle*)*veh;
-            for (AnyVehicleIterator veh2 = anyVehiclesBegin(); veh2 != anyVehiclesEnd(); ++veh2) {
-                MSVehicle* lead = (MSVehicle*)*veh2;
-                if (lead == follow) {
-                    continue;
+            MSVehicle* v = (MSVehicle*)*veh;
+            const double pos = v->getPositionOnLane(this);
+            maxExtent = MAX2(maxExtent, fabs(pos - v->getBackPositionOnLane(this)));
+            maxMinGap = MAX2(maxMinGap, v->getVehicleType().getMinGap());
+            haveOpposite |= v->getLaneChangeModel().isOpposite();
+            sorted.push_back(std::make_pair(pos, (int)vehs.size()));
+            vehs.push_back(v);
+            positions.push_back(pos);
+        }
+        std::sort(sorted.begin(), sorted.end());
+        for (int i = 0; i < (int)vehs.size(); ++i) {
+            MSVehicle* follow = vehs[i];
+            // a leader can only collide if its back is before the front (plus minGap) of the follower.
+            // opposite vehicles measure the gap from their back and use the minGap of the leader if both are opposite,
+            // so the window is widened by the extent of the follower and the largest minGap
+            const double maxLeaderPos = (haveOpposite
+                                         ? positions[i] + maxMinGap + 2 * maxExtent
+                                         : positions[i] + follow->getVehicleType().getMinGap() + maxExtent);
+            candidates.clear();
+            for (std::vector<std::pair<double, int> >::const_iterator it = std::lower_bound(sorted.begin(), sorted.end(), std::make_pair(positions[i], -1));
+                    it != sorted.end() && it->first <= maxLeaderPos; ++it) {
+                if (it->second != i) {
+                    candidates.push_back(it->second);
                 }
-                if (lead->getPositionOnLane(this) < follow->getPositionOnLane(this)) {
-                    continue;
-                }
-                if (detectCollisionBetween(timestep, stage, follow, lead, toRemove, toTeleport)) {
+            }
+            // check in the order of the vehicles on the lane
+            std::sort(candidates.begin(), candidates.end());
+            for (std::vector<int>::const_iterator it = candidates.begin(); it != candidates.end(); ++it) {
+                if (detectCollisionBetween(timestep, stage, follow, vehs[*it], toRemove, toTeleport)) {
                     // XXX what about collisions with multiple leaders at once?
                     break;
                 }
@@ -1418,6 +1465,8 @@ MSLane::handleCollisionBetween(SUMOTime timestep, const std::string& stage, MSVe
                   + (latGap == 0 ? "" : "', latGap=" + toString(latGap))
                   + ", time=" + time2string(MSNet::getInstance()->getCurrentTimeStep())
                   + " stage=" + stage + ".");
+    MSNet::getInstance()->informVehicleStateListener(victim, MSNet::VEHICLE_STATE_COLLISION);
+    MSNet::getInstance()->informVehicleStateListener(collider, MSNet::VEHICLE_STATE_COLLISION);
     MSNet::getInstance()->getVehicleControl().registerCollision();
 }
 
@@ -1831,6 +1880,8 @@ void
 MSLane::setLength(double val) {
     myLength = val;
     myEdge->recalcCache();
+    // the best lanes of the vehicles depend on the lane lengths
+    MSVehicle::clearBestLanesCache();
 }
 
 
@@ -2660,6 +2711,20 @@ MSLane::loadState(std::vector<std::string>& vehIds, MSVehicleControl& vc) {
 }
 
 
+void
+MSLane::clearState() {
+    myVehicles.clear();
+    myPartialVehicles.clear();
+    myTmpVehicles.clear();
+    myVehBuffer.clear();
+    myParkingVehicles.clear();
+    myBruttoVehicleLengthSum = 0;
+    myNettoVehicleLengthSum = 0;
+    myLeaderInfoTime = SUMOTime_MIN;
+    myFollowerInfoTime = SUMOTime_MIN;
+}
+
+
 MSLeaderDistanceInfo
 MSLane::getFollowersOnConsecutive(const MSVehicle* ego, double backOffset,
                                   bool allSublanes, double searchDist, bool ignoreMinorLinks) const {
@@ -51,6 +51,9 @@
 #ifndef NO_TRACI
 #include <traci-server/TraCIServerAPI_Lane.h>
 #endif
+#ifdef HAVE_FOX
+#include <fx.h>
+#endif
 
 
 // ===========================================================================
@@ -77,6 +80,8 @@ class MSLeaderInfo;
  *  simulation. Allows moving vehicles.
  */
 class MSLane : public Named, public Parameterised {
+    friend class MSSimulationContext;
+
 public:
     /// needs access to myTmpVehicles (this maybe should be done via double-buffering!!!)
     friend class MSLaneChanger;
@@ -516,14 +521,27 @@ public:
     /// @name Vehicle movement (longitudinal)
     /// @{
 
+    /// @brief The stages of planning the movements (see MSEdgeControl::planMovements)
+    enum PlanStage {
+        /// @brief plan the movements and register them at the links
+        PLAN_COMPLETE,
+        /// @brief plan the movements without modifying links (may run concurrently for different lanes)
+        PLAN_SPECULATIVE,
+        /// @brief register the speculatively planned movements at the links
+        PLAN_REGISTER
+    };
+
     /** @brief Compute safe velocities for all vehicles based on positions and
      * speeds from the last time step. Also registers
      * ApproachingVehicleInformation for all links
      *
-     * This method goes through all vehicles calling their "planMove" method.
+     * This method goes through all vehicles calling their "planMove" method
+     *  (or planMoveSpeculative / registerPlannedMove for the parallel stages).
+     * @param[in] t The current time step
+     * @param[in] stage The planning stage to perform
      * @see MSVehicle::planMove
      */
-    virtual void planMovements(const SUMOTime t);
+    virtual void planMovements(const SUMOTime t, PlanStage stage = PLAN_COMPLETE);
 
     /** @brief Executes planned vehicle movements with regards to right-of-way
      *
@@ -1018,6 +1036,12 @@ public:
      * @todo What about throwing an error if something else fails (a vehicle can not be referenced)?
      */
     void loadState(std::vector<std::string>& vehIDs, MSVehicleControl& vc);
+
+    /** @brief Forgets all vehicles before quick-loading state
+     *
+     * The vehicles themselves are deleted by MSVehicleControl::clearState
+     */
+    void clearState();
     /// @}
 
 
@@ -1210,6 +1234,11 @@ protected:
     /// @brief time step for which myFollowerInfo was last updated
     mutable SUMOTime myFollowerInfoTime;
 
+#ifdef HAVE_FOX
+    /// @brief the mutex for the leader information when planning in parallel
+    mutable FXMutex myLeaderInfoMutex;
+#endif
+
     /// @brief precomputed myShape.length / myLength
     const double myLengthGeometryFactor;
 
@@ -1227,6 +1256,14 @@ protected:
     // @brief transient changes in permissions
     std::map<long, SVCPermissions> myPermissionChanges;
 
+    /// @name buffers reused by the sublane collision detection (to avoid allocations in every step)
+    /// @{
+    std::vector<MSVehicle*> myCollisionVehicles;
+    std::vector<double> myCollisionPositions;
+    std::vector<std::pair<double, int> > myCollisionSorted;
+    std::vector<int> myCollisionCandidates;
+    /// @}
+
     /// definition of the static dictionary type
     typedef std::map< std::string, MSLane* > DictType;
 
@@ -260,23 +260,31 @@ getLastIntersections(const MSLane* lane, const MSLane* foe);
 void
 MSLink::setApproaching(const SUMOVehicle* approaching, const SUMOTime arrivalTime, const double arrivalSpeed, const double leaveSpeed,
                        const bool setRequest, const SUMOTime arrivalTimeBraking, const double arrivalSpeedBraking, const SUMOTime waitingTime, double dist) {
+    for (ApproachInfos::const_iterator i = myApproachingVehicles.begin(); i != myApproachingVehicles.end(); ++i) {
+        if (i->first == approaching) {
+            // keep the first registration
+            return;
+        }
+    }
     const SUMOTime leaveTime = getLeaveTime(arrivalTime, arrivalSpeed, leaveSpeed, approaching->getVehicleType().getLength());
-    myApproachingVehicles.insert(std::make_pair(approaching,
-                                 ApproachingVehicleInformation(arrivalTime, leaveTime, arrivalSpeed, leaveSpeed, setRequest,
-                                         arrivalTimeBraking, arrivalSpeedBraking, waitingTime, dist)));
+    myApproachingVehicles.push_back(std::make_pair(approaching,
+                                    ApproachingVehicleInformation(arrivalTime, leaveTime, arrivalSpeed, leaveSpeed, setRequest,
+                                            arrivalTimeBraking, arrivalSpeedBraking, waitingTime, dist)));
 }
 
 
 void
 MSLink::addBlockedLink(MSLink* link) {
-    myBlockedFoeLinks.insert(link);
+    if (std::find(myBlockedFoeLinks.begin(), myBlockedFoeLinks.end(), link) == myBlockedFoeLinks.end()) {
+        myBlockedFoeLinks.push_back(link);
+    }
 }
 
 
 
 bool
 MSLink::willHaveBlockedFoe() const {
-    for (std::set<MSLink*>::const_iterator i = myBlockedFoeLinks.begin(); i != myBlockedFoeLinks.end(); ++i) {
+    for (std::vector<MSLink*>::const_iterator i = myBlockedFoeLinks.begin(); i != myBlockedFoeLinks.end(); ++i) {
         if ((*i)->isBlockingAnyone()) {
             return true;
         }
@@ -287,18 +295,23 @@ MSLink::willHaveBlockedFoe() const {
 
 void
 MSLink::removeApproaching(const SUMOVehicle* veh) {
-    myApproachingVehicles.erase(veh);
+    for (ApproachInfos::iterator i = myApproachingVehicles.begin(); i != myApproachingVehicles.end(); ++i) {
+        if (i->first == veh) {
+            myApproachingVehicles.erase(i);
+            return;
+        }
+    }
 }
 
 
 MSLink::ApproachingVehicleInformation
 MSLink::getApproaching(const SUMOVehicle* veh) const {
-    std::map<const SUMOVehicle*, ApproachingVehicleInformation>::const_iterator i = myApproachingVehicles.find(veh);
-    if (i != myApproachingVehicles.end()) {
-        return i->second;
-    } else {
-        return ApproachingVehicleInformation(-1000, -1000, 0, 0, false, -1000, 0, 0, 0);
+    for (ApproachInfos::const_iterator i = myApproachingVehicles.begin(); i != myApproachingVehicles.end(); ++i) {
+        if (i->first == veh) {
+            return i->second;
+        }
     }
+    return ApproachingVehicleInformation(-1000, -1000, 0, 0, false, -1000, 0, 0, 0);
 }
 
 
@@ -325,7 +338,7 @@ MSLink::opened(SUMOTime arrivalTime, double arrivalSpeed, double leaveSpeed, dou
         for (std::vector<MSLink*>::const_iterator it = mySublaneFoeLinks.begin(); it != mySublaneFoeLinks.end(); ++it) {
             const MSLink* foeLink = *it;
             assert(myLane != foeLink->getLane());
-            for (std::map<const SUMOVehicle*, ApproachingVehicleInformation>::const_iterator i = foeLink->myApproachingVehicles.begin(); i != foeLink->myApproachingVehicles.end(); ++i) {
+            for (ApproachInfos::const_iterator i = foeLink->myApproachingVehicles.begin(); i != foeLink->myApproachingVehicles.end(); ++i) {
                 const SUMOVehicle* foe = i->first;
                 if (
                     // there only is a conflict if the paths cross
@@ -396,7 +409,7 @@ bool
 MSLink::blockedAtTime(SUMOTime arrivalTime, SUMOTime leaveTime, double arrivalSpeed, double leaveSpeed,
                       bool sameTargetLane, double impatience, double decel, SUMOTime waitingTime,
                       std::vector<const SUMOVehicle*>* collectFoes, const SUMOVehicle* ego) const {
-    for (std::map<const SUMOVehicle*, ApproachingVehicleInformation>::const_iterator i = myApproachingVehicles.begin(); i != myApproachingVehicles.end(); ++i) {
+    for (ApproachInfos::const_iterator i = myApproachingVehicles.begin(); i != myApproachingVehicles.end(); ++i) {
         if (i->first != ego && blockedByFoe(i->first, i->second, arrivalTime, leaveTime, arrivalSpeed, leaveSpeed, sameTargetLane,
                                             impatience, decel, waitingTime)) {
             if (collectFoes == 0) {
@@ -553,16 +566,17 @@ MSLink::writeApproaching(OutputDevice& od, const std::string fromLaneID) const {
         const std::string via = getViaLane() == 0 ? "" : getViaLane()->getID();
         od.writeAttr(SUMO_ATTR_VIA, via);
         od.writeAttr(SUMO_ATTR_TO, getLane() == 0 ? "" : getLane()->getID());
-        std::vector<std::pair<SUMOTime, const SUMOVehicle*> > toSort; // stabilize output
-        for (std::map<const SUMOVehicle*, ApproachingVehicleInformation>::const_iterator it = myApproachingVehicles.begin(); it != myApproachingVehicles.end(); ++it) {
-            toSort.push_back(std::make_pair(it->second.arrivalTime, it->first));
+        std::vector<std::pair<SUMOTime, int> > toSort; // stabilize output
+        for (int i = 0; i < (int)myApproachingVehicles.size(); ++i) {
+            toSort.push_back(std::make_pair(myApproachingVehicles[i].second.arrivalTime, i));
         }
         std::sort(toSort.begin(), toSort.end());
-        for (std::vector<std::pair<SUMOTime, const SUMOVehicle*> >::const_iterator it = toSort.begin(); it != toSort.end(); ++it) {
+        for (std::vector<std::pair<SUMOTime, int> >::const_iterator it = toSort.begin(); it != toSort.end(); ++it) {
             od.openTag("approaching");
-            const ApproachingVehicleInformation& avi = myApproachingVehicles.find(it->second)->second;
-            od.writeAttr(SUMO_ATTR_ID, it->second->getID());
-            od.writeAttr(SUMO_ATTR_IMPATIENCE, it->second->getImpatience());
+            const SUMOVehicle* const veh = myApproachingVehicles[it->second].first;
+            const ApproachingVehicleInformation& avi = myApproachingVehicles[it->second].second;
+            od.writeAttr(SUMO_ATTR_ID, veh->getID());
+            od.writeAttr(SUMO_ATTR_IMPATIENCE, veh->getImpatience());
             od.writeAttr("arrivalTime", time2string(avi.arrivalTime));
             od.writeAttr("arrivalTimeBraking", time2string(avi.arrivalTimeBraking));
             od.writeAttr("leaveTime", time2string(avi.leavingTime));
@@ -888,6 +902,22 @@ MSLink::getLeaderInfo(const MSVehicle* ego, double dist, std::vector<const MSPer
 }
 
 
+bool
+MSLink::hasFoeVehicles() const {
+    for (std::vector<const MSLane*>::const_iterator i = myFoeLanes.begin(); i != myFoeLanes.end(); ++i) {
+        if ((*i)->getVehicleNumberWithPartials() > 0) {
+            return true;
+        }
+    }
+    for (std::vector<MSLane*>::const_iterator i = mySublaneFoeLanes.begin(); i != mySublaneFoeLanes.end(); ++i) {
+        if ((*i)->getVehicleNumberWithPartials() > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
 MSLane*
 MSLink::getViaLaneOrLane() const {
     if (myInternalLane != 0) {
@@ -121,30 +121,29 @@ public:
         }
 
         /// @brief The time the vehicle's front arrives at the link
-        const SUMOTime arrivalTime;
+        SUMOTime arrivalTime;
         /// @brief The estimated time at which the vehicle leaves the link
-        const SUMOTime leavingTime;
+        SUMOTime leavingTime;
         /// @brief The estimated speed with which the vehicle arrives at the link (for headway computation)
-        const double arrivalSpeed;
+        double arrivalSpeed;
         /// @brief The estimated speed with which the vehicle leaves the link (for headway computation)
-        const double leaveSpeed;
+        double leaveSpeed;
         /// @brief Whether the vehicle wants to pass the link (@todo: check semantics)
-        const bool willPass;
+        bool willPass;
         /// @brief The time the vehicle's front arrives at the link if it starts braking
-        const SUMOTime arrivalTimeBraking;
+        SUMOTime arrivalTimeBraking;
         /// @brief The estimated speed with which the vehicle arrives at the link if it starts braking(for headway computation)
-        const double arrivalSpeedBraking;
+        double arrivalSpeedBraking;
         /// @brief The waiting duration at the current link
-        const SUMOTime waitingTime;
+        SUMOTime waitingTime;
         /// @brief The distance up to the current link
-        const double dist;
-
-    private:
-        /// invalidated assignment operator
-        ApproachingVehicleInformation& operator=(const ApproachingVehicleInformation& s);
+        double dist;
 
     };
 
+    /// @brief the approaching vehicles of a link (in the order of their registration)
+    typedef std::vector<std::pair<const SUMOVehicle*, ApproachingVehicleInformation> > ApproachInfos;
+
 
     /** @brief Constructor for simulation which uses internal lanes
      *
@@ -202,7 +201,7 @@ public:
     ApproachingVehicleInformation getApproaching(const SUMOVehicle* veh) const;
 
     /// @brief return all approaching vehicles
-    const std::map<const SUMOVehicle*, ApproachingVehicleInformation>& getApproaching() const {
+    const ApproachInfos& getApproaching() const {
         return myApproachingVehicles;
     }
 
@@ -424,6 +423,9 @@ public:
      */
     LinkLeaders getLeaderInfo(const MSVehicle* ego, double dist, std::vector<const MSPerson*>* collectBlockers = 0, bool isShadowLink = false) const;
 
+    /// @brief return whether there are vehicles on the foe lanes (the candidates for getLeaderInfo)
+    bool hasFoeVehicles() const;
+
     /// @brief return the speed at which ego vehicle must approach the zipper link
     double getZipperSpeed(const MSVehicle* ego, const double dist, double vSafe,
                           SUMOTime arrivalTime,
@@ -525,8 +527,10 @@ private:
     /// @brief The lane approaching this link
     MSLane* myLaneBefore;
 
-    std::map<const SUMOVehicle*, ApproachingVehicleInformation> myApproachingVehicles;
-    std::set<MSLink*> myBlockedFoeLinks;
+    /// @brief the approaching vehicles, a flat container as it is small, rebuilt often and iterated by all foe links
+    ApproachInfos myApproachingVehicles;
+    /// @brief the links which are blocked by vehicles on this link
+    std::vector<MSLink*> myBlockedFoeLinks;
 
     /// @brief The position within this respond
     int myIndex;
@@ -98,6 +98,7 @@
 #include "MSJunction.h"
 #include "MSJunctionLogic.h"
 #include "MSLane.h"
+#include "MSVehicle.h"
 #include "MSVehicleTransfer.h"
 #include "MSRoute.h"
 #include "MSGlobals.h"
@@ -178,6 +179,10 @@ MSNet::MSNet(MSVehicleControl* vc, MSEventControl* beginOfTimestepEvents,
              MSEventControl* endOfTimestepEvents, MSEventControl* insertionEvents,
              ShapeContainer* shapeCont):
     myVehiclesMoved(0),
+    myPlanDuration(0),
+    myExecuteDuration(0),
+    myLaneChangeDuration(0),
+    myActiveLanes(0),
     myHavePermissions(false),
     myHasInternalLinks(false),
     myHasElevation(false),
@@ -192,6 +197,7 @@ MSNet::MSNet(MSVehicleControl* vc, MSEventControl* beginOfTimestepEvents,
     myMaxTeleports = oc.getInt("max-num-teleports");
     myLogExecutionTime = !oc.getBool("no-duration-log");
     myLogStepNumber = !oc.getBool("no-step-log");
+    myLogPhaseDurations = myLogExecutionTime && oc.getBool("duration-log.statistics");
     myInserter = new MSInsertionControl(*vc, string2time(oc.getString("max-depart-delay")), oc.getBool("eager-insert"), oc.getInt("max-num-vehicles"));
     myVehicleControl = vc;
     myDetectorControl = new MSDetectorControl();
@@ -368,6 +374,36 @@ MSNet::loadRoutes() {
 }
 
 
+void
+MSNet::clearState(const SUMOTime step) {
+    if (MSGlobals::gUseMesoSim) {
+        throw ProcessError("Replacing the simulation state is not supported for the mesoscopic simulation.");
+    }
+    if (hasPersons() || hasContainers()) {
+        throw ProcessError("Replacing the simulation state is not supported for simulations with persons or containers.");
+    }
+    myInserter->clearState();
+    MSVehicleTransfer::getInstance()->clearState();
+    myDetectorControl->clearState();
+    for (std::map<std::string, MSStoppingPlace*>::const_iterator it = myBusStopDict.getMyMap().begin(); it != myBusStopDict.getMyMap().end(); ++it) {
+        it->second->clearState();
+    }
+    for (std::map<std::string, MSStoppingPlace*>::const_iterator it = myContainerStopDict.getMyMap().begin(); it != myContainerStopDict.getMyMap().end(); ++it) {
+        it->second->clearState();
+    }
+    for (std::map<std::string, MSParkingArea*>::const_iterator it = myParkingAreaDict.getMyMap().begin(); it != myParkingAreaDict.getMyMap().end(); ++it) {
+        it->second->clearState();
+    }
+    for (std::map<std::string, MSChargingStation*>::const_iterator it = myChargingStationDict.getMyMap().begin(); it != myChargingStationDict.getMyMap().end(); ++it) {
+        it->second->clearState();
+    }
+    // vehicles must be deleted before the lanes are emptied (they remove their partial occupations)
+    myVehicleControl->clearState();
+    myEdges->clearState();
+    myStep = step;
+}
+
+
 void
 MSNet::closeSimulation(SUMOTime start) {
     myDetectorControl->close(myStep);
@@ -430,6 +466,16 @@ MSNet::closeSimulation(SUMOTime start) {
         if (OptionsCont::getOptions().getBool("duration-log.statistics")) {
             msg << MSDevice_Tripinfo::printStatistics();
         }
+        const long long int steps = (myStep - start) / DELTA_T;
+        if (myLogPhaseDurations && !MSGlobals::gUseMesoSim && steps > 0) {
+            msg.setf(std::ios::fixed, std::ios::floatfield);
+            msg << "Movement (mean per step):" << "\n"
+                << " Active lanes: " << std::setprecision(1) << ((double)myActiveLanes / (double)steps) << "\n"
+                << std::setprecision(3)
+                << " Plan: " << ((double)myPlanDuration / 1000. / (double)steps) << "ms\n"
+                << " Execute: " << ((double)myExecuteDuration / 1000. / (double)steps) << "ms\n"
+                << " Change lanes: " << ((double)myLaneChangeDuration / 1000. / (double)steps) << "ms\n";
+        }
         WRITE_MESSAGE(msg.str());
     }
 }
@@ -476,9 +522,7 @@ MSNet::simulationStep() {
         MSStateHandler::saveState(myStateDumpPrefix + "_" + time2string(myStep) + myStateDumpSuffix, myStep);
     }
     myBeginOfTimestepEvents->execute(myStep);
-#ifdef HAVE_FOX
     MSDevice_Routing::waitForAll();
-#endif
     if (MSGlobals::gCheck4Accidents) {
         myEdges->detectCollisions(myStep, STAGE_EVENTS);
     }
@@ -491,18 +535,34 @@ MSNet::simulationStep() {
         // assure all lanes with vehicles are 'active'
         myEdges->patchActiveLanes();
 
+        long long int phaseBegin = myLogPhaseDurations ? SysUtils::getCurrentMicros() : 0;
         // compute safe velocities for all vehicles for the next few lanes
         // also register ApproachingVehicleInformation for all links
         myEdges->planMovements(myStep);
+        if (myLogPhaseDurations) {
+            myActiveLanes += myEdges->getActiveLaneNumber();
+            const long long int now = SysUtils::getCurrentMicros();
+            myPlanDuration += now - phaseBegin;
+            phaseBegin = now;
+        }
 
         // decide right-of-way and execute movements
         myEdges->executeMovements(myStep);
+        if (myLogPhaseDurations) {
+            myExecuteDuration += SysUtils::getCurrentMicros() - phaseBegin;
+        }
         if (MSGlobals::gCheck4Accidents) {
             myEdges->detectCollisions(myStep, STAGE_MOVEMENTS);
         }
 
         // vehicles may change lanes
+        if (myLogPhaseDurations) {
+            phaseBegin = SysUtils::getCurrentMicros();
+        }
         myEdges->changeLanes(myStep);
+        if (myLogPhaseDurations) {
+            myLaneChangeDuration += SysUtils::getCurrentMicros() - phaseBegin;
+        }
 
         if (MSGlobals::gCheck4Accidents) {
             myEdges->detectCollisions(myStep, STAGE_LANECHANGE);
@@ -521,9 +581,7 @@ MSNet::simulationStep() {
     // insert vehicles
     myInserter->determineCandidates(myStep);
     myInsertionEvents->execute(myStep);
-#ifdef HAVE_FOX
     MSDevice_Routing::waitForAll();
-#endif
     myInserter->emitVehicles(myStep);
     if (MSGlobals::gCheck4Accidents) {
         //myEdges->patchActiveLanes(); // @note required to detect collisions on lanes that were empty before insertion. wasteful?
@@ -623,6 +681,7 @@ MSNet::clearAll() {
     MSEdge::clear();
     MSLane::clear();
     MSRoute::clear();
+    MSVehicle::clearBestLanesCache();
     delete MSVehicleTransfer::getInstance();
     MSDevice_Routing::cleanup();
     MSTrigger::cleanup();
@@ -811,6 +870,9 @@ MSNet::postSimStepOutput() const {
             oss << " (0ms ?*RT. ?";
         }
         oss << "UPS, ";
+        if (!MSGlobals::gUseMesoSim) {
+            oss << "bestLanes " << (int)(100. * MSVehicle::getBestLanesCacheHitRate()) << "%, ";
+        }
 #ifndef NO_TRACI
         if (TraCIServer::getInstance() != 0) {
             oss << "TraCI: " << myTraCIStepDuration << "ms, ";
@@ -1026,7 +1088,7 @@ MSNet::checkElevation() {
 int
 MSNet::getHaltingVehicleNumber() const {
     int result = 0;
-    for (MSVehicleControl::constVehIt it = myVehicleControl->loadedVehBegin(); it != myVehicleControl->loadedVehEnd(); ++it) {
+    for (MSVehicleControl::constVehIt it = myVehicleControl->runningVehBegin(); it != myVehicleControl->runningVehEnd(); ++it) {
         const SUMOVehicle* veh = it->second;
         if ((veh->isOnRoad() || veh->isRemoteControlled()) && veh->getSpeed() < SUMO_const_haltingSpeed)  {
             result++;
@@ -1040,7 +1102,7 @@ MSNet::getVehicleMeanSpeeds() const {
     double speedSum = 0;
     double relSpeedSum = 0;
     int count = 0;
-    for (MSVehicleControl::constVehIt it = myVehicleControl->loadedVehBegin(); it != myVehicleControl->loadedVehEnd(); ++it) {
+    for (MSVehicleControl::constVehIt it = myVehicleControl->runningVehBegin(); it != myVehicleControl->runningVehEnd(); ++it) {
         const SUMOVehicle* veh = it->second;
         if ((veh->isOnRoad() || veh->isRemoteControlled()) && !veh->isStopped()) {
             count++;
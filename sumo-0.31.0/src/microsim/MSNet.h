@@ -87,6 +87,8 @@ typedef std::vector<MSEdge*> MSEdgeVector;
  * @brief The simulated network and simulation perfomer
  */
 class MSNet {
+    friend class MSSimulationContext;
+
 public:
     /** @enum SimulationState
      * @brief Possible states of a simulation - running or stopped with different reasons
@@ -262,6 +264,16 @@ public:
     }
 
 
+    /** @brief Discards the current vehicle related state (used by quick-loading of state)
+     *
+     * Deletes all vehicles and flows, empties lanes, stops, detectors and the
+     *  insertion queue and sets the current simulation step.
+     * @param[in] step The simulation step of the state to be loaded
+     * @exception ProcessError If the simulation contains state which cannot be discarded
+     */
+    void clearState(const SUMOTime step);
+
+
     /** @brief Write netstate, summary and detector output
      * @todo Which exceptions may occur?
      */
@@ -588,7 +600,9 @@ public:
         /// @brief The vehicles starts to stop
         VEHICLE_STATE_STARTING_STOP,
         /// @brief The vehicle ends to stop
-        VEHICLE_STATE_ENDING_STOP
+        VEHICLE_STATE_ENDING_STOP,
+        /// @brief The vehicle is involved in a collision
+        VEHICLE_STATE_COLLISION
     };
 
 
@@ -775,6 +789,15 @@ protected:
 
     /// @brief The overall number of vehicle movements
     long long int myVehiclesMoved;
+
+    /// @brief Information whether the durations of the movement phases shall be logged (duration-log.statistics)
+    bool myLogPhaseDurations;
+
+    /// @brief The overall durations of planning, executing and changing lanes in microseconds
+    long long int myPlanDuration, myExecuteDuration, myLaneChangeDuration;
+
+    /// @brief The overall number of active lanes
+    long long int myActiveLanes;
     //}
 
 
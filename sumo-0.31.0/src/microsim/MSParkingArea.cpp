@@ -176,6 +176,17 @@ MSParkingArea::leaveFrom(SUMOVehicle* what) {
 }
 
 
+void
+MSParkingArea::clearState() {
+    std::map<unsigned int, LotSpaceDefinition >::iterator i;
+    for (i = mySpaceOccupancies.begin(); i != mySpaceOccupancies.end(); i++) {
+        (*i).second.vehicle = 0;
+    }
+    myEndPositions.clear();
+    computeLastFreePos();
+}
+
+
 void
 MSParkingArea::computeLastFreePos() {
     myLastFreeLot = 0;
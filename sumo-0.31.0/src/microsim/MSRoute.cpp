@@ -48,9 +48,7 @@
 // ===========================================================================
 MSRoute::RouteDict MSRoute::myDict;
 MSRoute::RouteDistDict MSRoute::myDistDict;
-#ifdef HAVE_FOX
-FXMutex MSRoute::myDictMutex(true);
-#endif
+std::recursive_mutex MSRoute::myDictMutex;
 
 
 // ===========================================================================
@@ -105,9 +103,7 @@ void
 MSRoute::release() const {
     myReferenceCounter--;
     if (myReferenceCounter == 0) {
-#ifdef HAVE_FOX
-        FXMutexLock f(myDictMutex);
-#endif
+        std::lock_guard<std::recursive_mutex> f(myDictMutex);
         myDict.erase(myID);
         delete this;
     }
@@ -116,9 +112,7 @@ MSRoute::release() const {
 
 bool
 MSRoute::dictionary(const std::string& id, const MSRoute* route) {
-#ifdef HAVE_FOX
-    FXMutexLock f(myDictMutex);
-#endif
+    std::lock_guard<std::recursive_mutex> f(myDictMutex);
     if (myDict.find(id) == myDict.end() && myDistDict.find(id) == myDistDict.end()) {
         myDict[id] = route;
         return true;
@@ -129,9 +123,7 @@ MSRoute::dictionary(const std::string& id, const MSRoute* route) {
 
 bool
 MSRoute::dictionary(const std::string& id, RandomDistributor<const MSRoute*>* const routeDist, const bool permanent) {
-#ifdef HAVE_FOX
-    FXMutexLock f(myDictMutex);
-#endif
+    std::lock_guard<std::recursive_mutex> f(myDictMutex);
     if (myDict.find(id) == myDict.end() && myDistDict.find(id) == myDistDict.end()) {
         myDistDict[id] = std::make_pair(routeDist, permanent);
         return true;
@@ -142,9 +134,7 @@ MSRoute::dictionary(const std::string& id, RandomDistributor<const MSRoute*>* co
 
 const MSRoute*
 MSRoute::dictionary(const std::string& id, std::mt19937* rng) {
-#ifdef HAVE_FOX
-    FXMutexLock f(myDictMutex);
-#endif
+    std::lock_guard<std::recursive_mutex> f(myDictMutex);
     RouteDict::iterator it = myDict.find(id);
     if (it == myDict.end()) {
         RouteDistDict::iterator it2 = myDistDict.find(id);
@@ -159,9 +149,7 @@ MSRoute::dictionary(const std::string& id, std::mt19937* rng) {
 
 RandomDistributor<const MSRoute*>*
 MSRoute::distDictionary(const std::string& id) {
-#ifdef HAVE_FOX
-    FXMutexLock f(myDictMutex);
-#endif
+    std::lock_guard<std::recursive_mutex> f(myDictMutex);
     RouteDistDict::iterator it2 = myDistDict.find(id);
     if (it2 == myDistDict.end()) {
         return 0;
@@ -172,9 +160,7 @@ MSRoute::distDictionary(const std::string& id) {
 
 void
 MSRoute::clear() {
-#ifdef HAVE_FOX
-    FXMutexLock f(myDictMutex);
-#endif
+    std::lock_guard<std::recursive_mutex> f(myDictMutex);
     for (RouteDistDict::iterator i = myDistDict.begin(); i != myDistDict.end(); ++i) {
         delete i->second.first;
     }
@@ -188,9 +174,7 @@ MSRoute::clear() {
 
 void
 MSRoute::checkDist(const std::string& id) {
-#ifdef HAVE_FOX
-    FXMutexLock f(myDictMutex);
-#endif
+    std::lock_guard<std::recursive_mutex> f(myDictMutex);
     RouteDistDict::iterator it = myDistDict.find(id);
     if (it != myDistDict.end() && !it->second.second) {
         const std::vector<const MSRoute*>& routes = it->second.first->getVals();
@@ -205,9 +189,7 @@ MSRoute::checkDist(const std::string& id) {
 
 void
 MSRoute::insertIDs(std::vector<std::string>& into) {
-#ifdef HAVE_FOX
-    FXMutexLock f(myDictMutex);
-#endif
+    std::lock_guard<std::recursive_mutex> f(myDictMutex);
     into.reserve(myDict.size() + myDistDict.size() + into.size());
     for (RouteDict::const_iterator i = myDict.begin(); i != myDict.end(); ++i) {
         into.push_back((*i).first);
@@ -259,9 +241,7 @@ MSRoute::operator[](int index) const {
 
 void
 MSRoute::dict_saveState(OutputDevice& out) {
-#ifdef HAVE_FOX
-    FXMutexLock f(myDictMutex);
-#endif
+    std::lock_guard<std::recursive_mutex> f(myDictMutex);
     for (RouteDict::iterator it = myDict.begin(); it != myDict.end(); ++it) {
         out.openTag(SUMO_TAG_ROUTE).writeAttr(SUMO_ATTR_ID, (*it).second->getID());
         out.writeAttr(SUMO_ATTR_STATE, (*it).second->myAmPermanent);
@@ -38,15 +38,12 @@
 #include <map>
 #include <vector>
 #include <algorithm>
+#include <mutex>
 #include <utils/common/Named.h>
 #include <utils/distribution/RandomDistributor.h>
 #include <utils/common/RGBColor.h>
 #include <utils/vehicle/SUMOVehicleParameter.h>
 #include <utils/common/Parameterised.h>
-#ifdef HAVE_FOX
-#include <fx.h>
-#include <FXThread.h>
-#endif
 
 
 // ===========================================================================
@@ -72,6 +69,8 @@ typedef ConstMSEdgeVector::const_iterator MSRouteIterator;
  * @class MSRoute
  */
 class MSRoute : public Named, public Parameterised {
+    friend class MSSimulationContext;
+
 public:
     /// Constructor
     MSRoute(const std::string& id, const ConstMSEdgeVector& edges,
@@ -261,10 +260,8 @@ private:
     /// The dictionary container
     static RouteDistDict myDistDict;
 
-#ifdef HAVE_FOX
     /// @brief the mutex for the route dictionaries
-    static FXMutex myDictMutex;
-#endif
+    static std::recursive_mutex myDictMutex;
 private:
     /** invalid assignment operator */
     MSRoute& operator=(const MSRoute& s);
@@ -0,0 +1,244 @@
+/****************************************************************************/
+/// @file    MSSimulationContext.cpp
+/// @date    Oct 2017
+/// @version $Id$
+///
+// Process-wide simulation state of one of several simulations in a process
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <utils/common/RandHelper.h>
+#include <utils/options/OptionsCont.h>
+#include <microsim/MSGlobals.h>
+#include <microsim/MSEdge.h>
+#include <microsim/MSLane.h>
+#include <microsim/MSVehicle.h>
+#include <microsim/MSVehicleType.h>
+#include <microsim/MSRoute.h>
+#include <microsim/MSRouteHandler.h>
+#include <microsim/MSVehicleTransfer.h>
+#include <microsim/MSCModel_NonInteracting.h>
+#include <microsim/lcmodels/MSAbstractLaneChangeModel.h>
+#include <microsim/pedestrians/MSPModel.h>
+#include <microsim/pedestrians/MSPModel_Striping.h>
+#include <microsim/trigger/MSTrigger.h>
+#include <microsim/trigger/MSCalibrator.h>
+#include <microsim/traffic_lights/MSPushButton.h>
+#include <microsim/output/MSStopOut.h>
+#include <microsim/output/MSAmitranTrajectories.h>
+#include <microsim/devices/MSDevice.h>
+#include <microsim/devices/MSDevice_Routing.h>
+#include <microsim/devices/MSDevice_Tripinfo.h>
+#include <microsim/devices/MSDevice_Vehroutes.h>
+#include <microsim/devices/MSDevice_BTsender.h>
+#include <microsim/devices/MSDevice_BTreceiver.h>
+#include <microsim/devices/MSDevice_SSM.h>
+#ifndef NO_TRACI
+#include <traci-server/TraCIServer.h>
+#include <traci-server/TraCIServerAPI_Vehicle.h>
+#include <traci-server/lib/TraCI.h>
+#endif
+#include "MSSimulationContext.h"
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+MSSimulationContext* MSSimulationContext::myActive = 0;
+std::recursive_mutex MSSimulationContext::myLock;
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+MSSimulationContext::Activation::Activation(MSSimulationContext& context) {
+    myLock.lock();
+    if (myActive != &context) {
+        if (myActive != 0) {
+            myActive->swapState();
+        }
+        context.swapState();
+        myActive = &context;
+    }
+}
+
+
+MSSimulationContext::Activation::~Activation() {
+    myLock.unlock();
+}
+
+
+MSSimulationContext::MSSimulationContext() : myBegin(0) {
+    // every static holding simulation state has to be registered here,
+    // anything missing is shared between the contexts
+    // network and object dictionaries
+    add(MSNet::myInstance);
+    add(MSEdge::myDict);
+    add(MSEdge::myEdges);
+    add(MSLane::myDict);
+    add(MSLane::myCollisionAction);
+    add(MSLane::myCheckJunctionCollisions);
+    add(MSLane::myCollisionStopTime);
+    add(MSVehicle::myBestLanesCache);
+    add(MSVehicle::myBestLanesLookups);
+    add(MSVehicle::myBestLanesHits);
+    add(MSVehicleType::myNextIndex);
+#ifdef _DEBUG
+    add(MSBaseVehicle::myShallTraceMoveReminders);
+#endif
+    add(MSRoute::myDict);
+    add(MSRoute::myDistDict);
+    add(MSVehicleTransfer::myInstance);
+    add(MSTrigger::myInstances);
+    add(MSCalibrator::LeftoverReminders);
+    add(MSCalibrator::LeftoverVehicleParameters);
+    add(MSPedestrianPushButton::m_crossingEdgeMap);
+    add(MSPedestrianPushButton::m_crossingEdgeMapLoaded);
+    // settings
+    add(OptionsCont::getOptions());
+    add(DELTA_T);
+    add(MSGlobals::gOmitEmptyEdgesOnDump);
+    add(MSGlobals::gSemiImplicitEulerUpdate);
+    add(MSGlobals::gTimeToGridlock);
+    add(MSGlobals::gTimeToGridlockHighways);
+    add(MSGlobals::gTimeToImpatience);
+    add(MSGlobals::gUsingInternalLanes);
+    add(MSGlobals::gIgnoreJunctionBlocker);
+    add(MSGlobals::gCheck4Accidents);
+    add(MSGlobals::gCheckRoutes);
+    add(MSGlobals::gLaneChangeDuration);
+    add(MSGlobals::gLateralResolution);
+    add(MSGlobals::gStateLoaded);
+    add(MSGlobals::gNumSimThreads);
+    add(MSGlobals::gUseMesoSim);
+    add(MSGlobals::gMesoLimitedJunctionControl);
+    add(MSGlobals::gMesoOvertaking);
+    add(MSGlobals::gMesoTLSPenalty);
+    add(MSGlobals::gMesoMinorPenalty);
+    add(MSGlobals::gMesoNet);
+    add(MSGlobals::gWaitingTimeMemory);
+    add(MSAbstractLaneChangeModel::myAllowOvertakingRight);
+    add(MSAbstractLaneChangeModel::myLCOutput);
+    // random number generators
+    add(RandHelper::myRandomNumberGenerator);
+    add(*MSRouteHandler::getParsingRNG());
+    add(*MSDevice::getEquipmentRNG());
+    // models
+    add(MSPModel::myModel);
+    add(MSPModel_Striping::stripeWidth);
+    add(MSPModel_Striping::dawdling);
+    add(MSPModel_Striping::jamTime);
+    add(MSPModel_Striping::myWalkingAreaPaths);
+    add(MSPModel_Striping::myMinNextLengths);
+    add(MSCModel_NonInteracting::myModel);
+    // devices and outputs
+    add(MSDevice::myExplicitIDs);
+    add(MSDevice_Routing::myEdgeWeightSettingCommand);
+    add(MSDevice_Routing::myEdgeSpeeds);
+    add(MSDevice_Routing::myAdaptationWeight);
+    add(MSDevice_Routing::myAdaptationInterval);
+    add(MSDevice_Routing::myLastAdaptation);
+    add(MSDevice_Routing::myAdaptationSteps);
+    add(MSDevice_Routing::myAdaptationStepsIndex);
+    add(MSDevice_Routing::myPastEdgeSpeeds);
+    add(MSDevice_Routing::myWithTaz);
+    add(MSDevice_Routing::myCachedRoutes);
+    add(MSDevice_Routing::myRouter);
+    add(MSDevice_Routing::myRouterWithProhibited);
+    add(MSDevice_Routing::myRandomizeWeightsFactor);
+    add(MSDevice_Routing::myThreadPool);
+    add(MSDevice_Tripinfo::myPendingOutput);
+    add(MSDevice_Tripinfo::myVehicleCount);
+    add(MSDevice_Tripinfo::myTotalRouteLength);
+    add(MSDevice_Tripinfo::myTotalDuration);
+    add(MSDevice_Tripinfo::myTotalWaitingTime);
+    add(MSDevice_Tripinfo::myTotalTimeLoss);
+    add(MSDevice_Tripinfo::myTotalDepartDelay);
+    add(MSDevice_Tripinfo::myWalkCount);
+    add(MSDevice_Tripinfo::myTotalWalkRouteLength);
+    add(MSDevice_Tripinfo::myTotalWalkDuration);
+    add(MSDevice_Vehroutes::mySaveExits);
+    add(MSDevice_Vehroutes::myLastRouteOnly);
+    add(MSDevice_Vehroutes::myDUAStyle);
+    add(MSDevice_Vehroutes::mySorted);
+    add(MSDevice_Vehroutes::myIntendedDepart);
+    add(MSDevice_Vehroutes::myRouteLength);
+    add(MSDevice_Vehroutes::myStateListener.myDevices);
+    add(MSDevice_Vehroutes::myDepartureCounts);
+    add(MSDevice_Vehroutes::myRouteInfos);
+    add(MSDevice_BTsender::sVehicles);
+    add(MSDevice_BTreceiver::myWasInitialised);
+    add(MSDevice_BTreceiver::myRange);
+    add(MSDevice_BTreceiver::myOffTime);
+    add(MSDevice_BTreceiver::sRecognitionRNG);
+    add(MSDevice_BTreceiver::sVehicles);
+    add(MSDevice_SSM::instances);
+    add(MSStopOut::myInstance);
+    add(MSAmitranTrajectories::myWrittenTypes);
+    add(MSAmitranTrajectories::myWrittenVehicles);
+#ifndef NO_TRACI
+    add(TraCIServer::myInstance);
+    add(TraCIServer::myDoCloseConnection);
+    add(TraCIServerAPI_Vehicle::gVTDMap);
+    add(TraCI::myLoadArgs);
+    add(TraCI::mySnapshots);
+#endif
+}
+
+
+MSSimulationContext::~MSSimulationContext() {
+    {
+        Activation activation(*this);
+        if (MSNet::myInstance != 0) {
+            MSNet::myInstance->closeSimulation(myBegin);
+            delete MSNet::myInstance;
+        }
+        // hand the process state back
+        swapState();
+        myActive = 0;
+    }
+    for (std::vector<SlotBase*>::iterator i = mySlots.begin(); i != mySlots.end(); ++i) {
+        delete *i;
+    }
+}
+
+
+MSNet::SimulationState
+MSSimulationContext::step(SUMOTime stopTime) {
+    Activation activation(*this);
+    MSNet* const net = MSNet::getInstance();
+    net->simulationStep();
+    return net->simulationState(stopTime);
+}
+
+
+void
+MSSimulationContext::swapState() {
+    for (std::vector<SlotBase*>::iterator i = mySlots.begin(); i != mySlots.end(); ++i) {
+        (*i)->swap();
+    }
+}
+
+
+/****************************************************************************/
+
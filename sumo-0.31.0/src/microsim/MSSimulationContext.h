@@ -0,0 +1,195 @@
+/****************************************************************************/
+/// @file    MSSimulationContext.h
+/// @date    Oct 2017
+/// @version $Id$
+///
+// Process-wide simulation state of one of several simulations in a process
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef MSSimulationContext_h
+#define MSSimulationContext_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <utils/common/SUMOTime.h>
+#include "MSNet.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSSimulationContext
+ * @brief Handle for one of several simulations living in the same process
+ *
+ * The network, the object dictionaries (edges, lanes, routes), MSGlobals, the
+ *  random number generators, the options and the static state of models and
+ *  devices are process-wide. A context stores all of them for its simulation
+ *  while another context is active and swaps them in when it gets activated,
+ *  so each simulation has its own vehicle control, edge control and RNG.
+ *
+ * This multiplexes several simulations over the process-wide state of a
+ *  single one, it does not run them in parallel:
+ *  - Only one context can be active at a time. Activation and stepping are
+ *    serialized by a process-wide (recursive) lock, so stepping N contexts
+ *    takes as long as stepping them one after the other. Contexts may be
+ *    driven from several threads, the simulation threads of the active
+ *    context (e.g. for rerouting) still run in parallel.
+ *  - Each context loads its own network, the topology is not shared.
+ *  - Output devices and message handlers are process-wide, the simulations
+ *    should write to different files.
+ *
+ * The state is swapped using a list of registered variables (see the
+ *  constructor). A static which belongs to the simulation but is not in this
+ *  list is silently shared between all contexts, so new statics of the
+ *  simulation kernel have to be registered there.
+ *
+ * Contexts are created by NLBuilder::loadContext.
+ */
+class MSSimulationContext {
+public:
+    /** @class Activation
+     * @brief Keeps a context active and other threads from switching contexts during its lifetime
+     */
+    class Activation {
+    public:
+        /// @brief Constructor, activates the given context
+        Activation(MSSimulationContext& context);
+
+        /// @brief Destructor, releases the lock (the context stays active until another one is activated)
+        ~Activation();
+
+    private:
+        /// @brief Invalidated copy constructor.
+        Activation(const Activation&);
+
+        /// @brief Invalidated assignment operator.
+        Activation& operator=(const Activation&);
+    };
+
+
+    /// @brief Constructor for an empty context
+    MSSimulationContext();
+
+
+    /// @brief Destructor, closes and deletes the context's simulation
+    ~MSSimulationContext();
+
+
+    /** @brief Performs a single simulation step within this context
+     * @param[in] stopTime The time the simulation shall stop at
+     * @return The simulation state after the step
+     */
+    MSNet::SimulationState step(SUMOTime stopTime);
+
+
+    /// @brief Sets the begin time of the simulation (needed for closing it)
+    void setBegin(SUMOTime begin) {
+        myBegin = begin;
+    }
+
+
+    /// @brief Returns the currently active context (0 if the process state is active)
+    static MSSimulationContext* getActive() {
+        return myActive;
+    }
+
+
+private:
+    /** @class SlotBase
+     * @brief Storage for the value of a process-wide variable while the context is inactive
+     */
+    class SlotBase {
+    public:
+        /// @brief Destructor
+        virtual ~SlotBase() {}
+
+        /// @brief Exchanges the stored and the process-wide value
+        virtual void swap() = 0;
+    };
+
+
+    /** @class Slot
+     * @brief Storage for a process-wide variable of the given type
+     */
+    template<class T>
+    class Slot : public SlotBase {
+    public:
+        /// @brief Constructor, the stored value is value-initialized
+        Slot(T& global) : myGlobal(global), myValue() {}
+
+        /// @brief Exchanges the stored and the process-wide value
+        void swap() {
+            using std::swap;
+            swap(myGlobal, myValue);
+        }
+
+    private:
+        /// @brief The process-wide variable
+        T& myGlobal;
+
+        /// @brief The stored value
+        T myValue;
+    };
+
+
+    /// @brief Registers a process-wide variable belonging to a simulation
+    template<class T>
+    void add(T& global) {
+        mySlots.push_back(new Slot<T>(global));
+    }
+
+
+    /// @brief Exchanges the process-wide state with the stored one
+    void swapState();
+
+
+private:
+    /// @brief The process-wide variables of this context
+    std::vector<SlotBase*> mySlots;
+
+    /// @brief The begin time of the simulation
+    SUMOTime myBegin;
+
+    /// @brief The currently active context
+    static MSSimulationContext* myActive;
+
+    /// @brief The lock for activation and stepping
+    static std::recursive_mutex myLock;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSSimulationContext(const MSSimulationContext&);
+
+    /// @brief Invalidated assignment operator.
+    MSSimulationContext& operator=(const MSSimulationContext&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
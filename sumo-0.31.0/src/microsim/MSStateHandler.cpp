@@ -35,13 +35,21 @@
 #endif
 
 #include <sstream>
+#include <limits>
 #include <utils/common/TplConvert.h>
+#include <utils/common/StringTokenizer.h>
+#include <utils/common/RandHelper.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/iodevices/OutputDevice.h>
+#include <utils/iodevices/OutputDevice_String.h>
 #include <utils/xml/SUMOXMLDefinitions.h>
 #include <utils/xml/SUMOVehicleParserHelper.h>
+#include <utils/xml/SUMOSAXReader.h>
 #include <microsim/devices/MSDevice_Routing.h>
+#include <microsim/traffic_lights/MSTLLogicControl.h>
+#include <microsim/output/MSDetectorControl.h>
 #include <microsim/MSEdge.h>
+#include <microsim/MSEventControl.h>
 #include <microsim/MSLane.h>
 #include <microsim/MSGlobals.h>
 #include <microsim/MSNet.h>
@@ -55,6 +63,12 @@
 #include <mesosim/MELoop.h>
 
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const char* const MSStateHandler::EVENT_CONTROLS[] = {"begin", "end", "insertion"};
+
+
 // ===========================================================================
 // method definitions
 // ===========================================================================
@@ -64,7 +78,8 @@ MSStateHandler::MSStateHandler(const std::string& file, const SUMOTime offset) :
     mySegment(0),
     myEdgeAndLane(0, -1),
     myAttrs(0),
-    myLastParameterised(0) {
+    myLastParameterised(0),
+    myClearState(false) {
     myAmLoadingState = true;
     const std::vector<std::string> vehIDs = OptionsCont::getOptions().getStringVector("load-state.remove-vehicles");
     myVehiclesToRemove.insert(vehIDs.begin(), vehIDs.end());
@@ -78,11 +93,22 @@ MSStateHandler::~MSStateHandler() {
 void
 MSStateHandler::saveState(const std::string& file, SUMOTime step) {
     OutputDevice& out = OutputDevice::getDevice(file);
+    saveState(out, step);
+    out.close();
+}
+
+
+void
+MSStateHandler::saveState(OutputDevice& out, SUMOTime step, const bool complete) {
     out.writeHeader<MSEdge>(SUMO_TAG_SNAPSHOT);
     out.writeAttr("xmlns:xsi", "http://www.w3.org/2001/XMLSchema-instance").writeAttr("xsi:noNamespaceSchemaLocation", "http://sumo.dlr.de/xsd/state_file.xsd");
     out.writeAttr(SUMO_ATTR_VERSION, VERSION_STRING).writeAttr(SUMO_ATTR_TIME, time2string(step));
     MSRoute::dict_saveState(out);
     MSNet::getInstance()->getVehicleControl().saveState(out);
+    if (complete) {
+        MSNet::getInstance()->getInsertionControl().saveState(out);
+        MSNet::getInstance()->getTLSControl().saveState(out);
+    }
     MSVehicleTransfer::getInstance()->saveState(out);
     if (MSGlobals::gUseMesoSim) {
         for (int i = 0; i < MSEdge::dictSize(); i++) {
@@ -98,7 +124,71 @@ MSStateHandler::saveState(const std::string& file, SUMOTime step) {
             }
         }
     }
-    out.close();
+    if (complete) {
+        // the vehicles have to be on their lanes when loading the detectors
+        MSNet::getInstance()->getDetectorControl().saveState(out);
+        for (int i = 0; i < 3; i++) {
+            const std::map<long long, SUMOTime> times = getEventControl(i)->getEventTimes();
+            std::ostringstream value;
+            for (std::map<long long, SUMOTime>::const_iterator j = times.begin(); j != times.end(); ++j) {
+                value << (j == times.begin() ? "" : " ") << j->first << " " << j->second;
+            }
+            out.openTag(SUMO_TAG_EVENTSTATE);
+            out.writeAttr(SUMO_ATTR_ID, EVENT_CONTROLS[i]);
+            out.writeAttr(SUMO_ATTR_VALUE, value.str());
+            out.closeTag();
+        }
+        // needs to come last since rebuilding the vehicles consumes random numbers
+        out.openTag(SUMO_TAG_RNGSTATE);
+        out.writeAttr(SUMO_ATTR_RNG_DEFAULT, RandHelper::saveState());
+        out.writeAttr(SUMO_ATTR_RNG_ROUTEHANDLER, RandHelper::saveState(MSRouteHandler::getParsingRNG()));
+        out.writeAttr(SUMO_ATTR_RNG_DEVICE, RandHelper::saveState(MSDevice::getEquipmentRNG()));
+        out.closeTag();
+    }
+    out.closeTag();
+}
+
+
+std::string
+MSStateHandler::saveSnapshot(SUMOTime step) {
+    OutputDevice_String out(true);
+    // binary doubles are only scaled to integers when using the default precision
+    out.setPrecision(std::numeric_limits<double>::digits10 + 2);
+    saveState(out, step, true);
+    return out.getString();
+}
+
+
+SUMOTime
+MSStateHandler::loadSnapshot(const std::string& snapshot) {
+    // only marks the vehicles as loaded while parsing, the simulation itself was not started from a state
+    const bool wasStateLoaded = MSGlobals::gStateLoaded;
+    MSGlobals::gStateLoaded = true;
+    MSStateHandler h("", 0);
+    h.myClearState = true;
+    SUMOSAXReader reader(h, XERCES_CPP_NAMESPACE::SAX2XMLReader::Val_Never);
+    try {
+        reader.parseBinaryString(snapshot);
+    } catch (...) {
+        MSGlobals::gStateLoaded = wasStateLoaded;
+        throw;
+    }
+    MSGlobals::gStateLoaded = wasStateLoaded;
+    return h.getTime();
+}
+
+
+MSEventControl*
+MSStateHandler::getEventControl(const int index) {
+    MSNet* const net = MSNet::getInstance();
+    switch (index) {
+        case 0:
+            return net->getBeginOfTimestepEvents();
+        case 1:
+            return net->getEndOfTimestepEvents();
+        default:
+            return net->getInsertionEvents();
+    }
 }
 
 
@@ -113,6 +203,46 @@ MSStateHandler::myStartElement(int element, const SUMOSAXAttributes& attrs) {
             if (version != VERSION_STRING) {
                 WRITE_WARNING("State was written with sumo version " + version + " (present: " + VERSION_STRING + ")!");
             }
+            if (myClearState) {
+                MSNet::getInstance()->clearState(myTime);
+            }
+            break;
+        }
+        case SUMO_TAG_FLOWSTATE: {
+            SUMOVehicleParameter* pars = SUMOVehicleParserHelper::parseFlowAttributes(attrs, 0, -1);
+            pars->repetitionsDone = attrs.getInt(SUMO_ATTR_DONE);
+            if (!MSNet::getInstance()->getInsertionControl().add(pars, attrs.getInt(SUMO_ATTR_INDEX))) {
+                const std::string id = pars->id;
+                delete pars;
+                throw ProcessError("Another flow with the id '" + id + "' exists.");
+            }
+            myLastParameterised = pars;
+            break;
+        }
+        case SUMO_TAG_TLLOGIC: {
+            MSNet::getInstance()->getTLSControl().loadState(myTime,
+                    attrs.getString(SUMO_ATTR_ID), attrs.getString(SUMO_ATTR_PROGRAMID), attrs.getInt(SUMO_ATTR_PHASE),
+                    TplConvert::_2long(attrs.getString(SUMO_ATTR_DURATION).c_str()));
+            break;
+        }
+        case SUMO_TAG_DETECTORSTATE: {
+            MSNet::getInstance()->getDetectorControl().loadState(attrs);
+            break;
+        }
+        case SUMO_TAG_EVENTSTATE: {
+            std::map<long long, SUMOTime>& times = myEventTimes[attrs.getString(SUMO_ATTR_ID)];
+            StringTokenizer st(attrs.getString(SUMO_ATTR_VALUE));
+            const int size = st.size();
+            for (int i = 0; i + 1 < size; i += 2) {
+                const long long index = TplConvert::_2long(st.next().c_str());
+                times[index] = TplConvert::_2long(st.next().c_str());
+            }
+            break;
+        }
+        case SUMO_TAG_RNGSTATE: {
+            RandHelper::loadState(attrs.getString(SUMO_ATTR_RNG_DEFAULT));
+            RandHelper::loadState(attrs.getString(SUMO_ATTR_RNG_ROUTEHANDLER), MSRouteHandler::getParsingRNG());
+            RandHelper::loadState(attrs.getString(SUMO_ATTR_RNG_DEVICE), MSDevice::getEquipmentRNG());
             break;
         }
         case SUMO_TAG_DELAY: {
@@ -190,6 +320,12 @@ MSStateHandler::myStartElement(int element, const SUMOSAXAttributes& attrs) {
 void
 MSStateHandler::myEndElement(int element) {
     MSRouteHandler::myEndElement(element);
+    if (element == SUMO_TAG_SNAPSHOT && !myEventTimes.empty()) {
+        // the events which were added while loading (e.g. by the vehicles and tls) keep their times
+        for (int i = 0; i < 3; i++) {
+            getEventControl(i)->setEventTimes(myEventTimes[EVENT_CONTROLS[i]], myTime);
+        }
+    }
     if (element != SUMO_TAG_PARAM && myVehicleParameter == 0 && myCurrentVType == 0) {
         myLastParameterised = 0;
     }
@@ -217,6 +353,7 @@ MSStateHandler::closeVehicle() {
                 routingDevice->notifyEnter(*v, MSMoveReminder::NOTIFICATION_DEPARTED);
             }
             MSNet::getInstance()->getInsertionControl().alreadyDeparted(v);
+            vc.registerStateRunning(v);
         }
         while (!myDeviceAttrs.empty()) {
             const std::string attrID = myDeviceAttrs.back()->getString(SUMO_ATTR_ID);
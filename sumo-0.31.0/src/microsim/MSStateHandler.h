@@ -32,6 +32,8 @@
 #include <config.h>
 #endif
 
+#include <map>
+#include <string>
 #include <utils/common/SUMOTime.h>
 #include "MSRouteHandler.h"
 
@@ -40,6 +42,8 @@
 // class declarations
 // ===========================================================================
 class MESegment;
+class MSEventControl;
+class OutputDevice;
 
 
 // ===========================================================================
@@ -63,6 +67,30 @@ public:
      */
     static void saveState(const std::string& file, SUMOTime step);
 
+    /** @brief Saves the current state into the given device
+     *
+     * @param[in] out The (possibly binary) device to write the state into
+     * @param[in] step The current simulation step
+     * @param[in] complete Whether flows, tls phases and random number generators shall be saved as well
+     */
+    static void saveState(OutputDevice& out, SUMOTime step, const bool complete = false);
+
+    /** @brief Returns the complete current state as a binary in-memory snapshot
+     *
+     * @param[in] step The current simulation step
+     * @return The snapshot (to be given to loadSnapshot)
+     */
+    static std::string saveSnapshot(SUMOTime step);
+
+    /** @brief Replaces the current simulation state by the given snapshot
+     *
+     * All vehicles are discarded (see MSNet::clearState) and rebuilt from the snapshot.
+     * @param[in] snapshot A snapshot as returned by saveSnapshot
+     * @return The simulation step the snapshot was taken at
+     * @exception ProcessError If the snapshot could not be loaded
+     */
+    static SUMOTime loadSnapshot(const std::string& snapshot);
+
     SUMOTime getTime() const {
         return myTime;
     }
@@ -94,6 +122,13 @@ protected:
     /// Ends the processing of a vehicle
     void closeVehicle();
 
+private:
+    /// @brief Returns the event control with the given index (begin of step, end of step, insertion)
+    static MSEventControl* getEventControl(const int index);
+
+    /// @brief The names of the event controls in the state (in the order of getEventControl)
+    static const char* const EVENT_CONTROLS[];
+
 private:
     const SUMOTime myOffset;
     SUMOTime myTime;
@@ -113,6 +148,12 @@ private:
     /// @brief vehicles that shall be removed when loading state
     std::set<std::string> myVehiclesToRemove;
 
+    /// @brief whether the current state shall be discarded before loading (quick-loading a snapshot)
+    bool myClearState;
+
+    /// @brief the saved execution times of the events for each event control (applied after loading)
+    std::map<std::string, std::map<long long, SUMOTime> > myEventTimes;
+
 
 private:
     /// @brief Invalidated copy constructor
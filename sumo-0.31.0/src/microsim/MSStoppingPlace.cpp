@@ -135,6 +135,13 @@ MSStoppingPlace::leaveFrom(SUMOVehicle* what) {
 }
 
 
+void
+MSStoppingPlace::clearState() {
+    myEndPositions.clear();
+    computeLastFreePos();
+}
+
+
 void
 MSStoppingPlace::computeLastFreePos() {
     myLastFreePos = myEndPos;
@@ -130,6 +130,13 @@ public:
     void leaveFrom(SUMOVehicle* what);
 
 
+    /** @brief Forgets all stopping vehicles before quick-loading state
+     *
+     * Recomputes the free space using "computeLastFreePos" then.
+     */
+    virtual void clearState();
+
+
     /** @brief Returns the last free position on this stop
      *
      * @return The last free position of this bus stop
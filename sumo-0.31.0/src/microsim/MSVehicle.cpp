@@ -100,6 +100,9 @@
 
 #define CRLL_LOOK_AHEAD 5
 
+// the estimated memory in bytes the shared best lanes may use before the least recently used are evicted
+#define BEST_LANES_CACHE_BYTES (64 * 1024 * 1024)
+
 // @todo Calibrate with real-world values / make configurable
 #define DIST_TO_STOPLINE_EXPECT_PRIORITY 1.0
 
@@ -108,6 +111,9 @@
 // ===========================================================================
 std::vector<MSLane*> MSVehicle::myEmptyLaneVector;
 std::vector<MSTransportable*> MSVehicle::myEmptyTransportableVector;
+MSVehicle::BestLanesCache MSVehicle::myBestLanesCache;
+long long MSVehicle::myBestLanesLookups(0);
+long long MSVehicle::myBestLanesHits(0);
 
 
 // ===========================================================================
@@ -576,6 +582,8 @@ MSVehicle::MSVehicle(SUMOVehicleParameter* pars, const MSRoute* route,
     myStopDist(std::numeric_limits<double>::max()),
     myCollisionImmunity(-1),
     myCachedPosition(Position::INVALID),
+    myPlanIsSpeculative(false),
+    myNeedsReplanning(false),
     myEdgeWeights(0)
 #ifndef NO_TRACI
     , myInfluencer(0)
@@ -1518,6 +1526,8 @@ MSVehicle::planMove(const SUMOTime t, const MSLeaderInfo& ahead, const double le
                 << "\n";
     }
 #endif
+    // remove information about approaching links, will be reset later in this step
+    removeApproachingInformation(myLFLinkLanes);
     planMoveInternal(t, ahead, myLFLinkLanes, myStopDist); // XXX: Why do we reach over myLFLinkLanes and myStopDist as arguments?! That only seems to obscure things (Leo). Refs. #2575
 #ifdef DEBUG_PLAN_MOVE
     if (DEBUG_COND) {
@@ -1553,6 +1563,38 @@ MSVehicle::planMove(const SUMOTime t, const MSLeaderInfo& ahead, const double le
 }
 
 
+void
+MSVehicle::planMoveSpeculative(const SUMOTime t, const MSLeaderInfo& ahead) {
+    // opposite direction driving and shadow lanes use the uncached leader
+    // information of other lanes which is not safe for concurrent queries
+    myNeedsReplanning = (getCarFollowModel().hasRandomSafeSpeed()
+                         || getLaneChangeModel().isOpposite()
+                         || getLaneChangeModel().getShadowLane() != 0);
+#ifndef NO_TRACI
+    myNeedsReplanning |= myInfluencer != 0;
+#endif
+    if (!myNeedsReplanning) {
+        myPlanIsSpeculative = true;
+        planMoveInternal(t, ahead, myLFLinkLanesSpeculative, myStopDist);
+        myPlanIsSpeculative = false;
+    }
+}
+
+
+void
+MSVehicle::registerPlannedMove(const SUMOTime t, const MSLeaderInfo& ahead, const double lengthsInFront) {
+    removeApproachingInformation(myLFLinkLanes);
+    if (myNeedsReplanning) {
+        planMoveInternal(t, ahead, myLFLinkLanes, myStopDist);
+    } else {
+        myLFLinkLanes.swap(myLFLinkLanesSpeculative);
+    }
+    myLFLinkLanesSpeculative.clear();
+    checkRewindLinkLanes(lengthsInFront, myLFLinkLanes);
+    getLaneChangeModel().resetChanged();
+}
+
+
 void
 MSVehicle::planMoveInternal(const SUMOTime t, MSLeaderInfo ahead, DriveItemVector& lfLinks, double& myStopDist) const {
 #ifdef DEBUG_VEHICLE_GUI_SELECTION
@@ -1561,8 +1603,6 @@ MSVehicle::planMoveInternal(const SUMOTime t, MSLeaderInfo ahead, DriveItemVecto
     }
 #endif
 
-    // remove information about approaching links, will be reset later in this step
-    removeApproachingInformation(lfLinks);
     lfLinks.clear();
     myStopDist = std::numeric_limits<double>::max();
     //
@@ -2014,6 +2054,12 @@ void
 MSVehicle::checkLinkLeader(const MSLink* link, const MSLane* lane, double seen,
                            DriveProcessItem* const lastLink, double& v, double& vLinkPass, double& vLinkWait, bool& setRequest,
                            bool isShadowLink) const {
+    if (myPlanIsSpeculative && link->fromInternalLane() && link->hasFoeVehicles()) {
+        // the link leaders depend on the approach registrations and
+        // right-of-way decisions of the vehicles planned before
+        myNeedsReplanning = true;
+        return;
+    }
     const MSLink::LinkLeaders linkLeaders = link->getLeaderInfo(this, seen, 0, isShadowLink);
     for (MSLink::LinkLeaders::const_iterator it = linkLeaders.begin(); it != linkLeaders.end(); ++it) {
         // the vehicle to enter the junction first has priority
@@ -3277,10 +3323,60 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
         }
     }
 
-    // go forward along the next lanes;
+    // determine the edges to examine; together with the vehicle class and the stop
+    //  they define the best lanes (apart from the occupancies) which may be shared
+    BestLanesKey key;
+    key.vClass = myType->getVehicleClass();
+    key.stopLane = 0;
+    key.stopPos = 0;
     int seen = 0;
     double seenLength = 0;
     bool progress = true;
+    for (MSRouteIterator ce = myCurrEdge; progress;) {
+        key.edges.push_back(*ce);
+        if (nextStopEdge == ce && !nextStopLane->isInternal()) {
+            progress = false;
+            key.stopLane = nextStopLane;
+            key.stopPos = nextStopPos;
+        }
+        ++seen;
+        seenLength += (*ce)->getLanes()[0]->getLength();
+        const MSEdge* const examinedEdge = *ce;
+        ++ce;
+        progress &= (seen <= 4 || seenLength < 3000);
+        progress &= seen <= 8;
+        progress &= ce != myRoute->end();
+        if (progress) {
+            // the priorities of the links between the examined edges decide between
+            //  equally good lanes (see nextLinkPriority), the ones of traffic lights change
+            const std::vector<MSLane*>& lanes = examinedEdge->getLanes();
+            for (std::vector<MSLane*>::const_iterator i = lanes.begin(); i != lanes.end(); ++i) {
+                const MSLinkCont& links = (*i)->getLinkCont();
+                for (MSLinkCont::const_iterator j = links.begin(); j != links.end(); ++j) {
+                    if ((*j)->isTLSControlled() && &(*j)->getLane()->getEdge() == *ce) {
+                        key.linkPriorities.push_back((*j)->havePriority());
+                    }
+                }
+            }
+        } else if (ce != myRoute->end()) {
+            // the lanes allowed on the last examined edge depend on the following one
+            key.edges.push_back(*ce);
+        }
+    }
+    key.examined = seen;
+    myBestLanesLookups++;
+    const std::vector<std::vector<LaneQ> >* const cached = myBestLanesCache.get(key);
+    if (cached != 0) {
+        myBestLanesHits++;
+        myBestLanes = *cached;
+        updateOccupancyAndCurrentBestLane(startLane);
+        return;
+    }
+
+    // go forward along the next lanes;
+    seen = 0;
+    seenLength = 0;
+    progress = true;
     for (MSRouteIterator ce = myCurrEdge; progress;) {
         std::vector<LaneQ> currentLanes;
         const std::vector<MSLane*>* allowed = 0;
@@ -3455,6 +3551,7 @@ MSVehicle::updateBestLanes(bool forceRebuild, const MSLane* startLane) {
             }
         }
     }
+    myBestLanesCache.put(key, myBestLanes);
     updateOccupancyAndCurrentBestLane(startLane);
 #ifdef DEBUG_BESTLANES
     if (DEBUG_COND) {
@@ -3545,6 +3642,100 @@ MSVehicle::adaptBestLanesOccupation(int laneIndex, double density) {
 }
 
 
+void
+MSVehicle::clearBestLanesCache() {
+    myBestLanesCache.clear();
+}
+
+
+double
+MSVehicle::getBestLanesCacheHitRate() {
+    return myBestLanesLookups == 0 ? 0. : (double)myBestLanesHits / (double)myBestLanesLookups;
+}
+
+
+bool
+MSVehicle::BestLanesKey::operator<(const BestLanesKey& other) const {
+    if (vClass != other.vClass) {
+        return vClass < other.vClass;
+    }
+    if (examined != other.examined) {
+        return examined < other.examined;
+    }
+    if (stopLane != other.stopLane) {
+        return stopLane < other.stopLane;
+    }
+    if (stopPos != other.stopPos) {
+        return stopPos < other.stopPos;
+    }
+    if (edges != other.edges) {
+        return edges < other.edges;
+    }
+    return linkPriorities < other.linkPriorities;
+}
+
+
+const std::vector<std::vector<MSVehicle::LaneQ> >*
+MSVehicle::BestLanesCache::get(const BestLanesKey& key) {
+    std::map<BestLanesKey, Entry>::iterator i = myEntries.find(key);
+    if (i == myEntries.end()) {
+        return 0;
+    }
+    myUsage.splice(myUsage.begin(), myUsage, i->second.used);
+    return &i->second.bestLanes;
+}
+
+
+void
+MSVehicle::BestLanesCache::put(const BestLanesKey& key, const std::vector<std::vector<LaneQ> >& bestLanes) {
+    const long long bytes = estimateBytes(key, bestLanes);
+    if (bytes > BEST_LANES_CACHE_BYTES) {
+        return;
+    }
+    while (myBytes + bytes > BEST_LANES_CACHE_BYTES) {
+        std::map<BestLanesKey, Entry>::iterator evicted = myEntries.find(*myUsage.back());
+        myBytes -= evicted->second.bytes;
+        myUsage.pop_back();
+        myEntries.erase(evicted);
+    }
+    std::pair<std::map<BestLanesKey, Entry>::iterator, bool> inserted = myEntries.insert(std::make_pair(key, Entry()));
+    if (!inserted.second) {
+        // the key was cached already, replace its entry
+        myBytes -= inserted.first->second.bytes;
+        myUsage.erase(inserted.first->second.used);
+    }
+    Entry& entry = inserted.first->second;
+    entry.bestLanes = bestLanes;
+    entry.bytes = bytes;
+    myUsage.push_front(&inserted.first->first);
+    entry.used = myUsage.begin();
+    myBytes += bytes;
+}
+
+
+void
+MSVehicle::BestLanesCache::clear() {
+    myEntries.clear();
+    myUsage.clear();
+    myBytes = 0;
+}
+
+
+long long
+MSVehicle::BestLanesCache::estimateBytes(const BestLanesKey& key, const std::vector<std::vector<LaneQ> >& bestLanes) {
+    // the map and list nodes are counted with four pointers each
+    long long bytes = sizeof(BestLanesKey) + sizeof(Entry) + 8 * sizeof(void*);
+    bytes += key.edges.size() * sizeof(const MSEdge*) + key.linkPriorities.size() / 8;
+    for (std::vector<std::vector<LaneQ> >::const_iterator i = bestLanes.begin(); i != bestLanes.end(); ++i) {
+        bytes += sizeof(std::vector<LaneQ>) + i->size() * sizeof(LaneQ);
+        for (std::vector<LaneQ>::const_iterator j = i->begin(); j != i->end(); ++j) {
+            bytes += j->bestContinuations.size() * sizeof(MSLane*);
+        }
+    }
+    return bytes;
+}
+
+
 void
 MSVehicle::fixPosition() {
     if (MSGlobals::gLaneChangeDuration > 0 && !getLaneChangeModel().isChangingLanes()) {
@@ -4387,6 +4578,7 @@ MSVehicle::saveState(OutputDevice& out) {
     internals.push_back(toString(distance(myRoute->begin(), myCurrEdge)));
     internals.push_back(toString(myDepartPos));
     internals.push_back(toString(myWaitingTime));
+    internals.push_back(toString(myChosenSpeedFactor, 17));
     out.writeAttr(SUMO_ATTR_STATE, internals);
     out.writeAttr(SUMO_ATTR_POSITION, myState.myPos);
     out.writeAttr(SUMO_ATTR_SPEED, myState.mySpeed);
@@ -4414,6 +4606,11 @@ MSVehicle::loadState(const SUMOSAXAttributes& attrs, const SUMOTime offset) {
     bis >> routeOffset;
     bis >> myDepartPos;
     bis >> myWaitingTime;
+    double speedFactor;
+    if (bis >> speedFactor) {
+        // older states do not contain the speed factor
+        myChosenSpeedFactor = speedFactor;
+    }
     if (hasDeparted()) {
         myCurrEdge += routeOffset;
         myDeparture -= offset;
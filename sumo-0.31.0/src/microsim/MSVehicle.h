@@ -86,6 +86,8 @@ public:
     /// the lane changer sets myLastLaneChangeOffset
     friend class MSLaneChanger;
     friend class MSLaneChangerSublane;
+    /// the best lanes cache belongs to the simulation
+    friend class MSSimulationContext;
 
     /** @class State
      * @brief Container that holds the vehicles driving state (position+speed).
@@ -342,6 +344,33 @@ public:
     void planMove(const SUMOTime t, const MSLeaderInfo& ahead, const double lengthsInFront);
 
 
+    /** @brief Computes the safe velocities like planMove without modifying links or junctions
+     *
+     * Vehicles on different lanes may be planned concurrently. The plan is
+     *  kept aside and registered by registerPlannedMove. Vehicles whose plan
+     *  depends on the approach registrations or the right-of-way decisions of
+     *  other vehicles in this step, on random numbers or on TraCI influence are
+     *  marked for being planned again sequentially.
+     *
+     * @param[in] t The current timeStep
+     * @param[in] ahead The leaders (may be 0)
+     * @see MSEdgeControl::planMovements
+     */
+    void planMoveSpeculative(const SUMOTime t, const MSLeaderInfo& ahead);
+
+
+    /** @brief Registers the plan computed by planMoveSpeculative at the links
+     *
+     * Plans again if needed, yielding the same result as planMove. Has to be
+     *  called for all vehicles in the order used by sequential planning.
+     *
+     * @param[in] t The current timeStep
+     * @param[in] ahead The leaders (may be 0)
+     * @param[in] lengthsInFront Sum of vehicle lengths in front of the vehicle
+     */
+    void registerPlannedMove(const SUMOTime t, const MSLeaderInfo& ahead, const double lengthsInFront);
+
+
     /** @brief Executes planned vehicle movements with regards to right-of-way
      *
      * This method goes through all DriveProcessItems in myLFLinkLanes in order
@@ -780,6 +809,15 @@ public:
     /// @brief update occupation from MSLaneChanger
     void adaptBestLanesOccupation(int laneIndex, double density);
 
+    /** @brief Removes all best lanes shared between vehicles
+     *
+     * Must be called whenever the lane permissions or lengths change.
+     */
+    static void clearBestLanesCache();
+
+    /// @brief Returns the share of best lanes computations which were served by the shared cache
+    static double getBestLanesCacheHitRate();
+
     /// @}
 
     /// @brief repair errors in vehicle position after changing between internal edges
@@ -1557,6 +1595,76 @@ protected:
     static std::vector<MSLane*> myEmptyLaneVector;
     static std::vector<MSTransportable*> myEmptyTransportableVector;
 
+    /** @struct BestLanesKey
+     * @brief Everything the best lanes (except for the occupancies) depend on
+     */
+    struct BestLanesKey {
+        /// @brief The vehicle class
+        SUMOVehicleClass vClass;
+        /// @brief The examined edges of the route followed by the next route edge (if any)
+        std::vector<const MSEdge*> edges;
+        /// @brief The number of examined edges
+        int examined;
+        /// @brief The lane of the next stop (or arrival) if it lies on the examined edges, 0 otherwise
+        const MSLane* stopLane;
+        /// @brief The position of the next stop (or arrival) on stopLane
+        double stopPos;
+        /// @brief The current priorities of the traffic light controlled links between the examined edges
+        std::vector<bool> linkPriorities;
+
+        bool operator<(const BestLanesKey& other) const;
+    };
+
+    /** @class BestLanesCache
+     * @brief Best lanes computed without occupancies, bounded by their estimated memory
+     *
+     * When the limit is exceeded the least recently used entries are evicted.
+     */
+    class BestLanesCache {
+    public:
+        /// @brief Constructor
+        BestLanesCache() : myBytes(0) {}
+
+        /// @brief Returns the best lanes for the key (0 if not cached) and marks them as recently used
+        const std::vector<std::vector<LaneQ> >* get(const BestLanesKey& key);
+
+        /// @brief Stores the best lanes for the key, evicting the least recently used ones if needed
+        void put(const BestLanesKey& key, const std::vector<std::vector<LaneQ> >& bestLanes);
+
+        /// @brief Removes all entries
+        void clear();
+
+    private:
+        /// @brief Returns the estimated memory used by an entry
+        static long long estimateBytes(const BestLanesKey& key, const std::vector<std::vector<LaneQ> >& bestLanes);
+
+        /// @brief A cached value
+        struct Entry {
+            /// @brief The best lanes
+            std::vector<std::vector<LaneQ> > bestLanes;
+            /// @brief The estimated memory of the entry
+            long long bytes;
+            /// @brief The position in the usage order
+            std::list<const BestLanesKey*>::iterator used;
+        };
+
+        /// @brief The cached best lanes
+        std::map<BestLanesKey, Entry> myEntries;
+
+        /// @brief The keys of the entries from the most to the least recently used
+        std::list<const BestLanesKey*> myUsage;
+
+        /// @brief The estimated memory of all entries
+        long long myBytes;
+    };
+
+    /// @brief The best lanes shared by all vehicles
+    static BestLanesCache myBestLanesCache;
+
+    /// @brief The number of best lanes rebuilds and how many of them were served by the cache
+    static long long myBestLanesLookups;
+    static long long myBestLanesHits;
+
     /// @brief The vehicle's list of stops
     std::list<Stop> myStops;
 
@@ -1655,6 +1763,15 @@ protected:
     typedef std::vector< DriveProcessItem > DriveItemVector;
     DriveItemVector myLFLinkLanes;
 
+    /// @brief The links computed by planMoveSpeculative (not yet registered)
+    DriveItemVector myLFLinkLanesSpeculative;
+
+    /// @brief Whether planMoveSpeculative is running
+    bool myPlanIsSpeculative;
+
+    /// @brief Whether the speculative plan has to be computed again by registerPlannedMove
+    mutable bool myNeedsReplanning;
+
     /// @todo: documentation
     void planMoveInternal(const SUMOTime t, MSLeaderInfo ahead, DriveItemVector& lfLinks, double& myStopDist) const;
 
@@ -65,7 +65,8 @@ MSVehicleControl::MSVehicleControl() :
     myWaitingForPerson(0),
     myWaitingForContainer(0),
     myMaxSpeedFactor(1),
-    myMinDeceleration(SUMOVTypeParameter::getDefaultDecel(SVC_IGNORING)) {
+    myMinDeceleration(SUMOVTypeParameter::getDefaultDecel(SVC_IGNORING)),
+    myPositionIndexTime(-1) {
     SUMOVTypeParameter defType(DEFAULT_VTYPE_ID, SVC_PASSENGER);
     myVTypeDict[DEFAULT_VTYPE_ID] = MSVehicleType::build(defType);
     SUMOVTypeParameter defPedType(DEFAULT_PEDTYPE_ID, SVC_PEDESTRIAN);
@@ -83,6 +84,8 @@ MSVehicleControl::~MSVehicleControl() {
         delete(*i).second;
     }
     myVehicleDict.clear();
+    myVehicleIndex.clear();
+    myRunningVehicles.clear();
     // delete vehicle type distributions
     for (VTypeDistDictType::iterator i = myVTypeDistDict.begin(); i != myVTypeDistDict.end(); ++i) {
         delete(*i).second;
@@ -141,6 +144,10 @@ MSVehicleControl::scheduleVehicleRemoval(SUMOVehicle* veh) {
 void
 MSVehicleControl::vehicleDeparted(const SUMOVehicle& v) {
     ++myRunningVehNo;
+    SUMOVehicle* const veh = getVehicle(v.getID());
+    if (veh != 0) {
+        myRunningVehicles[v.getID()] = veh;
+    }
     myTotalDepartureDelay += STEPS2TIME(v.getDeparture() - STEPFLOOR(v.getParameter().depart));
     MSNet::getInstance()->informVehicleStateListener(&v, MSNet::VEHICLE_STATE_DEPARTED);
     myMaxSpeedFactor = MAX2(myMaxSpeedFactor, v.getChosenSpeedFactor());
@@ -148,6 +155,12 @@ MSVehicleControl::vehicleDeparted(const SUMOVehicle& v) {
 }
 
 
+void
+MSVehicleControl::registerStateRunning(SUMOVehicle* v) {
+    myRunningVehicles[v->getID()] = v;
+}
+
+
 void
 MSVehicleControl::setState(int runningVehNo, int loadedVehNo, int endedVehNo, double totalDepartureDelay, double totalTravelTime) {
     myRunningVehNo = runningVehNo;
@@ -182,10 +195,31 @@ MSVehicleControl::saveState(OutputDevice& out) {
 }
 
 
+void
+MSVehicleControl::clearState() {
+    for (VehicleDictType::iterator i = myVehicleDict.begin(); i != myVehicleDict.end(); ++i) {
+        delete(*i).second;
+    }
+    myVehicleDict.clear();
+    myVehicleIndex.clear();
+    myRunningVehicles.clear();
+    myPositionIndex.clear();
+    myPositionIndexTime = -1;
+    myWaiting.clear();
+    myWaitingForPerson = 0;
+    myWaitingForContainer = 0;
+    myLoadedVehNo = 0;
+    myRunningVehNo = 0;
+    myEndedVehNo = 0;
+    myDiscarded = 0;
+    myTotalDepartureDelay = 0;
+    myTotalTravelTime = 0;
+}
+
+
 bool
 MSVehicleControl::addVehicle(const std::string& id, SUMOVehicle* v) {
-    VehicleDictType::iterator it = myVehicleDict.find(id);
-    if (it == myVehicleDict.end()) {
+    if (myVehicleIndex.insert(std::make_pair(id, v)).second) {
         // id not in myVehicleDict.
         myVehicleDict[id] = v;
         return true;
@@ -196,8 +230,8 @@ MSVehicleControl::addVehicle(const std::string& id, SUMOVehicle* v) {
 
 SUMOVehicle*
 MSVehicleControl::getVehicle(const std::string& id) const {
-    VehicleDictType::const_iterator it = myVehicleDict.find(id);
-    if (it == myVehicleDict.end()) {
+    std::unordered_map<std::string, SUMOVehicle*>::const_iterator it = myVehicleIndex.find(id);
+    if (it == myVehicleIndex.end()) {
         return 0;
     }
     return it->second;
@@ -212,11 +246,31 @@ MSVehicleControl::deleteVehicle(SUMOVehicle* veh, bool discard) {
     }
     if (veh != 0) {
         myVehicleDict.erase(veh->getID());
+        myVehicleIndex.erase(veh->getID());
+        myRunningVehicles.erase(veh->getID());
+        myPositionIndexTime = -1;
     }
     delete veh;
 }
 
 
+const KDTree<const SUMOVehicle*>&
+MSVehicleControl::getPositionIndex() {
+    const SUMOTime now = MSNet::getInstance()->getCurrentTimeStep();
+    if (myPositionIndexTime != now) {
+        myPositionIndex.clear();
+        for (VehicleDictType::const_iterator i = myRunningVehicles.begin(); i != myRunningVehicles.end(); ++i) {
+            if (i->second->isOnRoad()) {
+                myPositionIndex.add(i->second->getPosition(), i->second);
+            }
+        }
+        myPositionIndex.build();
+        myPositionIndexTime = now;
+    }
+    return myPositionIndex;
+}
+
+
 bool
 MSVehicleControl::checkVType(const std::string& id) {
     if (id == DEFAULT_VTYPE_ID) {
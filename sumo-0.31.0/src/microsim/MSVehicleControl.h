@@ -35,10 +35,12 @@
 #include <cmath>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <set>
 #include <utils/distribution/RandomDistributor.h>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/SUMOVehicleClass.h>
+#include <utils/geom/KDTree.h>
 
 
 // ===========================================================================
@@ -173,6 +175,33 @@ public:
     constVehIt loadedVehEnd() const {
         return myVehicleDict.end();
     }
+
+
+    /** @brief Returns the begin of the map of running (departed and not yet arrived) vehicles
+     *
+     * Per step outputs should iterate over the running vehicles instead of
+     *  all loaded ones. The vehicles are sorted by id as in the loaded map.
+     * @return The begin of the running vehicles map
+     */
+    constVehIt runningVehBegin() const {
+        return myRunningVehicles.begin();
+    }
+
+
+    /** @brief Returns the end of the map of running vehicles
+     * @return The end of the running vehicles map
+     */
+    constVehIt runningVehEnd() const {
+        return myRunningVehicles.end();
+    }
+
+
+    /** @brief Adds a vehicle which was loaded in a departed state to the running vehicles
+     *
+     * The number of running vehicles is not changed (it is part of the loaded state).
+     * @param[in] v The vehicle loaded from a state file
+     */
+    void registerStateRunning(SUMOVehicle* v);
     /// @}
 
 
@@ -428,6 +457,10 @@ public:
     /** @brief Saves the current state into the given stream
      */
     void saveState(OutputDevice& out);
+
+    /** @brief Deletes all vehicles and resets the counters before quick-loading state
+     */
+    void clearState();
     /// @}
 
     /// @brief avoid counting a vehicle twice if it was loaded from state and route input
@@ -459,6 +492,14 @@ public:
         return myMinDeceleration;
     }
 
+    /** @brief Returns a spatial index of the vehicles on the road
+     *
+     * The index is built from the vehicles' positions on first request within
+     *  a simulation step and reused for further requests in that step.
+     * @return The index of all vehicles on the road
+     */
+    const KDTree<const SUMOVehicle*>& getPositionIndex();
+
 private:
     /** @brief Checks whether the vehicle type (distribution) may be added
      *
@@ -520,6 +561,10 @@ protected:
     typedef std::map< std::string, SUMOVehicle* > VehicleDictType;
     /// @brief Dictionary of vehicles
     VehicleDictType myVehicleDict;
+    /// @brief Hashed index of the vehicles for the retrieval by id
+    std::unordered_map<std::string, SUMOVehicle*> myVehicleIndex;
+    /// @brief Dictionary of the running vehicles (a subset of myVehicleDict)
+    VehicleDictType myRunningVehicles;
     /// @}
 
 
@@ -563,6 +608,12 @@ protected:
     /// @brief The minimum deceleration capability for all vehicles in the network
     double myMinDeceleration;
 
+    /// @brief The spatial index of the vehicles on the road
+    KDTree<const SUMOVehicle*> myPositionIndex;
+
+    /// @brief The time the spatial index was built at (-1 if it is outdated)
+    SUMOTime myPositionIndexTime;
+
 private:
     /// @brief invalidated copy constructor
     MSVehicleControl(const MSVehicleControl& s);
@@ -68,6 +68,8 @@ class SUMOSAXAttributes;
  * This object is used as a singleton
  */
 class MSVehicleTransfer {
+    friend class MSSimulationContext;
+
 public:
     /// @brief Destructor
     virtual ~MSVehicleTransfer();
@@ -117,6 +119,9 @@ public:
     /** @brief Loads one transfer vehicle state from the given descriptionn */
     void loadState(const SUMOSAXAttributes& attrs, const SUMOTime offset, MSVehicleControl& vc);
 
+    /** @brief Forgets all vehicles (they are deleted by MSVehicleControl::clearState) */
+    void clearState();
+
     /** @brief Returns the instance of this object
      * @return The singleton instance
      */
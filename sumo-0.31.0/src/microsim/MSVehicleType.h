@@ -71,6 +71,8 @@ class SUMOVTypeParameter;
  *  Ford Mustang in your simulation while the car instances just refer to it.
  */
 class MSVehicleType {
+    friend class MSSimulationContext;
+
 public:
     /** @brief Constructor.
      *
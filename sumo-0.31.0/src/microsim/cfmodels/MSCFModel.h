@@ -182,6 +182,17 @@ public:
     virtual int getModelID() const = 0;
 
 
+    /** @brief Returns whether the safe speeds depend on random numbers
+     *
+     * Vehicles with such a model are planned sequentially when the movements
+     *  are planned in parallel (see MSEdgeControl::planMovements).
+     * @return Whether followSpeed or stopSpeed draw random numbers
+     */
+    virtual bool hasRandomSafeSpeed() const {
+        return false;
+    }
+
+
     /** @brief Duplicates the car-following model
      * @param[in] vtype The vehicle type this model belongs to (1:1)
      * @return A duplicate of this car-following model
@@ -102,6 +102,15 @@ public:
     }
 
 
+    /** @brief Returns whether the safe speeds depend on random numbers
+     * @return Always true, the action points and the preferred acceleration are randomized
+     * @see MSCFModel::hasRandomSafeSpeed
+     */
+    bool hasRandomSafeSpeed() const {
+        return true;
+    }
+
+
     /** @brief Get the driver's imperfection
      * @return The imperfection of drivers of this class
      */
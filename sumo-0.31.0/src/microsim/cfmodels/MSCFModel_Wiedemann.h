@@ -122,6 +122,15 @@ public:
     }
 
 
+    /** @brief Returns whether the safe speeds depend on random numbers
+     * @return Always true, the opening speed difference is randomized
+     * @see MSCFModel::hasRandomSafeSpeed
+     */
+    bool hasRandomSafeSpeed() const {
+        return true;
+    }
+
+
     /** @brief Duplicates the car-following model
      * @param[in] vtype The vehicle type this model belongs to (1:1)
      * @return A duplicate of this car-following model
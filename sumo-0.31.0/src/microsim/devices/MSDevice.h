@@ -69,6 +69,8 @@ class SUMOSAXAttributes;
  *  an empty (nothing doing) implementation of these.
  */
 class MSDevice : public MSMoveReminder, public Named {
+    friend class MSSimulationContext;
+
 public:
     /** @brief Inserts options for building devices
      * @param[filled] oc The options container to add the options to
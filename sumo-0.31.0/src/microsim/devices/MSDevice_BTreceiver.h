@@ -55,6 +55,8 @@ class SUMOVehicle;
  * @see MSDevice
  */
 class MSDevice_BTreceiver : public MSDevice {
+    friend class MSSimulationContext;
+
 public:
     /** @brief Inserts MSDevice_BTreceiver-options
      * @param[filled] oc The options container to add the options to
@@ -54,6 +54,8 @@ class SUMOVehicle;
  * @see MSDevice
  */
 class MSDevice_BTsender : public MSDevice {
+    friend class MSSimulationContext;
+
 public:
     /** @brief Inserts MSDevice_BTsender-options
      * @param[filled] oc The options container to add the options to
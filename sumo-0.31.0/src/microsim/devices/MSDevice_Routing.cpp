@@ -65,9 +65,7 @@ std::map<std::pair<const MSEdge*, const MSEdge*>, const MSRoute*> MSDevice_Routi
 SUMOAbstractRouter<MSEdge, SUMOVehicle>* MSDevice_Routing::myRouter = 0;
 AStarRouter<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >* MSDevice_Routing::myRouterWithProhibited = 0;
 double MSDevice_Routing::myRandomizeWeightsFactor = 0;
-#ifdef HAVE_FOX
-FXWorkerThread::Pool MSDevice_Routing::myThreadPool;
-#endif
+SUMOWorkerThread::Pool* MSDevice_Routing::myThreadPool = 0;
 
 
 // ===========================================================================
@@ -142,12 +140,6 @@ MSDevice_Routing::checkOptions(OptionsCont& oc) {
         WRITE_ERROR("The value for device.rerouting.adaptation-weight must be between 0 and 1!");
         ok = false;
     }
-#ifndef HAVE_FOX
-    if (oc.getInt("device.rerouting.threads") > 1) {
-        WRITE_ERROR("Parallel routing is only possible when compiled with Fox.");
-        ok = false;
-    }
-#endif
     return ok;
 }
 
@@ -358,15 +350,11 @@ MSDevice_Routing::reroute(const SUMOTime currentTime, const bool onInit) {
         return;
     }
     myLastRouting = currentTime;
-#ifdef HAVE_FOX
-    const bool needThread = (myRouter == 0 && myThreadPool.isFull());
-#else
-    const bool needThread = true;
-#endif
+    const bool needThread = (myRouter == 0 && (myThreadPool == 0 || myThreadPool->isFull()));
     if (needThread && myRouter == 0) {
         OptionsCont& oc = OptionsCont::getOptions();
         const std::string routingAlgorithm = oc.getString("routing-algorithm");
-        const bool mayHaveRestrictions = MSNet::getInstance()->hasPermissions() || oc.getInt("remote-port") != 0;
+        const bool mayHaveRestrictions = MSNet::getInstance()->hasPermissions() || oc.getInt("remote-port") != 0 || oc.isSet("remote-shm");
         if (routingAlgorithm == "dijkstra") {
             if (mayHaveRestrictions) {
                 myRouter = new DijkstraRouterTT<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> >(
@@ -381,14 +369,16 @@ MSDevice_Routing::reroute(const SUMOTime currentTime, const bool onInit) {
                 const AStar::LookupTable* lookup = 0;
                 if (oc.isSet("astar.all-distances")) {
                     lookup = new AStar::FLT(oc.getString("astar.all-distances"), (int)MSEdge::getAllEdges().size());
-                } else if (oc.isSet("astar.landmark-distances")) {
+                } else if (oc.isSet("astar.landmark-distances") || oc.getInt("astar.auto-landmarks") > 0) {
                     const double speedFactor = myHolder.getChosenSpeedFactor();
                     // we need an exemplary vehicle with speedFactor 1
                     myHolder.setChosenSpeedFactor(1);
                     CHRouterWrapper<MSEdge, SUMOVehicle, prohibited_withPermissions<MSEdge, SUMOVehicle> > router(
                         MSEdge::getAllEdges(), true, &MSNet::getTravelTime,
                         string2time(oc.getString("begin")), string2time(oc.getString("end")), std::numeric_limits<int>::max(), 1);
-                    lookup = new AStar::LMLT(oc.getString("astar.landmark-distances"), MSEdge::getAllEdges(), &router, &myHolder, "", oc.getInt("device.rerouting.threads"));
+                    lookup = new AStar::LMLT(oc.isSet("astar.landmark-distances") ? oc.getString("astar.landmark-distances") : "", MSEdge::getAllEdges(), &router, &myHolder,
+                                             oc.isSet("astar.save-landmark-distances") ? oc.getString("astar.save-landmark-distances") : "", oc.getInt("device.rerouting.threads"),
+                                             oc.getInt("astar.auto-landmarks"));
                     myHolder.setChosenSpeedFactor(speedFactor);
                 }
                 myRouter = new AStar(MSEdge::getAllEdges(), true, &MSDevice_Routing::getEffort, lookup);
@@ -397,14 +387,16 @@ MSDevice_Routing::reroute(const SUMOTime currentTime, const bool onInit) {
                 const AStar::LookupTable* lookup = 0;
                 if (oc.isSet("astar.all-distances")) {
                     lookup = new AStar::FLT(oc.getString("astar.all-distances"), (int)MSEdge::getAllEdges().size());
-                } else if (oc.isSet("astar.landmark-distances")) {
+                } else if (oc.isSet("astar.landmark-distances") || oc.getInt("astar.auto-landmarks") > 0) {
                     const double speedFactor = myHolder.getChosenSpeedFactor();
                     // we need an exemplary vehicle with speedFactor 1
                     myHolder.setChosenSpeedFactor(1);
                     CHRouterWrapper<MSEdge, SUMOVehicle, noProhibitions<MSEdge, SUMOVehicle> > router(
                         MSEdge::getAllEdges(), true, &MSNet::getTravelTime,
                         string2time(oc.getString("begin")), string2time(oc.getString("end")), std::numeric_limits<int>::max(), 1);
-                    lookup = new AStar::LMLT(oc.getString("astar.landmark-distances"), MSEdge::getAllEdges(), &router, &myHolder, "", oc.getInt("device.rerouting.threads"));
+                    lookup = new AStar::LMLT(oc.isSet("astar.landmark-distances") ? oc.getString("astar.landmark-distances") : "", MSEdge::getAllEdges(), &router, &myHolder,
+                                             oc.isSet("astar.save-landmark-distances") ? oc.getString("astar.save-landmark-distances") : "", oc.getInt("device.rerouting.threads"),
+                                             oc.getInt("astar.auto-landmarks"));
                     myHolder.setChosenSpeedFactor(speedFactor);
                 }
                 myRouter = new AStar(MSEdge::getAllEdges(), true, &MSDevice_Routing::getEffort, lookup);
@@ -427,21 +419,22 @@ MSDevice_Routing::reroute(const SUMOTime currentTime, const bool onInit) {
             throw ProcessError("Unknown routing algorithm '" + routingAlgorithm + "'!");
         }
     }
-#ifdef HAVE_FOX
     if (needThread) {
         const int numThreads = OptionsCont::getOptions().getInt("device.rerouting.threads");
-        if (myThreadPool.size() < numThreads) {
-            new WorkerThread(myThreadPool, myRouter);
+        if (numThreads > 0 && myThreadPool == 0) {
+            myThreadPool = new SUMOWorkerThread::Pool();
         }
-        if (myThreadPool.size() < numThreads) {
+        if (myThreadPool != 0 && myThreadPool->size() < numThreads) {
+            new WorkerThread(*myThreadPool, myRouter);
+        }
+        if (myThreadPool != 0 && myThreadPool->size() < numThreads) {
             myRouter = 0;
         }
     }
-    if (myThreadPool.size() > 0) {
-        myThreadPool.add(new RoutingTask(myHolder, currentTime, onInit));
+    if (isParallel()) {
+        myThreadPool->add(new RoutingTask(myHolder, currentTime, onInit));
         return;
     }
-#endif
     myHolder.reroute(currentTime, *myRouter, onInit, myWithTaz);
 }
 
@@ -508,26 +501,22 @@ void
 MSDevice_Routing::cleanup() {
     delete myRouterWithProhibited;
     myRouterWithProhibited = 0;
-#ifdef HAVE_FOX
-    if (myThreadPool.size() > 0) {
-        // we cannot wait for the static destructor to do the cleanup
-        // because the output devices are gone by then
-        myThreadPool.clear();
+    if (isParallel()) {
         // router deletion is done in thread destructor
         myRouter = 0;
-        return;
     }
-#endif
+    // the pool has to go before the output devices are closed
+    delete myThreadPool;
+    myThreadPool = 0;
     delete myRouter;
     myRouter = 0;
 }
 
 
-#ifdef HAVE_FOX
 void
 MSDevice_Routing::waitForAll() {
-    if (myThreadPool.size() > 0) {
-        myThreadPool.waitAll();
+    if (isParallel()) {
+        myThreadPool->waitAll();
     }
 }
 
@@ -536,7 +525,7 @@ MSDevice_Routing::waitForAll() {
 // MSDevice_Routing::RoutingTask-methods
 // ---------------------------------------------------------------------------
 void
-MSDevice_Routing::RoutingTask::run(FXWorkerThread* context) {
+MSDevice_Routing::RoutingTask::run(SUMOWorkerThread* context) {
     myVehicle.reroute(myTime, static_cast<WorkerThread*>(context)->getRouter(), myOnInit, myWithTaz);
     const MSEdge* source = *myVehicle.getRoute().begin();
     const MSEdge* dest = myVehicle.getRoute().getLastEdge();
@@ -550,7 +539,6 @@ MSDevice_Routing::RoutingTask::run(FXWorkerThread* context) {
         unlock();
     }
 }
-#endif
 
 
 /****************************************************************************/
@@ -40,12 +40,9 @@
 #include <utils/vehicle/SUMOAbstractRouter.h>
 #include <utils/vehicle/AStarRouter.h>
 #include <microsim/MSVehicle.h>
+#include <utils/common/SUMOWorkerThread.h>
 #include "MSDevice.h"
 
-#ifdef HAVE_FOX
-#include <utils/foxtools/FXWorkerThread.h>
-#endif
-
 
 // ===========================================================================
 // class declarations
@@ -74,6 +71,8 @@ class MSLane;
  *  "wrappedRerouteCommandExecute".
  */
 class MSDevice_Routing : public MSDevice {
+    friend class MSSimulationContext;
+
 public:
     /** @brief Inserts MSDevice_Routing-options
      * @param[filled] oc The options container to add the options to
@@ -118,18 +117,16 @@ public:
     static SUMOAbstractRouter<MSEdge, SUMOVehicle>& getRouterTT(
         const MSEdgeVector& prohibited = MSEdgeVector());
 
-#ifdef HAVE_FOX
     static void waitForAll();
     static void lock() {
-        myThreadPool.lock();
+        myThreadPool->lock();
     }
     static void unlock() {
-        myThreadPool.unlock();
+        myThreadPool->unlock();
     }
     static bool isParallel() {
-        return myThreadPool.size() > 0;
+        return myThreadPool != 0 && myThreadPool->size() > 0;
     }
-#endif
 
 
 
@@ -196,16 +193,15 @@ public:
 
 
 private:
-#ifdef HAVE_FOX
     /**
      * @class WorkerThread
      * @brief the thread which provides the router instance as context
      */
-    class WorkerThread : public FXWorkerThread {
+    class WorkerThread : public SUMOWorkerThread {
     public:
-        WorkerThread(FXWorkerThread::Pool& pool,
+        WorkerThread(SUMOWorkerThread::Pool& pool,
                      SUMOAbstractRouter<MSEdge, SUMOVehicle>* router)
-            : FXWorkerThread(pool), myRouter(router) {}
+            : SUMOWorkerThread(pool), myRouter(router) {}
         SUMOAbstractRouter<MSEdge, SUMOVehicle>& getRouter() const {
             return *myRouter;
         }
@@ -221,11 +217,11 @@ private:
      * @class RoutingTask
      * @brief the routing task which mainly calls reroute of the vehicle
      */
-    class RoutingTask : public FXWorkerThread::Task {
+    class RoutingTask : public SUMOWorkerThread::Task {
     public:
         RoutingTask(SUMOVehicle& v, const SUMOTime time, const bool onInit)
             : myVehicle(v), myTime(time), myOnInit(onInit) {}
-        void run(FXWorkerThread* context);
+        void run(SUMOWorkerThread* context);
     private:
         SUMOVehicle& myVehicle;
         const SUMOTime myTime;
@@ -234,7 +230,6 @@ private:
         /// @brief Invalidated assignment operator.
         RoutingTask& operator=(const RoutingTask&);
     };
-#endif
 
     /** @brief Constructor
      *
@@ -367,9 +362,8 @@ private:
     /// @brief Whether to disturb edge weights dynamically
     static double myRandomizeWeightsFactor;
 
-#ifdef HAVE_FOX
-    static FXWorkerThread::Pool myThreadPool;
-#endif
+    /// @brief The pool of routing threads (created on first use, so each simulation context gets its own)
+    static SUMOWorkerThread::Pool* myThreadPool;
 
 private:
     /// @brief Invalidated copy constructor.
@@ -1063,7 +1063,7 @@ MSDevice_SSM::determineTTCandDRAC(EncounterApproachInfo& eInfo) const {
 
 
 double
-MSDevice_SSM::computeTTC(double gap, double followerSpeed, double leaderSpeed) const {
+MSDevice_SSM::computeTTC(double gap, double followerSpeed, double leaderSpeed) {
     // TODO: in merging or crossing situations, the TTC may be lower than the one computed here for following situations
     // More specifically, the followers conflict time entry should be less than the leaders conflict exit time.
     // For merging conflicts, the minimum has to be taken from the two if a collision at merge was predicted.
@@ -61,6 +61,7 @@ class SUMOVehicle;
 class MSCrossSection;
 
 class MSDevice_SSM : public MSDevice {
+    friend class MSSimulationContext;
 
 private:
     /// All currently existing SSM devices
@@ -321,6 +322,19 @@ public:
     static void cleanup();
 
 
+    /** @brief Computes the time to collision (in seconds) for two vehicles with a given initial gap under the assumption
+     *         that both maintain their current speeds. Returns INVALID (the maximum double) if no collision would occur under this assumption.
+     */
+    static double computeTTC(double gap, double followerSpeed, double leaderSpeed);
+
+
+    /** @brief Computes the DRAC (deceleration to avoid a collision) for a lead/follow situation as defined,
+     *         e.g., in Mahmud et al. (2016, Application of proximal surrogate indicators for safety evaluation)
+     *         for two vehicles with a given gap. Returns INVALID (the maximum double) if no deceleration is required by the follower to avoid a crash.
+     */
+    static double computeDRAC(double gap, double followerSpeed, double leaderSpeed);
+
+
 public:
     /// @brief Destructor.
     ~MSDevice_SSM();
@@ -546,18 +560,6 @@ private:
     void determineTTCandDRAC(EncounterApproachInfo& eInfo) const;
 
 
-    /** @brief Computes the time to collision (in seconds) for two vehicles with a given initial gap under the assumption
-     *         that both maintain their current speeds. Returns INVALID if no collision would occur under this assumption.
-     */
-    double computeTTC(double gap, double followerSpeed, double leaderSpeed) const;
-
-
-    /** @brief Computes the DRAC (deceleration to avoid a collision) for a lead/follow situation as defined,
-     *         e.g., in Mahmud et al. (2016, Application of proximal surrogate indicators for safety evaluation)
-     *         for two vehicles with a given gap. Returns INVALID if no deceleration is required by the follower to avoid a crash.
-     */
-    static double computeDRAC(double gap, double followerSpeed, double leaderSpeed);
-
     /** @brief Computes the DRAC a crossing situation, determining the minimal constant deceleration needed
      *         for one of the vehicles to reach the conflict area after the other if the latter continues with
      *         constant speed.
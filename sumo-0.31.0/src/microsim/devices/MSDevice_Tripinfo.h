@@ -52,6 +52,8 @@ class SUMOVehicle;
  * @see MSDevice
  */
 class MSDevice_Tripinfo : public MSDevice {
+    friend class MSSimulationContext;
+
 public:
     /** @brief Build devices for the given vehicle, if needed
      *
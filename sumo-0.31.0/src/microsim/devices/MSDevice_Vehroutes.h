@@ -56,6 +56,8 @@ class MSRoute;
  * @see MSDevice
  */
 class MSDevice_Vehroutes : public MSDevice {
+    friend class MSSimulationContext;
+
 public:
     /** @brief Static intialization
      */
@@ -49,6 +49,8 @@ class MSLane;
  * @brief Interface for lane-change models
  */
 class MSAbstractLaneChangeModel {
+    friend class MSSimulationContext;
+
 public:
 
     /** @class MSLCMessager
@@ -51,7 +51,7 @@ std::map<std::string, int> MSAmitranTrajectories::myWrittenVehicles;
 void
 MSAmitranTrajectories::write(OutputDevice& of, const SUMOTime timestep) {
     MSVehicleControl& vc = MSNet::getInstance()->getVehicleControl();
-    for (MSVehicleControl::constVehIt v = vc.loadedVehBegin(); v != vc.loadedVehEnd(); ++v) {
+    for (MSVehicleControl::constVehIt v = vc.runningVehBegin(); v != vc.runningVehEnd(); ++v) {
         writeVehicle(of, *v->second, timestep);
     }
 }
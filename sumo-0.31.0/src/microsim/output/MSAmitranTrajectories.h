@@ -56,6 +56,8 @@ class MSLane;
  * @todo consider error-handling on write (using IOError)
  */
 class MSAmitranTrajectories {
+    friend class MSSimulationContext;
+
 public:
     /** @brief Writes the complete network state into the given device
      *
@@ -51,8 +51,8 @@ MSBatteryExport::write(OutputDevice& of, SUMOTime timestep, int precision) {
     of.setPrecision(precision);
 
     MSVehicleControl& vc = MSNet::getInstance()->getVehicleControl();
-    MSVehicleControl::constVehIt it = vc.loadedVehBegin();
-    MSVehicleControl::constVehIt end = vc.loadedVehEnd();
+    MSVehicleControl::constVehIt it = vc.runningVehBegin();
+    MSVehicleControl::constVehIt end = vc.runningVehEnd();
     for (; it != end; ++it) {
         const MSVehicle* veh = static_cast<const MSVehicle*>((*it).second);
 
@@ -34,11 +34,15 @@
 #endif
 
 #include <iostream>
+#include <limits>
+#include <sstream>
 #include "MSDetectorControl.h"
 #include "MSMeanData_Net.h"
 #include <utils/options/OptionsCont.h>
 #include <utils/options/Option.h>
 #include <utils/common/MsgHandler.h>
+#include <utils/common/TplConvert.h>
+#include <utils/xml/SUMOSAXAttributes.h>
 
 
 // ===========================================================================
@@ -130,6 +134,90 @@ MSDetectorControl::updateDetectors(const SUMOTime step) {
 }
 
 
+void
+MSDetectorControl::clearState() {
+    for (std::map<SumoXMLTag, NamedObjectCont<MSDetectorFileOutput*> >::const_iterator i = myDetectors.begin(); i != myDetectors.end(); ++i) {
+        const std::map<std::string, MSDetectorFileOutput*>& dets = getTypedDetectors((*i).first).getMyMap();
+        for (std::map<std::string, MSDetectorFileOutput*>::const_iterator j = dets.begin(); j != dets.end(); ++j) {
+            (*j).second->clearState();
+        }
+    }
+}
+
+
+void
+MSDetectorControl::saveState(OutputDevice& out) const {
+    for (std::map<IntervalsKey, SUMOTime>::const_iterator i = myLastCalls.begin(); i != myLastCalls.end(); ++i) {
+        out.openTag(SUMO_TAG_DETECTORSTATE);
+        out.writeAttr(SUMO_ATTR_PERIOD, i->first.first);
+        out.writeAttr(SUMO_ATTR_BEGIN, i->first.second);
+        out.writeAttr(SUMO_ATTR_TIME, i->second);
+        out.closeTag();
+    }
+    for (std::map<SumoXMLTag, NamedObjectCont<MSDetectorFileOutput*> >::const_iterator i = myDetectors.begin(); i != myDetectors.end(); ++i) {
+        const std::map<std::string, MSDetectorFileOutput*>& dets = getTypedDetectors((*i).first).getMyMap();
+        for (std::map<std::string, MSDetectorFileOutput*>::const_iterator j = dets.begin(); j != dets.end(); ++j) {
+            std::ostringstream state;
+            state.precision(std::numeric_limits<double>::digits10 + 2);
+            (*j).second->saveState(state);
+            if (!state.str().empty()) {
+                out.openTag(SUMO_TAG_DETECTORSTATE);
+                out.writeAttr(SUMO_ATTR_ID, (*j).first);
+                out.writeAttr(SUMO_ATTR_TYPE, toString((*i).first));
+                out.writeAttr(SUMO_ATTR_VALUE, state.str());
+                out.closeTag();
+            }
+        }
+    }
+    for (std::vector<MSMeanData*>::const_iterator i = myMeanData.begin(); i != myMeanData.end(); ++i) {
+        std::ostringstream state;
+        state.precision(std::numeric_limits<double>::digits10 + 2);
+        (*i)->saveState(state);
+        if (!state.str().empty()) {
+            out.openTag(SUMO_TAG_DETECTORSTATE);
+            out.writeAttr(SUMO_ATTR_ID, (*i)->getID());
+            out.writeAttr(SUMO_ATTR_VALUE, state.str());
+            out.closeTag();
+        }
+    }
+}
+
+
+void
+MSDetectorControl::loadState(const SUMOSAXAttributes& attrs) {
+    if (!attrs.hasAttribute(SUMO_ATTR_ID)) {
+        const IntervalsKey key(TplConvert::_2long(attrs.getString(SUMO_ATTR_PERIOD).c_str()),
+                               TplConvert::_2long(attrs.getString(SUMO_ATTR_BEGIN).c_str()));
+        if (myLastCalls.find(key) != myLastCalls.end()) {
+            myLastCalls[key] = TplConvert::_2long(attrs.getString(SUMO_ATTR_TIME).c_str());
+        }
+        return;
+    }
+    const std::string id = attrs.getString(SUMO_ATTR_ID);
+    MSDetectorFileOutput* det = 0;
+    if (attrs.hasAttribute(SUMO_ATTR_TYPE)) {
+        const std::string type = attrs.getString(SUMO_ATTR_TYPE);
+        if (SUMOXMLDefinitions::Tags.hasString(type)) {
+            det = getTypedDetectors((SumoXMLTag)SUMOXMLDefinitions::Tags.get(type)).get(id);
+        }
+    } else {
+        for (std::vector<MSMeanData*>::const_iterator i = myMeanData.begin(); i != myMeanData.end(); ++i) {
+            if ((*i)->getID() == id) {
+                det = *i;
+            }
+        }
+    }
+    if (det == 0) {
+        throw ProcessError("Unknown detector '" + id + "' in state.");
+    }
+    std::istringstream state(attrs.getString(SUMO_ATTR_VALUE));
+    det->loadState(state);
+    if (state.fail()) {
+        throw ProcessError("Could not load the state of detector '" + id + "'.");
+    }
+}
+
+
 void
 MSDetectorControl::writeOutput(SUMOTime step, bool closing) {
     for (Intervals::iterator i = myIntervals.begin(); i != myIntervals.end(); ++i) {
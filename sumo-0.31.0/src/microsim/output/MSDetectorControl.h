@@ -48,6 +48,7 @@
 // class declarations
 // ===========================================================================
 class MSMeanData;
+class SUMOSAXAttributes;
 
 
 // ===========================================================================
@@ -185,6 +186,33 @@ public:
     void writeOutput(SUMOTime step, bool closing);
 
 
+    /** @brief Forgets all vehicles and collected values of all detectors
+     *
+     * Called before quick-loading state.
+     * @see MSDetectorFileOutput::clearState
+     */
+    void clearState();
+
+
+    /** @brief Saves the last output times of the intervals and the state of all detectors
+     *
+     * Used for in-memory snapshots only (detectors are identified by their ids).
+     * @param[in] out The device to write the state into
+     * @see MSDetectorFileOutput::saveState
+     */
+    void saveState(OutputDevice& out) const;
+
+
+    /** @brief Loads the saved state of an interval or of a detector
+     *
+     * Elements without an id describe an interval, elements without a type
+     *  belong to mean data.
+     * @param[in] attrs The attributes of the detector state element
+     * @exception ProcessError If the detector is not known or its state could not be read
+     */
+    void loadState(const SUMOSAXAttributes& attrs);
+
+
 protected:
     /// @name Structures needed for assigning detectors to intervals
     /// @{
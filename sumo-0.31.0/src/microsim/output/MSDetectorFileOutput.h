@@ -35,6 +35,7 @@
 
 #include <string>
 #include <set>
+#include <iostream>
 
 #include <utils/common/Named.h>
 #include <utils/common/SUMOTime.h>
@@ -119,6 +120,36 @@ public:
     virtual void reset() { }
 
 
+    /** @brief Forgets all vehicles and collected values before quick-loading state
+     *
+     * Called when the state of the simulation is replaced (the vehicles are deleted afterwards)
+     */
+    virtual void clearState() { }
+
+
+    /** @brief Writes the vehicles on the detector and the collected values
+     *
+     * Used for in-memory snapshots. Vehicles are referenced by their ids,
+     *  doubles are written with the precision of the given stream.
+     *
+     * @param[in] into The stream to write the state into
+     */
+    virtual void saveState(std::ostream& into) const {
+        UNUSED_PARAMETER(into);
+    }
+
+
+    /** @brief Replaces the vehicles on the detector and the collected values by the saved ones
+     *
+     * Called after the vehicles of the snapshot were put on their lanes.
+     *
+     * @param[in] from The stream written by saveState
+     */
+    virtual void loadState(std::istream& from) {
+        UNUSED_PARAMETER(from);
+    }
+
+
     /** @brief Updates the detector (computes values)
      *
      * @param[in] step The current time step
@@ -292,9 +292,10 @@ MSE2Collector::recalculateDetectorLength() {
 
 MSE2Collector::~MSE2Collector() {
     // clear move notifications
-    for (std::vector<MoveNotificationInfo*>::iterator j = myMoveNotifications.begin(); j != myMoveNotifications.end(); ++j) {
+    for (std::vector<MoveNotificationInfo*>::iterator j = myMoveNotificationPool.begin(); j != myMoveNotificationPool.end(); ++j) {
         delete *j;
     }
+    myMoveNotificationPool.clear();
     myMoveNotifications.clear();
 
     // clear vehicle infos
@@ -776,8 +777,7 @@ MSE2Collector::detectorUpdate(const SUMOTime /* step */) {
 
     JamInfo* currentJam = 0;
     std::vector<JamInfo*> jams;
-    std::map<std::string, SUMOTime> haltingVehicles;
-    std::map<std::string, SUMOTime> intervalHaltingVehicles;
+    myNextHaltingVehicles.clear();
 
     // go through the list of vehicles positioned on the detector
     for (std::vector<MoveNotificationInfo*>::iterator i = myMoveNotifications.begin(); i != myMoveNotifications.end(); ++i) {
@@ -793,7 +793,7 @@ MSE2Collector::detectorUpdate(const SUMOTime /* step */) {
             integrateMoveNotification(vi->second, *i);
         }
         // construct jam structure
-        bool isInJam = checkJam(i, haltingVehicles, intervalHaltingVehicles);
+        bool isInJam = checkJam(i, myNextHaltingVehicles);
         buildJam(isInJam, i, currentJam, jams);
     }
 
@@ -804,8 +804,8 @@ MSE2Collector::detectorUpdate(const SUMOTime /* step */) {
     aggregateOutputValues();
 
     // save information about halting vehicles
-    myHaltingVehicleDurations = haltingVehicles;
-    myIntervalHaltingVehicleDurations = intervalHaltingVehicles;
+    std::sort(myNextHaltingVehicles.begin(), myNextHaltingVehicles.end(), sortHaltingInfo);
+    myHaltingVehicles.swap(myNextHaltingVehicles);
 
 #ifdef DEBUG_E2_DETECTOR_UPDATE
     std::cout << "\n" << SIMTIME << " Current lanes for vehicles still on the detector:" << std::endl;
@@ -836,10 +836,7 @@ MSE2Collector::detectorUpdate(const SUMOTime /* step */) {
     }
     myLeftVehicles.clear();
 
-    // reset move notifications
-    for (std::vector<MoveNotificationInfo*>::iterator j = myMoveNotifications.begin(); j != myMoveNotifications.end(); ++j) {
-        delete *j;
-    }
+    // reset move notifications (they are kept in myMoveNotificationPool)
     myMoveNotifications.clear();
 }
 
@@ -903,7 +900,7 @@ MSE2Collector::integrateMoveNotification(VehicleInfo* vi, const MoveNotification
 
 
 MSE2Collector::MoveNotificationInfo*
-MSE2Collector::makeMoveNotification(const SUMOVehicle& veh, double oldPos, double newPos, double newSpeed, const VehicleInfo& vehInfo) const {
+MSE2Collector::makeMoveNotification(const SUMOVehicle& veh, double oldPos, double newPos, double newSpeed, const VehicleInfo& vehInfo) {
 #ifdef DEBUG_E2_NOTIFY_MOVE
     std::cout << SIMTIME << " makeMoveNotification() for vehicle '" << veh.getID() << "'"
               << " oldPos = " << oldPos << " newPos = " << newPos << " newSpeed = " << newSpeed
@@ -939,7 +936,21 @@ MSE2Collector::makeMoveNotification(const SUMOVehicle& veh, double oldPos, doubl
 #endif
 
     /* Store new infos */
-    return new MoveNotificationInfo(veh.getID(), oldPos, newPos, newSpeed, veh.getAcceleration(), myDetectorLength - (vehInfo.entryOffset + newPos), timeOnDetector, lengthOnDetector, timeLoss, stillOnDetector);
+    if (myMoveNotifications.size() == myMoveNotificationPool.size()) {
+        myMoveNotificationPool.push_back(new MoveNotificationInfo());
+    }
+    MoveNotificationInfo* mni = myMoveNotificationPool[myMoveNotifications.size()];
+    mni->id = veh.getID();
+    mni->oldPos = oldPos;
+    mni->newPos = newPos;
+    mni->speed = newSpeed;
+    mni->accel = veh.getAcceleration();
+    mni->distToDetectorEnd = myDetectorLength - (vehInfo.entryOffset + newPos);
+    mni->timeOnDetector = timeOnDetector;
+    mni->lengthOnDetector = lengthOnDetector;
+    mni->timeLoss = timeLoss;
+    mni->onDetector = stillOnDetector;
+    return mni;
 }
 
 void
@@ -990,47 +1001,39 @@ MSE2Collector::buildJam(bool isInJam, std::vector<MoveNotificationInfo*>::const_
 
 
 bool
-MSE2Collector::checkJam(std::vector<MoveNotificationInfo*>::const_iterator mni, std::map<std::string, SUMOTime>& haltingVehicles, std::map<std::string, SUMOTime>& intervalHaltingVehicles) {
+MSE2Collector::checkJam(std::vector<MoveNotificationInfo*>::const_iterator mni, std::vector<HaltingInfo>& haltingVehicles) {
 #ifdef DEBUG_E2_JAMS
     std::cout << SIMTIME << " CheckJam() for vehicle '" << (*mni)->id << "'" << std::endl;
 #endif
     // jam-checking begins
     bool isInJam = false;
+    // look up whether the vehicle was halting in the last step
+    std::vector<HaltingInfo>::iterator v = std::lower_bound(myHaltingVehicles.begin(), myHaltingVehicles.end(), (*mni)->id, compareHaltingInfo);
+    const bool wasHalting = v != myHaltingVehicles.end() && v->id == (*mni)->id;
     // first, check whether the vehicle is slow enough to be counted as halting
     if ((*mni)->speed < myJamHaltingSpeedThreshold) {
         myCurrentHaltingsNumber++;
         // we have to track the time it was halting;
         // so let's look up whether it was halting before and compute the overall halting time
-        bool wasHalting = myHaltingVehicleDurations.count((*mni)->id) > 0;
         if (wasHalting) {
-            haltingVehicles[(*mni)->id] = myHaltingVehicleDurations[(*mni)->id] + DELTA_T;
-            intervalHaltingVehicles[(*mni)->id] = myIntervalHaltingVehicleDurations[(*mni)->id] + DELTA_T;
+            haltingVehicles.push_back(HaltingInfo((*mni)->id, v->duration + DELTA_T, v->intervalDuration + DELTA_T));
         } else {
 #ifdef DEBUG_E2_JAMS
             std::cout << SIMTIME << " vehicle '" << (*mni)->id << "' starts halting." << std::endl;
 #endif
-            haltingVehicles[(*mni)->id] = DELTA_T;
-            intervalHaltingVehicles[(*mni)->id] = DELTA_T;
+            haltingVehicles.push_back(HaltingInfo((*mni)->id, DELTA_T, DELTA_T));
             myCurrentStartedHalts++;
             myStartedHalts++;
         }
         // we now check whether the halting time is large enough
-        if (haltingVehicles[(*mni)->id] > myJamHaltingTimeThreshold) {
+        if (haltingVehicles.back().duration > myJamHaltingTimeThreshold) {
             // yep --> the vehicle is a part of a jam
             isInJam = true;
         }
-    } else {
+    } else if (wasHalting) {
         // is not standing anymore; keep duration information
-        std::map<std::string, SUMOTime>::iterator v = myHaltingVehicleDurations.find((*mni)->id);
-        if (v != myHaltingVehicleDurations.end()) {
-            myPastStandingDurations.push_back(v->second);
-            myHaltingVehicleDurations.erase(v);
-        }
-        v = myIntervalHaltingVehicleDurations.find((*mni)->id);
-        if (v != myIntervalHaltingVehicleDurations.end()) {
-            myPastIntervalStandingDurations.push_back((*v).second);
-            myIntervalHaltingVehicleDurations.erase(v);
-        }
+        myPastStandingDurations.push_back(v->duration);
+        myPastIntervalStandingDurations.push_back(v->intervalDuration);
     }
 #ifdef DEBUG_E2_JAMS
     std::cout << SIMTIME << " vehicle '" << (*mni)->id << "'" << (isInJam ? "is jammed." : "is not jammed.") << std::endl;
@@ -1169,9 +1172,9 @@ MSE2Collector::writeXMLOutput(OutputDevice& dev, SUMOTime startTime, SUMOTime st
         maxHaltingDuration = MAX2(maxHaltingDuration, (*i));
         haltingNo++;
     }
-    for (std::map<std::string, SUMOTime> ::iterator i = myHaltingVehicleDurations.begin(); i != myHaltingVehicleDurations.end(); ++i) {
-        haltingDurationSum += (*i).second;
-        maxHaltingDuration = MAX2(maxHaltingDuration, (*i).second);
+    for (std::vector<HaltingInfo>::iterator i = myHaltingVehicles.begin(); i != myHaltingVehicles.end(); ++i) {
+        haltingDurationSum += i->duration;
+        maxHaltingDuration = MAX2(maxHaltingDuration, i->duration);
         haltingNo++;
     }
     const SUMOTime meanHaltingDuration = haltingNo != 0 ? haltingDurationSum / haltingNo : 0;
@@ -1184,9 +1187,9 @@ MSE2Collector::writeXMLOutput(OutputDevice& dev, SUMOTime startTime, SUMOTime st
         intervalMaxHaltingDuration = MAX2(intervalMaxHaltingDuration, (*i));
         intervalHaltingNo++;
     }
-    for (std::map<std::string, SUMOTime> ::iterator i = myIntervalHaltingVehicleDurations.begin(); i != myIntervalHaltingVehicleDurations.end(); ++i) {
-        intervalHaltingDurationSum += (*i).second;
-        intervalMaxHaltingDuration = MAX2(intervalMaxHaltingDuration, (*i).second);
+    for (std::vector<HaltingInfo>::iterator i = myHaltingVehicles.begin(); i != myHaltingVehicles.end(); ++i) {
+        intervalHaltingDurationSum += i->intervalDuration;
+        intervalMaxHaltingDuration = MAX2(intervalMaxHaltingDuration, i->intervalDuration);
         intervalHaltingNo++;
     }
     const SUMOTime intervalMeanHaltingDuration = intervalHaltingNo != 0 ? intervalHaltingDurationSum / intervalHaltingNo : 0;
@@ -1252,14 +1255,126 @@ MSE2Collector::reset() {
     myMaxJamInMeters = 0;
     myTimeSamples = 0;
     myMeanVehicleNumber = 0;
-    for (std::map<std::string, SUMOTime>::iterator i = myIntervalHaltingVehicleDurations.begin(); i != myIntervalHaltingVehicleDurations.end(); ++i) {
-        (*i).second = 0;
+    for (std::vector<HaltingInfo>::iterator i = myHaltingVehicles.begin(); i != myHaltingVehicles.end(); ++i) {
+        i->intervalDuration = 0;
     }
     myPastStandingDurations.clear();
     myPastIntervalStandingDurations.clear();
 }
 
 
+void
+MSE2Collector::clearState() {
+    myMoveNotifications.clear();
+    for (VehicleInfoMap::iterator j = myVehicleInfos.begin(); j != myVehicleInfos.end(); ++j) {
+        delete j->second;
+    }
+    myVehicleInfos.clear();
+    myLeftVehicles.clear();
+    myHaltingVehicles.clear();
+    myNumberOfSeenVehicles = 0;
+    myNumberOfLeftVehicles = 0;
+    reset();
+    myCurrentOccupancy = 0;
+    myCurrentMeanSpeed = -1;
+    myCurrentMeanLength = -1;
+    myCurrentJamNo = 0;
+    myCurrentMaxJamLengthInMeters = 0;
+    myCurrentMaxJamLengthInVehicles = 0;
+    myCurrentJamLengthInMeters = 0;
+    myCurrentJamLengthInVehicles = 0;
+    myCurrentStartedHalts = 0;
+    myCurrentHaltingsNumber = 0;
+}
+
+
+void
+MSE2Collector::saveState(std::ostream& into) const {
+    into << myVehicleSamples << " " << myTotalTimeLoss << " " << mySpeedSum << " " << myStartedHalts
+         << " " << myJamLengthInMetersSum << " " << myJamLengthInVehiclesSum << " " << myTimeSamples
+         << " " << myOccupancySum << " " << myMaxOccupancy << " " << myMeanMaxJamInVehicles
+         << " " << myMeanMaxJamInMeters << " " << myMaxJamInVehicles << " " << myMaxJamInMeters
+         << " " << myMeanVehicleNumber << " " << myNumberOfEnteredVehicles << " " << myNumberOfSeenVehicles
+         << " " << myNumberOfLeftVehicles << " " << myMaxVehicleNumber << " " << myCurrentOccupancy
+         << " " << myCurrentMeanSpeed << " " << myCurrentMeanLength << " " << myCurrentJamNo
+         << " " << myCurrentMaxJamLengthInMeters << " " << myCurrentMaxJamLengthInVehicles
+         << " " << myCurrentJamLengthInMeters << " " << myCurrentJamLengthInVehicles
+         << " " << myCurrentStartedHalts << " " << myCurrentHaltingsNumber;
+    into << " " << myVehicleInfos.size();
+    for (VehicleInfoMap::const_iterator i = myVehicleInfos.begin(); i != myVehicleInfos.end(); ++i) {
+        const VehicleInfo& vi = *i->second;
+        into << " " << vi.id << " " << vi.type << " " << vi.length << " " << vi.minGap
+             << " " << vi.entryLaneID << " " << vi.entryOffset << " " << vi.currentLane->getID()
+             << " " << vi.currentOffsetIndex << " " << vi.exitOffset << " " << vi.distToDetectorEnd
+             << " " << vi.totalTimeOnDetector << " " << vi.accumulatedTimeLoss << " " << vi.onDetector
+             << " " << vi.hasEntered << " " << vi.lastAccel << " " << vi.lastSpeed << " " << vi.lastPos;
+    }
+    into << " " << myHaltingVehicles.size();
+    for (std::vector<HaltingInfo>::const_iterator i = myHaltingVehicles.begin(); i != myHaltingVehicles.end(); ++i) {
+        into << " " << i->id << " " << i->duration << " " << i->intervalDuration;
+    }
+    const std::vector<SUMOTime>* const durations[] = {&myPastStandingDurations, &myPastIntervalStandingDurations};
+    for (int i = 0; i < 2; i++) {
+        into << " " << durations[i]->size();
+        for (std::vector<SUMOTime>::const_iterator j = durations[i]->begin(); j != durations[i]->end(); ++j) {
+            into << " " << *j;
+        }
+    }
+}
+
+
+void
+MSE2Collector::loadState(std::istream& from) {
+    clearState();
+    from >> myVehicleSamples >> myTotalTimeLoss >> mySpeedSum >> myStartedHalts
+         >> myJamLengthInMetersSum >> myJamLengthInVehiclesSum >> myTimeSamples
+         >> myOccupancySum >> myMaxOccupancy >> myMeanMaxJamInVehicles
+         >> myMeanMaxJamInMeters >> myMaxJamInVehicles >> myMaxJamInMeters
+         >> myMeanVehicleNumber >> myNumberOfEnteredVehicles >> myNumberOfSeenVehicles
+         >> myNumberOfLeftVehicles >> myMaxVehicleNumber >> myCurrentOccupancy
+         >> myCurrentMeanSpeed >> myCurrentMeanLength >> myCurrentJamNo
+         >> myCurrentMaxJamLengthInMeters >> myCurrentMaxJamLengthInVehicles
+         >> myCurrentJamLengthInMeters >> myCurrentJamLengthInVehicles
+         >> myCurrentStartedHalts >> myCurrentHaltingsNumber;
+    int size = 0;
+    from >> size;
+    for (int i = 0; i < size && from; i++) {
+        std::string id, type, entryLaneID, currentLaneID;
+        double length, minGap, entryOffset, exitOffset, distToDetectorEnd;
+        std::size_t currentOffsetIndex;
+        from >> id >> type >> length >> minGap >> entryLaneID >> entryOffset >> currentLaneID
+             >> currentOffsetIndex >> exitOffset >> distToDetectorEnd;
+        const MSLane* const entryLane = MSLane::dictionary(entryLaneID);
+        const MSLane* const currentLane = MSLane::dictionary(currentLaneID);
+        if (entryLane == 0 || currentLane == 0) {
+            from.setstate(std::ios::failbit);
+            break;
+        }
+        VehicleInfo* vi = new VehicleInfo(id, type, length, minGap, entryLane, entryOffset, currentOffsetIndex, exitOffset, distToDetectorEnd, false);
+        vi->currentLane = currentLane;
+        from >> vi->totalTimeOnDetector >> vi->accumulatedTimeLoss >> vi->onDetector
+             >> vi->hasEntered >> vi->lastAccel >> vi->lastSpeed >> vi->lastPos;
+        myVehicleInfos[id] = vi;
+    }
+    from >> size;
+    for (int i = 0; i < size && from; i++) {
+        std::string id;
+        SUMOTime duration, intervalDuration;
+        from >> id >> duration >> intervalDuration;
+        myHaltingVehicles.push_back(HaltingInfo(id, duration, intervalDuration));
+    }
+    std::vector<SUMOTime>* const durations[] = {&myPastStandingDurations, &myPastIntervalStandingDurations};
+    for (int i = 0; i < 2; i++) {
+        from >> size;
+        for (int j = 0; j < size && from; j++) {
+            SUMOTime duration;
+            from >> duration;
+            durations[i]->push_back(duration);
+        }
+    }
+}
+
+
 int
 MSE2Collector::getCurrentVehicleNumber() const {
     int result = 0;
@@ -163,22 +163,10 @@ private:
     /** @brief Values collected in notifyMove and needed in detectorUpdate() to
      *          calculate the accumulated quantities for the detector. These are
      *          temporarily stored in myMoveNotifications for each step.
+     *
+     * The instances are owned by myMoveNotificationPool and reused in each step.
     */
     struct MoveNotificationInfo {
-        MoveNotificationInfo(std::string _vehID, double _oldPos, double _newPos, double _speed, double _accel, double _distToDetectorEnd, double _timeOnDetector, double _lengthOnDetector, double _timeLoss, bool _onDetector) :
-            id(_vehID),
-            oldPos(_oldPos),
-            newPos(_newPos),
-            speed(_speed),
-            accel(_accel),
-            distToDetectorEnd(_distToDetectorEnd),
-            timeOnDetector(_timeOnDetector),
-            lengthOnDetector(_lengthOnDetector),
-            timeLoss(_timeLoss),
-            onDetector(_onDetector) {}
-
-        virtual ~MoveNotificationInfo() {};
-
         /// Vehicle's id
         std::string id;
         /// Position before the last integration step (relative to the vehicle's entry lane on the detector)
@@ -202,6 +190,29 @@ private:
     };
 
 
+    /** @brief The halting durations of a vehicle on the detector
+     *
+     * These are kept in a vector sorted by the vehicle id which is rebuilt in each step.
+     * The vector memory is reused but each entry copies the vehicle id, which allocates
+     * for ids not fitting into the small string buffer. Vehicles have no numerical id
+     * in this version and their addresses may be reused by vehicles inserted in the
+     * same step, so neither can serve as the key.
+     */
+    struct HaltingInfo {
+        HaltingInfo(const std::string& _vehID, SUMOTime _duration, SUMOTime _intervalDuration) :
+            id(_vehID),
+            duration(_duration),
+            intervalDuration(_intervalDuration) {}
+
+        /// Vehicle's id
+        std::string id;
+        /// The duration of the current halt
+        SUMOTime duration;
+        /// The duration of the current halt within the current interval
+        SUMOTime intervalDuration;
+    };
+
+
 
     /** @brief Internal representation of a jam
      *
@@ -416,6 +427,24 @@ public:
     virtual void reset();
 
 
+    /** @brief Forgets all vehicles and collected values
+     * @see MSDetectorFileOutput::clearState
+     */
+    void clearState();
+
+
+    /** @brief Writes the vehicles on the detector and the collected values
+     * @see MSDetectorFileOutput::saveState
+     */
+    void saveState(std::ostream& into) const;
+
+
+    /** @brief Replaces the vehicles on the detector and the collected values by the saved ones
+     * @see MSDetectorFileOutput::loadState
+     */
+    void loadState(std::istream& from);
+
+
     /// @name Methods returning current values
     /// @{
 
@@ -530,7 +559,7 @@ private:
      * @param[in/out] intervalHaltingVehicles
      * @return Whether vehicle is in a jam.
      */
-    bool checkJam(std::vector<MoveNotificationInfo*>::const_iterator mni, std::map<std::string, SUMOTime>& haltingVehicles, std::map<std::string, SUMOTime>& intervalHaltingVehicles);
+    bool checkJam(std::vector<MoveNotificationInfo*>::const_iterator mni, std::vector<HaltingInfo>& haltingVehicles);
 
 
     /** @brief Either adds the vehicle to the end of an existing jam, or closes the last jam, and/or creates a new jam
@@ -620,7 +649,7 @@ private:
      * @param vehInfo Info on the detector's memory of the vehicle
      * @return A MoveNotificationInfo containing quantities of interest for the detector
      */
-    MoveNotificationInfo* makeMoveNotification(const SUMOVehicle& veh, double oldPos, double newPos, double newSpeed, const VehicleInfo& vehInfo) const;
+    MoveNotificationInfo* makeMoveNotification(const SUMOVehicle& veh, double oldPos, double newPos, double newSpeed, const VehicleInfo& vehInfo);
 
     /** @brief Creates and returns a VehicleInfo (called at the vehicle's entry)
      *
@@ -646,6 +675,18 @@ private:
         return mni1->distToDetectorEnd < mni2->distToDetectorEnd;
     }
 
+    /** brief returns true if the halting information hi belongs to a vehicle with an id before the given one
+     */
+    static bool compareHaltingInfo(const HaltingInfo& hi, const std::string& vehID) {
+        return hi.id < vehID;
+    }
+
+    /** brief returns true if hi1 belongs to a vehicle with an id before the one of hi2
+     */
+    static bool sortHaltingInfo(const HaltingInfo& hi1, const HaltingInfo& hi2) {
+        return hi1.id < hi2.id;
+    }
+
 
 private:
 
@@ -687,16 +728,19 @@ private:
     ///        detector's notifyMove() in the last time step.
     std::vector<MoveNotificationInfo*> myMoveNotifications;
 
+    /// @brief All allocated move notifications, the first myMoveNotifications.size() are in use
+    std::vector<MoveNotificationInfo*> myMoveNotificationPool;
+
     /// @brief Keep track of vehicles that left the detector by a regular move along a junction (not lanechange, teleport, etc.)
     ///        and should be removed from myVehicleInfos after taking into account their movement. Non-longitudinal exits
     ///        are processed immediately in notifyLeave()
     std::set<std::string> myLeftVehicles;
 
-    /// @brief Storage for halting durations of known vehicles (for halting vehicles)
-    std::map<std::string, SUMOTime> myHaltingVehicleDurations;
+    /// @brief Storage for halting durations of known vehicles (for halting vehicles, sorted by id)
+    std::vector<HaltingInfo> myHaltingVehicles;
 
-    /// @brief Storage for halting durations of known vehicles (current interval)
-    std::map<std::string, SUMOTime> myIntervalHaltingVehicleDurations;
+    /// @brief The halting vehicles of the current step (swapped with myHaltingVehicles to reuse the vector memory, the ids are copied)
+    std::vector<HaltingInfo> myNextHaltingVehicles;
 
     /// @brief Halting durations of ended halts [s]
     std::vector<SUMOTime> myPastStandingDurations;
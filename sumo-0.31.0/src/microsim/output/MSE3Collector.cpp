@@ -35,6 +35,7 @@
 
 #include "MSE3Collector.h"
 #include <microsim/MSNet.h>
+#include <microsim/MSVehicleControl.h>
 #include <microsim/MSVehicle.h>
 
 
@@ -173,6 +174,74 @@ MSE3Collector::reset() {
 }
 
 
+void
+MSE3Collector::clearState() {
+    myEnteredContainer.clear();
+    myLeftContainer.clear();
+    myCurrentMeanSpeed = 0;
+    myCurrentHaltingsNumber = 0;
+}
+
+
+void
+MSE3Collector::saveState(std::ostream& into) const {
+    into << myCurrentMeanSpeed << " " << myCurrentHaltingsNumber << " " << myLastResetTime;
+    into << " " << myEnteredContainer.size();
+    for (std::map<const SUMOVehicle*, E3Values>::const_iterator i = myEnteredContainer.begin(); i != myEnteredContainer.end(); ++i) {
+        into << " " << i->first->getID();
+        saveValues(into, i->second);
+    }
+    into << " " << myLeftContainer.size();
+    for (std::map<std::string, E3Values>::const_iterator i = myLeftContainer.begin(); i != myLeftContainer.end(); ++i) {
+        into << " " << i->first;
+        saveValues(into, i->second);
+    }
+}
+
+
+void
+MSE3Collector::loadState(std::istream& from) {
+    clearState();
+    from >> myCurrentMeanSpeed >> myCurrentHaltingsNumber >> myLastResetTime;
+    int size = 0;
+    from >> size;
+    for (int i = 0; i < size && from; i++) {
+        std::string id;
+        E3Values values;
+        from >> id;
+        loadValues(from, values);
+        const SUMOVehicle* const veh = MSNet::getInstance()->getVehicleControl().getVehicle(id);
+        if (veh != 0) {
+            myEnteredContainer[veh] = values;
+        }
+    }
+    from >> size;
+    for (int i = 0; i < size && from; i++) {
+        std::string id;
+        from >> id;
+        loadValues(from, myLeftContainer[id]);
+    }
+}
+
+
+void
+MSE3Collector::saveValues(std::ostream& into, const E3Values& values) {
+    into << " " << values.entryTime << " " << values.frontLeaveTime << " " << values.backLeaveTime
+         << " " << values.speedSum << " " << values.haltings << " " << values.haltingBegin
+         << " " << values.intervalSpeedSum << " " << values.intervalHaltings
+         << " " << values.timeLoss << " " << values.intervalTimeLoss << " " << values.hadUpdate;
+}
+
+
+void
+MSE3Collector::loadValues(std::istream& from, E3Values& values) {
+    from >> values.entryTime >> values.frontLeaveTime >> values.backLeaveTime
+         >> values.speedSum >> values.haltings >> values.haltingBegin
+         >> values.intervalSpeedSum >> values.intervalHaltings
+         >> values.timeLoss >> values.intervalTimeLoss >> values.hadUpdate;
+}
+
+
 
 void
 MSE3Collector::enter(const SUMOVehicle& veh, const double entryTimestep, const double fractionTimeOnDet) {
@@ -234,7 +303,7 @@ MSE3Collector::leave(const SUMOVehicle& veh, const double leaveTimestep, const d
             values.timeLoss = static_cast<const MSVehicle&>(veh).getTimeLoss() - values.timeLoss;
         }
         myEnteredContainer.erase(&veh);
-        myLeftContainer[&veh] = values;
+        myLeftContainer[veh.getID()] = values;
     }
 }
 
@@ -250,7 +319,7 @@ MSE3Collector::writeXMLOutput(OutputDevice& dev,
     double meanSpeed = 0.;
     double meanHaltsPerVehicle = 0.;
     double meanTimeLoss = 0.;
-    for (std::map<const SUMOVehicle*, E3Values>::iterator i = myLeftContainer.begin(); i != myLeftContainer.end(); ++i) {
+    for (std::map<std::string, E3Values>::iterator i = myLeftContainer.begin(); i != myLeftContainer.end(); ++i) {
         meanHaltsPerVehicle += (double)(*i).second.haltings;
         meanTravelTime += (*i).second.frontLeaveTime - (*i).second.entryTime;
         const double steps = (*i).second.backLeaveTime - (*i).second.entryTime;
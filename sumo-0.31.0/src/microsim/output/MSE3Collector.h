@@ -221,6 +221,24 @@ public:
     void reset();
 
 
+    /** @brief Forgets all vehicles and collected values
+     * @see MSDetectorFileOutput::clearState
+     */
+    void clearState();
+
+
+    /** @brief Writes the vehicles within the area and the collected values
+     * @see MSDetectorFileOutput::saveState
+     */
+    void saveState(std::ostream& into) const;
+
+
+    /** @brief Replaces the vehicles within the area and the collected values by the saved ones
+     * @see MSDetectorFileOutput::loadState
+     */
+    void loadState(std::istream& from);
+
+
     /** @brief Called if a vehicle touches an entry-cross-section.
      *
      * Inserts vehicle into internal containers.
@@ -377,11 +395,17 @@ protected:
         bool hadUpdate;
     };
 
+    /// @brief Writes the given values of a vehicle (see saveState)
+    static void saveValues(std::ostream& into, const E3Values& values);
+
+    /// @brief Reads the values of a vehicle written by saveValues
+    static void loadValues(std::istream& from, E3Values& values);
+
     /// @brief Container for vehicles that have entered the area
     std::map<const SUMOVehicle*, E3Values> myEnteredContainer;
 
-    /// @brief Container for vehicles that have left the area
-    std::map<const SUMOVehicle*, E3Values> myLeftContainer;
+    /// @brief Container for vehicles that have left the area (by id since they may have left the network)
+    std::map<std::string, E3Values> myLeftContainer;
 
 
     /// @name Storages for current values
@@ -49,7 +49,7 @@ MSEmissionExport::write(OutputDevice& of, SUMOTime timestep, int precision) {
     of.openTag("timestep").writeAttr("time", time2string(timestep));
     of.setPrecision(precision);
     MSVehicleControl& vc = MSNet::getInstance()->getVehicleControl();
-    for (MSVehicleControl::constVehIt it = vc.loadedVehBegin(); it != vc.loadedVehEnd(); ++it) {
+    for (MSVehicleControl::constVehIt it = vc.runningVehBegin(); it != vc.runningVehEnd(); ++it) {
         const SUMOVehicle* veh = it->second;
         const MSVehicle* microVeh = dynamic_cast<const MSVehicle*>(veh);
         if (veh->isOnRoad()) {
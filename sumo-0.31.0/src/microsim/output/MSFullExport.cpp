@@ -65,7 +65,7 @@ void
 MSFullExport::writeVehicles(OutputDevice& of) {
     of.openTag("vehicles");
     MSVehicleControl& vc = MSNet::getInstance()->getVehicleControl();
-    for (MSVehicleControl::constVehIt it = vc.loadedVehBegin(); it != vc.loadedVehEnd(); ++it) {
+    for (MSVehicleControl::constVehIt it = vc.runningVehBegin(); it != vc.runningVehEnd(); ++it) {
         const SUMOVehicle* veh = it->second;
         const MSVehicle* microVeh = dynamic_cast<const MSVehicle*>(veh);
         if (veh->isOnRoad()) {
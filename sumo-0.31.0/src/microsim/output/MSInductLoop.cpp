@@ -43,6 +43,7 @@
 #include <microsim/MSLane.h>
 #include <microsim/MSVehicle.h>
 #include <microsim/MSNet.h>
+#include <microsim/MSVehicleControl.h>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/UtilExceptions.h>
 #include <utils/common/StringUtils.h>
@@ -79,6 +80,62 @@ MSInductLoop::reset() {
 }
 
 
+void
+MSInductLoop::clearState() {
+    myEnteredVehicleNumber = 0;
+    myLastOccupancy = 0;
+    myLastVehicleDataCont.clear();
+    myVehicleDataCont.clear();
+    myVehiclesOnDet.clear();
+}
+
+
+void
+MSInductLoop::saveState(std::ostream& into) const {
+    into << myLastLeaveTime << " " << myLastOccupancy << " " << myEnteredVehicleNumber;
+    const VehicleDataCont* const conts[] = {&myVehicleDataCont, &myLastVehicleDataCont};
+    for (int i = 0; i < 2; i++) {
+        into << " " << conts[i]->size();
+        for (VehicleDataCont::const_iterator j = conts[i]->begin(); j != conts[i]->end(); ++j) {
+            into << " " << j->idM << " " << j->lengthM << " " << j->entryTimeM << " " << j->leaveTimeM << " " << j->typeIDM;
+        }
+    }
+    into << " " << myVehiclesOnDet.size();
+    for (VehicleMap::const_iterator i = myVehiclesOnDet.begin(); i != myVehiclesOnDet.end(); ++i) {
+        into << " " << i->first->getID() << " " << i->second;
+    }
+}
+
+
+void
+MSInductLoop::loadState(std::istream& from) {
+    clearState();
+    from >> myLastLeaveTime >> myLastOccupancy >> myEnteredVehicleNumber;
+    VehicleDataCont* const conts[] = {&myVehicleDataCont, &myLastVehicleDataCont};
+    for (int i = 0; i < 2; i++) {
+        int size = 0;
+        from >> size;
+        for (int j = 0; j < size && from; j++) {
+            std::string id, typeID;
+            double length, entryTime, leaveTime;
+            from >> id >> length >> entryTime >> leaveTime >> typeID;
+            conts[i]->push_back(VehicleData(id, length, entryTime, leaveTime, typeID));
+        }
+    }
+    int size = 0;
+    from >> size;
+    for (int i = 0; i < size && from; i++) {
+        std::string id;
+        double entryTime;
+        from >> id >> entryTime;
+        SUMOVehicle* const veh = MSNet::getInstance()->getVehicleControl().getVehicle(id);
+        if (veh != 0) {
+            myVehiclesOnDet[veh] = entryTime;
+        }
+    }
+}
+
+
 bool
 MSInductLoop::notifyEnter(SUMOVehicle& veh, Notification reason, const MSLane* /* enteredLane */) {
     if (!vehicleApplies(veh)) {
@@ -95,6 +95,24 @@ public:
     virtual void reset();
 
 
+    /** @brief Forgets all vehicles and collected values
+     * @see MSDetectorFileOutput::clearState
+     */
+    void clearState();
+
+
+    /** @brief Writes the vehicles on the detector and the collected values
+     * @see MSDetectorFileOutput::saveState
+     */
+    void saveState(std::ostream& into) const;
+
+
+    /** @brief Replaces the vehicles on the detector and the collected values by the saved ones
+     * @see MSDetectorFileOutput::loadState
+     */
+    void loadState(std::istream& from);
+
+
     /** @brief Returns the position of the detector on the lane
      * @return The detector's position in meters
      */
@@ -284,6 +284,18 @@ MSMeanData::MeanDataValues::getSamples() const {
 }
 
 
+void
+MSMeanData::MeanDataValues::saveState(std::ostream& into) const {
+    into << " " << sampleSeconds << " " << travelledDistance;
+}
+
+
+void
+MSMeanData::MeanDataValues::loadState(std::istream& from) {
+    from >> sampleSeconds >> travelledDistance;
+}
+
+
 // ---------------------------------------------------------------------------
 // MSMeanData::MeanDataValueTracker - methods
 // ---------------------------------------------------------------------------
@@ -650,5 +662,48 @@ MSMeanData::detectorUpdate(const SUMOTime step) {
 }
 
 
+void
+MSMeanData::saveState(std::ostream& into) const {
+    if (myTrackVehicles) {
+        return;
+    }
+    int numValues = 0;
+    for (std::vector<std::vector<MeanDataValues*> >::const_iterator i = myMeasures.begin(); i != myMeasures.end(); ++i) {
+        numValues += (int)i->size();
+    }
+    into << numValues;
+    for (std::vector<std::vector<MeanDataValues*> >::const_iterator i = myMeasures.begin(); i != myMeasures.end(); ++i) {
+        for (std::vector<MeanDataValues*>::const_iterator j = i->begin(); j != i->end(); ++j) {
+            (*j)->saveState(into);
+        }
+    }
+}
+
+
+void
+MSMeanData::loadState(std::istream& from) {
+    if (myTrackVehicles) {
+        return;
+    }
+    int numValues = 0;
+    from >> numValues;
+    int currentValues = 0;
+    for (std::vector<std::vector<MeanDataValues*> >::const_iterator i = myMeasures.begin(); i != myMeasures.end(); ++i) {
+        for (std::vector<MeanDataValues*>::const_iterator j = i->begin(); j != i->end(); ++j) {
+            if (numValues == 0) {
+                // the state was saved before the data collection started
+                (*j)->reset();
+            } else {
+                (*j)->loadState(from);
+            }
+            currentValues++;
+        }
+    }
+    if (numValues != 0 && numValues != currentValues) {
+        from.setstate(std::ios::failbit);
+    }
+}
+
+
 /****************************************************************************/
 
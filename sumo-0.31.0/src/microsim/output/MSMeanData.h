@@ -144,6 +144,19 @@ public:
          */
         virtual void update();
 
+        /** @brief Writes the collected values
+         *
+         * @param[in] into The stream to write the values into
+         * @see MSDetectorFileOutput::saveState
+         */
+        virtual void saveState(std::ostream& into) const;
+
+        /** @brief Replaces the collected values by the ones written by saveState
+         *
+         * @param[in] from The stream to read the values from
+         */
+        virtual void loadState(std::istream& from);
+
         /** @brief Writes output values into the given stream
          *
          * @param[in] dev The output device to write the data into
@@ -357,6 +370,18 @@ public:
      */
     virtual void detectorUpdate(const SUMOTime step);
 
+    /** @brief Writes the collected values of all lanes / edges
+     *
+     * Not supported for tracked vehicles (their values are kept when loading).
+     * @see MSDetectorFileOutput::saveState
+     */
+    void saveState(std::ostream& into) const;
+
+    /** @brief Replaces the collected values of all lanes / edges by the saved ones
+     * @see MSDetectorFileOutput::loadState
+     */
+    void loadState(std::istream& from);
+
     double getMinSamples() const {
         return myMinSamples;
     }
@@ -32,7 +32,9 @@
 #include <microsim/MSEdgeControl.h>
 #include <microsim/MSEdge.h>
 #include <microsim/MSLane.h>
+#include <microsim/MSNet.h>
 #include <microsim/MSVehicle.h>
+#include <microsim/MSVehicleControl.h>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/ToString.h>
 #include <utils/iodevices/OutputDevice.h>
@@ -84,6 +86,50 @@ MSMeanData_Amitran::MSLaneMeanDataValues::addTo(MSMeanData::MeanDataValues& val)
 }
 
 
+void
+MSMeanData_Amitran::MSLaneMeanDataValues::saveState(std::ostream& into) const {
+    MSMeanData::MeanDataValues::saveState(into);
+    into << " " << amount << " " << typedAmount.size();
+    for (std::map<const MSVehicleType*, int>::const_iterator it = typedAmount.begin(); it != typedAmount.end(); ++it) {
+        into << " " << it->first->getID() << " " << it->second;
+    }
+    into << " " << typedSamples.size();
+    for (std::map<const MSVehicleType*, double>::const_iterator it = typedSamples.begin(); it != typedSamples.end(); ++it) {
+        into << " " << it->first->getID() << " " << it->second;
+    }
+    into << " " << typedTravelDistance.size();
+    for (std::map<const MSVehicleType*, double>::const_iterator it = typedTravelDistance.begin(); it != typedTravelDistance.end(); ++it) {
+        into << " " << it->first->getID() << " " << it->second;
+    }
+}
+
+
+void
+MSMeanData_Amitran::MSLaneMeanDataValues::loadState(std::istream& from) {
+    MSMeanData::MeanDataValues::loadState(from);
+    typedAmount.clear();
+    typedSamples.clear();
+    typedTravelDistance.clear();
+    MSVehicleControl& vc = MSNet::getInstance()->getVehicleControl();
+    int size = 0;
+    from >> amount >> size;
+    for (int i = 0; i < size && from; i++) {
+        std::string typeID;
+        from >> typeID;
+        from >> typedAmount[vc.getVType(typeID)];
+    }
+    std::map<const MSVehicleType*, double>* const typed[] = {&typedSamples, &typedTravelDistance};
+    for (int i = 0; i < 2; i++) {
+        from >> size;
+        for (int j = 0; j < size && from; j++) {
+            std::string typeID;
+            from >> typeID;
+            from >> (*typed[i])[vc.getVType(typeID)];
+        }
+    }
+}
+
+
 void
 MSMeanData_Amitran::MSLaneMeanDataValues::notifyMoveInternal(const SUMOVehicle& veh, const double /* frontOnLane */, const double timeOnLane, const double /*meanSpeedFrontOnLane*/, const double /*meanSpeedVehicleOnLane*/, const double /*travelledDistanceFrontOnLane*/, const double travelledDistanceVehicleOnLane, const double /* meanLengthOnLane */) {
     sampleSeconds += timeOnLane;
@@ -75,6 +75,22 @@ MSMeanData_Emissions::MSLaneMeanDataValues::addTo(MSMeanData::MeanDataValues& va
 }
 
 
+void
+MSMeanData_Emissions::MSLaneMeanDataValues::saveState(std::ostream& into) const {
+    MSMeanData::MeanDataValues::saveState(into);
+    into << " " << myEmissions.CO2 << " " << myEmissions.CO << " " << myEmissions.HC << " " << myEmissions.fuel
+         << " " << myEmissions.NOx << " " << myEmissions.PMx << " " << myEmissions.electricity;
+}
+
+
+void
+MSMeanData_Emissions::MSLaneMeanDataValues::loadState(std::istream& from) {
+    MSMeanData::MeanDataValues::loadState(from);
+    from >> myEmissions.CO2 >> myEmissions.CO >> myEmissions.HC >> myEmissions.fuel
+         >> myEmissions.NOx >> myEmissions.PMx >> myEmissions.electricity;
+}
+
+
 void
 MSMeanData_Emissions::MSLaneMeanDataValues::notifyMoveInternal(const SUMOVehicle& veh, const double /* frontOnLane */, const double timeOnLane, const double /*meanSpeedFrontOnLane*/, const double meanSpeedVehicleOnLane, const double /*travelledDistanceFrontOnLane*/, const double travelledDistanceVehicleOnLane, const double /* meanLengthOnLane */) {
     sampleSeconds += timeOnLane;
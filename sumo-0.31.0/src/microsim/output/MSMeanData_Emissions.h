@@ -90,6 +90,16 @@ public:
          */
         void addTo(MSMeanData::MeanDataValues& val) const;
 
+        /** @brief Writes the collected values
+         * @see MSMeanData::MeanDataValues::saveState
+         */
+        void saveState(std::ostream& into) const;
+
+        /** @brief Replaces the collected values by the ones written by saveState
+         * @see MSMeanData::MeanDataValues::loadState
+         */
+        void loadState(std::istream& from);
+
 
         /** @brief Writes output values into the given stream
          *
@@ -74,6 +74,20 @@ MSMeanData_Harmonoise::MSLaneMeanDataValues::addTo(MSMeanData::MeanDataValues& v
 }
 
 
+void
+MSMeanData_Harmonoise::MSLaneMeanDataValues::saveState(std::ostream& into) const {
+    MSMeanData::MeanDataValues::saveState(into);
+    into << " " << currentTimeN << " " << meanNTemp;
+}
+
+
+void
+MSMeanData_Harmonoise::MSLaneMeanDataValues::loadState(std::istream& from) {
+    MSMeanData::MeanDataValues::loadState(from);
+    from >> currentTimeN >> meanNTemp;
+}
+
+
 void
 MSMeanData_Harmonoise::MSLaneMeanDataValues::update() {
     meanNTemp += (double) pow(10., HelpersHarmonoise::sum(currentTimeN) / 10.);
@@ -122,6 +122,26 @@ MSMeanData_Net::MSLaneMeanDataValues::addTo(MSMeanData::MeanDataValues& val) con
 }
 
 
+void
+MSMeanData_Net::MSLaneMeanDataValues::saveState(std::ostream& into) const {
+    MSMeanData::MeanDataValues::saveState(into);
+    into << " " << nVehDeparted << " " << nVehArrived << " " << nVehEntered << " " << nVehLeft
+         << " " << nVehVaporized << " " << waitSeconds << " " << nVehLaneChangeFrom << " " << nVehLaneChangeTo
+         << " " << frontSampleSeconds << " " << frontTravelledDistance << " " << vehLengthSum
+         << " " << occupationSum << " " << minimalVehicleLength;
+}
+
+
+void
+MSMeanData_Net::MSLaneMeanDataValues::loadState(std::istream& from) {
+    MSMeanData::MeanDataValues::loadState(from);
+    from >> nVehDeparted >> nVehArrived >> nVehEntered >> nVehLeft
+         >> nVehVaporized >> waitSeconds >> nVehLaneChangeFrom >> nVehLaneChangeTo
+         >> frontSampleSeconds >> frontTravelledDistance >> vehLengthSum
+         >> occupationSum >> minimalVehicleLength;
+}
+
+
 void
 MSMeanData_Net::MSLaneMeanDataValues::notifyMoveInternal(
     const SUMOVehicle& veh, const double frontOnLane,
@@ -55,6 +55,8 @@ class SUMOVehicle;
  * @todo consider error-handling on write (using IOError)
  */
 class MSStopOut {
+    friend class MSSimulationContext;
+
 public:
 
     /** @brief Static intialization
@@ -91,8 +91,8 @@ MSVTKExport::getSpeed() {
     std::vector<double> output;
 
     MSVehicleControl& vc = MSNet::getInstance()->getVehicleControl();
-    MSVehicleControl::constVehIt it = vc.loadedVehBegin();
-    MSVehicleControl::constVehIt end = vc.loadedVehEnd();
+    MSVehicleControl::constVehIt it = vc.runningVehBegin();
+    MSVehicleControl::constVehIt end = vc.runningVehEnd();
 
 
     for (; it != end; ++it) {
@@ -115,8 +115,8 @@ MSVTKExport::getPositions() {
     std::vector<double> output;
 
     MSVehicleControl& vc = MSNet::getInstance()->getVehicleControl();
-    MSVehicleControl::constVehIt it = vc.loadedVehBegin();
-    MSVehicleControl::constVehIt end = vc.loadedVehEnd();
+    MSVehicleControl::constVehIt it = vc.runningVehBegin();
+    MSVehicleControl::constVehIt end = vc.runningVehEnd();
 
 
     for (; it != end; ++it) {
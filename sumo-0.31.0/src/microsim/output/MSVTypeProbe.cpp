@@ -67,7 +67,7 @@ MSVTypeProbe::execute(SUMOTime currentTime) {
     myOutputDevice.writeAttr(SUMO_ATTR_ID, getID());
     myOutputDevice.writeAttr("vType", myVType);
     MSVehicleControl& vc = MSNet::getInstance()->getVehicleControl();
-    for (MSVehicleControl::constVehIt it = vc.loadedVehBegin(); it != vc.loadedVehEnd(); ++it) {
+    for (MSVehicleControl::constVehIt it = vc.runningVehBegin(); it != vc.runningVehEnd(); ++it) {
         const SUMOVehicle* veh = it->second;
         const MSVehicle* microVeh = dynamic_cast<const MSVehicle*>(veh);
         if (myVType == "" || myVType == veh->getVehicleType().getID()) {
@@ -54,6 +54,8 @@ typedef std::pair<const MSPerson*, double> PersonDist;
  *
  */
 class MSPModel {
+    friend class MSSimulationContext;
+
 public:
 
     static MSPModel* getModel();
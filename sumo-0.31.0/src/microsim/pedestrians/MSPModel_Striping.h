@@ -57,6 +57,7 @@ class MSJunction;
  */
 class MSPModel_Striping : public MSPModel {
 
+    friend class MSSimulationContext;
     friend class GUIPerson; // for debugging
 
 public:
@@ -61,6 +61,8 @@ protected:
  * Pedestrian push button
  */
 class MSPedestrianPushButton: MSPushButton {
+    friend class MSSimulationContext;
+
 public:
     /**
      * MSPedestrianPushButton constructor
@@ -45,6 +45,7 @@
 #include <utils/common/TplConvert.h>
 #include <utils/common/ToString.h>
 #include <utils/common/MsgHandler.h>
+#include <utils/iodevices/OutputDevice.h>
 
 
 // ===========================================================================
@@ -844,5 +845,37 @@ MSTLLogicControl::switchOffAll() {
     }
 }
 
+
+void
+MSTLLogicControl::saveState(OutputDevice& out) {
+    const SUMOTime now = MSNet::getInstance()->getCurrentTimeStep();
+    for (std::map<std::string, TLSLogicVariants*>::const_iterator i = myLogics.begin(); i != myLogics.end(); ++i) {
+        const MSTrafficLightLogic* const logic = (*i).second->getActive();
+        const SUMOTime nextSwitch = logic->getNextSwitchTime();
+        out.openTag(SUMO_TAG_TLLOGIC);
+        out.writeAttr(SUMO_ATTR_ID, (*i).first);
+        out.writeAttr(SUMO_ATTR_PROGRAMID, logic->getProgramID());
+        out.writeAttr(SUMO_ATTR_PHASE, logic->getCurrentPhaseIndex());
+        out.writeAttr(SUMO_ATTR_DURATION, nextSwitch >= 0 ? nextSwitch - now : -1);
+        out.closeTag();
+    }
+}
+
+
+void
+MSTLLogicControl::loadState(SUMOTime t, const std::string& id, const std::string& programID, const int phase, const SUMOTime remaining) {
+    MSTrafficLightLogic* logic = getActive(id);
+    if (logic == 0) {
+        throw ProcessError("Could not restore the state of tls '" + id + "': No such tls exists.");
+    }
+    if (logic->getProgramID() != programID) {
+        switchTo(id, programID);
+        logic = getActive(id);
+    }
+    if (remaining >= 0) {
+        logic->changeStepAndDuration(*this, t, phase, remaining);
+    }
+}
+
 /****************************************************************************/
 
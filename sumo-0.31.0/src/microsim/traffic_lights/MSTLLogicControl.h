@@ -47,6 +47,7 @@ class MSTrafficLightLogic;
 class MSLink;
 class MSLane;
 class MSPhaseDefinition;
+class OutputDevice;
 
 
 // ===========================================================================
@@ -378,6 +379,29 @@ public:
     void switchOffAll();
 
 
+    /// @name State I/O
+    /// @{
+
+    /** @brief Saves the active program and the current phase of all tls
+     *
+     * @param[in] out The (possibly binary) device to write the state into
+     */
+    void saveState(OutputDevice& out);
+
+
+    /** @brief Restores the active program and the current phase of the named tls
+     *
+     * @param[in] t The current time step
+     * @param[in] id The id of the tls
+     * @param[in] programID The program which was active when saving the state
+     * @param[in] phase The phase index which was active when saving the state
+     * @param[in] remaining The remaining duration of the phase (-1 if the program does not switch)
+     * @exception ProcessError If either the tls or the program to switch to is not known
+     */
+    void loadState(SUMOTime t, const std::string& id, const std::string& programID, const int phase, const SUMOTime remaining);
+    /// @}
+
+
 
 protected:
     /**
@@ -55,6 +55,8 @@ class MSRouteProbe;
  * @brief Calibrates the flow on a segment to a specified one
  */
 class MSCalibrator : public MSTrigger, public MSRouteHandler, public Command {
+    friend class MSSimulationContext;
+
 public:
     /** constructor */
     MSCalibrator(const std::string& id,
@@ -46,6 +46,8 @@
  *  allow some common operation on them.
  */
 class MSTrigger : public Named {
+    friend class MSSimulationContext;
+
 public:
     /** @brief Constructor
      *
@@ -58,6 +58,7 @@
 #include <microsim/MSGlobals.h>
 #include <microsim/output/MSDetectorControl.h>
 #include <microsim/MSFrame.h>
+#include <microsim/MSSimulationContext.h>
 #include <microsim/MSEdgeWeightsStorage.h>
 #include <microsim/MSStateHandler.h>
 
@@ -219,59 +220,90 @@ NLBuilder::build() {
 }
 
 
+MSNet*
+NLBuilder::init() {
+    OptionsCont& oc = OptionsCont::getOptions();
+    oc.clear();
+    MSFrame::fillOptions();
+    OptionsIO::getOptions();
+    if (oc.processMetaOptions(OptionsIO::getArgC() < 2)) {
+        SystemFrame::close();
+        return 0;
+    }
+    XMLSubSys::setValidation(oc.getString("xml-validation"), oc.getString("xml-validation.net"));
+    if (!MSFrame::checkOptions()) {
+        throw ProcessError();
+    }
+    MsgHandler::initOutputOptions();
+    RandHelper::initRandGlobal();
+    RandHelper::initRandGlobal(MSRouteHandler::getParsingRNG());
+    RandHelper::initRandGlobal(MSDevice::getEquipmentRNG());
+    MSFrame::setMSGlobals(oc);
+    MSVehicleControl* vc = 0;
+    if (MSGlobals::gUseMesoSim) {
+        vc = new MEVehicleControl();
+    } else {
+        vc = new MSVehicleControl();
+    }
+    MSNet* net = new MSNet(vc, new MSEventControl(), new MSEventControl(), new MSEventControl());
+#ifndef NO_TRACI
+    // need to init TraCI-Server before loading routes to catch VEHICLE_STATE_BUILT
+    TraCIServer::openSocket(std::map<int, TraCIServer::CmdExecutor>());
+#endif
+
+    NLEdgeControlBuilder eb;
+    NLDetectorBuilder db(*net);
+    NLJunctionControlBuilder jb(*net, db);
+    NLTriggerBuilder tb;
+    NLHandler handler("", *net, db, tb, eb, jb);
+    tb.setHandler(&handler);
+    NLBuilder builder(oc, *net, eb, jb, db, handler);
+    MsgHandler::getErrorInstance()->clear();
+    MsgHandler::getWarningInstance()->clear();
+    MsgHandler::getMessageInstance()->clear();
+    if (!builder.build()) {
+        delete net;
+        throw ProcessError();
+    }
+    return net;
+}
+
+
 int
 NLBuilder::loadAndRun() {
     MSNet::SimulationState state = MSNet::SIMSTATE_LOADING;
     while (state == MSNet::SIMSTATE_LOADING) {
-        OptionsCont& oc = OptionsCont::getOptions();
-        oc.clear();
-        MSFrame::fillOptions();
-        OptionsIO::getOptions();
-        if (oc.processMetaOptions(OptionsIO::getArgC() < 2)) {
-            SystemFrame::close();
+        MSNet* net = init();
+        if (net == 0) {
             return 0;
         }
-        XMLSubSys::setValidation(oc.getString("xml-validation"), oc.getString("xml-validation.net"));
-        if (!MSFrame::checkOptions()) {
-            throw ProcessError();
-        }
-        MsgHandler::initOutputOptions();
-        RandHelper::initRandGlobal();
-        RandHelper::initRandGlobal(MSRouteHandler::getParsingRNG());
-        RandHelper::initRandGlobal(MSDevice::getEquipmentRNG());
-        MSFrame::setMSGlobals(oc);
-        MSVehicleControl* vc = 0;
-        if (MSGlobals::gUseMesoSim) {
-            vc = new MEVehicleControl();
-        } else {
-            vc = new MSVehicleControl();
-        }
-        MSNet* net = new MSNet(vc, new MSEventControl(), new MSEventControl(), new MSEventControl());
-#ifndef NO_TRACI
-        // need to init TraCI-Server before loading routes to catch VEHICLE_STATE_BUILT
-        TraCIServer::openSocket(std::map<int, TraCIServer::CmdExecutor>());
-#endif
+        const OptionsCont& oc = OptionsCont::getOptions();
+        state = net->simulate(string2time(oc.getString("begin")), string2time(oc.getString("end")));
+        delete net;
+    }
+    return 0;
+}
 
-        NLEdgeControlBuilder eb;
-        NLDetectorBuilder db(*net);
-        NLJunctionControlBuilder jb(*net, db);
-        NLTriggerBuilder tb;
-        NLHandler handler("", *net, db, tb, eb, jb);
-        tb.setHandler(&handler);
-        NLBuilder builder(oc, *net, eb, jb, db, handler);
-        MsgHandler::getErrorInstance()->clear();
-        MsgHandler::getWarningInstance()->clear();
-        MsgHandler::getMessageInstance()->clear();
-        if (builder.build()) {
-            state = net->simulate(string2time(oc.getString("begin")), string2time(oc.getString("end")));
-            delete net;
-        } else {
-            MsgHandler::getErrorInstance()->inform("Quitting (on error).", false);
-            delete net;
-            return 1;
+
+MSSimulationContext*
+NLBuilder::loadContext(const std::vector<std::string>& args) {
+    MSSimulationContext* context = new MSSimulationContext();
+    try {
+        MSSimulationContext::Activation activation(*context);
+        OptionsIO::setArgs(args);
+        MSNet* net = init();
+        if (net == 0) {
+            throw ProcessError("No simulation was loaded.");
         }
+        const SUMOTime begin = string2time(OptionsCont::getOptions().getString("begin"));
+        context->setBegin(begin);
+        net->setCurrentTimeStep(begin);
+        net->loadRoutes();
+    } catch (...) {
+        delete context;
+        throw;
     }
-    return 0;
+    return context;
 }
 
 
@@ -323,6 +355,12 @@ NLBuilder::buildNet() {
         delete tlc;
         throw;
     }
+#ifndef NO_TRACI
+    if (TraCIServer::getInstance() != 0) {
+        // build the lane index used for coordinate conversions while loading instead of on the first request
+        myNet.getLanesRTree();
+    }
+#endif
 }
 
 
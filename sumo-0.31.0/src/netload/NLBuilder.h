@@ -41,6 +41,7 @@
 // class declarations
 // ===========================================================================
 class MSNet;
+class MSSimulationContext;
 class NLContainer;
 class MSJunctionLogic;
 class MSDetectorControl;
@@ -106,6 +107,26 @@ public:
     static int loadAndRun();
 
 
+    /** @brief Loads the simulation described by the given arguments into a new context
+     *
+     * The simulation is initialised up to its begin time and may be advanced
+     *  using MSSimulationContext::step. XMLSubSys and OptionsIO (for the program
+     *  name) have to be initialised before.
+     * @param[in] args The command line arguments (without the program name)
+     * @return The context holding the loaded simulation
+     * @exception ProcessError If the options are invalid or the simulation could not be built
+     */
+    static MSSimulationContext* loadContext(const std::vector<std::string>& args);
+
+
+    /** @brief Parses the options and builds the network
+     *
+     * @return The built network or 0 if only meta options (help, version) were processed
+     * @exception ProcessError If the options are invalid or the network could not be built
+     */
+    static MSNet* init();
+
+
 protected:
     /** @brief Loads a described subpart form the given list of files
      *
@@ -327,9 +327,7 @@ ROEdge::getSuccessors(SUMOVehicleClass vClass) const {
     if (vClass == SVC_IGNORING || !RONet::getInstance()->hasPermissions() || isTazConnector()) {
         return myFollowingEdges;
     }
-#ifdef HAVE_FOX
-    FXMutexLock locker(myLock);
-#endif
+    std::lock_guard<std::mutex> locker(myLock);
     std::map<SUMOVehicleClass, ROEdgeVector>::const_iterator i = myClassesSuccessorMap.find(vClass);
     if (i != myClassesSuccessorMap.end()) {
         // can use cached value
@@ -39,15 +39,13 @@
 #include <map>
 #include <vector>
 #include <algorithm>
+#include <mutex>
 #include <utils/common/Named.h>
 #include <utils/common/StdDefs.h>
 #include <utils/common/ValueTimeLine.h>
 #include <utils/common/SUMOVehicleClass.h>
 #include <utils/emissions/PollutantsInterface.h>
 #include <utils/geom/Boundary.h>
-#ifdef HAVE_FOX
-#include <fx.h>
-#endif
 #include <utils/vehicle/SUMOVTypeParameter.h>
 #include "RONode.h"
 #include "ROVehicle.h"
@@ -552,10 +550,8 @@ protected:
     /// @brief The successors available for a given vClass
     mutable std::map<SUMOVehicleClass, ROEdgeVector> myClassesSuccessorMap;
 
-#ifdef HAVE_FOX
     /// The mutex used to avoid concurrent updates of myClassesSuccessorMap
-    mutable FXMutex myLock;
-#endif
+    mutable std::mutex myLock;
 
 private:
     /// @brief Invalidated copy constructor
@@ -132,6 +132,9 @@ ROFrame::fillOptions(OptionsCont& oc) {
     oc.doRegister("routing-threads", new Option_Integer(0));
     oc.addDescription("routing-threads", "Processing", "The number of parallel execution threads used for routing");
 
+    oc.doRegister("routing-window", new Option_Integer(0));
+    oc.addDescription("routing-window", "Processing", "Stream sorted input through the routing threads keeping at most INT computed routes in memory (0 disables streaming); the ids of all loaded vehicles and routes are still kept for the duplicate checks");
+
     // register defaults options
     oc.doRegister("departlane", new Option_String());
     oc.addDescription("departlane", "Defaults", "Assigns a default depart lane");
@@ -176,12 +179,18 @@ ROFrame::checkOptions(OptionsCont& oc) {
         WRITE_ERROR("At least two alternatives should be enabled.");
         return false;
     }
-#ifndef HAVE_FOX
-    if (oc.getInt("routing-threads") > 1) {
-        WRITE_ERROR("Parallel routing is only possible when compiled with Fox.");
+    if (oc.getInt("routing-window") < 0) {
+        WRITE_ERROR("The routing window must not be negative.");
+        return false;
+    }
+    if (oc.getInt("routing-window") > 0 && oc.getInt("routing-threads") == 0) {
+        WRITE_ERROR("The routing window needs routing threads.");
+        return false;
+    }
+    if (oc.getInt("routing-window") > 0 && oc.getBool("bulk-routing")) {
+        WRITE_ERROR("The routing window cannot be combined with bulk routing.");
         return false;
     }
-#endif
     return true;
 }
 
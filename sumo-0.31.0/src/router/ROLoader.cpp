@@ -197,6 +197,7 @@ ROLoader::processRoutes(const SUMOTime start, const SUMOTime end, const SUMOTime
     const SUMOTime firstStep = myLoaders.getFirstLoadTime();
     SUMOTime lastStep = firstStep;
     SUMOTime time = MIN2(firstStep, end);
+    SUMOTime savedTime = time;
     while (time <= end) {
         writeStats(time, start, absNo, endGiven);
         myLoaders.loadNext(time);
@@ -204,6 +205,7 @@ ROLoader::processRoutes(const SUMOTime start, const SUMOTime end, const SUMOTime
             break;
         }
         lastStep = net.saveAndRemoveRoutesUntil(myOptions, provider, time);
+        savedTime = time;
         if ((!net.furtherStored() && myLoaders.haveAllLoaded()) || MsgHandler::getErrorInstance()->wasInformed()) {
             break;
         }
@@ -213,6 +215,11 @@ ROLoader::processRoutes(const SUMOTime start, const SUMOTime end, const SUMOTime
             time += increment;
         }
     }
+    if (myOptions.getInt("routing-window") > 0 && net.furtherStored() && !MsgHandler::getErrorInstance()->wasInformed()) {
+        // when streaming the routes of the last step are still computed in the background
+        const SUMOTime streamedStep = net.saveAndRemoveRoutesUntil(myOptions, provider, savedTime);
+        lastStep = MAX2(lastStep, streamedStep);
+    }
     if (myLogSteps) {
         WRITE_MESSAGE("Routes found between time steps " + time2string(firstStep) + " and " + time2string(lastStep) + ".");
     }
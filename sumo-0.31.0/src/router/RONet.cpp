@@ -73,6 +73,7 @@ RONet::RONet()
       myReadRouteNo(0), myDiscardedRouteNo(0), myWrittenRouteNo(0),
       myHavePermissions(false),
       myNumInternalEdges(0),
+      myStreamTime(-SUMOTime_MAX),
       myErrorHandler(OptionsCont::getOptions().exists("ignore-errors")
                      && OptionsCont::getOptions().getBool("ignore-errors") ? MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance()),
       myKeepVTypeDist(OptionsCont::getOptions().exists("keep-vtype-distributions")
@@ -270,11 +271,11 @@ RONet::cleanup() {
         myTypesOutput->close();
     }
     RouteCostCalculator<RORoute, ROEdge, ROVehicle>::cleanup();
-#ifdef HAVE_FOX
     if (myThreadPool.size() > 0) {
         myThreadPool.clear();
     }
-#endif
+    // the pending tasks were deleted by the pool
+    myStreamTasks.clear();
 }
 
 
@@ -504,7 +505,6 @@ RONet::createBulkRouteRequests(const RORouterProvider& provider, const SUMOTime
     }
     int workerIndex = 0;
     for (std::map<const int, std::vector<RORoutable*> >::const_iterator i = bulkVehs.begin(); i != bulkVehs.end(); ++i) {
-#ifdef HAVE_FOX
         if (myThreadPool.size() > 0) {
             RORoutable* const first = i->second.front();
             myThreadPool.add(new RoutingTask(first, removeLoops, myErrorHandler), workerIndex);
@@ -519,7 +519,6 @@ RONet::createBulkRouteRequests(const RORouterProvider& provider, const SUMOTime
             }
             continue;
         }
-#endif
         for (std::vector<RORoutable*>::const_iterator j = i->second.begin(); j != i->second.end(); ++j) {
             (*j)->computeRoute(provider, removeLoops, myErrorHandler);
             provider.getVehicleRouter().setBulkMode(true);
@@ -535,17 +534,20 @@ RONet::saveAndRemoveRoutesUntil(OptionsCont& options, const RORouterProvider& pr
     MsgHandler* mh = (options.getBool("ignore-errors") ?
                       MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance());
     checkFlows(time, mh);
-    SUMOTime lastTime = -1;
     const bool removeLoops = options.getBool("remove-loops");
     const int maxNumThreads = options.getInt("routing-threads");
     if (myRoutables.size() != 0) {
         if (options.getBool("bulk-routing")) {
-#ifdef HAVE_FOX
             while ((int)myThreadPool.size() < maxNumThreads) {
                 new WorkerThread(myThreadPool, provider);
             }
-#endif
             createBulkRouteRequests(provider, time, removeLoops);
+        } else if (maxNumThreads > 0 && options.getInt("routing-window") > 0) {
+            // the routes of this step are computed in the background (also while loading the next step),
+            //  so only the ones of the previous step are written
+            const SUMOTime writeTime = myStreamTime;
+            createStreamRouteRequests(options, provider, time);
+            return writeRoutes(options, writeTime);
         } else {
             for (RoutablesMap::const_iterator i = myRoutables.begin(); i != myRoutables.end(); ++i) {
                 if (i->first >= time) {
@@ -553,7 +555,6 @@ RONet::saveAndRemoveRoutesUntil(OptionsCont& options, const RORouterProvider& pr
                 }
                 for (std::deque<RORoutable*>::const_iterator r = i->second.begin(); r != i->second.end(); ++r) {
                     RORoutable* const routable = *r;
-#ifdef HAVE_FOX
                     // add task
                     if (maxNumThreads > 0) {
                         const int numThreads = (int)myThreadPool.size();
@@ -571,15 +572,61 @@ RONet::saveAndRemoveRoutesUntil(OptionsCont& options, const RORouterProvider& pr
                         }
                         continue;
                     }
-#endif
                     routable->computeRoute(provider, removeLoops, myErrorHandler);
                 }
             }
         }
-#ifdef HAVE_FOX
         myThreadPool.waitAll();
-#endif
     }
+    return writeRoutes(options, time);
+}
+
+
+void
+RONet::createStreamRouteRequests(OptionsCont& options, const RORouterProvider& provider, const SUMOTime time) {
+    const bool removeLoops = options.getBool("remove-loops");
+    const int maxNumThreads = options.getInt("routing-threads");
+    const int window = options.getInt("routing-window");
+    // collect first because writing removes routables from the container
+    std::vector<RORoutable*> routables;
+    for (RoutablesMap::const_iterator i = myRoutables.begin(); i != myRoutables.end(); ++i) {
+        if (i->first >= time) {
+            break;
+        }
+        for (std::deque<RORoutable*>::const_iterator r = i->second.begin(); r != i->second.end(); ++r) {
+            if (myStreamTasks.count(*r) == 0) {
+                routables.push_back(*r);
+            }
+        }
+    }
+    for (std::vector<RORoutable*>::const_iterator r = routables.begin(); r != routables.end(); ++r) {
+        const int numThreads = (int)myThreadPool.size();
+        if (numThreads == 0) {
+            // the CHRouter needs initialization before it gets cloned (see saveAndRemoveRoutesUntil)
+            (*r)->computeRoute(provider, removeLoops, myErrorHandler);
+            myStreamTasks[*r] = 0;
+            new WorkerThread(myThreadPool, provider);
+            continue;
+        }
+        if (numThreads < maxNumThreads && myThreadPool.isFull()) {
+            new WorkerThread(myThreadPool, provider);
+        }
+        RoutingTask* const task = new RoutingTask(*r, removeLoops, myErrorHandler);
+        myStreamTasks[*r] = task;
+        myThreadPool.add(task);
+        // all routables up to this one are requested now, so writing the oldest only waits for their
+        //  routes (this one may be written as well, so it must not be used afterwards)
+        while ((int)myStreamTasks.size() > window) {
+            writeRoutes(options, time, 1);
+        }
+    }
+    myStreamTime = time;
+}
+
+
+SUMOTime
+RONet::writeRoutes(OptionsCont& options, const SUMOTime time, int maxRoutables) {
+    SUMOTime lastTime = -1;
     // write all vehicles (and additional structures)
     while (myRoutables.size() != 0 || myContainers.size() != 0) {
         // get the next vehicle, person or container
@@ -594,7 +641,22 @@ RONet::saveAndRemoveRoutesUntil(OptionsCont& options, const RORouterProvider& pr
         }
         const SUMOTime minTime = MIN2(routableTime, containerTime);
         if (routableTime == minTime) {
+            if (maxRoutables == 0) {
+                break;
+            }
+            maxRoutables--;
             const RORoutable* const r = routables->second.front();
+            // wait for the route if it is computed in the background
+            std::map<const RORoutable*, RoutingTask*>::iterator task = myStreamTasks.find(r);
+            // when enforcing the routing window only requested routables may be written
+            assert(maxRoutables < 0 || task != myStreamTasks.end());
+            if (task != myStreamTasks.end()) {
+                if (task->second != 0) {
+                    myThreadPool.waitFor(task->second);
+                    delete task->second;
+                }
+                myStreamTasks.erase(task);
+            }
             // check whether to print the output
             if (lastTime != routableTime && lastTime != -1) {
                 // report writing progress
@@ -705,15 +767,13 @@ RONet::setPermissionsFound() {
 }
 
 
-#ifdef HAVE_FOX
 // ---------------------------------------------------------------------------
 // RONet::RoutingTask-methods
 // ---------------------------------------------------------------------------
 void
-RONet::RoutingTask::run(FXWorkerThread* context) {
+RONet::RoutingTask::run(SUMOWorkerThread* context) {
     myRoutable->computeRoute(*static_cast<WorkerThread*>(context), myRemoveLoops, myErrorHandler);
 }
-#endif
 
 
 /****************************************************************************/
@@ -37,6 +37,7 @@
 #include <vector>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/NamedObjectCont.h>
+#include <utils/common/SUMOWorkerThread.h>
 #include <utils/distribution/RandomDistributor.h>
 #include <utils/vehicle/PedestrianRouter.h>
 #include <utils/vehicle/SUMOAbstractRouter.h>
@@ -46,10 +47,6 @@
 #include "RORoutable.h"
 #include "RORouteDef.h"
 
-#ifdef HAVE_FOX
-#include <utils/foxtools/FXWorkerThread.h>
-#endif
-
 
 // ===========================================================================
 // class declarations
@@ -405,6 +402,10 @@ public:
      *  exists, its route is computed and it is written and removed from
      *  the internal container.
      *
+     * When routing in parallel with a routing window (streaming), the routes
+     *  are computed in the background and only the vehicles of the previous
+     *  call are written, so the routing overlaps with loading the next step.
+     *
      * @param[in] options The options used during this process
      * @param[in] provider The router provider for routes computation
      * @param[in] time The time until which route definitions shall be processed
@@ -459,25 +460,24 @@ public:
         return myRoutesOutput;
     }
 
-#ifdef HAVE_FOX
-    FXWorkerThread::Pool& getThreadPool() {
+    SUMOWorkerThread::Pool& getThreadPool() {
         return myThreadPool;
     }
 
-    class WorkerThread : public FXWorkerThread, public RORouterProvider {
+    class WorkerThread : public SUMOWorkerThread, public RORouterProvider {
     public:
-        WorkerThread(FXWorkerThread::Pool& pool,
+        WorkerThread(SUMOWorkerThread::Pool& pool,
                      const RORouterProvider& original)
-            : FXWorkerThread(pool), RORouterProvider(original) {}
+            : SUMOWorkerThread(pool), RORouterProvider(original) {}
         virtual ~WorkerThread() {
             stop();
         }
     };
 
-    class BulkmodeTask : public FXWorkerThread::Task {
+    class BulkmodeTask : public SUMOWorkerThread::Task {
     public:
         BulkmodeTask(const bool value) : myValue(value) {}
-        void run(FXWorkerThread* context) {
+        void run(SUMOWorkerThread* context) {
             static_cast<WorkerThread*>(context)->getVehicleRouter().setBulkMode(myValue);
         }
     private:
@@ -486,7 +486,6 @@ public:
         /// @brief Invalidated assignment operator.
         BulkmodeTask& operator=(const BulkmodeTask&);
     };
-#endif
 
 
 private:
@@ -494,6 +493,22 @@ private:
 
     void createBulkRouteRequests(const RORouterProvider& provider, const SUMOTime time, const bool removeLoops);
 
+    /** @brief Hands the routables departing before the given time to the routing threads
+     *
+     * At most routing-window routables are kept in memory after being handed over,
+     *  if there are more, the oldest ones are written first.
+     */
+    void createStreamRouteRequests(OptionsCont& options, const RORouterProvider& provider, const SUMOTime time);
+
+    /** @brief Writes and removes the routables and containers departing before the given time
+     *
+     * @param[in] options The options used during this process
+     * @param[in] time The time until which the routables shall be written
+     * @param[in] maxRoutables The maximum number of routables to write (-1 for no limit)
+     * @return The last seen departure time>=time
+     */
+    SUMOTime writeRoutes(OptionsCont& options, const SUMOTime time, int maxRoutables = -1);
+
 private:
     /// @brief Unique instance of RONet
     static RONet* myInstance;
@@ -579,19 +594,21 @@ private:
     /// @brief The number of internal edges in the dictionary
     int myNumInternalEdges;
 
+    /// @brief The time until which the routables were handed to the routing threads (when streaming)
+    SUMOTime myStreamTime;
+
     /// @brief handler for ignorable error messages
     MsgHandler* myErrorHandler;
 
     /// @brief whether to keep the the vtype distribution in output
     const bool myKeepVTypeDist;
 
-#ifdef HAVE_FOX
 private:
-    class RoutingTask : public FXWorkerThread::Task {
+    class RoutingTask : public SUMOWorkerThread::Task {
     public:
         RoutingTask(RORoutable* v, const bool removeLoops, MsgHandler* errorHandler)
             : myRoutable(v), myRemoveLoops(removeLoops), myErrorHandler(errorHandler) {}
-        void run(FXWorkerThread* context);
+        void run(SUMOWorkerThread* context);
     private:
         RORoutable* const myRoutable;
         const bool myRemoveLoops;
@@ -604,8 +621,10 @@ private:
 
 private:
     /// @brief for multi threaded routing
-    FXWorkerThread::Pool myThreadPool;
-#endif
+    SUMOWorkerThread::Pool myThreadPool;
+
+    /// @brief The routables which are routed but not yet written with their pending tasks (0 if already finished)
+    std::map<const RORoutable*, RoutingTask*> myStreamTasks;
 
 private:
     /// @brief Invalidated copy constructor
@@ -50,6 +50,9 @@
 // command: set connection priority (execution order)
 #define CMD_SETORDER 0x03
 
+// command: several simulation steps with repeated vehicle controls
+#define CMD_MULTISTEP 0x04
+
 // command: stop node
 #define CMD_STOP 0x12
 
@@ -415,6 +418,14 @@
 #define STOP_CHARGING_STATION 0x20
 #define STOP_PARKING_AREA 0x40
 
+// ****************************************
+// Multi step termination flags
+// ****************************************
+// a watched vehicle was involved in a collision
+#define MULTISTEP_COLLISION 0x01
+// a watched vehicle arrived
+#define MULTISTEP_ARRIVED 0x02
+
 // ****************************************
 // Departure Flags
 // ****************************************
@@ -699,6 +710,15 @@
 // get/set vehicle via
 #define VAR_VIA 0xbe
 
+// occupancy grid of the surrounding vehicles (get: vehicle)
+#define VAR_OCCUPANCY_GRID 0x21
+
+// values of the given variables for all vehicles, column by column (get: vehicle)
+#define VAR_COLUMNS 0x25
+
+// nearest vehicles with distance, relative speed, bearing and time to collision (get: vehicle)
+#define VAR_NEAREST_VEHICLES 0x2f
+
 // current CO2 emission of a node (get: vehicle, lane, edge)
 #define VAR_CO2EMISSION 0x60
 
@@ -816,6 +836,15 @@
 // triggers saving simulation state (set: simulation)
 #define CMD_SAVE_SIMSTATE 0x95
 
+// takes an in-memory snapshot of the simulation state (set: simulation)
+#define CMD_SAVE_SNAPSHOT 0x96
+
+// replaces the simulation state by an in-memory snapshot (set: simulation)
+#define CMD_LOAD_SNAPSHOT 0x97
+
+// configures delta encoding of context subscription results (set: simulation)
+#define CMD_SUBSCRIPTION_DELTA 0x98
+
 // sets/retrieves abstract parameter
 #define VAR_PARAMETER 0x7e
 
@@ -190,6 +190,24 @@ struct TraCINextTLSData {
 };
 
 
+struct TraCINearestVehicleData {
+    /* @brief Constructor */
+    TraCINearestVehicleData() {}
+    /// @brief The id of the vehicle
+    std::string id;
+    /// @brief The distance between the vehicles' front positions
+    double dist;
+    /// @brief The change rate of the distance (negative if approaching)
+    double relSpeed;
+    /// @brief The direction of the vehicle in degrees clockwise from the ego heading
+    double bearing;
+    /// @brief The time to collision (INVALID_DOUBLE_VALUE if the vehicles do not approach)
+    double ttc;
+    /// @brief The deceleration needed to avoid the collision (INVALID_DOUBLE_VALUE if the vehicles do not approach)
+    double drac;
+};
+
+
 struct TraCIBestLanesData {
     /* @brief Constructor */
     TraCIBestLanesData() {}
@@ -51,7 +51,9 @@
 #include <map>
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 #include <foreign/tcpip/socket.h>
+#include <foreign/tcpip/shmsocket.h>
 #include <foreign/tcpip/storage.h>
 #include <utils/common/SUMOTime.h>
 #include <utils/vehicle/DijkstraRouterTT.h>
@@ -73,6 +75,8 @@
 #include <microsim/MSLane.h>
 #include <microsim/MSGlobals.h>
 #include <microsim/traffic_lights/MSTLLogicControl.h>
+#include <microsim/output/MSDetectorControl.h>
+#include <microsim/output/MSInductLoop.h>
 #include "lib/TraCI.h"
 #include "TraCIConstants.h"
 #include "TraCIServer.h"
@@ -112,7 +116,8 @@ bool TraCIServer::myDoCloseConnection = false;
 TraCIServer::TraCIServer(const SUMOTime begin, const int port, const int numClients)
     : myServerSocket(0),
       myTargetTime(begin),
-      myAmEmbedded(port == 0),
+      myAmEmbedded(port == 0 && !OptionsCont::getOptions().isSet("remote-shm")),
+      myNativeSubscriptions(!OptionsCont::getOptions().getBool("remote-legacy-subscriptions")),
       myLaneTree(0) {
 #ifdef DEBUG_MULTI_CLIENTS
     std::cout << "Creating new TraCIServer for " << numClients << " clients on port " << port << "." << std::endl;
@@ -127,6 +132,7 @@ TraCIServer::TraCIServer(const SUMOTime begin, const int port, const int numClie
     myVehicleStateChanges[MSNet::VEHICLE_STATE_ENDING_PARKING] = std::vector<std::string>();
     myVehicleStateChanges[MSNet::VEHICLE_STATE_STARTING_STOP] = std::vector<std::string>();
     myVehicleStateChanges[MSNet::VEHICLE_STATE_ENDING_STOP] = std::vector<std::string>();
+    myVehicleStateChanges[MSNet::VEHICLE_STATE_COLLISION] = std::vector<std::string>();
 
     myExecutors[CMD_GET_INDUCTIONLOOP_VARIABLE] = &TraCIServerAPI_InductionLoop::processGet;
     myExecutors[CMD_GET_LANEAREA_VARIABLE] = &TraCIServerAPI_LaneArea::processGet;
@@ -167,11 +173,27 @@ TraCIServer::TraCIServer(const SUMOTime begin, const int port, const int numClie
 
     if (!myAmEmbedded) {
         try {
-            WRITE_MESSAGE("***Starting server on port " + toString(port) + " ***");
-            myServerSocket = new tcpip::Socket(port);
+            const std::string shm = OptionsCont::getOptions().isSet("remote-shm") ? OptionsCont::getOptions().getString("remote-shm") : "";
+            if (shm != "") {
+                if (numClients != 1) {
+                    throw ProcessError("Only a single client can connect through shared memory.");
+                }
+                WRITE_MESSAGE("***Starting server on shared memory segment '" + shm + "' ***");
+            } else {
+                WRITE_MESSAGE("***Starting server on port " + toString(port) + " ***");
+                myServerSocket = new tcpip::Socket(port);
+            }
             while ((int)mySockets.size() < numClients) {
                 int index = (int)mySockets.size() + MAX_ORDER + 1;
-                mySockets[index] = new SocketInfo(myServerSocket->accept(true), begin);
+                tcpip::Socket* client = 0;
+                if (shm != "") {
+                    tcpip::ShmSocket* const shmSocket = new tcpip::ShmSocket(shm);
+                    shmSocket->waitForClient();
+                    client = shmSocket;
+                } else {
+                    client = myServerSocket->accept(true);
+                }
+                mySockets[index] = new SocketInfo(client, begin);
                 mySockets[index]->vehicleStateChanges[MSNet::VEHICLE_STATE_BUILT] = std::vector<std::string>();
                 mySockets[index]->vehicleStateChanges[MSNet::VEHICLE_STATE_DEPARTED] = std::vector<std::string>();
                 mySockets[index]->vehicleStateChanges[MSNet::VEHICLE_STATE_STARTING_TELEPORT] = std::vector<std::string>();
@@ -182,6 +204,7 @@ TraCIServer::TraCIServer(const SUMOTime begin, const int port, const int numClie
                 mySockets[index]->vehicleStateChanges[MSNet::VEHICLE_STATE_ENDING_PARKING] = std::vector<std::string>();
                 mySockets[index]->vehicleStateChanges[MSNet::VEHICLE_STATE_STARTING_STOP] = std::vector<std::string>();
                 mySockets[index]->vehicleStateChanges[MSNet::VEHICLE_STATE_ENDING_STOP] = std::vector<std::string>();
+                mySockets[index]->vehicleStateChanges[MSNet::VEHICLE_STATE_COLLISION] = std::vector<std::string>();
             }
             // When got here, all clients have connected
             if (numClients > 1) {
@@ -209,6 +232,7 @@ TraCIServer::~TraCIServer() {
 void
 TraCIServer::openSocket(const std::map<int, CmdExecutor>& execs) {
     if (myInstance == 0 && !myDoCloseConnection && (OptionsCont::getOptions().getInt("remote-port") != 0
+            || OptionsCont::getOptions().isSet("remote-shm")
 #ifdef HAVE_PYTHON
             || OptionsCont::getOptions().isSet("python-script")
 #endif
@@ -265,6 +289,50 @@ TraCIServer::postProcessVTD() {
 }
 
 
+void
+TraCIServer::setSubscriptionDelta(int keyframePeriod, double epsilon, const std::map<int, double>& epsilons) {
+    DeltaEncoding& delta = getCurrentDeltaEncoding();
+    delta.keyframePeriod = keyframePeriod;
+    delta.epsilon = epsilon;
+    delta.epsilons = epsilons;
+    // start over with a full result
+    removeDeltaStates(delta);
+}
+
+
+TraCIServer::DeltaEncoding&
+TraCIServer::getCurrentDeltaEncoding() {
+    if (myAmEmbedded || myCurrentSocket == mySockets.end()) {
+        return myEmbeddedDelta;
+    }
+    return myCurrentSocket->second->delta;
+}
+
+
+void
+TraCIServer::removeDeltaStates(const DeltaEncoding& delta) {
+    for (std::vector<Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end(); ++i) {
+        i->deltaStates.erase(&delta);
+    }
+}
+
+
+void
+TraCIServer::stateLoaded(SUMOTime targetTime) {
+    myTargetTime = targetTime;
+    for (std::map<int, SocketInfo*>::iterator i = mySockets.begin(); i != mySockets.end(); ++i) {
+        i->second->targetTime = targetTime;
+        for (std::map<MSNet::VehicleState, std::vector<std::string> >::iterator j = i->second->vehicleStateChanges.begin(); j != i->second->vehicleStateChanges.end(); ++j) {
+            (*j).second.clear();
+        }
+    }
+    for (std::map<MSNet::VehicleState, std::vector<std::string> >::iterator i = myVehicleStateChanges.begin(); i != myVehicleStateChanges.end(); ++i) {
+        (*i).second.clear();
+    }
+    myVTDControlledVehicles.clear();
+}
+
+
 // ---------- Initialisation and Shutdown
 
 
@@ -414,7 +482,7 @@ TraCIServer::nextTargetTime() const {
 
 // send out subscription results to clients which will act in this step (i.e. with client target time <= myTargetTime)
 void
-TraCIServer::sendOutputToAll() const {
+TraCIServer::sendOutputToAll() {
 #ifdef DEBUG_MULTI_CLIENTS
     std::cout << "\n    Sending subscription results to clients:\n";
 #endif
@@ -422,7 +490,21 @@ TraCIServer::sendOutputToAll() const {
     while (i != mySockets.end()) {
         if (i->second->targetTime <= MSNet::getInstance()->getCurrentTimeStep()) {
             // this client will become active before the next SUMO step. Provide subscription results.
-            i->second->socket->sendExact(myOutputStorage);
+            if (i->second->multiStep != 0) {
+                // the client's multi step command is finished
+                tcpip::Storage response;
+                writeMultiStepResponse(*i->second->multiStep, response);
+                i->second->socket->sendExact(response);
+                delete i->second->multiStep;
+                i->second->multiStep = 0;
+            } else if (i->second->delta.keyframePeriod > 0) {
+                tcpip::Storage response;
+                writeStatusCmd(CMD_SIMSTEP, RTYPE_OK, "", response);
+                writeDeltaSubscriptionResults(i->second->delta, response);
+                i->second->socket->sendExact(response);
+            } else {
+                i->second->socket->sendExact(myOutputStorage);
+            }
 #ifdef DEBUG_MULTI_CLIENTS
             std::cout << i->second->socket << "\n";
 #endif
@@ -448,6 +530,8 @@ TraCIServer::processCommandsUntilSimStep(SUMOTime step) {
             // This is the entry point after performing a SUMO step (block is skipped before first SUMO step since then no simulation results have to be sent)
             // update subscription results
             postProcessSimulationStep();
+            // continue the clients' multi step commands or collect their responses
+            processMultiSteps();
             // Send out subscription results to clients which will act in this SUMO step (i.e. with client target time <= current sumo timestep end)
             sendOutputToAll();
             myOutputStorage.reset();
@@ -529,6 +613,8 @@ TraCIServer::processCommandsUntilSimStep(SUMOTime step) {
                             std::cout << "    Received command SIM_STEP, end turn for client " << myCurrentSocket->second->socket << std::endl;
 #endif
                             done = true;
+                        } else if (cmd == CMD_MULTISTEP && myCurrentSocket->second->multiStep != 0) {
+                            done = true;
                         } else if (cmd == CMD_LOAD) {
 #ifdef DEBUG_MULTI_CLIENTS
                             std::cout << "    Received command LOAD." << std::endl;
@@ -606,6 +692,8 @@ TraCIServer::cleanup() {
     myTargetTime = string2time(OptionsCont::getOptions().getString("begin"));
     for (myCurrentSocket = mySockets.begin(); myCurrentSocket != mySockets.end(); ++myCurrentSocket) {
         myCurrentSocket->second->targetTime = myTargetTime;
+        delete myCurrentSocket->second->multiStep;
+        myCurrentSocket->second->multiStep = 0;
     }
     myOutputStorage.reset();
     myInputStorage.reset();
@@ -705,6 +793,7 @@ TraCIServer::removeCurrentSocket() {
     std::cout << "       Removing socket " << myCurrentSocket->second->socket
               << " (order " << myCurrentSocket->first << ")" << std::endl;
 #endif
+    removeDeltaStates(myCurrentSocket->second->delta);
 
     if (mySockets.size() == 1) {
         // Last client has disconnected
@@ -812,6 +901,9 @@ TraCIServer::dispatchCommand() {
                 }
                 return commandId;
             }
+            case CMD_MULTISTEP:
+                success = commandMultiStep();
+                break;
             case CMD_CLOSE:
                 writeStatusCmd(CMD_CLOSE, RTYPE_OK, "");
                 myCurrentSocket->second->socket->sendExact(myOutputStorage);
@@ -911,13 +1003,110 @@ TraCIServer::commandGetVersion() {
 }
 
 
+bool
+TraCIServer::commandMultiStep() {
+    int steps = 0;
+    int perStep = 0;
+    std::vector<std::string> watched;
+    if (myInputStorage.readUnsignedByte() != TYPE_COMPOUND || myInputStorage.readInt() != 4) {
+        return writeErrorStatusCmd(CMD_MULTISTEP, "A multi step command needs a compound object with four items.", myOutputStorage);
+    }
+    if (!readTypeCheckingInt(myInputStorage, steps) || steps < 1) {
+        return writeErrorStatusCmd(CMD_MULTISTEP, "The number of steps must be given as a positive integer.", myOutputStorage);
+    }
+    if (!readTypeCheckingUnsignedByte(myInputStorage, perStep)) {
+        return writeErrorStatusCmd(CMD_MULTISTEP, "The result mode must be given as an unsigned byte.", myOutputStorage);
+    }
+    if (!readTypeCheckingStringList(myInputStorage, watched)) {
+        return writeErrorStatusCmd(CMD_MULTISTEP, "The watched vehicles must be given as a string list.", myOutputStorage);
+    }
+    if (myInputStorage.readUnsignedByte() != TYPE_COMPOUND) {
+        return writeErrorStatusCmd(CMD_MULTISTEP, "The vehicle controls must be given as a compound object.", myOutputStorage);
+    }
+    const int numItems = myInputStorage.readInt();
+    if (numItems % 3 != 0) {
+        return writeErrorStatusCmd(CMD_MULTISTEP, "A vehicle control consists of the vehicle id, the variable and its value.", myOutputStorage);
+    }
+    std::vector<std::pair<std::string, std::vector<unsigned char> > > controls;
+    for (int i = 0; i < numItems / 3; ++i) {
+        std::string id;
+        int variable = 0;
+        if (!readTypeCheckingString(myInputStorage, id) || !readTypeCheckingUnsignedByte(myInputStorage, variable)) {
+            return writeErrorStatusCmd(CMD_MULTISTEP, "A vehicle control consists of the vehicle id, the variable and its value.", myOutputStorage);
+        }
+        if (MSNet::getInstance()->getVehicleControl().getVehicle(id) == 0) {
+            return writeErrorStatusCmd(CMD_MULTISTEP, "Vehicle '" + id + "' is not known", myOutputStorage);
+        }
+        tcpip::Storage control;
+        control.writeUnsignedByte(variable);
+        control.writeString(id);
+        if (!copyTypedValue(myInputStorage, control)) {
+            return writeErrorStatusCmd(CMD_MULTISTEP, "The value type of the control " + toHex(variable, 2) + " for vehicle '" + id + "' is not supported.", myOutputStorage);
+        }
+        controls.push_back(std::make_pair(id, std::vector<unsigned char>(control.begin(), control.end())));
+    }
+    MultiStep* const multiStep = new MultiStep();
+    multiStep->steps = steps;
+    multiStep->perStep = perStep != 0;
+    multiStep->watched.insert(watched.begin(), watched.end());
+    multiStep->controls.swap(controls);
+    std::string error;
+    if (!applyMultiStepControls(*multiStep, error)) {
+        delete multiStep;
+        return writeErrorStatusCmd(CMD_MULTISTEP, error, myOutputStorage);
+    }
+    if (myAmEmbedded) {
+        bool finished = false;
+        while (!finished) {
+            for (std::map<MSNet::VehicleState, std::vector<std::string> >::iterator i = myVehicleStateChanges.begin(); i != myVehicleStateChanges.end(); ++i) {
+                (*i).second.clear();
+            }
+            MSNet::getInstance()->simulationStep();
+            updateSubscriptionCache();
+            finished = updateMultiStep(*multiStep, myVehicleStateChanges, myEmbeddedDelta);
+            if (!finished && !applyMultiStepControls(*multiStep, error)) {
+                multiStep->error = error;
+                finished = true;
+            }
+        }
+        myTargetTime = MSNet::getInstance()->getCurrentTimeStep();
+        writeMultiStepResponse(*multiStep, myOutputStorage);
+        delete multiStep;
+        if (error != "") {
+            return false;
+        }
+    } else {
+        // the response is sent by sendOutputToAll when the command is finished
+        delete myCurrentSocket->second->multiStep;
+        myCurrentSocket->second->multiStep = multiStep;
+        myCurrentSocket->second->targetTime = MSNet::getInstance()->getCurrentTimeStep() + DELTA_T;
+    }
+    return true;
+}
+
+
 void
 TraCIServer::postProcessSimulationStep() {
-    SUMOTime t = MSNet::getInstance()->getCurrentTimeStep();
 #ifdef DEBUG_MULTI_CLIENTS
-    std::cout << "   postProcessSimulationStep() at time " << t << std::endl;
+    std::cout << "   postProcessSimulationStep() at time " << MSNet::getInstance()->getCurrentTimeStep() << std::endl;
 #endif
     writeStatusCmd(CMD_SIMSTEP, RTYPE_OK, "");
+    updateSubscriptionCache();
+    if (myAmEmbedded && myEmbeddedDelta.keyframePeriod > 0) {
+        writeDeltaSubscriptionResults(myEmbeddedDelta, myOutputStorage);
+    } else {
+        // clients using delta encoding get their results in sendOutputToAll
+        myOutputStorage.writeStorage(mySubscriptionCache);
+    }
+#ifdef DEBUG_SUBSCRIPTIONS
+    std::cout << "   Size after writing subscriptions is " << mySubscriptionCache.size() << std::endl;
+#endif
+}
+
+
+void
+TraCIServer::updateSubscriptionCache() {
+    SUMOTime t = MSNet::getInstance()->getCurrentTimeStep();
     int noActive = 0;
     for (std::vector<Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end();) {
         const Subscription& s = *i;
@@ -944,7 +1133,7 @@ TraCIServer::postProcessSimulationStep() {
     std::cout << "   Size after writing an int is " << mySubscriptionCache.size() << std::endl;
 #endif
     for (std::vector<Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end();) {
-        const Subscription& s = *i;
+        Subscription& s = *i;
         if (s.beginTime > t) {
             ++i;
             continue;
@@ -963,10 +1152,173 @@ TraCIServer::postProcessSimulationStep() {
             i = mySubscriptions.erase(i);
         }
     }
-    myOutputStorage.writeStorage(mySubscriptionCache);
-#ifdef DEBUG_SUBSCRIPTIONS
-    std::cout << "   Size after writing subscriptions is " << mySubscriptionCache.size() << std::endl;
-#endif
+}
+
+
+void
+TraCIServer::writeDeltaSubscriptionResults(const DeltaEncoding& delta, tcpip::Storage& into) {
+    const SUMOTime t = MSNet::getInstance()->getCurrentTimeStep();
+    // the finished subscriptions were already removed by updateSubscriptionCache
+    int noActive = 0;
+    tcpip::Storage results;
+    for (std::vector<Subscription>::iterator i = mySubscriptions.begin(); i != mySubscriptions.end(); ++i) {
+        if (i->beginTime > t) {
+            continue;
+        }
+        if (i->evaluated != t) {
+            // usually updateSubscriptionCache did this already
+            std::string errors;
+            evaluateSubscription(*i, errors);
+        }
+        const int size = (int)results.size();
+        if (i->contextVars) {
+            writeDeltaSubscription(*i, delta, results);
+        } else {
+            results.writePacket(i->result);
+        }
+        if ((int)results.size() > size) {
+            ++noActive;
+        }
+    }
+    into.writeInt(noActive);
+    into.writeStorage(results);
+}
+
+
+bool
+TraCIServer::copyTypedValue(tcpip::Storage& inputStorage, tcpip::Storage& into) {
+    const int type = inputStorage.readUnsignedByte();
+    into.writeUnsignedByte(type);
+    switch (type) {
+        case TYPE_UBYTE:
+            into.writeUnsignedByte(inputStorage.readUnsignedByte());
+            return true;
+        case TYPE_BYTE:
+            into.writeByte(inputStorage.readByte());
+            return true;
+        case TYPE_INTEGER:
+            into.writeInt(inputStorage.readInt());
+            return true;
+        case TYPE_DOUBLE:
+            into.writeDouble(inputStorage.readDouble());
+            return true;
+        case TYPE_STRING:
+            into.writeString(inputStorage.readString());
+            return true;
+        case TYPE_STRINGLIST:
+            into.writeStringList(inputStorage.readStringList());
+            return true;
+        case TYPE_COLOR:
+            for (int i = 0; i < 4; ++i) {
+                into.writeUnsignedByte(inputStorage.readUnsignedByte());
+            }
+            return true;
+        case POSITION_2D:
+            into.writeDouble(inputStorage.readDouble());
+            into.writeDouble(inputStorage.readDouble());
+            return true;
+        case TYPE_COMPOUND: {
+            const int numItems = inputStorage.readInt();
+            into.writeInt(numItems);
+            for (int i = 0; i < numItems; ++i) {
+                if (!copyTypedValue(inputStorage, into)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+
+bool
+TraCIServer::applyMultiStepControls(const MultiStep& multiStep, std::string& error) {
+    bool ok = true;
+    for (std::vector<std::pair<std::string, std::vector<unsigned char> > >::const_iterator i = multiStep.controls.begin(); i != multiStep.controls.end(); ++i) {
+        if (MSNet::getInstance()->getVehicleControl().getVehicle(i->first) == 0) {
+            continue;
+        }
+        tcpip::Storage control(&i->second[0], (int)i->second.size());
+        tcpip::Storage response;
+        if (!TraCIServerAPI_Vehicle::processSet(*this, control, response) && ok) {
+            // skip length, command id and status of the error response
+            response.readUnsignedByte();
+            response.readUnsignedByte();
+            response.readUnsignedByte();
+            error = response.readString();
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+
+bool
+TraCIServer::updateMultiStep(MultiStep& multiStep, std::map<MSNet::VehicleState, std::vector<std::string> >& stateChanges,
+                             const DeltaEncoding& delta) {
+    multiStep.done++;
+    const std::vector<std::string>& collisions = stateChanges[MSNet::VEHICLE_STATE_COLLISION];
+    for (std::vector<std::string>::const_iterator i = collisions.begin(); i != collisions.end(); ++i) {
+        if (multiStep.watched.count(*i) > 0) {
+            multiStep.stopFlags |= MULTISTEP_COLLISION;
+            if (find(multiStep.stopIDs.begin(), multiStep.stopIDs.end(), *i) == multiStep.stopIDs.end()) {
+                multiStep.stopIDs.push_back(*i);
+            }
+        }
+    }
+    const std::vector<std::string>& arrivals = stateChanges[MSNet::VEHICLE_STATE_ARRIVED];
+    for (std::vector<std::string>::const_iterator i = arrivals.begin(); i != arrivals.end(); ++i) {
+        if (multiStep.watched.count(*i) > 0) {
+            multiStep.stopFlags |= MULTISTEP_ARRIVED;
+            if (find(multiStep.stopIDs.begin(), multiStep.stopIDs.end(), *i) == multiStep.stopIDs.end()) {
+                multiStep.stopIDs.push_back(*i);
+            }
+        }
+    }
+    const bool finished = multiStep.done >= multiStep.steps || multiStep.stopFlags != 0;
+    if (multiStep.perStep || finished) {
+        if (delta.keyframePeriod > 0) {
+            // the changes are relative to the last results the client received, skipped steps do not matter
+            writeDeltaSubscriptionResults(delta, multiStep.results);
+        } else {
+            multiStep.results.writeStorage(mySubscriptionCache);
+        }
+        multiStep.numResults++;
+    }
+    return finished;
+}
+
+
+void
+TraCIServer::writeMultiStepResponse(MultiStep& multiStep, tcpip::Storage& outputStorage) {
+    if (multiStep.error != "") {
+        // the results collected so far are dropped like the ones of any failed command
+        writeErrorStatusCmd(CMD_MULTISTEP, multiStep.error, outputStorage);
+        return;
+    }
+    writeStatusCmd(CMD_MULTISTEP, RTYPE_OK, "", outputStorage);
+    outputStorage.writeInt(multiStep.done);
+    outputStorage.writeUnsignedByte(multiStep.stopFlags);
+    outputStorage.writeStringList(multiStep.stopIDs);
+    outputStorage.writeInt(multiStep.numResults);
+    outputStorage.writeStorage(multiStep.results);
+}
+
+
+void
+TraCIServer::processMultiSteps() {
+    const SUMOTime t = MSNet::getInstance()->getCurrentTimeStep();
+    for (std::map<int, SocketInfo*>::iterator i = mySockets.begin(); i != mySockets.end(); ++i) {
+        MultiStep* const multiStep = i->second->multiStep;
+        if (multiStep != 0 && i->second->targetTime <= t && !updateMultiStep(*multiStep, i->second->vehicleStateChanges, i->second->delta)) {
+            if (applyMultiStepControls(*multiStep, multiStep->error)) {
+                i->second->targetTime += DELTA_T;
+            }
+            // otherwise the target time is not advanced so the error is sent by sendOutputToAll right away
+        }
+    }
 }
 
 
@@ -984,7 +1336,11 @@ TraCIServer::sendSingleSimStepResponse() {
 //    myOutputStorage.writeInt(0);
 //    myCurrentSocket->second->socket->sendExact(myOutputStorage);
 //    myOutputStorage.reset();
-    myOutputStorage.writeStorage(mySubscriptionCache);
+    if (myCurrentSocket->second->delta.keyframePeriod > 0) {
+        writeDeltaSubscriptionResults(myCurrentSocket->second->delta, myOutputStorage);
+    } else {
+        myOutputStorage.writeStorage(mySubscriptionCache);
+    }
     // send results to active client
     myCurrentSocket->second->socket->sendExact(myOutputStorage);
     myOutputStorage.reset();
@@ -1019,10 +1375,11 @@ TraCIServer::writeErrorStatusCmd(int commandId, const std::string& description,
 
 
 void
-TraCIServer::initialiseSubscription(const TraCIServer::Subscription& s) {
+TraCIServer::initialiseSubscription(TraCIServer::Subscription& s) {
     tcpip::Storage writeInto;
     std::string errors;
-    if (processSingleSubscription(s, writeInto, errors)) {
+    const DeltaEncoding& delta = getCurrentDeltaEncoding();
+    if (processSingleSubscription(s, writeInto, errors, &delta)) {
         if (s.endTime < MSNet::getInstance()->getCurrentTimeStep()) {
             writeStatusCmd(s.commandId, RTYPE_ERR, "Subscription has ended.");
         } else {
@@ -1037,6 +1394,9 @@ TraCIServer::initialiseSubscription(const TraCIServer::Subscription& s) {
                         if (offset == (int)i->variables.size() || i->parameters[offset] != *k) {
                             i->variables.push_back(*j);
                             i->parameters.push_back(*k);
+                            // the next results need to contain the new variable for all objects
+                            i->deltaStates.clear();
+                            i->evaluated = SUMOTime_MIN;
                         }
                     }
                     needNewSubscription = false;
@@ -1047,6 +1407,9 @@ TraCIServer::initialiseSubscription(const TraCIServer::Subscription& s) {
                 mySubscriptions.push_back(s);
                 // Add new subscription to subscription cache (note: seems a bit inefficient)
                 if (s.beginTime < MSNet::getInstance()->getCurrentTimeStep()) {
+                    // the cache holds the full results for all clients
+                    tcpip::Storage full;
+                    full.writePacket(s.result);
                     // copy new subscription into cache
                     int noActive = 1 + (mySubscriptionCache.size() > 0 ? mySubscriptionCache.readInt() : 0);
                     tcpip::Storage tmp;
@@ -1054,7 +1417,7 @@ TraCIServer::initialiseSubscription(const TraCIServer::Subscription& s) {
                     while (mySubscriptionCache.valid_pos()) {
                         tmp.writeByte(mySubscriptionCache.readByte());
                     }
-                    tmp.writeStorage(writeInto);
+                    tmp.writeStorage(full);
                     mySubscriptionCache.reset();
                     mySubscriptionCache.writeStorage(tmp);
                 }
@@ -1214,9 +1577,24 @@ TraCIServer::collectObjectsInRange(int domain, const PositionVector& shape, doub
 
 
 bool
-TraCIServer::processSingleSubscription(const Subscription& s, tcpip::Storage& writeInto,
-                                       std::string& errors) {
+TraCIServer::processSingleSubscription(Subscription& s, tcpip::Storage& writeInto,
+                                       std::string& errors, const DeltaEncoding* delta) {
+    const bool ok = evaluateSubscription(s, errors);
+    if (s.contextVars && delta != 0 && delta->keyframePeriod > 0) {
+        writeDeltaSubscription(s, *delta, writeInto);
+    } else {
+        writeInto.writePacket(s.result);
+    }
+    return ok;
+}
+
+
+bool
+TraCIServer::evaluateSubscription(Subscription& s, std::string& errors) {
     bool ok = true;
+    s.evaluated = SUMOTime_MIN;
+    s.result.clear();
+    s.objects.clear();
     tcpip::Storage outputStorage;
     const int getCommandId = s.contextVars ? s.contextDomain : s.commandId - 0x30;
     std::set<std::string> objIDs;
@@ -1230,13 +1608,20 @@ TraCIServer::processSingleSubscription(const Subscription& s, tcpip::Storage& wr
         objIDs.insert(s.id);
     }
     const int numVars = s.contextVars && s.variables.size() == 1 && s.variables[0] == ID_LIST ? 0 : (int)s.variables.size();
+    const bool native = numVars > 0 && isNativeSubscription(s);
+    // the values per object are only needed for the delta encoding
+    const bool keepObjects = s.contextVars && hasDeltaClients();
     for (std::set<std::string>::iterator j = objIDs.begin(); j != objIDs.end(); ++j) {
+        tcpip::Storage objectStorage;
+        tcpip::Storage& values = keepObjects ? objectStorage : outputStorage;
+        std::vector<int> starts;
         if (s.contextVars) {
             outputStorage.writeString(*j);
         }
-        if (numVars > 0) {
+        if (numVars > 0 && !(native && writeNativeValues(getCommandId, *j, s.variables, values, &starts))) {
             std::vector<std::vector<unsigned char> >::const_iterator k = s.parameters.begin();
             for (std::vector<int>::const_iterator i = s.variables.begin(); i != s.variables.end(); ++i, ++k) {
+                starts.push_back((int)values.size());
                 tcpip::Storage message;
                 message.writeUnsignedByte(*i);
                 message.writeString(*j);
@@ -1264,11 +1649,11 @@ TraCIServer::processSingleSubscription(const Subscription& s, tcpip::Storage& wr
                     tmpOutput.readUnsignedByte();
                     int variable = tmpOutput.readUnsignedByte();
                     std::string id = tmpOutput.readString();
-                    outputStorage.writeUnsignedByte(variable);
-                    outputStorage.writeUnsignedByte(RTYPE_OK);
+                    values.writeUnsignedByte(variable);
+                    values.writeUnsignedByte(RTYPE_OK);
                     length -= (lengthLength + 1 + 4 + (int)id.length());
                     while (--length > 0) {
-                        outputStorage.writeUnsignedByte(tmpOutput.readUnsignedByte());
+                        values.writeUnsignedByte(tmpOutput.readUnsignedByte());
                     }
                 } else {
                     //read length
@@ -1278,19 +1663,26 @@ TraCIServer::processSingleSubscription(const Subscription& s, tcpip::Storage& wr
                     //read status
                     tmpOutput.readUnsignedByte();
                     std::string msg = tmpOutput.readString();
-                    outputStorage.writeUnsignedByte(*i);
-                    outputStorage.writeUnsignedByte(RTYPE_ERR);
-                    outputStorage.writeUnsignedByte(TYPE_STRING);
-                    outputStorage.writeString(msg);
+                    values.writeUnsignedByte(*i);
+                    values.writeUnsignedByte(RTYPE_ERR);
+                    values.writeUnsignedByte(TYPE_STRING);
+                    values.writeString(msg);
                     errors = errors + msg;
                 }
             }
         }
+        if (keepObjects) {
+            s.objects.push_back(ObjectValues(*j));
+            s.objects.back().values.assign(objectStorage.begin(), objectStorage.end());
+            s.objects.back().starts.swap(starts);
+            outputStorage.writeStorage(objectStorage);
+        }
     }
     int length = (1 + 4) + 1 + (4 + (int)(s.id.length())) + 1 + (int)outputStorage.size();
     if (s.contextVars) {
         length += 4;
     }
+    tcpip::Storage writeInto;
     writeInto.writeUnsignedByte(0); // command length -> extended
     writeInto.writeInt(length);
     writeInto.writeUnsignedByte(s.commandId + 0x10);
@@ -1305,10 +1697,219 @@ TraCIServer::processSingleSubscription(const Subscription& s, tcpip::Storage& wr
     if (!s.contextVars || objIDs.size() != 0) {
         writeInto.writeStorage(outputStorage);
     }
+    s.result.assign(writeInto.begin(), writeInto.end());
+    if (!s.contextVars || keepObjects) {
+        s.evaluated = MSNet::getInstance()->getCurrentTimeStep();
+    }
     return ok;
 }
 
 
+void
+TraCIServer::writeDeltaSubscription(Subscription& s, const DeltaEncoding& delta, tcpip::Storage& writeInto) {
+    if (s.result.empty()) {
+        // the subscribed object was not found
+        return;
+    }
+    const int numVars = s.variables.size() == 1 && s.variables[0] == ID_LIST ? 0 : (int)s.variables.size();
+    DeltaState& state = s.deltaStates[&delta];
+    const bool keyframe = state.countdown <= 0;
+    if (keyframe) {
+        state.values.clear();
+        state.countdown = delta.keyframePeriod;
+    }
+    state.countdown--;
+    tcpip::Storage outputStorage;
+    int numEntries = 0;
+    std::set<std::string> objIDs;
+    for (std::vector<ObjectValues>::const_iterator j = s.objects.begin(); j != s.objects.end(); ++j) {
+        objIDs.insert(j->id);
+        if (writeDeltaValues(delta, state, j->id, j->values, j->starts, outputStorage)) {
+            numEntries++;
+        }
+    }
+    std::vector<std::string> removed;
+    for (std::map<std::string, std::vector<std::vector<unsigned char> > >::iterator i = state.values.begin(); i != state.values.end();) {
+        if (objIDs.count(i->first) == 0) {
+            removed.push_back(i->first);
+            state.values.erase(i++);
+        } else {
+            ++i;
+        }
+    }
+    outputStorage.writeStringList(removed);
+    // the same length as in evaluateSubscription plus the keyframe flag
+    const int length = (1 + 4) + 1 + (4 + (int)(s.id.length())) + 1 + 4 + 1 + (int)outputStorage.size();
+    writeInto.writeUnsignedByte(0); // command length -> extended
+    writeInto.writeInt(length);
+    writeInto.writeUnsignedByte(s.commandId + 0x10);
+    writeInto.writeString(s.id);
+    writeInto.writeUnsignedByte(s.contextDomain);
+    writeInto.writeUnsignedByte(numVars);
+    writeInto.writeUnsignedByte(keyframe ? 1 : 0);
+    writeInto.writeInt(numEntries);
+    writeInto.writeStorage(outputStorage);
+}
+
+
+bool
+TraCIServer::hasDeltaClients() const {
+    if (myEmbeddedDelta.keyframePeriod > 0) {
+        return true;
+    }
+    for (std::map<int, SocketInfo*>::const_iterator i = mySockets.begin(); i != mySockets.end(); ++i) {
+        if (i->second->delta.keyframePeriod > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+bool
+TraCIServer::writeDeltaValues(const DeltaEncoding& delta, DeltaState& state, const std::string& id, const std::vector<unsigned char>& values,
+                              const std::vector<int>& starts, tcpip::Storage& into) {
+    std::map<std::string, std::vector<std::vector<unsigned char> > >::iterator it = state.values.find(id);
+    const bool isNew = it == state.values.end();
+    if (isNew) {
+        it = state.values.insert(std::make_pair(id, std::vector<std::vector<unsigned char> >(starts.size()))).first;
+    }
+    std::vector<std::vector<unsigned char> >& last = it->second;
+    std::vector<std::vector<unsigned char> > changed;
+    for (int k = 0; k < (int)starts.size(); ++k) {
+        const int end = k + 1 < (int)starts.size() ? starts[k + 1] : (int)values.size();
+        std::vector<unsigned char> current(values.begin() + starts[k], values.begin() + end);
+        if (isNew || deltaChanged(delta, last[k], current)) {
+            // errors are not remembered so they are reported again in the next step
+            last[k] = current[1] == RTYPE_OK ? current : std::vector<unsigned char>();
+            changed.push_back(current);
+        }
+    }
+    if (!isNew && changed.empty()) {
+        return false;
+    }
+    into.writeString(id);
+    into.writeUnsignedByte((int)changed.size());
+    for (std::vector<std::vector<unsigned char> >::const_iterator i = changed.begin(); i != changed.end(); ++i) {
+        into.writePacket(*i);
+    }
+    return true;
+}
+
+
+bool
+TraCIServer::deltaChanged(const DeltaEncoding& delta, const std::vector<unsigned char>& last, const std::vector<unsigned char>& current) const {
+    if (last.size() != current.size()) {
+        return true;
+    }
+    const int type = current[2];
+    if (type == TYPE_DOUBLE || type == POSITION_2D || type == POSITION_3D) {
+        std::map<int, double>::const_iterator it = delta.epsilons.find(current[0]);
+        const double epsilon = it != delta.epsilons.end() ? it->second : delta.epsilon;
+        for (int offset = 3; offset + 8 <= (int)current.size(); offset += 8) {
+            tcpip::Storage lastValue(&last[offset], 8);
+            tcpip::Storage currentValue(&current[offset], 8);
+            if (fabs(currentValue.readDouble() - lastValue.readDouble()) > epsilon) {
+                return true;
+            }
+        }
+        return false;
+    }
+    return last != current;
+}
+
+
+bool
+TraCIServer::isNativeSubscription(const TraCIServer::Subscription& s) const {
+    if (!myNativeSubscriptions) {
+        return false;
+    }
+    const int domain = s.contextVars ? s.contextDomain : s.commandId - 0x30;
+    std::vector<std::vector<unsigned char> >::const_iterator k = s.parameters.begin();
+    for (std::vector<int>::const_iterator i = s.variables.begin(); i != s.variables.end(); ++i, ++k) {
+        if (!k->empty()) {
+            return false;
+        }
+        switch (domain) {
+            case CMD_GET_VEHICLE_VARIABLE:
+                if (!TraCIServerAPI_Vehicle::isNative(*i)) {
+                    return false;
+                }
+                break;
+            case CMD_GET_LANE_VARIABLE:
+                if (!TraCIServerAPI_Lane::isNative(*i)) {
+                    return false;
+                }
+                break;
+            case CMD_GET_INDUCTIONLOOP_VARIABLE:
+                if (!TraCIServerAPI_InductionLoop::isNative(*i)) {
+                    return false;
+                }
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+
+bool
+TraCIServer::writeNativeValues(int domain, const std::string& id, const std::vector<int>& variables, tcpip::Storage& into,
+                               std::vector<int>* starts) {
+    switch (domain) {
+        case CMD_GET_VEHICLE_VARIABLE: {
+            const MSVehicle* const veh = dynamic_cast<const MSVehicle*>(MSNet::getInstance()->getVehicleControl().getVehicle(id));
+            if (veh == 0) {
+                return false;
+            }
+            for (std::vector<int>::const_iterator i = variables.begin(); i != variables.end(); ++i) {
+                if (starts != 0) {
+                    starts->push_back((int)into.size());
+                }
+                into.writeUnsignedByte(*i);
+                into.writeUnsignedByte(RTYPE_OK);
+                TraCIServerAPI_Vehicle::writeNative(*i, veh, into);
+            }
+        }
+        break;
+        case CMD_GET_LANE_VARIABLE: {
+            const MSLane* const lane = MSLane::dictionary(id);
+            if (lane == 0) {
+                return false;
+            }
+            for (std::vector<int>::const_iterator i = variables.begin(); i != variables.end(); ++i) {
+                if (starts != 0) {
+                    starts->push_back((int)into.size());
+                }
+                into.writeUnsignedByte(*i);
+                into.writeUnsignedByte(RTYPE_OK);
+                TraCIServerAPI_Lane::writeNative(*i, lane, into);
+            }
+        }
+        break;
+        case CMD_GET_INDUCTIONLOOP_VARIABLE: {
+            const MSInductLoop* const il = dynamic_cast<const MSInductLoop*>(MSNet::getInstance()->getDetectorControl().getTypedDetectors(SUMO_TAG_INDUCTION_LOOP).get(id));
+            if (il == 0) {
+                return false;
+            }
+            for (std::vector<int>::const_iterator i = variables.begin(); i != variables.end(); ++i) {
+                if (starts != 0) {
+                    starts->push_back((int)into.size());
+                }
+                into.writeUnsignedByte(*i);
+                into.writeUnsignedByte(RTYPE_OK);
+                TraCIServerAPI_InductionLoop::writeNative(*i, il, into);
+            }
+        }
+        break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+
 bool
 TraCIServer::addObjectVariableSubscription(const int commandId, const bool hasContext) {
     const SUMOTime beginTime = myInputStorage.readInt();
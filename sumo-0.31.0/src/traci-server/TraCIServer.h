@@ -72,6 +72,8 @@
  * @brief TraCI server used to control sumo by a remote TraCI client
  */
 class TraCIServer : public MSNet::VehicleStateListener {
+    friend class MSSimulationContext;
+
 public:
     /// @brief Definition of a method to be called for serving an associated commandID
     typedef bool(*CmdExecutor)(TraCIServer& server, tcpip::Storage& inputStorage, tcpip::Storage& outputStorage);
@@ -118,6 +120,25 @@ public:
 
     void postProcessVTD();
 
+    /** @brief Resets the target times of all clients and forgets vehicle related data
+     *
+     * Called after the simulation state was replaced by a snapshot.
+     * @param[in] targetTime The simulation step of the loaded state
+     */
+    void stateLoaded(SUMOTime targetTime);
+
+    /** @brief Configures the delta encoding of context subscription results for the current client
+     *
+     * If enabled, context subscriptions only report objects which entered the range
+     *  and values which changed since they were last transmitted to this client, together
+     *  with the objects which left the range. Every keyframePeriod results all values are sent.
+     *  Other clients still receive the full results.
+     * @param[in] keyframePeriod The number of steps between full results (0 disables the delta encoding)
+     * @param[in] epsilon The default threshold for numerical values to count as changed
+     * @param[in] epsilons Thresholds for single variables
+     */
+    void setSubscriptionDelta(int keyframePeriod, double epsilon, const std::map<int, double>& epsilons);
+
     /// @brief clean up subscriptions
     void cleanup();
 
@@ -285,14 +306,83 @@ private:
 
 
 
+    /// @brief The progress of a multi step command (CMD_MULTISTEP)
+    struct MultiStep {
+    public:
+        /// @brief constructor
+        MultiStep() : steps(0), done(0), perStep(false), stopFlags(0), numResults(0) {}
+        /// @brief The number of steps to perform
+        int steps;
+        /// @brief The number of steps performed so far
+        int done;
+        /// @brief Whether the subscription results of every step are returned (only the last ones otherwise)
+        bool perStep;
+        /// @brief The vehicles whose collision or arrival stops the command
+        std::set<std::string> watched;
+        /// @brief The vehicle set commands (variable, id and typed value) applied before each step by vehicle id
+        std::vector<std::pair<std::string, std::vector<unsigned char> > > controls;
+        /// @brief The reasons for stopping early (MULTISTEP_COLLISION, MULTISTEP_ARRIVED)
+        int stopFlags;
+        /// @brief The watched vehicles which caused the early stop
+        std::vector<std::string> stopIDs;
+        /// @brief The collected subscription results
+        tcpip::Storage results;
+        /// @brief The number of collected subscription results
+        int numResults;
+        /// @brief The error of a failed control which ended the command (empty if none failed)
+        std::string error;
+    };
+
+
+    /// @brief The delta encoding settings of a client (CMD_SUBSCRIPTION_DELTA)
+    struct DeltaEncoding {
+    public:
+        /// @brief constructor
+        DeltaEncoding() : keyframePeriod(0), epsilon(0.) {}
+        /// @brief The number of results between full results (0 if delta encoding is off)
+        int keyframePeriod;
+        /// @brief The default threshold for numerical values to count as changed
+        double epsilon;
+        /// @brief Variable specific thresholds
+        std::map<int, double> epsilons;
+    };
+
+
+    /// @brief The values of one object of a context subscription (kept for the delta encoding)
+    struct ObjectValues {
+    public:
+        /// @brief constructor
+        ObjectValues(const std::string& idArg) : id(idArg) {}
+        /// @brief The id of the object
+        std::string id;
+        /// @brief The value chunks of all subscribed variables
+        std::vector<unsigned char> values;
+        /// @brief The offsets of the single variables within values
+        std::vector<int> starts;
+    };
+
+
+    /// @brief What a client received last for a context subscription (delta encoding only)
+    struct DeltaState {
+    public:
+        /// @brief constructor
+        DeltaState() : countdown(0) {}
+        /// @brief The last transmitted value chunks per object and variable
+        std::map<std::string, std::vector<std::vector<unsigned char> > > values;
+        /// @brief The number of results until the next full result
+        int countdown;
+    };
+
+
     struct SocketInfo {
     public:
         /// @brief constructor
         SocketInfo(tcpip::Socket* socket, SUMOTime t)
-            : targetTime(t), socket(socket) {}
+            : targetTime(t), socket(socket), multiStep(0) {}
         /// @brief destructor
         ~SocketInfo() {
             delete socket;
+            delete multiStep;
         }
         /// @brief Target time: next point of action for the client
         SUMOTime targetTime;
@@ -300,6 +390,10 @@ private:
         tcpip::Socket* socket;
         /// @brief container for vehicle state changes since last step taken by this client
         std::map<MSNet::VehicleState, std::vector<std::string> > vehicleStateChanges;
+        /// @brief The running multi step command of this client (0 if there is none)
+        MultiStep* multiStep;
+        /// @brief The delta encoding settings of this client
+        DeltaEncoding delta;
     private:
         SocketInfo(const SocketInfo&);
     };
@@ -316,9 +410,54 @@ private:
     /** @brief Handles subscriptions to send after a simstep2 command
      */
     void postProcessSimulationStep();
+
+
+    /** @brief Handles a multi step command
+     * @return Whether the command could be started
+     */
+    bool commandMultiStep();
     /// @}
 
 
+    /// @brief Recomputes the subscription results of the current step into mySubscriptionCache
+    void updateSubscriptionCache();
+
+    /** @brief Writes the subscription results of the current step delta encoded for a single client
+     *
+     * Has to be called after updateSubscriptionCache and only for results which are sent to the client.
+     * @param[in] delta The settings of the client
+     * @param[out] into The storage to write the number of results and the results into
+     */
+    void writeDeltaSubscriptionResults(const DeltaEncoding& delta, tcpip::Storage& into);
+
+    /// @brief Returns the delta encoding settings of the client whose commands are processed
+    DeltaEncoding& getCurrentDeltaEncoding();
+
+    /// @brief Forgets what the client with the given settings received (the next results are full ones)
+    void removeDeltaStates(const DeltaEncoding& delta);
+
+    /// @brief Reads a typed value (atomic or compound) and appends it to the given storage
+    /// @return Whether the type is supported
+    bool copyTypedValue(tcpip::Storage& inputStorage, tcpip::Storage& into);
+
+    /// @brief Applies the vehicle controls of the given multi step command, skipping vehicles which left the simulation
+    /// @param[out] error The description of the first failing control
+    /// @return Whether all controls could be applied
+    bool applyMultiStepControls(const MultiStep& multiStep, std::string& error);
+
+    /// @brief Collects the results of the step just performed
+    /// @param[in] delta The delta encoding settings of the client running the command
+    /// @return Whether the multi step command is finished
+    bool updateMultiStep(MultiStep& multiStep, std::map<MSNet::VehicleState, std::vector<std::string> >& stateChanges,
+                         const DeltaEncoding& delta);
+
+    /// @brief Writes the response to a finished multi step command (the error status if a control failed)
+    void writeMultiStepResponse(MultiStep& multiStep, tcpip::Storage& outputStorage);
+
+    /// @brief Continues or finishes the multi step commands of the clients after a SUMO step
+    void processMultiSteps();
+
+
     /// @brief Reads the next command ID from the input storage
     /// @return the command ID
     /// @param[out] the version with reference parameters provides information on the command start position and length used in dispatchCommand for checking purposes
@@ -338,7 +477,8 @@ private:
     SUMOTime nextTargetTime() const;
 
     /// @brief send out subscription results (actually just the content of myOutputStorage) to clients which will act in this step (i.e. with client target time <= myTargetTime)
-    void sendOutputToAll() const;
+    /// @note clients which finished a multi step command get its response instead
+    void sendOutputToAll();
 
     /// @brief sends an empty response to a simstep command to the current client. (This applies to a situation where the TraCI step frequency is higher than the SUMO step frequency)
     void sendSingleSimStepResponse();
@@ -382,6 +522,12 @@ private:
     /// @brief Whether the server runs in embedded mode
     const bool myAmEmbedded;
 
+    /// @brief Whether supported subscription variables are written without dispatching get commands
+    const bool myNativeSubscriptions;
+
+    /// @brief The delta encoding settings of the client in embedded mode (the clients in mySockets have their own)
+    DeltaEncoding myEmbeddedDelta;
+
     /// @brief Map of commandIds -> their executors; applicable if the executor applies to the method footprint
     std::map<int, CmdExecutor> myExecutors;
 
@@ -410,7 +556,7 @@ private:
                      const std::vector<int>& variablesArg, const std::vector<std::vector<unsigned char> >& paramsArg,
                      SUMOTime beginTimeArg, SUMOTime endTimeArg, bool contextVarsArg, int contextDomainArg, double rangeArg)
             : commandId(commandIdArg), id(idArg), variables(variablesArg), parameters(paramsArg), beginTime(beginTimeArg), endTime(endTimeArg),
-              contextVars(contextVarsArg), contextDomain(contextDomainArg), range(rangeArg) {}
+              contextVars(contextVarsArg), contextDomain(contextDomainArg), range(rangeArg), evaluated(SUMOTime_MIN) {}
 
         /// @brief commandIdArg The command id of the subscription
         int commandId;
@@ -430,6 +576,14 @@ private:
         int contextDomain;
         /// @brief The range of the context
         double range;
+        /// @brief What the clients using delta encoding received last (by their settings)
+        std::map<const DeltaEncoding*, DeltaState> deltaStates;
+        /// @brief The time step the kept results belong to (SUMOTime_MIN if they are not usable)
+        SUMOTime evaluated;
+        /// @brief The full result of the last evaluation (empty if the subscribed object was not found)
+        std::vector<unsigned char> result;
+        /// @brief The values per object of the last evaluation (context subscriptions with delta encoding clients only)
+        std::vector<ObjectValues> objects;
 
     };
 
@@ -454,10 +608,66 @@ private:
 
 private:
     bool addObjectVariableSubscription(const int commandId, const bool hasContext);
-    void initialiseSubscription(const Subscription& s);
+    void initialiseSubscription(Subscription& s);
     void removeSubscription(int commandId, const std::string& identity, int domain);
-    bool processSingleSubscription(const TraCIServer::Subscription& s, tcpip::Storage& writeInto,
-                                   std::string& errors);
+    bool processSingleSubscription(TraCIServer::Subscription& s, tcpip::Storage& writeInto,
+                                   std::string& errors, const DeltaEncoding* delta = 0);
+
+    /** @brief Evaluates the subscription and keeps the results in the subscription
+     *
+     * The values per object are only kept for context subscriptions if a client uses delta encoding.
+     * @param[in, out] s The subscription to evaluate
+     * @param[out] errors The error messages of failing variables
+     * @return Whether all variables could be retrieved
+     */
+    bool evaluateSubscription(TraCIServer::Subscription& s, std::string& errors);
+
+    /** @brief Writes the kept results of a context subscription delta encoded for a single client
+     * @param[in, out] s The evaluated subscription
+     * @param[in] delta The settings of the receiving client
+     * @param[out] writeInto The storage to write the result into
+     */
+    void writeDeltaSubscription(TraCIServer::Subscription& s, const DeltaEncoding& delta, tcpip::Storage& writeInto);
+
+    /// @brief Returns whether any client uses delta encoding
+    bool hasDeltaClients() const;
+
+    /** @brief Writes the changed values of a context subscription's object
+     * @param[in] delta The settings of the receiving client
+     * @param[in, out] state The last values transmitted to the client
+     * @param[in] id The id of the object
+     * @param[in] values The current values of all subscribed variables
+     * @param[in] starts The offsets of the single variables within values
+     * @param[out] into The storage to write the object's entry into
+     * @return Whether an entry was written (the object is new or a value changed)
+     */
+    bool writeDeltaValues(const DeltaEncoding& delta, DeltaState& state, const std::string& id, const std::vector<unsigned char>& values,
+                          const std::vector<int>& starts, tcpip::Storage& into);
+
+    /** @brief Returns whether a value chunk differs from the last transmitted one
+     * @param[in] delta The settings of the receiving client
+     * @param[in] last The last transmitted chunk (variable, status, type, value)
+     * @param[in] current The current chunk
+     * @return Whether the difference exceeds the variable's threshold
+     */
+    bool deltaChanged(const DeltaEncoding& delta, const std::vector<unsigned char>& last, const std::vector<unsigned char>& current) const;
+
+    /** @brief Returns whether all variables of the subscription can be written directly
+     * @param[in] s The subscription to check
+     * @return Whether the domain and all variables are supported and no variable has parameters
+     */
+    bool isNativeSubscription(const TraCIServer::Subscription& s) const;
+
+    /** @brief Writes the values of the subscribed variables of the given object directly
+     * @param[in] domain The get command id of the object's domain
+     * @param[in] id The id of the object
+     * @param[in] variables The variables to write
+     * @param[out] into The storage to write the values into
+     * @param[out] starts If given, receives the offset of each variable's value within into
+     * @return Whether the object is known (nothing is written otherwise)
+     */
+    bool writeNativeValues(int domain, const std::string& id, const std::vector<int>& variables, tcpip::Storage& into,
+                           std::vector<int>* starts = 0);
 
 
     bool findObjectShape(int domain, const std::string& id, PositionVector& shape);
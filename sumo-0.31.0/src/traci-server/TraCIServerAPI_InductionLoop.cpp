@@ -161,6 +161,65 @@ TraCIServerAPI_InductionLoop::getPosition(const std::string& id, Position& p) {
 }
 
 
+bool
+TraCIServerAPI_InductionLoop::isNative(const int variable) {
+    switch (variable) {
+        case VAR_POSITION:
+        case VAR_LANE_ID:
+        case LAST_STEP_VEHICLE_NUMBER:
+        case LAST_STEP_MEAN_SPEED:
+        case LAST_STEP_VEHICLE_ID_LIST:
+        case LAST_STEP_OCCUPANCY:
+        case LAST_STEP_LENGTH:
+        case LAST_STEP_TIME_SINCE_DETECTION:
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+void
+TraCIServerAPI_InductionLoop::writeNative(const int variable, const MSInductLoop* const il, tcpip::Storage& into) {
+    switch (variable) {
+        case VAR_POSITION:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_InductionLoop::getPosition(il));
+            break;
+        case VAR_LANE_ID:
+            into.writeUnsignedByte(TYPE_STRING);
+            into.writeString(TraCI_InductionLoop::getLaneID(il));
+            break;
+        case LAST_STEP_VEHICLE_NUMBER:
+            into.writeUnsignedByte(TYPE_INTEGER);
+            into.writeInt(TraCI_InductionLoop::getLastStepVehicleNumber(il));
+            break;
+        case LAST_STEP_MEAN_SPEED:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_InductionLoop::getLastStepMeanSpeed(il));
+            break;
+        case LAST_STEP_VEHICLE_ID_LIST:
+            into.writeUnsignedByte(TYPE_STRINGLIST);
+            into.writeStringList(TraCI_InductionLoop::getLastStepVehicleIDs(il));
+            break;
+        case LAST_STEP_OCCUPANCY:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_InductionLoop::getLastStepOccupancy(il));
+            break;
+        case LAST_STEP_LENGTH:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_InductionLoop::getLastStepMeanLength(il));
+            break;
+        case LAST_STEP_TIME_SINCE_DETECTION:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_InductionLoop::getTimeSinceDetection(il));
+            break;
+        default:
+            break;
+    }
+}
+
+
 NamedRTree*
 TraCIServerAPI_InductionLoop::getTree() {
     NamedRTree* t = new NamedRTree();
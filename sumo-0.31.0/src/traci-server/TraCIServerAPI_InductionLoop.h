@@ -38,6 +38,12 @@
 #include <foreign/tcpip/storage.h>
 
 
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class MSInductLoop;
+
+
 // ===========================================================================
 // class definitions
 // ===========================================================================
@@ -65,6 +71,23 @@ public:
     static bool getPosition(const std::string& id, Position& p);
 
 
+    /** @brief Returns whether the variable can be written by writeNative
+     * @param[in] variable The variable to check
+     * @return Whether the variable is supported by writeNative
+     */
+    static bool isNative(const int variable);
+
+
+    /** @brief Writes the type and value of a variable directly (used for subscriptions)
+     *
+     * The output equals the one of processGet without the need of building a command.
+     * @param[in] variable The variable to retrieve (one of those accepted by isNative)
+     * @param[in] il The induction loop to retrieve the value for
+     * @param[out] into The storage to write into
+     */
+    static void writeNative(const int variable, const MSInductLoop* const il, tcpip::Storage& into);
+
+
     /** @brief Returns a tree filled with inductive loop instances
      * @return The rtree of inductive loops
      */
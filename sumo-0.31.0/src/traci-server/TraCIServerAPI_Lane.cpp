@@ -348,6 +348,45 @@ TraCIServerAPI_Lane::getShape(const std::string& id, PositionVector& shape) {
 }
 
 
+bool
+TraCIServerAPI_Lane::isNative(const int variable) {
+    switch (variable) {
+        case LAST_STEP_VEHICLE_NUMBER:
+        case LAST_STEP_MEAN_SPEED:
+        case LAST_STEP_OCCUPANCY:
+        case VAR_WAITING_TIME:
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+void
+TraCIServerAPI_Lane::writeNative(const int variable, const MSLane* const lane, tcpip::Storage& into) {
+    switch (variable) {
+        case LAST_STEP_VEHICLE_NUMBER:
+            into.writeUnsignedByte(TYPE_INTEGER);
+            into.writeInt(TraCI_Lane::getLastStepVehicleNumber(lane));
+            break;
+        case LAST_STEP_MEAN_SPEED:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_Lane::getLastStepMeanSpeed(lane));
+            break;
+        case LAST_STEP_OCCUPANCY:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_Lane::getLastStepOccupancy(lane));
+            break;
+        case VAR_WAITING_TIME:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_Lane::getWaitingTime(lane));
+            break;
+        default:
+            break;
+    }
+}
+
+
 void
 TraCIServerAPI_Lane::StoringVisitor::add(const MSLane* const l) const {
     switch (myDomain) {
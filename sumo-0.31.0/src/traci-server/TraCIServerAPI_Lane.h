@@ -41,6 +41,7 @@
 // class declarations
 // ===========================================================================
 class TraCIServer;
+class MSLane;
 
 
 // ===========================================================================
@@ -81,6 +82,23 @@ public:
     static bool getShape(const std::string& id, PositionVector& shape);
 
 
+    /** @brief Returns whether the variable can be written by writeNative
+     * @param[in] variable The variable to check
+     * @return Whether the variable is supported by writeNative
+     */
+    static bool isNative(const int variable);
+
+
+    /** @brief Writes the type and value of a variable directly (used for subscriptions)
+     *
+     * The output equals the one of processGet without the need of building a command.
+     * @param[in] variable The variable to retrieve (one of those accepted by isNative)
+     * @param[in] lane The lane to retrieve the value for
+     * @param[out] into The storage to write into
+     */
+    static void writeNative(const int variable, const MSLane* const lane, tcpip::Storage& into);
+
+
     /** @class StoringVisitor
      * @brief Allows to store the object; used as context while traveling the rtree in TraCI
      */
@@ -211,7 +211,10 @@ TraCIServerAPI_Simulation::processSet(TraCIServer& server, tcpip::Storage& input
     // variable
     int variable = inputStorage.readUnsignedByte();
     if (variable != CMD_CLEAR_PENDING_VEHICLES
-            && variable != CMD_SAVE_SIMSTATE) {
+            && variable != CMD_SAVE_SIMSTATE
+            && variable != CMD_SAVE_SNAPSHOT
+            && variable != CMD_LOAD_SNAPSHOT
+            && variable != CMD_SUBSCRIPTION_DELTA) {
         return server.writeErrorStatusCmd(CMD_SET_SIM_VARIABLE, "Set Simulation Variable: unsupported variable " + toHex(variable, 2) + " specified", outputStorage);
     }
     // id
@@ -236,6 +239,59 @@ TraCIServerAPI_Simulation::processSet(TraCIServer& server, tcpip::Storage& input
             MSStateHandler::saveState(file, MSNet::getInstance()->getCurrentTimeStep());
         }
         break;
+        case CMD_SAVE_SNAPSHOT: {
+            //save current simulation state in memory
+            std::string snapshotID;
+            if (!server.readTypeCheckingString(inputStorage, snapshotID)) {
+                return server.writeErrorStatusCmd(CMD_SET_SIM_VARIABLE, "A string is needed for saving a snapshot.", outputStorage);
+            }
+            TraCI::saveSnapshot(snapshotID);
+        }
+        break;
+        case CMD_LOAD_SNAPSHOT: {
+            //replace the simulation state by a snapshot
+            std::string snapshotID;
+            if (!server.readTypeCheckingString(inputStorage, snapshotID)) {
+                return server.writeErrorStatusCmd(CMD_SET_SIM_VARIABLE, "A string is needed for loading a snapshot.", outputStorage);
+            }
+            try {
+                TraCI::loadSnapshot(snapshotID);
+            } catch (TraCIException& e) {
+                return server.writeErrorStatusCmd(CMD_SET_SIM_VARIABLE, e.what(), outputStorage);
+            }
+            server.stateLoaded(MSNet::getInstance()->getCurrentTimeStep());
+        }
+        break;
+        case CMD_SUBSCRIPTION_DELTA: {
+            //configure the delta encoding of context subscription results
+            if (inputStorage.readUnsignedByte() != TYPE_COMPOUND) {
+                return server.writeErrorStatusCmd(CMD_SET_SIM_VARIABLE, "Configuring subscription deltas requires a compound object.", outputStorage);
+            }
+            const int itemNo = inputStorage.readInt();
+            if (itemNo < 2 || itemNo % 2 != 0) {
+                return server.writeErrorStatusCmd(CMD_SET_SIM_VARIABLE, "Configuring subscription deltas requires the keyframe period, the default threshold and pairs of variable and threshold.", outputStorage);
+            }
+            int keyframePeriod = 0;
+            if (!server.readTypeCheckingInt(inputStorage, keyframePeriod) || keyframePeriod < 0) {
+                return server.writeErrorStatusCmd(CMD_SET_SIM_VARIABLE, "The keyframe period must be given as a non-negative int.", outputStorage);
+            }
+            double epsilon = 0.;
+            if (!server.readTypeCheckingDouble(inputStorage, epsilon)) {
+                return server.writeErrorStatusCmd(CMD_SET_SIM_VARIABLE, "The default threshold must be given as a double.", outputStorage);
+            }
+            std::map<int, double> epsilons;
+            for (int i = 2; i < itemNo; i += 2) {
+                int var = 0;
+                if (!server.readTypeCheckingUnsignedByte(inputStorage, var)) {
+                    return server.writeErrorStatusCmd(CMD_SET_SIM_VARIABLE, "The variable of a threshold must be given as an unsigned byte.", outputStorage);
+                }
+                if (!server.readTypeCheckingDouble(inputStorage, epsilons[var])) {
+                    return server.writeErrorStatusCmd(CMD_SET_SIM_VARIABLE, "A variable's threshold must be given as a double.", outputStorage);
+                }
+            }
+            server.setSubscriptionDelta(keyframePeriod, epsilon, epsilons);
+        }
+        break;
         default:
             break;
     }
@@ -262,24 +318,7 @@ TraCIServerAPI_Simulation::writeVehicleStateIDs(TraCIServer& server, tcpip::Stor
 
 std::pair<MSLane*, double>
 TraCIServerAPI_Simulation::convertCartesianToRoadMap(Position pos) {
-    std::pair<MSLane*, double> result;
-    std::vector<std::string> allEdgeIds;
-    double minDistance = std::numeric_limits<double>::max();
-
-    allEdgeIds = MSNet::getInstance()->getEdgeControl().getEdgeNames();
-    for (std::vector<std::string>::iterator itId = allEdgeIds.begin(); itId != allEdgeIds.end(); itId++) {
-        const std::vector<MSLane*>& allLanes = MSEdge::dictionary((*itId))->getLanes();
-        for (std::vector<MSLane*>::const_iterator itLane = allLanes.begin(); itLane != allLanes.end(); itLane++) {
-            const double newDistance = (*itLane)->getShape().distance2D(pos);
-            if (newDistance < minDistance) {
-                minDistance = newDistance;
-                result.first = (*itLane);
-            }
-        }
-    }
-    // @todo this may be a place where 3D is required but 2D is delivered
-    result.second = result.first->getShape().nearest_offset_to_point2D(pos, false);
-    return result;
+    return TraCI::convertCartesianToRoadMap(pos);
 }
 
 
@@ -51,6 +51,7 @@
 #include <utils/emissions/PollutantsInterface.h>
 #include <utils/emissions/HelpersHarmonoise.h>
 #include <utils/vehicle/SUMOVehicleParameter.h>
+#include <traci-server/lib/TraCI.h>
 #include <traci-server/lib/TraCI_Vehicle.h>
 #include "TraCIConstants.h"
 #include "TraCIServerAPI_Simulation.h"
@@ -114,6 +115,9 @@ TraCIServerAPI_Vehicle::processGet(TraCIServer& server, tcpip::Storage& inputSto
             && variable != VAR_HEIGHT
             && variable != VAR_LINE
             && variable != VAR_VIA
+            && variable != VAR_OCCUPANCY_GRID
+            && variable != VAR_COLUMNS
+            && variable != VAR_NEAREST_VEHICLES
             && variable != CMD_CHANGELANE
        ) {
         return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Get Vehicle Variable: unsupported variable " + toHex(variable, 2) + " specified", outputStorage);
@@ -135,6 +139,24 @@ TraCIServerAPI_Vehicle::processGet(TraCIServer& server, tcpip::Storage& inputSto
                 tempMsg.writeUnsignedByte(TYPE_INTEGER);
                 tempMsg.writeInt(TraCI_Vehicle::getIDCount());
                 break;
+            case VAR_COLUMNS: {
+                if (inputStorage.readUnsignedByte() != TYPE_COMPOUND) {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of columns requires a compound object.", outputStorage);
+                }
+                const int numVars = inputStorage.readInt();
+                std::vector<int> variables;
+                for (int i = 0; i < numVars; ++i) {
+                    int var = 0;
+                    if (!server.readTypeCheckingUnsignedByte(inputStorage, var)) {
+                        return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of columns requires a list of variables given as unsigned bytes.", outputStorage);
+                    }
+                    variables.push_back(var);
+                }
+                if (!writeColumns(variables, tempMsg)) {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of columns is not supported for at least one of the given variables.", outputStorage);
+                }
+            }
+            break;
             case VAR_SPEED:
                 tempMsg.writeUnsignedByte(TYPE_DOUBLE);
                 tempMsg.writeDouble(TraCI_Vehicle::getSpeed(id));
@@ -374,6 +396,83 @@ TraCIServerAPI_Vehicle::processGet(TraCIServer& server, tcpip::Storage& inputSto
                 }
             }
             break;
+            case VAR_NEAREST_VEHICLES: {
+                if (inputStorage.readUnsignedByte() != TYPE_COMPOUND) {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of the nearest vehicles requires a compound object.", outputStorage);
+                }
+                if (inputStorage.readInt() != 2) {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of the nearest vehicles requires the number of vehicles and the search radius as parameter.", outputStorage);
+                }
+                int k = 0;
+                if (!server.readTypeCheckingInt(inputStorage, k)) {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of the nearest vehicles requires the number of vehicles as first parameter.", outputStorage);
+                }
+                double maxDist = 0;
+                if (!server.readTypeCheckingDouble(inputStorage, maxDist)) {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of the nearest vehicles requires the search radius as second parameter.", outputStorage);
+                }
+                const std::vector<TraCINearestVehicleData> nearest = TraCI_Vehicle::getNearestVehicles(id, k, maxDist);
+                tempMsg.writeUnsignedByte(TYPE_COMPOUND);
+                tempMsg.writeInt(1 + (int)nearest.size() * 6);
+                tempMsg.writeUnsignedByte(TYPE_INTEGER);
+                tempMsg.writeInt((int)nearest.size());
+                for (std::vector<TraCINearestVehicleData>::const_iterator it = nearest.begin(); it != nearest.end(); ++it) {
+                    tempMsg.writeUnsignedByte(TYPE_STRING);
+                    tempMsg.writeString(it->id);
+                    tempMsg.writeUnsignedByte(TYPE_DOUBLE);
+                    tempMsg.writeDouble(it->dist);
+                    tempMsg.writeUnsignedByte(TYPE_DOUBLE);
+                    tempMsg.writeDouble(it->relSpeed);
+                    tempMsg.writeUnsignedByte(TYPE_DOUBLE);
+                    tempMsg.writeDouble(it->bearing);
+                    tempMsg.writeUnsignedByte(TYPE_DOUBLE);
+                    tempMsg.writeDouble(it->ttc);
+                    tempMsg.writeUnsignedByte(TYPE_DOUBLE);
+                    tempMsg.writeDouble(it->drac);
+                }
+            }
+            break;
+            case VAR_OCCUPANCY_GRID: {
+                if (inputStorage.readUnsignedByte() != TYPE_COMPOUND) {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of the occupancy grid requires a compound object.", outputStorage);
+                }
+                if (inputStorage.readInt() != 4) {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of the occupancy grid requires width, height, resolution and alignment as parameter.", outputStorage);
+                }
+                int width = 0;
+                if (!server.readTypeCheckingInt(inputStorage, width)) {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of the occupancy grid requires the number of columns as first parameter.", outputStorage);
+                }
+                int height = 0;
+                if (!server.readTypeCheckingInt(inputStorage, height)) {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of the occupancy grid requires the number of rows as second parameter.", outputStorage);
+                }
+                double resolution = 0;
+                if (!server.readTypeCheckingDouble(inputStorage, resolution)) {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of the occupancy grid requires the cell size as third parameter.", outputStorage);
+                }
+                int egoAligned = 0;
+                if (!server.readTypeCheckingUnsignedByte(inputStorage, egoAligned)) {
+                    return server.writeErrorStatusCmd(CMD_GET_VEHICLE_VARIABLE, "Retrieval of the occupancy grid requires the alignment flag as fourth parameter.", outputStorage);
+                }
+                const std::vector<double> grid = TraCI_Vehicle::getOccupancyGrid(id, width, height, resolution, egoAligned != 0);
+                // the cells are packed as big endian floats into a single string
+                tcpip::Storage cells;
+                for (std::vector<double>::const_iterator i = grid.begin(); i != grid.end(); ++i) {
+                    cells.writeFloat((float)(*i));
+                }
+                tempMsg.writeUnsignedByte(TYPE_COMPOUND);
+                tempMsg.writeInt(4);
+                tempMsg.writeUnsignedByte(TYPE_INTEGER);
+                tempMsg.writeInt(width);
+                tempMsg.writeUnsignedByte(TYPE_INTEGER);
+                tempMsg.writeInt(height);
+                tempMsg.writeUnsignedByte(TYPE_INTEGER);
+                tempMsg.writeInt((int)grid.size() / (width * height));
+                tempMsg.writeUnsignedByte(TYPE_STRING);
+                tempMsg.writeString(std::string(cells.begin(), cells.end()));
+            }
+            break;
             case VAR_STOPSTATE:
                 tempMsg.writeUnsignedByte(TYPE_UBYTE);
                 tempMsg.writeUnsignedByte(TraCI_Vehicle::getStopState(id));
@@ -493,6 +592,165 @@ TraCIServerAPI_Vehicle::processGet(TraCIServer& server, tcpip::Storage& inputSto
 }
 
 
+bool
+TraCIServerAPI_Vehicle::writeColumns(const std::vector<int>& variables, tcpip::Storage& into) {
+    int numColumns = 0;
+    for (std::vector<int>::const_iterator v = variables.begin(); v != variables.end(); ++v) {
+        switch (*v) {
+            case VAR_POSITION:
+                numColumns += 2;
+                break;
+            case VAR_POSITION3D:
+                numColumns += 3;
+                break;
+            case VAR_SPEED:
+            case VAR_ANGLE:
+            case VAR_SLOPE:
+            case VAR_LANEPOSITION:
+            case VAR_LANEPOSITION_LAT:
+            case VAR_WAITING_TIME:
+            case VAR_ACCUMULATED_WAITING_TIME:
+            case VAR_SPEED_FACTOR:
+            case VAR_LANE_INDEX:
+            case VAR_ROUTE_INDEX:
+            case VAR_SIGNALS:
+            case VAR_ROAD_ID:
+            case VAR_LANE_ID:
+            case VAR_TYPE:
+            case VAR_ROUTE_ID:
+                numColumns++;
+                break;
+            default:
+                return false;
+        }
+    }
+    // collect the vehicles in the order of TraCI_Vehicle::getIDList
+    std::vector<std::string> ids;
+    std::vector<const MSVehicle*> vehicles;
+    MSVehicleControl& c = MSNet::getInstance()->getVehicleControl();
+    for (MSVehicleControl::constVehIt i = c.runningVehBegin(); i != c.runningVehEnd(); ++i) {
+        if ((*i).second->isOnRoad() || (*i).second->isParking()) {
+            const MSVehicle* veh = dynamic_cast<const MSVehicle*>((*i).second);
+            if (veh == 0) {
+                throw TraCIException("Vehicle '" + (*i).first + "' is not a micro-simulation vehicle");
+            }
+            ids.push_back((*i).first);
+            vehicles.push_back(veh);
+        }
+    }
+    const int num = (int)vehicles.size();
+    into.writeUnsignedByte(TYPE_COMPOUND);
+    into.writeInt(1 + numColumns);
+    into.writeUnsignedByte(TYPE_STRINGLIST);
+    into.writeStringList(ids);
+    for (std::vector<int>::const_iterator v = variables.begin(); v != variables.end(); ++v) {
+        switch (*v) {
+            case VAR_POSITION:
+            case VAR_POSITION3D: {
+                std::vector<TraCIPosition> positions;
+                positions.reserve(num);
+                for (std::vector<const MSVehicle*>::const_iterator i = vehicles.begin(); i != vehicles.end(); ++i) {
+                    positions.push_back(TraCI_Vehicle::getPosition(*i));
+                }
+                into.writeUnsignedByte(TYPE_STRING);
+                into.writeInt(8 * num);
+                for (std::vector<TraCIPosition>::const_iterator p = positions.begin(); p != positions.end(); ++p) {
+                    into.writeDouble(p->x);
+                }
+                into.writeUnsignedByte(TYPE_STRING);
+                into.writeInt(8 * num);
+                for (std::vector<TraCIPosition>::const_iterator p = positions.begin(); p != positions.end(); ++p) {
+                    into.writeDouble(p->y);
+                }
+                if (*v == VAR_POSITION3D) {
+                    into.writeUnsignedByte(TYPE_STRING);
+                    into.writeInt(8 * num);
+                    for (std::vector<TraCIPosition>::const_iterator p = positions.begin(); p != positions.end(); ++p) {
+                        into.writeDouble(p->z);
+                    }
+                }
+            }
+            break;
+            case VAR_LANE_INDEX:
+            case VAR_ROUTE_INDEX:
+            case VAR_SIGNALS:
+                into.writeUnsignedByte(TYPE_STRING);
+                into.writeInt(4 * num);
+                for (std::vector<const MSVehicle*>::const_iterator i = vehicles.begin(); i != vehicles.end(); ++i) {
+                    switch (*v) {
+                        case VAR_LANE_INDEX:
+                            into.writeInt(TraCI_Vehicle::getLaneIndex(*i));
+                            break;
+                        case VAR_ROUTE_INDEX:
+                            into.writeInt(TraCI_Vehicle::getRouteIndex(*i));
+                            break;
+                        default:
+                            into.writeInt(TraCI_Vehicle::getSignalStates(*i));
+                            break;
+                    }
+                }
+                break;
+            case VAR_ROAD_ID:
+            case VAR_LANE_ID:
+            case VAR_TYPE:
+            case VAR_ROUTE_ID:
+                into.writeUnsignedByte(TYPE_STRINGLIST);
+                into.writeInt(num);
+                for (std::vector<const MSVehicle*>::const_iterator i = vehicles.begin(); i != vehicles.end(); ++i) {
+                    switch (*v) {
+                        case VAR_ROAD_ID:
+                            into.writeString(TraCI_Vehicle::getRoadID(*i));
+                            break;
+                        case VAR_LANE_ID:
+                            into.writeString(TraCI_Vehicle::getLaneID(*i));
+                            break;
+                        case VAR_TYPE:
+                            into.writeString(TraCI_Vehicle::getTypeID(*i));
+                            break;
+                        default:
+                            into.writeString(TraCI_Vehicle::getRouteID(*i));
+                            break;
+                    }
+                }
+                break;
+            default:
+                into.writeUnsignedByte(TYPE_STRING);
+                into.writeInt(8 * num);
+                for (std::vector<const MSVehicle*>::const_iterator i = vehicles.begin(); i != vehicles.end(); ++i) {
+                    switch (*v) {
+                        case VAR_SPEED:
+                            into.writeDouble(TraCI_Vehicle::getSpeed(*i));
+                            break;
+                        case VAR_ANGLE:
+                            into.writeDouble(TraCI_Vehicle::getAngle(*i));
+                            break;
+                        case VAR_SLOPE:
+                            into.writeDouble(TraCI_Vehicle::getSlope(*i));
+                            break;
+                        case VAR_LANEPOSITION:
+                            into.writeDouble(TraCI_Vehicle::getLanePosition(*i));
+                            break;
+                        case VAR_LANEPOSITION_LAT:
+                            into.writeDouble(TraCI_Vehicle::getLateralLanePosition(*i));
+                            break;
+                        case VAR_WAITING_TIME:
+                            into.writeDouble(TraCI_Vehicle::getWaitingTime(*i));
+                            break;
+                        case VAR_ACCUMULATED_WAITING_TIME:
+                            into.writeDouble(TraCI_Vehicle::getAccumulatedWaitingTime(*i));
+                            break;
+                        default:
+                            into.writeDouble(TraCI_Vehicle::getSpeedFactor(*i));
+                            break;
+                    }
+                }
+                break;
+        }
+    }
+    return true;
+}
+
+
 bool
 TraCIServerAPI_Vehicle::processSet(TraCIServer& server, tcpip::Storage& inputStorage,
                                    tcpip::Storage& outputStorage) {
@@ -1380,7 +1638,7 @@ TraCIServerAPI_Vehicle::processSet(TraCIServer& server, tcpip::Storage& inputSto
                     found = vtdMap_matchingRoutePosition(pos, origID, *v, bestDistance, &lane, lanePos, routeOffset, edges);
                     // @note silenty ignoring mapping failure
                 } else {
-                    found = vtdMap(pos, maxRouteDistance, mayLeaveNetwork, origID, angle, *v, server, bestDistance, &lane, lanePos, routeOffset, edges);
+                    found = vtdMap(pos, maxRouteDistance, mayLeaveNetwork, origID, angle, *v, bestDistance, &lane, lanePos, routeOffset, edges);
                 }
                 if ((found && bestDistance <= maxRouteDistance) || mayLeaveNetwork) {
                     // optionally compute lateral offset
@@ -1507,14 +1765,16 @@ TraCIServerAPI_Vehicle::processSet(TraCIServer& server, tcpip::Storage& inputSto
 
 
 bool
-TraCIServerAPI_Vehicle::vtdMap(const Position& pos, double maxRouteDistance, bool mayLeaveNetwork, const std::string& origID, const double angle,  MSVehicle& v, TraCIServer& server,
+TraCIServerAPI_Vehicle::vtdMap(const Position& pos, double maxRouteDistance, bool mayLeaveNetwork, const std::string& origID, const double angle,  MSVehicle& v,
                                double& bestDistance, MSLane** lane, double& lanePos, int& routeOffset, ConstMSEdgeVector& edges) {
     // collect edges around the vehicle
     double speed = pos.distanceTo2D(v.getPosition()); // !!!v.getSpeed();
     std::set<std::string> into;
-    PositionVector shape;
-    shape.push_back(pos);
-    server.collectObjectsInRange(CMD_GET_EDGE_VARIABLE, shape, maxRouteDistance, into);
+    std::vector<MSLane*> lanesInRange;
+    TraCI::collectLanesInRange(pos, maxRouteDistance, lanesInRange);
+    for (std::vector<MSLane*>::const_iterator j = lanesInRange.begin(); j != lanesInRange.end(); ++j) {
+        into.insert((*j)->getEdge().getID());
+    }
     double maxDist = 0;
     std::map<MSLane*, LaneUtility> lane2utility;
     // compute utility for all candidate edges
@@ -1805,6 +2065,113 @@ TraCIServerAPI_Vehicle::getPosition(const std::string& id, Position& p) {
 }
 
 
+bool
+TraCIServerAPI_Vehicle::isNative(const int variable) {
+    switch (variable) {
+        case VAR_SPEED:
+        case VAR_POSITION:
+        case VAR_POSITION3D:
+        case VAR_ANGLE:
+        case VAR_SLOPE:
+        case VAR_ROAD_ID:
+        case VAR_LANE_ID:
+        case VAR_LANE_INDEX:
+        case VAR_TYPE:
+        case VAR_ROUTE_ID:
+        case VAR_ROUTE_INDEX:
+        case VAR_LANEPOSITION:
+        case VAR_LANEPOSITION_LAT:
+        case VAR_WAITING_TIME:
+        case VAR_ACCUMULATED_WAITING_TIME:
+        case VAR_SIGNALS:
+        case VAR_SPEED_FACTOR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+void
+TraCIServerAPI_Vehicle::writeNative(const int variable, const MSVehicle* const veh, tcpip::Storage& into) {
+    switch (variable) {
+        case VAR_SPEED:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_Vehicle::getSpeed(veh));
+            break;
+        case VAR_POSITION:
+        case VAR_POSITION3D: {
+            const TraCIPosition pos = TraCI_Vehicle::getPosition(veh);
+            into.writeUnsignedByte(variable == VAR_POSITION ? POSITION_2D : POSITION_3D);
+            into.writeDouble(pos.x);
+            into.writeDouble(pos.y);
+            if (variable == VAR_POSITION3D) {
+                into.writeDouble(pos.z);
+            }
+        }
+        break;
+        case VAR_ANGLE:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_Vehicle::getAngle(veh));
+            break;
+        case VAR_SLOPE:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_Vehicle::getSlope(veh));
+            break;
+        case VAR_ROAD_ID:
+            into.writeUnsignedByte(TYPE_STRING);
+            into.writeString(TraCI_Vehicle::getRoadID(veh));
+            break;
+        case VAR_LANE_ID:
+            into.writeUnsignedByte(TYPE_STRING);
+            into.writeString(TraCI_Vehicle::getLaneID(veh));
+            break;
+        case VAR_LANE_INDEX:
+            into.writeUnsignedByte(TYPE_INTEGER);
+            into.writeInt(TraCI_Vehicle::getLaneIndex(veh));
+            break;
+        case VAR_TYPE:
+            into.writeUnsignedByte(TYPE_STRING);
+            into.writeString(TraCI_Vehicle::getTypeID(veh));
+            break;
+        case VAR_ROUTE_ID:
+            into.writeUnsignedByte(TYPE_STRING);
+            into.writeString(TraCI_Vehicle::getRouteID(veh));
+            break;
+        case VAR_ROUTE_INDEX:
+            into.writeUnsignedByte(TYPE_INTEGER);
+            into.writeInt(TraCI_Vehicle::getRouteIndex(veh));
+            break;
+        case VAR_LANEPOSITION:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_Vehicle::getLanePosition(veh));
+            break;
+        case VAR_LANEPOSITION_LAT:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_Vehicle::getLateralLanePosition(veh));
+            break;
+        case VAR_WAITING_TIME:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_Vehicle::getWaitingTime(veh));
+            break;
+        case VAR_ACCUMULATED_WAITING_TIME:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_Vehicle::getAccumulatedWaitingTime(veh));
+            break;
+        case VAR_SIGNALS:
+            into.writeUnsignedByte(TYPE_INTEGER);
+            into.writeInt(TraCI_Vehicle::getSignalStates(veh));
+            break;
+        case VAR_SPEED_FACTOR:
+            into.writeUnsignedByte(TYPE_DOUBLE);
+            into.writeDouble(TraCI_Vehicle::getSpeedFactor(veh));
+            break;
+        default:
+            break;
+    }
+}
+
+
 #endif
 
 
@@ -47,6 +47,8 @@
  * @brief APIs for getting/setting vehicle values via TraCI
  */
 class TraCIServerAPI_Vehicle {
+    friend class MSSimulationContext;
+
 public:
     /** @brief Processes a get value command (Command 0xa4: Get Vehicle Variable)
      *
@@ -76,8 +78,36 @@ public:
     static bool getPosition(const std::string& id, Position& p);
 
 
+    /** @brief Returns whether the variable can be written by writeNative
+     * @param[in] variable The variable to check
+     * @return Whether the variable is supported by writeNative
+     */
+    static bool isNative(const int variable);
+
+
+    /** @brief Writes the type and value of a variable directly (used for subscriptions)
+     *
+     * The output equals the one of processGet without the need of building a command.
+     * @param[in] variable The variable to retrieve (one of those accepted by isNative)
+     * @param[in] veh The vehicle to retrieve the value for
+     * @param[out] into The storage to write into
+     */
+    static void writeNative(const int variable, const MSVehicle* const veh, tcpip::Storage& into);
+
+
 private:
-    static bool vtdMap(const Position& pos, double maxRouteDistance, bool mayLeaveNetwork, const std::string& origID, const double angle, MSVehicle& v, TraCIServer& server,
+    /** @brief Writes the values of the given variables for all vehicles column by column
+     *
+     * The response is a compound of the vehicle ids followed by one column per variable
+     *  (two for VAR_POSITION, three for VAR_POSITION3D). Numerical columns are packed as
+     *  big endian doubles or integers into a string, textual columns are string lists.
+     * @param[in] variables The variables to retrieve
+     * @param[out] into The storage to write the compound into
+     * @return Whether all given variables are supported
+     */
+    static bool writeColumns(const std::vector<int>& variables, tcpip::Storage& into);
+
+    static bool vtdMap(const Position& pos, double maxRouteDistance, bool mayLeaveNetwork, const std::string& origID, const double angle, MSVehicle& v,
                        double& bestDistance, MSLane** lane, double& lanePos, int& routeOffset, ConstMSEdgeVector& edges);
 
     static bool vtdMap_matchingRoutePosition(const Position& pos, const std::string& origID, MSVehicle& v,
@@ -32,6 +32,8 @@
 #include <config.h>
 #endif
 
+#include <limits>
+#include <utils/common/NamedRTree.h>
 #include <utils/geom/PositionVector.h>
 #include <utils/geom/Position.h>
 #include <utils/common/RGBColor.h>
@@ -42,13 +44,16 @@
 #include <microsim/MSEdgeControl.h>
 #include <microsim/MSFrame.h>
 #include <microsim/MSLane.h>
+#include <microsim/MSNet.h>
 #include <microsim/MSRouteHandler.h>
+#include <microsim/MSStateHandler.h>
 #include "TraCI.h"
 
 // ===========================================================================
 // static member definitions
 // ===========================================================================
 std::vector<std::string> TraCI::myLoadArgs;
+std::map<std::string, std::string> TraCI::mySnapshots;
 
 // ===========================================================================
 // member definitions
@@ -62,6 +67,24 @@ TraCI::load(const std::vector<std::string>& args) {
     myLoadArgs = args;
 }
 
+void
+TraCI::saveSnapshot(const std::string& snapshotID) {
+    mySnapshots[snapshotID] = MSStateHandler::saveSnapshot(MSNet::getInstance()->getCurrentTimeStep());
+}
+
+void
+TraCI::loadSnapshot(const std::string& snapshotID) {
+    std::map<std::string, std::string>::const_iterator i = mySnapshots.find(snapshotID);
+    if (i == mySnapshots.end()) {
+        throw TraCIException("Snapshot '" + snapshotID + "' is not known.");
+    }
+    try {
+        MSStateHandler::loadSnapshot(i->second);
+    } catch (ProcessError& e) {
+        throw TraCIException("Could not load snapshot '" + snapshotID + "': " + e.what());
+    }
+}
+
 void
 TraCI::close() {
 }
@@ -183,21 +206,34 @@ TraCI::getLaneChecking(const std::string& edgeID, int laneIndex, double pos) {
 
 std::pair<MSLane*, double>
 TraCI::convertCartesianToRoadMap(Position pos) {
-    /// XXX use rtree instead
-    std::pair<MSLane*, double> result;
-    std::vector<std::string> allEdgeIds;
+    if (MSLane::dictSize() == 0) {
+        throw TraCIException("The network has no lanes.");
+    }
+    std::pair<MSLane*, double> result(static_cast<MSLane*>(0), 0.);
     double minDistance = std::numeric_limits<double>::max();
-
-    allEdgeIds = MSNet::getInstance()->getEdgeControl().getEdgeNames();
-    for (std::vector<std::string>::iterator itId = allEdgeIds.begin(); itId != allEdgeIds.end(); itId++) {
-        const std::vector<MSLane*>& allLanes = MSEdge::dictionary((*itId))->getLanes();
-        for (std::vector<MSLane*>::const_iterator itLane = allLanes.begin(); itLane != allLanes.end(); itLane++) {
-            const double newDistance = (*itLane)->getShape().distance2D(pos);
+    // every lane closer than the search range intersects the searched box, so the
+    //  closest candidate is the closest lane as soon as it lies within the range
+    double range = 10.;
+    while (result.first == 0 || minDistance > range) {
+        if (result.first != 0) {
+            range = minDistance;
+        }
+        const float cmin[2] = {(float)(pos.x() - range), (float)(pos.y() - range)};
+        const float cmax[2] = {(float)(pos.x() + range), (float)(pos.y() + range)};
+        std::set<std::string> laneIDs;
+        Named::StoringVisitor sv(laneIDs);
+        MSNet::getInstance()->getLanesRTree().Search(cmin, cmax, sv);
+        for (std::set<std::string>::const_iterator i = laneIDs.begin(); i != laneIDs.end(); ++i) {
+            MSLane* const lane = MSLane::dictionary(*i);
+            const double newDistance = lane->getShape().distance2D(pos);
             if (newDistance < minDistance) {
                 minDistance = newDistance;
-                result.first = (*itLane);
+                result.first = lane;
             }
         }
+        if (result.first == 0) {
+            range *= 4.;
+        }
     }
     // @todo this may be a place where 3D is required but 2D is delivered
     result.second = result.first->getShape().nearest_offset_to_point2D(pos, false);
@@ -205,5 +241,21 @@ TraCI::convertCartesianToRoadMap(Position pos) {
 }
 
 
+void
+TraCI::collectLanesInRange(const Position& pos, double range, std::vector<MSLane*>& into) {
+    const float cmin[2] = {(float)(pos.x() - range), (float)(pos.y() - range)};
+    const float cmax[2] = {(float)(pos.x() + range), (float)(pos.y() + range)};
+    std::set<std::string> laneIDs;
+    Named::StoringVisitor sv(laneIDs);
+    MSNet::getInstance()->getLanesRTree().Search(cmin, cmax, sv);
+    for (std::set<std::string>::const_iterator i = laneIDs.begin(); i != laneIDs.end(); ++i) {
+        MSLane* const lane = MSLane::dictionary(*i);
+        if (lane->getShape().distance2D(pos) <= range) {
+            into.push_back(lane);
+        }
+    }
+}
+
+
 
 /****************************************************************************/
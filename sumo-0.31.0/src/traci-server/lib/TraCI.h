@@ -51,6 +51,8 @@ class MSLane;
  * @brief C++ TraCI client API implementation
  */
 class TraCI {
+    friend class MSSimulationContext;
+
 public:
     /// @name Connection handling
     /// @{
@@ -70,6 +72,16 @@ public:
     /// @brief load a simulation with the given arguments
     static void load(const std::vector<std::string>& args);
 
+    /// @name In-memory simulation state snapshots
+    /// @{
+
+    /// @brief Saves the complete simulation state in memory (replacing an older snapshot with the same id)
+    static void saveSnapshot(const std::string& snapshotID);
+
+    /// @brief Replaces the simulation state by the snapshot with the given id
+    static void loadSnapshot(const std::string& snapshotID);
+    /// @}
+
     /// @brief Advances by one step (or up to the given time)
     void simulationStep(SUMOTime time = 0);
 
@@ -98,8 +110,20 @@ public:
 
     static MSEdge* getEdge(const std::string& edgeID);
     static const MSLane* getLaneChecking(const std::string& edgeID, int laneIndex, double pos);
+    /** @brief Returns the lane closest to the given position and the offset of the position along it
+     *
+     * The lane is looked up in the lane index of the network (see MSNet::getLanesRTree)
+     *  by searching within a growing distance of the position.
+     */
     static std::pair<MSLane*, double> convertCartesianToRoadMap(Position pos);
 
+    /** @brief Collects the lanes whose shape is at most the given distance away from the position
+     * @param[in] pos The position to search around
+     * @param[in] range The maximum distance of the lanes
+     * @param[out] into The found lanes (sorted by id)
+     */
+    static void collectLanesInRange(const Position& pos, double range, std::vector<MSLane*>& into);
+
     static std::vector<std::string>& getLoadArgs() {
         return myLoadArgs;
     }
@@ -115,6 +139,9 @@ private:
     SubscribedContextValues mySubscribedContextValues;
 
     static std::vector<std::string> myLoadArgs;
+
+    /// @brief The snapshots taken by saveSnapshot (binary state by id)
+    static std::map<std::string, std::string> mySnapshots;
 };
 
 
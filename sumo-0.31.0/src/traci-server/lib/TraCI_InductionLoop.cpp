@@ -58,49 +58,97 @@ TraCI_InductionLoop::getIDCount() {
 
 double
 TraCI_InductionLoop::getPosition(const std::string& detID) {
-    return getDetector(detID)->getPosition();
+    return getPosition(getDetector(detID));
+}
+
+
+double
+TraCI_InductionLoop::getPosition(const MSInductLoop* il) {
+    return il->getPosition();
 }
 
 
 std::string
 TraCI_InductionLoop::getLaneID(const std::string& detID) {
-    return getDetector(detID)->getLane()->getID();
+    return getLaneID(getDetector(detID));
+}
+
+
+const std::string&
+TraCI_InductionLoop::getLaneID(const MSInductLoop* il) {
+    return il->getLane()->getID();
 }
 
 
 int
 TraCI_InductionLoop::getLastStepVehicleNumber(const std::string& detID) {
-    return getDetector(detID)->getCurrentPassedNumber();
+    return getLastStepVehicleNumber(getDetector(detID));
+}
+
+
+int
+TraCI_InductionLoop::getLastStepVehicleNumber(const MSInductLoop* il) {
+    return il->getCurrentPassedNumber();
 }
 
 
 double
 TraCI_InductionLoop::getLastStepMeanSpeed(const std::string& detID) {
-    return getDetector(detID)->getCurrentSpeed();
+    return getLastStepMeanSpeed(getDetector(detID));
+}
+
+
+double
+TraCI_InductionLoop::getLastStepMeanSpeed(const MSInductLoop* il) {
+    return il->getCurrentSpeed();
 }
 
 
 std::vector<std::string>
 TraCI_InductionLoop::getLastStepVehicleIDs(const std::string& detID) {
-    return getDetector(detID)->getCurrentVehicleIDs();
+    return getLastStepVehicleIDs(getDetector(detID));
+}
+
+
+std::vector<std::string>
+TraCI_InductionLoop::getLastStepVehicleIDs(const MSInductLoop* il) {
+    return il->getCurrentVehicleIDs();
 }
 
 
 double
 TraCI_InductionLoop::getLastStepOccupancy(const std::string& detID) {
-    return getDetector(detID)->getCurrentOccupancy();
+    return getLastStepOccupancy(getDetector(detID));
+}
+
+
+double
+TraCI_InductionLoop::getLastStepOccupancy(const MSInductLoop* il) {
+    return il->getCurrentOccupancy();
 }
 
 
 double
 TraCI_InductionLoop::getLastStepMeanLength(const std::string& detID) {
-    return getDetector(detID)->getCurrentLength();
+    return getLastStepMeanLength(getDetector(detID));
+}
+
+
+double
+TraCI_InductionLoop::getLastStepMeanLength(const MSInductLoop* il) {
+    return il->getCurrentLength();
 }
 
 
 double
 TraCI_InductionLoop::getTimeSinceDetection(const std::string& detID) {
-    return getDetector(detID)->getTimeSinceLastDetection();
+    return getTimeSinceDetection(getDetector(detID));
+}
+
+
+double
+TraCI_InductionLoop::getTimeSinceDetection(const MSInductLoop* il) {
+    return il->getTimeSinceLastDetection();
 }
 
 
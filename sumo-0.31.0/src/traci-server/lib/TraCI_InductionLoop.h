@@ -61,6 +61,16 @@ public:
     static double getTimeSinceDetection(const std::string& detID);
     static std::vector<TraCIVehicleData> getVehicleData(const std::string& detID);
 
+    // Getter for a known detector (used by the getters above and by the subscription writer of the server)
+    static double getPosition(const MSInductLoop* il);
+    static const std::string& getLaneID(const MSInductLoop* il);
+    static int getLastStepVehicleNumber(const MSInductLoop* il);
+    static double getLastStepMeanSpeed(const MSInductLoop* il);
+    static std::vector<std::string> getLastStepVehicleIDs(const MSInductLoop* il);
+    static double getLastStepOccupancy(const MSInductLoop* il);
+    static double getLastStepMeanLength(const MSInductLoop* il);
+    static double getTimeSinceDetection(const MSInductLoop* il);
+
 private:
     static MSInductLoop* getDetector(const std::string& detID);
 
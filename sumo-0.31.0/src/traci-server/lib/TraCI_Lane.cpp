@@ -191,13 +191,25 @@ TraCI_Lane::getElectricityConsumption(std::string laneID) {
 
 double
 TraCI_Lane::getLastStepMeanSpeed(std::string laneID) {
-    return getLane(laneID)->getMeanSpeed();
+    return getLastStepMeanSpeed(getLane(laneID));
+}
+
+
+double
+TraCI_Lane::getLastStepMeanSpeed(const MSLane* lane) {
+    return lane->getMeanSpeed();
 }
 
 
 double
 TraCI_Lane::getLastStepOccupancy(std::string laneID) {
-    return getLane(laneID)->getNettoOccupancy();
+    return getLastStepOccupancy(getLane(laneID));
+}
+
+
+double
+TraCI_Lane::getLastStepOccupancy(const MSLane* lane) {
+    return lane->getNettoOccupancy();
 }
 
 
@@ -219,7 +231,13 @@ TraCI_Lane::getLastStepLength(std::string laneID) {
 
 double
 TraCI_Lane::getWaitingTime(std::string laneID) {
-    return getLane(laneID)->getWaitingSeconds();
+    return getWaitingTime(getLane(laneID));
+}
+
+
+double
+TraCI_Lane::getWaitingTime(const MSLane* lane) {
+    return lane->getWaitingSeconds();
 }
 
 
@@ -237,7 +255,13 @@ TraCI_Lane::getTraveltime(std::string laneID) {
 
 int
 TraCI_Lane::getLastStepVehicleNumber(std::string laneID) {
-    return (int) getLane(laneID)->getVehicleNumber();
+    return getLastStepVehicleNumber(getLane(laneID));
+}
+
+
+int
+TraCI_Lane::getLastStepVehicleNumber(const MSLane* lane) {
+    return (int) lane->getVehicleNumber();
 }
 
 int
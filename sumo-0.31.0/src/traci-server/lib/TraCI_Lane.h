@@ -81,6 +81,12 @@ public:
     static int getLastStepHaltingNumber(std::string laneID);
     static std::vector<std::string> getLastStepVehicleIDs(std::string laneID);
 
+    // Getter for a known lane (used by the getters above and by the subscription writer of the server)
+    static double getLastStepMeanSpeed(const MSLane* lane);
+    static double getLastStepOccupancy(const MSLane* lane);
+    static double getWaitingTime(const MSLane* lane);
+    static int getLastStepVehicleNumber(const MSLane* lane);
+
     // Setter
     static void setAllowed(std::string laneID, std::vector<std::string> allowedClasses);
     static void setDisallowed(std::string laneID, std::vector<std::string> disallowedClasses);
@@ -27,7 +27,9 @@
 #include <config.h>
 #endif
 
+#include <limits>
 #include <utils/geom/GeomHelper.h>
+#include <utils/common/NamedRTree.h>
 #include <utils/common/StringTokenizer.h>
 #include <utils/common/StringUtils.h>
 #include <utils/common/TplConvert.h>
@@ -35,6 +37,7 @@
 #include <microsim/traffic_lights/MSTrafficLightLogic.h>
 #include <microsim/lcmodels/MSAbstractLaneChangeModel.h>
 #include <microsim/devices/MSDevice.h>
+#include <microsim/devices/MSDevice_SSM.h>
 #include <microsim/MSEdgeWeightsStorage.h>
 #include <microsim/MSVehicle.h>
 #include <microsim/MSVehicleControl.h>
@@ -48,6 +51,13 @@
 #include "TraCI_Vehicle.h"
 
 
+// ===========================================================================
+// definitions
+// ===========================================================================
+/// @brief the maximum number of cells of an occupancy grid (three values are sent per cell)
+#define MAX_OCCUPANCY_GRID_CELLS (1 << 20)
+
+
 // ===========================================================================
 // member definitions
 // ===========================================================================
@@ -82,7 +92,7 @@ std::vector<std::string>
 TraCI_Vehicle::getIDList() {
     std::vector<std::string> ids;
     MSVehicleControl& c = MSNet::getInstance()->getVehicleControl();
-    for (MSVehicleControl::constVehIt i = c.loadedVehBegin(); i != c.loadedVehEnd(); ++i) {
+    for (MSVehicleControl::constVehIt i = c.runningVehBegin(); i != c.runningVehEnd(); ++i) {
         if ((*i).second->isOnRoad() || (*i).second->isParking()) {
             ids.push_back((*i).first);
         }
@@ -97,7 +107,12 @@ TraCI_Vehicle::getIDCount() {
 
 double
 TraCI_Vehicle::getSpeed(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getSpeed(getVehicle(vehicleID));
+}
+
+
+double
+TraCI_Vehicle::getSpeed(const MSVehicle* veh) {
     return isVisible(veh) ? veh->getSpeed() : INVALID_DOUBLE_VALUE;
 }
 
@@ -111,7 +126,12 @@ TraCI_Vehicle::getSpeedWithoutTraCI(const std::string& vehicleID) {
 
 TraCIPosition
 TraCI_Vehicle::getPosition(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getPosition(getVehicle(vehicleID));
+}
+
+
+TraCIPosition
+TraCI_Vehicle::getPosition(const MSVehicle* veh) {
     if (isVisible(veh)) {
         return TraCI::makeTraCIPosition(veh->getPosition());
     } else {
@@ -126,51 +146,90 @@ TraCI_Vehicle::getPosition(const std::string& vehicleID) {
 
 double
 TraCI_Vehicle::getAngle(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getAngle(getVehicle(vehicleID));
+}
+
+
+double
+TraCI_Vehicle::getAngle(const MSVehicle* veh) {
     return isVisible(veh) ? GeomHelper::naviDegree(veh->getAngle()) : INVALID_DOUBLE_VALUE;
 }
 
 
 double
 TraCI_Vehicle::getSlope(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getSlope(getVehicle(vehicleID));
+}
+
+
+double
+TraCI_Vehicle::getSlope(const MSVehicle* veh) {
     return veh->isOnRoad() ? veh->getSlope() : INVALID_DOUBLE_VALUE;
 }
 
 
 std::string
 TraCI_Vehicle::getRoadID(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
-    return isVisible(veh) ? veh->getLane()->getEdge().getID() : "";
+    return getRoadID(getVehicle(vehicleID));
+}
+
+
+const std::string&
+TraCI_Vehicle::getRoadID(const MSVehicle* veh) {
+    return isVisible(veh) ? veh->getLane()->getEdge().getID() : StringUtils::emptyString;
 }
 
 
 std::string
 TraCI_Vehicle::getLaneID(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
-    return veh->isOnRoad() ? veh->getLane()->getID() : "";
+    return getLaneID(getVehicle(vehicleID));
+}
+
+
+const std::string&
+TraCI_Vehicle::getLaneID(const MSVehicle* veh) {
+    return veh->isOnRoad() ? veh->getLane()->getID() : StringUtils::emptyString;
 }
 
 
 int
 TraCI_Vehicle::getLaneIndex(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getLaneIndex(getVehicle(vehicleID));
+}
+
+
+int
+TraCI_Vehicle::getLaneIndex(const MSVehicle* veh) {
     return veh->isOnRoad() ? veh->getLane()->getIndex() : INVALID_INT_VALUE;
 }
 
 std::string
 TraCI_Vehicle::getTypeID(const std::string& vehicleID) {
-    return getVehicle(vehicleID)->getVehicleType().getID();
+    return getTypeID(getVehicle(vehicleID));
+}
+
+const std::string&
+TraCI_Vehicle::getTypeID(const MSVehicle* veh) {
+    return veh->getVehicleType().getID();
 }
 
 std::string
 TraCI_Vehicle::getRouteID(const std::string& vehicleID) {
-    return getVehicle(vehicleID)->getRoute().getID();
+    return getRouteID(getVehicle(vehicleID));
+}
+
+const std::string&
+TraCI_Vehicle::getRouteID(const MSVehicle* veh) {
+    return veh->getRoute().getID();
 }
 
 int
 TraCI_Vehicle::getRouteIndex(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getRouteIndex(getVehicle(vehicleID));
+}
+
+int
+TraCI_Vehicle::getRouteIndex(const MSVehicle* veh) {
     return veh->hasDeparted() ? veh->getRoutePosition() : INVALID_INT_VALUE;
 }
 
@@ -181,13 +240,21 @@ TraCI_Vehicle::getColor(const std::string& vehicleID) {
 
 double
 TraCI_Vehicle::getLanePosition(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getLanePosition(getVehicle(vehicleID));
+}
+
+double
+TraCI_Vehicle::getLanePosition(const MSVehicle* veh) {
     return veh->isOnRoad() ? veh->getPositionOnLane() : INVALID_DOUBLE_VALUE;
 }
 
 double
 TraCI_Vehicle::getLateralLanePosition(const std::string& vehicleID) {
-    MSVehicle* veh = getVehicle(vehicleID);
+    return getLateralLanePosition(getVehicle(vehicleID));
+}
+
+double
+TraCI_Vehicle::getLateralLanePosition(const MSVehicle* veh) {
     return veh->isOnRoad() ? veh->getLateralPositionOnLane() : INVALID_DOUBLE_VALUE;
 }
 
@@ -261,13 +328,25 @@ TraCI_Vehicle::getLeader(const std::string& vehicleID, double dist) {
 
 double
 TraCI_Vehicle::getWaitingTime(const std::string& vehicleID) {
-    return getVehicle(vehicleID)->getWaitingSeconds();
+    return getWaitingTime(getVehicle(vehicleID));
+}
+
+
+double
+TraCI_Vehicle::getWaitingTime(const MSVehicle* veh) {
+    return veh->getWaitingSeconds();
 }
 
 
 double
 TraCI_Vehicle::getAccumulatedWaitingTime(const std::string& vehicleID) {
-    return getVehicle(vehicleID)->getAccumulatedWaitingSeconds();
+    return getAccumulatedWaitingTime(getVehicle(vehicleID));
+}
+
+
+double
+TraCI_Vehicle::getAccumulatedWaitingTime(const MSVehicle* veh) {
+    return veh->getAccumulatedWaitingSeconds();
 }
 
 
@@ -311,7 +390,12 @@ TraCI_Vehicle::getEdges(const std::string& vehicleID) {
 
 int
 TraCI_Vehicle::getSignalStates(const std::string& vehicleID) {
-    return getVehicle(vehicleID)->getSignals();
+    return getSignalStates(getVehicle(vehicleID));
+}
+
+int
+TraCI_Vehicle::getSignalStates(const MSVehicle* veh) {
+    return veh->getSignals();
 }
 
 std::vector<TraCIBestLanesData>
@@ -372,6 +456,131 @@ TraCI_Vehicle::getNextTLS(const std::string& vehicleID) {
     return result;
 }
 
+
+std::vector<TraCINearestVehicleData>
+TraCI_Vehicle::getNearestVehicles(const std::string& vehicleID, int k, double maxDist) {
+    if (k < 0) {
+        throw TraCIException("The number of nearest vehicles must not be negative.");
+    }
+    std::vector<TraCINearestVehicleData> result;
+    MSVehicle* ego = getVehicle(vehicleID);
+    if (!ego->isOnRoad() || k == 0) {
+        return result;
+    }
+    const KDTree<const SUMOVehicle*>& index = MSNet::getInstance()->getVehicleControl().getPositionIndex();
+    std::vector<KDTree<const SUMOVehicle*>::Neighbor> neighbors;
+    index.nearest(ego->getPosition(), k, maxDist > 0 ? maxDist : std::numeric_limits<double>::max(), ego, neighbors);
+    const Position egoPos = ego->getPosition();
+    const Position egoVel = ego->getVelocityVector();
+    const double egoLength = ego->getVehicleType().getLength();
+    for (std::vector<KDTree<const SUMOVehicle*>::Neighbor>::const_iterator i = neighbors.begin(); i != neighbors.end(); ++i) {
+        const MSVehicle* const other = static_cast<const MSVehicle*>(i->second);
+        const Position otherPos = other->getPosition();
+        const Position otherVel = other->getVelocityVector();
+        TraCINearestVehicleData nvd;
+        nvd.id = other->getID();
+        nvd.dist = i->first;
+        nvd.relSpeed = 0.;
+        if (nvd.dist > 0.) {
+            const double dx = otherPos.x() - egoPos.x();
+            const double dy = otherPos.y() - egoPos.y();
+            nvd.relSpeed = ((otherVel.x() - egoVel.x()) * dx + (otherVel.y() - egoVel.y()) * dy) / nvd.dist;
+        }
+        const double relAngle = GeomHelper::angleDiff(ego->getAngle(), atan2(otherPos.y() - egoPos.y(), otherPos.x() - egoPos.x()));
+        // angleDiff is counterclockwise, the bearing is clockwise like the vehicle angle
+        nvd.bearing = fmod(360. - RAD2DEG(relAngle), 360.);
+        const double headingDiff = GeomHelper::angleDiff(ego->getAngle(), other->getAngle());
+        double ttc;
+        double drac;
+        if (fabs(relAngle) < M_PI / 2.) {
+            // the other vehicle is ahead, its front is one vehicle length further than its back
+            const double gap = nvd.dist - other->getVehicleType().getLength();
+            const double leaderSpeed = other->getSpeed() * cos(headingDiff);
+            ttc = MSDevice_SSM::computeTTC(gap, ego->getSpeed(), leaderSpeed);
+            drac = MSDevice_SSM::computeDRAC(gap, ego->getSpeed(), leaderSpeed);
+        } else {
+            const double gap = nvd.dist - egoLength;
+            const double leaderSpeed = ego->getSpeed() * cos(headingDiff);
+            ttc = MSDevice_SSM::computeTTC(gap, other->getSpeed(), leaderSpeed);
+            drac = MSDevice_SSM::computeDRAC(gap, other->getSpeed(), leaderSpeed);
+        }
+        nvd.ttc = ttc == std::numeric_limits<double>::max() ? INVALID_DOUBLE_VALUE : ttc;
+        nvd.drac = drac == std::numeric_limits<double>::max() ? INVALID_DOUBLE_VALUE : drac;
+        result.push_back(nvd);
+    }
+    return result;
+}
+
+
+std::vector<double>
+TraCI_Vehicle::getOccupancyGrid(const std::string& vehicleID, int width, int height, double resolution, bool egoAligned) {
+    if (width <= 0 || height <= 0 || resolution <= 0) {
+        throw TraCIException("The occupancy grid needs a positive size and resolution.");
+    }
+    // the client controls the size, so compute the product without overflow before allocating
+    if ((long long)width * (long long)height > MAX_OCCUPANCY_GRID_CELLS) {
+        throw TraCIException("The occupancy grid must not have more than " + toString(MAX_OCCUPANCY_GRID_CELLS) + " cells.");
+    }
+    MSVehicle* ego = getVehicle(vehicleID);
+    const int numCells = width * height;
+    std::vector<double> result(3 * numCells, 0.);
+    if (!ego->isOnRoad()) {
+        return result;
+    }
+    const Position egoPos = ego->getPosition();
+    const double upAngle = egoAligned ? ego->getAngle() : M_PI / 2.;
+    const double upX = cos(upAngle);
+    const double upY = sin(upAngle);
+    // collect the vehicles on all lanes close enough to touch the grid (sorted by id for determinism)
+    const double range = 0.5 * resolution * sqrt((double)width * width + (double)height * height);
+    const float cmin[2] = {(float)(egoPos.x() - range), (float)(egoPos.y() - range)};
+    const float cmax[2] = {(float)(egoPos.x() + range), (float)(egoPos.y() + range)};
+    std::set<std::string> laneIDs;
+    Named::StoringVisitor sv(laneIDs);
+    MSNet::getInstance()->getLanesRTree().Search(cmin, cmax, sv);
+    std::map<std::string, const MSVehicle*> vehicles;
+    for (std::set<std::string>::const_iterator i = laneIDs.begin(); i != laneIDs.end(); ++i) {
+        const MSLane* lane = MSLane::dictionary(*i);
+        lane->getVehiclesSecure();
+        for (MSLane::AnyVehicleIterator v = lane->anyVehiclesBegin(); v != lane->anyVehiclesEnd(); ++v) {
+            if (*v != ego) {
+                vehicles[(*v)->getID()] = *v;
+            }
+        }
+        lane->releaseVehicles();
+    }
+    // rasterize the bounding polygons in grid coordinates (one unit per cell, y pointing down)
+    for (std::map<std::string, const MSVehicle*>::const_iterator i = vehicles.begin(); i != vehicles.end(); ++i) {
+        const MSVehicle* veh = i->second;
+        const PositionVector poly = veh->getBoundingPoly();
+        PositionVector gridPoly;
+        for (PositionVector::const_iterator p = poly.begin(); p != poly.end(); ++p) {
+            const double dx = p->x() - egoPos.x();
+            const double dy = p->y() - egoPos.y();
+            gridPoly.push_back(Position(0.5 * width + (dx * upY - dy * upX) / resolution,
+                                        0.5 * height - (dx * upX + dy * upY) / resolution));
+        }
+        const Boundary b = gridPoly.getBoxBoundary();
+        const int colMin = MAX2(0, (int)floor(b.xmin()));
+        const int colMax = MIN2(width - 1, (int)floor(b.xmax()));
+        const int rowMin = MAX2(0, (int)floor(b.ymin()));
+        const int rowMax = MIN2(height - 1, (int)floor(b.ymax()));
+        const double speed = veh->getSpeed();
+        const double heading = fmod(RAD2DEG(upAngle - veh->getAngle()) + 720., 360.);
+        for (int row = rowMin; row <= rowMax; ++row) {
+            for (int col = colMin; col <= colMax; ++col) {
+                if (gridPoly.around(Position(col + 0.5, row + 0.5))) {
+                    const int index = row * width + col;
+                    result[index] = 1.;
+                    result[numCells + index] = speed;
+                    result[2 * numCells + index] = heading;
+                }
+            }
+        }
+    }
+    return result;
+}
+
 int
 TraCI_Vehicle::getStopState(const std::string& vehicleID) {
     MSVehicle* veh = getVehicle(vehicleID);
@@ -451,7 +660,13 @@ TraCI_Vehicle::getAllowedSpeed(const std::string& vehicleID) {
 
 double
 TraCI_Vehicle::getSpeedFactor(const std::string& vehicleID) {
-    return getVehicle(vehicleID)->getChosenSpeedFactor();
+    return getSpeedFactor(getVehicle(vehicleID));
+}
+
+
+double
+TraCI_Vehicle::getSpeedFactor(const MSVehicle* veh) {
+    return veh->getChosenSpeedFactor();
 }
 
 
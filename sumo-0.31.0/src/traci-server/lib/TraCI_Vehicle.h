@@ -90,6 +90,31 @@ public:
     static int getSignalStates(const std::string& vehicleID);
     static std::vector<TraCIBestLanesData> getBestLanes(const std::string& vehicleID);
     static std::vector<TraCINextTLSData> getNextTLS(const std::string& vehicleID);
+    /** @brief Returns the nearest vehicles with surrogate safety measures
+     *
+     * The vehicles are found in the per-step spatial index of the vehicle control.
+     *  Time to collision and deceleration rate to avoid a crash are computed as
+     *  by the SSM device, using the other vehicle's speed component along the
+     *  heading of the respective follower.
+     * @param[in] vehicleID The vehicle to search around
+     * @param[in] k The maximum number of vehicles to return
+     * @param[in] maxDist The search radius in m (unlimited if not positive)
+     * @return The vehicles sorted by ascending distance
+     */
+    static std::vector<TraCINearestVehicleData> getNearestVehicles(const std::string& vehicleID, int k, double maxDist);
+    /** @brief Returns an occupancy grid of the surrounding vehicles
+     *
+     * The grid consists of three channels (occupancy, speed, heading relative to the grid's
+     *  upward direction in degrees) of height x width cells each, stored channel by channel
+     *  and row by row with the first row being the upmost one. The given vehicle is located
+     *  in the grid's center and not rasterized itself.
+     * @param[in] vehicleID The vehicle to build the grid around
+     * @param[in] width The number of columns
+     * @param[in] height The number of rows
+     * @param[in] resolution The edge length of a cell in m
+     * @param[in] egoAligned Whether the grid is rotated to point into the vehicle's direction (or north otherwise)
+     */
+    static std::vector<double> getOccupancyGrid(const std::string& vehicleID, int width, int height, double resolution, bool egoAligned);
     static int getStopState(const std::string& vehicleID);
     static double getDistance(const std::string& vehicleID);
     static double getDrivingDistance(const std::string& vehicleID, const std::string& edgeID, double position, int laneIndex);
@@ -122,6 +147,26 @@ public:
 
     /// @}
 
+    /// @name Value retrieval for a known vehicle (used by the getters above and by the subscription and column writers of the server)
+    /// @{
+    static double getSpeed(const MSVehicle* veh);
+    static TraCIPosition getPosition(const MSVehicle* veh);
+    static double getAngle(const MSVehicle* veh);
+    static double getSlope(const MSVehicle* veh);
+    static const std::string& getRoadID(const MSVehicle* veh);
+    static const std::string& getLaneID(const MSVehicle* veh);
+    static int getLaneIndex(const MSVehicle* veh);
+    static const std::string& getTypeID(const MSVehicle* veh);
+    static const std::string& getRouteID(const MSVehicle* veh);
+    static int getRouteIndex(const MSVehicle* veh);
+    static double getLanePosition(const MSVehicle* veh);
+    static double getLateralLanePosition(const MSVehicle* veh);
+    static double getWaitingTime(const MSVehicle* veh);
+    static double getAccumulatedWaitingTime(const MSVehicle* veh);
+    static int getSignalStates(const MSVehicle* veh);
+    static double getSpeedFactor(const MSVehicle* veh);
+    /// @}
+
     /// @name State Changing
     /// @{
 
@@ -30,6 +30,7 @@
 #endif
 
 #include <ctime>
+#include <sstream>
 #include <utils/options/OptionsCont.h>
 #include <utils/common/SysUtils.h>
 #include "RandHelper.h"
@@ -80,5 +81,26 @@ RandHelper::initRandGlobal(std::mt19937* which) {
 }
 
 
+std::string
+RandHelper::saveState(std::mt19937* which) {
+    if (which == 0) {
+        which = &myRandomNumberGenerator;
+    }
+    std::ostringstream oss;
+    oss << *which;
+    return oss.str();
+}
+
+
+void
+RandHelper::loadState(const std::string& state, std::mt19937* which) {
+    if (which == 0) {
+        which = &myRandomNumberGenerator;
+    }
+    std::istringstream iss(state);
+    iss >> *which;
+}
+
+
 /****************************************************************************/
 
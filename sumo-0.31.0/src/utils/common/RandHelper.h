@@ -33,6 +33,7 @@
 #endif
 
 #include <cassert>
+#include <string>
 #include <vector>
 #include <random>
 
@@ -51,6 +52,8 @@ class OptionsCont;
  * @brief Utility functions for using a global, resetable random number generator
  */
 class RandHelper {
+    friend class MSSimulationContext;
+
 public:
     /// @brief Initialises the given options container with random number options
     static void insertRandOptions();
@@ -61,6 +64,12 @@ public:
     /// @brief Reads the given random number options and initialises the random number generator in accordance
     static void initRandGlobal(std::mt19937* which = 0);
 
+    /// @brief Returns the internal state of the given random number generator as a string
+    static std::string saveState(std::mt19937* which = 0);
+
+    /// @brief Restores the internal state of the given random number generator from a string written by saveState
+    static void loadState(const std::string& state, std::mt19937* which = 0);
+
     /// @brief Returns a random real number in [0, 1)
     static inline double rand(std::mt19937* rng = 0) {
         if (rng == 0) {
@@ -0,0 +1,423 @@
+/****************************************************************************/
+/// @file    SUMOWorkerThread.h
+/// @date    Oct 2017
+/// @version $Id$
+///
+// A thread class together with a pool and a task for parallelized computation
+//  which only depends on the standard library
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef SUMOWorkerThread_h
+#define SUMOWorkerThread_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class SUMOWorkerThread
+ * @brief A thread repeatingly calculating incoming tasks
+ *
+ * This is the counterpart of FXWorkerThread for code which has to run in
+ *  parallel also when compiled without FOX (e.g. the routing of sumo and
+ *  duarouter). Subclasses may hold data which is private to the thread
+ *  (like a router clone) and is made available to the tasks via the context.
+ *
+ * Tasks which are added without a worker index go to a queue which is shared
+ *  by all threads of the pool, so an idle thread always picks up the next
+ *  pending task instead of waiting for tasks assigned to it in advance.
+ *  Tasks with a worker index are run by this worker only, in the order they
+ *  were added (this is needed for tasks which change the state of the thread).
+ *
+ * The constructor only registers the worker with its pool. The underlying
+ *  thread is started by the pool when the next task is added or waited for,
+ *  so a subclass is completely constructed before it can pick up any of the
+ *  pending tasks.
+ */
+class SUMOWorkerThread {
+
+public:
+    class Pool;
+
+    /**
+     * @class SUMOWorkerThread::Task
+     * @brief Abstract superclass of a task to be run with an index to keep track of pending tasks
+     */
+    class Task {
+    public:
+        /// @brief Destructor
+        virtual ~Task() {};
+
+        /** @brief Abstract method which in subclasses should contain the computations to be performed.
+         *
+         * If there is data to be shared among several tasks (but not among several threads) it can be put in
+         *  a thread class subclassing the SUMOWorkerThread. The instance of the thread is then made available
+         *  via the context parameter.
+         *
+         * @param[in] context The thread which runs the task
+         */
+        virtual void run(SUMOWorkerThread* context) = 0;
+
+        /** @brief Sets the running index of this task.
+         *
+         * Every task receives an index which is unique among all pending tasks of the same thread pool.
+         *
+         * @param[in] newIndex the index to assign
+         */
+        void setIndex(const int newIndex) {
+            myIndex = newIndex;
+            myFinished = false;
+        }
+
+        /// @brief Returns the running index of this task
+        int getIndex() const {
+            return myIndex;
+        }
+
+    private:
+        /// @brief the index of the task, valid only after the task has been added to the pool
+        int myIndex;
+        /// @brief whether the task has been run (guarded by the internal mutex of the pool)
+        bool myFinished;
+
+        friend class Pool;
+    };
+
+    /**
+     * @class SUMOWorkerThread::Pool
+     * @brief A pool of worker threads which distributes the tasks and collects the results
+     */
+    class Pool {
+    public:
+        /** @brief Constructor
+         *
+         * May initialize the pool with a given number of workers.
+         *
+         * @param[in] numThreads the number of threads to create
+         */
+        Pool(int numThreads = 0) : myRunningIndex(0), myNumFinished(0) {
+            while (numThreads > 0) {
+                new SUMOWorkerThread(*this);
+                numThreads--;
+            }
+            std::lock_guard<std::mutex> guard(myMutex);
+            startWorkers();
+        }
+
+        /** @brief Destructor
+         *
+         * Stopping and deleting all workers by calling clear.
+         */
+        virtual ~Pool() {
+            clear();
+        }
+
+        /** @brief Stops and deletes all worker threads.
+         *
+         * The currently running tasks will be finished but all pending tasks are discarded.
+         *  All threads are stopped before the first one is deleted, so no task may
+         *  run while the data of a worker is destroyed.
+         */
+        void clear() {
+            std::unique_lock<std::mutex> lock(myMutex);
+            for (SUMOWorkerThread* const w : myWorkers) {
+                w->myStopped = true;
+            }
+            myTaskCondition.notify_all();
+            lock.unlock();
+            for (SUMOWorkerThread* const w : myWorkers) {
+                if (w->myThread.joinable()) {
+                    w->myThread.join();
+                }
+            }
+            lock.lock();
+            for (SUMOWorkerThread* const w : myWorkers) {
+                for (Task* const task : w->myTasks) {
+                    delete task;
+                }
+                delete w;
+            }
+            myWorkers.clear();
+            for (Task* const task : myTasks) {
+                delete task;
+            }
+            myTasks.clear();
+            for (Task* const task : myFinishedTasks) {
+                delete task;
+            }
+            myFinishedTasks.clear();
+            myRunningIndex = 0;
+            myNumFinished = 0;
+        }
+
+        /** @brief Adds the given thread to the pool.
+         *
+         * The thread is not started before the next call to add, waitAll or waitFor.
+         * @param[in] w the thread to add
+         */
+        void addWorker(SUMOWorkerThread* const w) {
+            std::lock_guard<std::mutex> guard(myMutex);
+            myWorkers.push_back(w);
+        }
+
+        /** @brief Gives a number to the given task and assigns it to the worker with the given index.
+         * If the index is negative, the task is queued for the next idle worker.
+         *
+         * @param[in] t the task to add
+         * @param[in] index index of the worker thread to use or -1 for an arbitrary one
+         */
+        void add(Task* const t, int index = -1) {
+            std::lock_guard<std::mutex> guard(myMutex);
+            startWorkers();
+            t->setIndex(myRunningIndex++);
+            if (index < 0) {
+                myTasks.push_back(t);
+                myTaskCondition.notify_one();
+            } else {
+                myWorkers[index % myWorkers.size()]->myTasks.push_back(t);
+                // the assigned worker may not be the one which wakes up on notify_one
+                myTaskCondition.notify_all();
+            }
+        }
+
+        /// @brief waits for all tasks to be finished
+        void waitAll(const bool deleteFinished = true) {
+            std::unique_lock<std::mutex> lock(myMutex);
+            startWorkers();
+            while (myNumFinished < myRunningIndex) {
+                myFinishedCondition.wait(lock);
+            }
+            if (deleteFinished) {
+                for (Task* const task : myFinishedTasks) {
+                    delete task;
+                }
+            }
+            myFinishedTasks.clear();
+            myRunningIndex = 0;
+            myNumFinished = 0;
+        }
+
+        /** @brief Waits for the given task to be finished and removes it from the finished tasks.
+         *
+         * The caller takes over the ownership of the task (it will not be deleted by waitAll or clear).
+         *  The task counters are not reset, so this can be mixed with waitAll.
+         *
+         * @param[in] t the task to wait for
+         */
+        void waitFor(Task* const t) {
+            std::unique_lock<std::mutex> lock(myMutex);
+            startWorkers();
+            while (!t->myFinished) {
+                myFinishedCondition.wait(lock);
+            }
+            // tasks usually finish in the order they were added, so the search is short
+            for (std::list<Task*>::iterator i = myFinishedTasks.begin(); i != myFinishedTasks.end(); ++i) {
+                if (*i == t) {
+                    myFinishedTasks.erase(i);
+                    break;
+                }
+            }
+        }
+
+        /** @brief Checks whether there are currently at least as many pending tasks as threads.
+         *
+         * @return whether there are enough tasks to let all threads work
+         */
+        bool isFull() const {
+            std::lock_guard<std::mutex> guard(myMutex);
+            return myRunningIndex - myNumFinished >= (int)myWorkers.size();
+        }
+
+        /** @brief Returns the number of threads in the pool.
+         *
+         * @return the number of threads
+         */
+        int size() const {
+            return (int)myWorkers.size();
+        }
+
+        /// @brief locks the pool mutex
+        void lock() {
+            myPoolMutex.lock();
+        }
+
+        /// @brief unlocks the pool mutex
+        void unlock() {
+            myPoolMutex.unlock();
+        }
+
+    private:
+        /** @brief Starts the threads of all workers which were added since the last call.
+         *
+         * The internal mutex has to be locked, the new threads block on it until it is released.
+         */
+        void startWorkers() {
+            for (SUMOWorkerThread* const w : myWorkers) {
+                if (!w->myStopped && !w->myThread.joinable()) {
+                    w->myThread = std::thread(&SUMOWorkerThread::run, w);
+                }
+            }
+        }
+
+        /** @brief Returns the next task for the given worker or 0 if there is none.
+         *
+         * The tasks assigned to the worker come first. The internal mutex has to be locked.
+         *
+         * @param[in] w the worker asking for a task
+         * @return the task to run
+         */
+        Task* next(SUMOWorkerThread* const w) {
+            std::deque<Task*>& tasks = w->myTasks.empty() ? myTasks : w->myTasks;
+            if (tasks.empty()) {
+                return 0;
+            }
+            Task* const t = tasks.front();
+            tasks.pop_front();
+            return t;
+        }
+
+        /** @brief Adds the given task to the list of finished tasks.
+         *
+         * The internal mutex has to be locked.
+         *
+         * @param[in] t the finished task
+         */
+        void addFinished(Task* const t) {
+            myNumFinished++;
+            t->myFinished = true;
+            myFinishedTasks.push_back(t);
+            // someone may wait for this single task (see waitFor)
+            myFinishedCondition.notify_all();
+        }
+
+    private:
+        /// @brief the current worker threads
+        std::vector<SUMOWorkerThread*> myWorkers;
+        /// @brief the internal mutex for the task lists and the counters
+        mutable std::mutex myMutex;
+        /// @brief the pool mutex for external sync
+        std::recursive_mutex myPoolMutex;
+        /// @brief the condition the idle workers wait on for new tasks
+        std::condition_variable myTaskCondition;
+        /// @brief the condition to wait on for finishing all tasks
+        std::condition_variable myFinishedCondition;
+        /// @brief the tasks which may be run by any worker
+        std::deque<Task*> myTasks;
+        /// @brief list of finished tasks
+        std::list<Task*> myFinishedTasks;
+        /// @brief the running index for the next task
+        int myRunningIndex;
+        /// @brief the number of finished tasks (is reset when the pool runs empty)
+        int myNumFinished;
+
+        friend class SUMOWorkerThread;
+    };
+
+public:
+    /** @brief Constructor
+     *
+     * Adds the thread to the given pool, which starts it when the next task arrives.
+     *
+     * @param[in] pool the pool for this thread
+     */
+    SUMOWorkerThread(Pool& pool): myPool(pool), myStopped(false), myCounter(0) {
+        pool.addWorker(this);
+    }
+
+    /** @brief Destructor
+     *
+     * Stops the thread by calling stop.
+     */
+    virtual ~SUMOWorkerThread() {
+        stop();
+    }
+
+    /** @brief Stops the thread
+     *
+     * The currently running task will be finished but all further tasks are discarded.
+     *  Subclasses which hold data used by the tasks should call this in their destructor.
+     */
+    void stop() {
+        if (myThread.joinable()) {
+            {
+                std::lock_guard<std::mutex> guard(myPool.myMutex);
+                myStopped = true;
+                myPool.myTaskCondition.notify_all();
+            }
+            myThread.join();
+        }
+    }
+
+    /// @brief Returns the number of tasks this thread has completed
+    int getCounter() const {
+        return myCounter;
+    }
+
+private:
+    /** @brief Main execution method of this thread.
+     *
+     * Checks for new tasks, calculates them and puts them in the finished list of the pool until being stopped.
+     */
+    void run() {
+        std::unique_lock<std::mutex> lock(myPool.myMutex);
+        while (true) {
+            Task* t = 0;
+            while (!myStopped && (t = myPool.next(this)) == 0) {
+                myPool.myTaskCondition.wait(lock);
+            }
+            if (myStopped) {
+                break;
+            }
+            lock.unlock();
+            t->run(this);
+            myCounter++;
+            lock.lock();
+            myPool.addFinished(t);
+        }
+    }
+
+private:
+    /// @brief the pool for this thread
+    Pool& myPool;
+    /// @brief the underlying thread
+    std::thread myThread;
+    /// @brief the list of pending tasks assigned to this thread
+    std::deque<Task*> myTasks;
+    /// @brief whether we are still running (guarded by the internal mutex of the pool)
+    bool myStopped;
+    /// @brief counting completed tasks for debugging / profiling
+    int myCounter;
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -59,6 +59,22 @@ SysUtils::getCurrentMillis() {
 }
 
 
+long long int
+SysUtils::getCurrentMicros() {
+#ifndef WIN32
+    timeval current;
+    gettimeofday(&current, 0);
+    return (long long int) current.tv_sec * 1000000LL + (long long int) current.tv_usec;
+#else
+    LARGE_INTEGER val, val2;
+    QueryPerformanceCounter(&val);
+    QueryPerformanceFrequency(&val2);
+    // split to avoid an overflow for long uptimes
+    return (long long int)(val.QuadPart / val2.QuadPart * 1000000 + val.QuadPart % val2.QuadPart * 1000000 / val2.QuadPart);
+#endif
+}
+
+
 #ifdef _MSC_VER
 long
 SysUtils::getWindowsTicks() {
@@ -46,6 +46,12 @@ public:
     static long getCurrentMillis();
 
 
+    /** @brief Returns the current time in microseconds (for measuring short durations)
+     * @return Current time
+     */
+    static long long int getCurrentMicros();
+
+
 #ifdef _MSC_VER
     /** @brief Returns the CPU ticks (windows only)
      *
@@ -0,0 +1,82 @@
+/****************************************************************************/
+/// @file    FXConditionalLock.h
+/// @date    Oct 2017
+/// @version $Id$
+///
+// A scoped lock which only triggers on condition
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef FXConditionalLock_h
+#define FXConditionalLock_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <fx.h>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class FXConditionalLock
+ * @brief A scoped lock which only triggers on condition
+ *
+ * Avoids the locking overhead for data which is only accessed concurrently
+ *  in some configurations (e.g. when running with several threads).
+ */
+class FXConditionalLock {
+public:
+    /// @brief Constructor, locks the mutex if the condition holds
+    FXConditionalLock(FXMutex& fxMutex, const bool condition)
+        : myMutex(fxMutex), myCondition(condition) {
+        if (condition) {
+            fxMutex.lock();
+        }
+    }
+
+    /// @brief Destructor, unlocks the mutex if it was locked
+    ~FXConditionalLock() {
+        if (myCondition) {
+            myMutex.unlock();
+        }
+    }
+
+private:
+    /// @brief the guarded mutex
+    FXMutex& myMutex;
+
+    /// @brief whether the mutex is locked
+    const bool myCondition;
+
+private:
+    /// @brief invalidated copy constructor
+    FXConditionalLock(const FXConditionalLock&);
+
+    /// @brief invalidated assignment operator
+    FXConditionalLock& operator=(const FXConditionalLock&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,189 @@
+/****************************************************************************/
+/// @file    KDTree.h
+/// @date    Oct 2017
+/// @version $Id$
+///
+// A static two-dimensional k-d tree for nearest neighbor queries
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef KDTree_h
+#define KDTree_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "Position.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class KDTree
+ * @brief A static two-dimensional k-d tree answering k nearest neighbor queries
+ *
+ * The items are stored in a single vector where the median of each range
+ *  (alternately by x and y) is the root of the range's subtree. The tree has
+ *  to be rebuilt after adding items or changing positions. Building takes
+ *  O(n log n), a query for the k nearest items O(log n + k) for evenly
+ *  distributed items.
+ */
+template<class T>
+class KDTree {
+public:
+    /// @brief A query result (the distance to the query position and the item)
+    typedef std::pair<double, T> Neighbor;
+
+
+    /// @brief Constructor
+    KDTree() {}
+
+
+    /// @brief Removes all items
+    void clear() {
+        myItems.clear();
+    }
+
+
+    /** @brief Adds an item (not found by queries until the next build)
+     * @param[in] pos The item's position
+     * @param[in] value The item
+     */
+    void add(const Position& pos, const T& value) {
+        myItems.push_back(Item(pos, value));
+    }
+
+
+    /// @brief Arranges the added items for querying
+    void build() {
+        build(0, (int)myItems.size(), 0);
+    }
+
+
+    /// @brief Returns the number of items
+    int size() const {
+        return (int)myItems.size();
+    }
+
+
+    /** @brief Collects the nearest items to the given position
+     * @param[in] pos The position to search around
+     * @param[in] k The maximum number of items to return
+     * @param[in] maxDist The maximum distance of returned items
+     * @param[in] exclude An item to skip (the querying object, for example)
+     * @param[out] into The found items sorted by ascending distance
+     */
+    void nearest(const Position& pos, int k, double maxDist, const T& exclude, std::vector<Neighbor>& into) const {
+        into.clear();
+        if (k <= 0) {
+            return;
+        }
+        into.reserve(k + 1);
+        search(0, (int)myItems.size(), 0, pos, k, maxDist * maxDist, exclude, into);
+        std::sort_heap(into.begin(), into.end(), NeighborLess());
+        for (typename std::vector<Neighbor>::iterator i = into.begin(); i != into.end(); ++i) {
+            i->first = sqrt(i->first);
+        }
+    }
+
+
+private:
+    /// @brief A stored item
+    struct Item {
+        Item(const Position& p, const T& v) : pos(p), value(v) {}
+        Position pos;
+        T value;
+    };
+
+    /// @brief Orders items by one coordinate
+    struct CoordLess {
+        CoordLess(int axis) : myAxis(axis) {}
+        bool operator()(const Item& a, const Item& b) const {
+            return myAxis == 0 ? a.pos.x() < b.pos.x() : a.pos.y() < b.pos.y();
+        }
+        int myAxis;
+    };
+
+    /// @brief Orders query results by distance only (the items need not be comparable)
+    struct NeighborLess {
+        bool operator()(const Neighbor& a, const Neighbor& b) const {
+            return a.first < b.first;
+        }
+    };
+
+
+    /// @brief Arranges the given range recursively
+    void build(int begin, int end, int axis) {
+        if (end - begin <= 1) {
+            return;
+        }
+        const int mid = (begin + end) / 2;
+        std::nth_element(myItems.begin() + begin, myItems.begin() + mid, myItems.begin() + end, CoordLess(axis));
+        build(begin, mid, 1 - axis);
+        build(mid + 1, end, 1 - axis);
+    }
+
+
+    /// @brief Searches the given range, heap is a max-heap of squared distances holding at most k items
+    void search(int begin, int end, int axis, const Position& pos, int k, double maxDist2,
+                const T& exclude, std::vector<Neighbor>& heap) const {
+        if (begin >= end) {
+            return;
+        }
+        const int mid = (begin + end) / 2;
+        const Item& item = myItems[mid];
+        if (!(item.value == exclude)) {
+            const double dist2 = pos.distanceSquaredTo2D(item.pos);
+            if (dist2 <= maxDist2 && ((int)heap.size() < k || dist2 < heap.front().first)) {
+                if ((int)heap.size() == k) {
+                    std::pop_heap(heap.begin(), heap.end(), NeighborLess());
+                    heap.pop_back();
+                }
+                heap.push_back(Neighbor(dist2, item.value));
+                std::push_heap(heap.begin(), heap.end(), NeighborLess());
+            }
+        }
+        const double diff = axis == 0 ? pos.x() - item.pos.x() : pos.y() - item.pos.y();
+        const int nearBegin = diff < 0 ? begin : mid + 1;
+        const int nearEnd = diff < 0 ? mid : end;
+        search(nearBegin, nearEnd, 1 - axis, pos, k, maxDist2, exclude, heap);
+        // the other side may only contain closer items if the splitting line is closer
+        const double bound2 = (int)heap.size() < k ? maxDist2 : heap.front().first;
+        if (diff * diff <= bound2) {
+            search(diff < 0 ? mid + 1 : begin, diff < 0 ? end : mid, 1 - axis, pos, k, maxDist2, exclude, heap);
+        }
+    }
+
+
+private:
+    /// @brief The items, arranged by build
+    std::vector<Item> myItems;
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -45,9 +45,15 @@
 // method definitions
 // ===========================================================================
 BinaryInputDevice::BinaryInputDevice(const std::string& name,
-                                     const bool isTyped, const bool doValidate)
-    : myStream(name.c_str(), std::fstream::in | std::fstream::binary),
-      myAmTyped(isTyped), myEnableValidation(doValidate) {}
+                                     const bool isTyped, const bool doValidate, const bool fromString)
+    : myStream(fromString ? static_cast<std::istream&>(myStringStream) : static_cast<std::istream&>(myFileStream)),
+      myAmTyped(isTyped), myEnableValidation(doValidate) {
+    if (fromString) {
+        myStringStream.str(name);
+    } else {
+        myFileStream.open(name.c_str(), std::fstream::in | std::fstream::binary);
+    }
+}
 
 
 BinaryInputDevice::~BinaryInputDevice() {}
@@ -35,6 +35,7 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <sstream>
 #include "BinaryFormatter.h"
 
 
@@ -66,9 +67,12 @@ class BinaryInputDevice {
 public:
     /** @brief Constructor
      *
-     * @param[in] name The name of the file to open for reading
+     * @param[in] name The name of the file to open for reading (or the content to read if fromString is set)
+     * @param[in] isTyped Whether each value is preceded by its type
+     * @param[in] doValidate Whether the types shall be checked
+     * @param[in] fromString Whether name holds the (binary) content itself instead of a file name
      */
-    BinaryInputDevice(const std::string& name, const bool isTyped = false, const bool doValidate = false);
+    BinaryInputDevice(const std::string& name, const bool isTyped = false, const bool doValidate = false, const bool fromString = false);
 
 
     /// @brief Destructor
@@ -221,8 +225,14 @@ private:
     int checkType(BinaryFormatter::DataType t);
 
 private:
-    /// @brief The encapsulated stream
-    std::ifstream myStream;
+    /// @brief The file stream used when reading from a file
+    std::ifstream myFileStream;
+
+    /// @brief The string stream used when reading from memory
+    std::istringstream myStringStream;
+
+    /// @brief The encapsulated stream (one of the above)
+    std::istream& myStream;
 
     const bool myAmTyped;
 
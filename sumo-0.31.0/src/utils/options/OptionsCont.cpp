@@ -474,6 +474,24 @@ OptionsCont::clear() {
 }
 
 
+void
+OptionsCont::swap(OptionsCont& other) {
+    myAddresses.swap(other.myAddresses);
+    myValues.swap(other.myValues);
+    myAppName.swap(other.myAppName);
+    myFullName.swap(other.myFullName);
+    myAppDescription.swap(other.myAppDescription);
+    myAdditionalMessage.swap(other.myAdditionalMessage);
+    myCallExamples.swap(other.myCallExamples);
+    mySubTopics.swap(other.mySubTopics);
+    myCopyrightNotices.swap(other.myCopyrightNotices);
+    mySubTopicEntries.swap(other.mySubTopicEntries);
+    myXMLDefaults.swap(other.myXMLDefaults);
+    myDeprecatedSynonymes.swap(other.myDeprecatedSynonymes);
+    std::swap(myHaveInformedAboutDeprecatedDivider, other.myHaveInformedAboutDeprecatedDivider);
+}
+
+
 void
 OptionsCont::addDescription(const std::string& name,
                             const std::string& subtopic,
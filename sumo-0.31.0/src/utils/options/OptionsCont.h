@@ -614,6 +614,12 @@ public:
     void clear();
 
 
+    /** @brief Exchanges the contents with another container
+     * @param[in, out] other The container to exchange the options with
+     */
+    void swap(OptionsCont& other);
+
+
     /** @brief Checks for help and configuration output, returns whether we should exit
      *
      * Returns false if no error was detected and the application may be executed
@@ -753,6 +759,13 @@ private:
 };
 
 
+/// @brief Exchanges the contents of two option containers
+inline void
+swap(OptionsCont& a, OptionsCont& b) {
+    a.swap(b);
+}
+
+
 #endif
 
 /****************************************************************************/
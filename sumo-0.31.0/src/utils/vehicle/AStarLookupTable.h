@@ -32,6 +32,13 @@
 
 #include <iostream>
 #include <fstream>
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include <utils/common/ToString.h>
 
 #ifdef HAVE_FOX
 #include <utils/foxtools/FXWorkerThread.h>
@@ -39,6 +46,9 @@
 
 #define UNREACHABLE (std::numeric_limits<double>::max() / 1000.0)
 
+#define LANDMARK_MAGIC "SUMOLMLT"
+#define LANDMARK_VERSION 1
+
 //#define ASTAR_DEBUG_LOOKUPTABLE
 //#define ASTAR_DEBUG_LOOKUPTABLE_FROM "disabled"
 //#define ASTAR_DEBUG_UNREACHABLE
@@ -101,11 +111,35 @@ private:
 };
 
 
+/**
+ * @class LandmarkLookupTable
+ * @brief Lower bounds for the A* ALT-variant from the distances to and from a set of landmarks
+ *
+ * The distances are read from a text file (one line per landmark followed by
+ *  lines "landmark edge distFrom distTo") or from a binary file which is
+ *  mapped into memory read-only and thus shared by all processes using it.
+ *  Missing distances and additional automatically selected landmarks
+ *  (farthest heuristic) are computed with the given router.
+ *
+ * The binary format starts with the magic "SUMOLMLT", the version, the
+ *  number of landmarks, the number of (non-internal) edges and a hash of
+ *  their ids, followed by the landmark ids (length prefixed and padded to
+ *  four bytes). The distances follow as float32 in native byte order,
+ *  landmark-major and indexed by the numerical edge id, first all distances
+ *  from the landmarks then all distances to the landmarks. A distance of -1
+ *  encodes unreachability.
+ */
 template<class E, class V>
 class LandmarkLookupTable : public AbstractLookupTable<E, V> {
 public:
-    LandmarkLookupTable(const std::string& filename, const std::vector<E*>& edges, SUMOAbstractRouter<E, V>* router, const V* defaultVehicle, const std::string& outfile, const int maxNumThreads) {
-        myFirstNonInternal = -1;
+    LandmarkLookupTable(const std::string& filename, const std::vector<E*>& edges, SUMOAbstractRouter<E, V>* router, const V* defaultVehicle,
+                        const std::string& outfile, const int maxNumThreads, const int numAutoLandmarks = 0) :
+        myFirstNonInternal(-1),
+        myNumEdges(0),
+        myFromLandmarkDists(0),
+        myToLandmarkDists(0),
+        myMappedData(0),
+        myMappedSize(0) {
         std::map<std::string, int> numericID;
         for (E* e : edges) {
             if (!e->isInternal()) {
@@ -115,55 +149,71 @@ public:
                 numericID[e->getID()] = e->getNumericalID() - myFirstNonInternal;
             }
         }
-        std::ifstream strm(filename.c_str());
-        if (!strm.good()) {
-            throw ProcessError("Could not load landmark-lookup-table from '" + filename + "'.");
-        }
-        std::ofstream* ostrm = 0;
-        if (!outfile.empty()) {
-            ostrm = new std::ofstream(outfile.c_str());
-            if (!ostrm->good()) {
-                throw ProcessError("Could not open file '" + outfile + "' for writing.");
-            }
+        if (myFirstNonInternal == -1) {
+            myFirstNonInternal = (int)edges.size();
         }
-        std::string line;
-        int numLandMarks = 0;
-        while (std::getline(strm, line)) {
-            if (line == "") {
-                break;
+        myNumEdges = (int)edges.size() - myFirstNonInternal;
+        std::vector<std::vector<double> > fromDists;
+        std::vector<std::vector<double> > toDists;
+        if (!filename.empty()) {
+            std::ifstream strm(filename.c_str(), std::ios::binary);
+            if (!strm.good()) {
+                throw ProcessError("Could not load landmark-lookup-table from '" + filename + "'.");
             }
-            //std::cout << "'" << line << "'" << "\n";
-            StringTokenizer st(line);
-            if (st.size() == 1) {
-                const std::string lm = st.get(0);
-                myLandmarks[lm] = numLandMarks++;
-                myFromLandmarkDists.push_back(std::vector<double>(0));
-                myToLandmarkDists.push_back(std::vector<double>(0));
-                if (ostrm != 0) {
-                    (*ostrm) << lm << "\n";
+            char magic[8];
+            if (strm.read(magic, 8) && std::string(magic, 8) == LANDMARK_MAGIC) {
+                strm.close();
+                loadBinary(filename, edges);
+                if (outfile.empty() && numAutoLandmarks <= 0) {
+                    return;
                 }
+                // the table gets extended, so we need our own copy
+                for (int i = 0; i < (int)myLandmarks.size(); ++i) {
+                    fromDists.push_back(std::vector<double>(myFromLandmarkDists + i * myNumEdges, myFromLandmarkDists + (i + 1) * myNumEdges));
+                    toDists.push_back(std::vector<double>(myToLandmarkDists + i * myNumEdges, myToLandmarkDists + (i + 1) * myNumEdges));
+                }
+                release();
             } else {
-                assert(st.size() == 4);
-                const std::string lm = st.get(0);
-                const std::string edge = st.get(1);
-                if (numericID[edge] != (int)myFromLandmarkDists[myLandmarks[lm]].size()) {
-                    WRITE_WARNING("Unknown or unordered edge '" + edge + "' in landmark file.");
+                strm.clear();
+                strm.seekg(0);
+                std::string line;
+                int numLandMarks = 0;
+                while (std::getline(strm, line)) {
+                    if (line == "") {
+                        break;
+                    }
+                    //std::cout << "'" << line << "'" << "\n";
+                    StringTokenizer st(line);
+                    if (st.size() == 1) {
+                        const std::string lm = st.get(0);
+                        myLandmarks[lm] = numLandMarks++;
+                        fromDists.push_back(std::vector<double>(0));
+                        toDists.push_back(std::vector<double>(0));
+                    } else {
+                        assert(st.size() == 4);
+                        const std::string lm = st.get(0);
+                        const std::string edge = st.get(1);
+                        if (numericID[edge] != (int)fromDists[myLandmarks[lm]].size()) {
+                            WRITE_WARNING("Unknown or unordered edge '" + edge + "' in landmark file.");
+                        }
+                        const double distFrom = TplConvert::_2double(st.get(2).c_str());
+                        const double distTo = TplConvert::_2double(st.get(3).c_str());
+                        fromDists[myLandmarks[lm]].push_back(distFrom);
+                        toDists[myLandmarks[lm]].push_back(distTo);
+                    }
                 }
-                const double distFrom = TplConvert::_2double(st.get(2).c_str());
-                const double distTo = TplConvert::_2double(st.get(3).c_str());
-                myFromLandmarkDists[myLandmarks[lm]].push_back(distFrom);
-                myToLandmarkDists[myLandmarks[lm]].push_back(distTo);
             }
         }
-        if (myLandmarks.empty()) {
+        if (myLandmarks.empty() && numAutoLandmarks <= 0) {
             WRITE_WARNING("No landmarks in '" + filename + "', falling back to standard A*.");
             return;
         }
-#ifdef HAVE_FOX
-        FXWorkerThread::Pool threadPool;
-#endif
+        // compute the missing distances of the given landmarks in one go
+        bool missing = false;
+        std::vector<int> incomplete;
+        std::vector<const E*> incompleteEdges;
         for (int i = 0; i < (int)myLandmarks.size(); ++i) {
-            if ((int)myFromLandmarkDists[i].size() != (int)edges.size() - myFirstNonInternal) {
+            if ((int)fromDists[i].size() != myNumEdges) {
                 const std::string landmarkID = getLandmark(i);
                 const E* landmark = 0;
                 // retrieve landmark edge
@@ -177,108 +227,74 @@ public:
                     continue;
                 }
                 if (router != 0) {
-                    const std::string missing = filename + ".missing";
-                    WRITE_WARNING("Not all network edges were found in the lookup table '" + filename + "' for landmark '" + landmarkID + "'. Saving missing values to '" + missing + "'.");
-                    if (ostrm == 0) {
-                        ostrm = new std::ofstream(missing.c_str());
-                        if (!ostrm->good()) {
-                            throw ProcessError("Could not open file '" + missing + "' for writing.");
-                        }
+                    if (outfile.empty()) {
+                        WRITE_WARNING("Not all network edges were found in the lookup table '" + filename + "' for landmark '" + landmarkID + "'. Saving missing values to '" + filename + ".missing'.");
                     }
+                    missing = true;
                 } else {
                     throw ProcessError("Not all network edges were found in the lookup table '" + filename + "' for landmark '" + landmarkID + "'.");
                 }
-                std::vector<const E*> routeLM(1, landmark);
-                const double lmCost = router->recomputeCosts(routeLM, defaultVehicle, 0);
-                std::vector<const E*> route;
-#ifdef HAVE_FOX
-                if (maxNumThreads > 0) {
-                    if (threadPool.size() == 0) {
-                        // The CHRouter needs initialization
-                        // before it gets cloned, so we do a dummy routing which is not in parallel
-                        router->compute(landmark, landmark, defaultVehicle, 0, route);
-                        route.clear();
-                        while ((int)threadPool.size() < maxNumThreads) {
-                            new WorkerThread(threadPool, router->clone(), defaultVehicle);
-                        }
-                    }
-                    std::vector<RoutingTask*> currentTasks;
-                    for (int j = (int)myFromLandmarkDists[i].size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
-                        const E* edge = edges[j];
-                        if (landmark != edge) {
-                            std::vector<const E*> routeE(1, edge);
-                            const double sourceDestCost = lmCost + router->recomputeCosts(routeE, defaultVehicle, 0);
-                            // compute from-distance (skip taz-sources and other unreachable edges)
-                            if (edge->getPredecessors().size() > 0 && landmark->getSuccessors().size() > 0) {
-                                currentTasks.push_back(new RoutingTask(landmark, edge, sourceDestCost));
-                                threadPool.add(currentTasks.back());
-                            }
-                            // compute to-distance (skip unreachable landmarks)
-                            if (landmark->getPredecessors().size() > 0 && edge->getSuccessors().size() > 0) {
-                                currentTasks.push_back(new RoutingTask(edge, landmark, sourceDestCost));
-                                threadPool.add(currentTasks.back());
-                            }
-                        }
-                    }
-                    threadPool.waitAll(false);
-                    int taskIndex = 0;
-                    for (int j = (int)myFromLandmarkDists[i].size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
-                        const E* edge = edges[j];
-                        double distFrom = -1;
-                        double distTo = -1;
-                        if (landmark == edge) {
-                            distFrom = 0;
-                            distTo = 0;
-                        } else {
-                            if (edge->getPredecessors().size() > 0 && landmark->getSuccessors().size() > 0) {
-                                distFrom = currentTasks[taskIndex]->getCost();
-                                delete currentTasks[taskIndex++];
-                            }
-                            if (landmark->getPredecessors().size() > 0 && edge->getSuccessors().size() > 0) {
-                                distTo = currentTasks[taskIndex]->getCost();
-                                delete currentTasks[taskIndex++];
-                            }
-                        }
-                        myFromLandmarkDists[i].push_back(distFrom);
-                        myToLandmarkDists[i].push_back(distTo);
-                        (*ostrm) << landmarkID << " " << edge->getID() << " " << distFrom << " " << distTo << "\n";
-                    }
-                    currentTasks.clear();
-                    continue;
-                }
-#endif
-                for (int j = (int)myFromLandmarkDists[i].size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
-                    const E* edge = edges[j];
-                    double distFrom = -1;
-                    double distTo = -1;
-                    if (landmark == edge) {
-                        distFrom = 0;
-                        distTo = 0;
-                    } else {
-                        std::vector<const E*> routeE(1, edge);
-                        const double sourceDestCost = lmCost + router->recomputeCosts(routeE, defaultVehicle, 0);
-                        // compute from-distance (skip taz-sources and other unreachable edges)
-                        if (edge->getPredecessors().size() > 0 && landmark->getSuccessors().size() > 0) {
-                            if (router->compute(landmark, edge, defaultVehicle, 0, route)) {
-                                distFrom = MAX2(0.0, router->recomputeCosts(route, defaultVehicle, 0) - sourceDestCost);
-                                route.clear();
-                            }
-                        }
-                        // compute to-distance (skip unreachable landmarks)
-                        if (landmark->getPredecessors().size() > 0 && edge->getSuccessors().size() > 0) {
-                            if (router->compute(edge, landmark, defaultVehicle, 0, route)) {
-                                distTo = MAX2(0.0, router->recomputeCosts(route, defaultVehicle, 0) - sourceDestCost);
-                                route.clear();
-                            }
-                        }
-                    }
-                    myFromLandmarkDists[i].push_back(distFrom);
-                    myToLandmarkDists[i].push_back(distTo);
-                    (*ostrm) << landmarkID << " " << edge->getID() << " " << distFrom << " " << distTo << "\n";
+                incomplete.push_back(i);
+                incompleteEdges.push_back(landmark);
+            }
+        }
+        computeDistances(incomplete, incompleteEdges, edges, router, defaultVehicle, maxNumThreads, fromDists, toDists);
+        // select further landmarks which are far away from the known ones
+        if ((int)myLandmarks.size() < numAutoLandmarks) {
+            if (router == 0) {
+                throw ProcessError("Cannot select landmarks without a router.");
+            }
+            PROGRESS_BEGIN_MESSAGE("Selecting " + toString(numAutoLandmarks - (int)myLandmarks.size()) + " landmarks");
+            std::vector<bool> candidate(myNumEdges, false);
+            for (int j = 0; j < myNumEdges; ++j) {
+                const E* const edge = edges[j + myFirstNonInternal];
+                std::vector<const E*> routeE(1, edge);
+                candidate[j] = (edge->getPredecessors().size() > 0 && edge->getSuccessors().size() > 0
+                                && router->recomputeCosts(routeE, defaultVehicle, 0) >= 0 && myLandmarks.count(edge->getID()) == 0);
+            }
+            while ((int)myLandmarks.size() < numAutoLandmarks) {
+                const int next = selectFarthest(edges, candidate, fromDists, toDists);
+                if (next < 0) {
+                    WRITE_WARNING("Could only select " + toString(myLandmarks.size()) + " landmarks.");
+                    break;
                 }
+                candidate[next] = false;
+                const E* const landmark = edges[next + myFirstNonInternal];
+                const int index = (int)myLandmarks.size();
+                myLandmarks[landmark->getID()] = index;
+                fromDists.push_back(std::vector<double>(0));
+                toDists.push_back(std::vector<double>(0));
+                computeDistances(std::vector<int>(1, index), std::vector<const E*>(1, landmark), edges, router, defaultVehicle, maxNumThreads, fromDists, toDists);
             }
+            PROGRESS_DONE_MESSAGE();
+        }
+#ifdef HAVE_FOX
+        myThreadPool.clear();
+#endif
+        // landmarks which do not exist in the network have no distances
+        for (int i = 0; i < (int)myLandmarks.size(); ++i) {
+            fromDists[i].resize(myNumEdges, -1);
+            toDists[i].resize(myNumEdges, -1);
+        }
+        myDists.reserve(2 * myLandmarks.size() * myNumEdges);
+        for (int i = 0; i < (int)myLandmarks.size(); ++i) {
+            myDists.insert(myDists.end(), fromDists[i].begin(), fromDists[i].end());
+        }
+        for (int i = 0; i < (int)myLandmarks.size(); ++i) {
+            myDists.insert(myDists.end(), toDists[i].begin(), toDists[i].end());
+        }
+        myFromLandmarkDists = myDists.empty() ? 0 : &myDists[0];
+        myToLandmarkDists = myFromLandmarkDists + myLandmarks.size() * myNumEdges;
+        if (!outfile.empty()) {
+            save(outfile, edges);
+        } else if (missing) {
+            save(filename + ".missing", edges);
         }
-        delete ostrm;
+    }
+
+    /// @brief Destructor
+    virtual ~LandmarkLookupTable() {
+        release();
     }
 
     double lowerBound(const E* from, const E* to, double speed, double speedFactor, double fromEffort, double toEffort) const {
@@ -288,10 +304,13 @@ public:
             std::cout << " lowerBound to=" << to->getID() << " result1=" << result << "\n";
         }
 #endif
-        for (int i = 0; i < (int)myLandmarks.size(); ++i) {
+        const int fromIndex = from->getNumericalID() - myFirstNonInternal;
+        const int toIndex = to->getNumericalID() - myFirstNonInternal;
+        const int numLandmarks = (int)myLandmarks.size();
+        for (int i = 0; i < numLandmarks; ++i) {
             // a cost of -1 is used to encode unreachability.
-            const double fl = myToLandmarkDists[i][from->getNumericalID() - myFirstNonInternal];
-            const double tl = myToLandmarkDists[i][to->getNumericalID() - myFirstNonInternal];
+            const double fl = myToLandmarkDists[i * myNumEdges + fromIndex];
+            const double tl = myToLandmarkDists[i * myNumEdges + toIndex];
             if (fl >= 0 && tl >= 0) {
                 const double bound = (fl - tl - toEffort) / speedFactor;
 #ifdef ASTAR_DEBUG_LOOKUPTABLE
@@ -302,8 +321,8 @@ public:
 #endif
                 result = MAX2(result, bound);
             }
-            const double lt = myFromLandmarkDists[i][to->getNumericalID() - myFirstNonInternal];
-            const double lf = myFromLandmarkDists[i][from->getNumericalID() - myFirstNonInternal];
+            const double lt = myFromLandmarkDists[i * myNumEdges + toIndex];
+            const double lf = myFromLandmarkDists[i * myNumEdges + fromIndex];
             if (lt >= 0 && lf >= 0) {
                 const double bound = (lt - lf - fromEffort) / speedFactor;
 #ifdef ASTAR_DEBUG_LOOKUPTABLE
@@ -333,12 +352,309 @@ public:
         return false;
     }
 
+private:
+    /// @brief computes the distances of the given landmarks to all edges they do not know yet
+    void computeDistances(const std::vector<int>& indices, const std::vector<const E*>& landmarks, const std::vector<E*>& edges,
+                          SUMOAbstractRouter<E, V>* router, const V* defaultVehicle, const int maxNumThreads,
+                          std::vector<std::vector<double> >& fromDists, std::vector<std::vector<double> >& toDists) {
+        if (indices.empty()) {
+            return;
+        }
+        std::vector<const E*> route;
+#ifdef HAVE_FOX
+        if (maxNumThreads > 0) {
+            if (myThreadPool.size() == 0) {
+                // The CHRouter needs initialization
+                // before it gets cloned, so we do a dummy routing which is not in parallel
+                router->compute(landmarks.front(), landmarks.front(), defaultVehicle, 0, route);
+                route.clear();
+                while ((int)myThreadPool.size() < maxNumThreads) {
+                    new WorkerThread(myThreadPool, router->clone(), defaultVehicle);
+                }
+            }
+            // the tasks of all landmarks are processed together
+            std::vector<RoutingTask*> currentTasks;
+            for (int k = 0; k < (int)indices.size(); ++k) {
+                const E* const landmark = landmarks[k];
+                std::vector<const E*> routeLM(1, landmark);
+                const double lmCost = router->recomputeCosts(routeLM, defaultVehicle, 0);
+                for (int j = (int)fromDists[indices[k]].size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
+                    const E* edge = edges[j];
+                    if (landmark != edge) {
+                        std::vector<const E*> routeE(1, edge);
+                        const double sourceDestCost = lmCost + router->recomputeCosts(routeE, defaultVehicle, 0);
+                        // compute from-distance (skip taz-sources and other unreachable edges)
+                        if (edge->getPredecessors().size() > 0 && landmark->getSuccessors().size() > 0) {
+                            currentTasks.push_back(new RoutingTask(landmark, edge, sourceDestCost));
+                            myThreadPool.add(currentTasks.back());
+                        }
+                        // compute to-distance (skip unreachable landmarks)
+                        if (landmark->getPredecessors().size() > 0 && edge->getSuccessors().size() > 0) {
+                            currentTasks.push_back(new RoutingTask(edge, landmark, sourceDestCost));
+                            myThreadPool.add(currentTasks.back());
+                        }
+                    }
+                }
+            }
+            myThreadPool.waitAll(false);
+            int taskIndex = 0;
+            for (int k = 0; k < (int)indices.size(); ++k) {
+                const E* const landmark = landmarks[k];
+                std::vector<double>& from = fromDists[indices[k]];
+                std::vector<double>& to = toDists[indices[k]];
+                for (int j = (int)from.size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
+                    const E* edge = edges[j];
+                    double distFrom = -1;
+                    double distTo = -1;
+                    if (landmark == edge) {
+                        distFrom = 0;
+                        distTo = 0;
+                    } else {
+                        if (edge->getPredecessors().size() > 0 && landmark->getSuccessors().size() > 0) {
+                            distFrom = currentTasks[taskIndex]->getCost();
+                            delete currentTasks[taskIndex++];
+                        }
+                        if (landmark->getPredecessors().size() > 0 && edge->getSuccessors().size() > 0) {
+                            distTo = currentTasks[taskIndex]->getCost();
+                            delete currentTasks[taskIndex++];
+                        }
+                    }
+                    from.push_back(distFrom);
+                    to.push_back(distTo);
+                }
+            }
+            return;
+        }
+#else
+        UNUSED_PARAMETER(maxNumThreads);
+#endif
+        for (int k = 0; k < (int)indices.size(); ++k) {
+            const E* const landmark = landmarks[k];
+            std::vector<const E*> routeLM(1, landmark);
+            const double lmCost = router->recomputeCosts(routeLM, defaultVehicle, 0);
+            std::vector<double>& from = fromDists[indices[k]];
+            std::vector<double>& to = toDists[indices[k]];
+            for (int j = (int)from.size() + myFirstNonInternal; j < (int)edges.size(); ++j) {
+                const E* edge = edges[j];
+                double distFrom = -1;
+                double distTo = -1;
+                if (landmark == edge) {
+                    distFrom = 0;
+                    distTo = 0;
+                } else {
+                    std::vector<const E*> routeE(1, edge);
+                    const double sourceDestCost = lmCost + router->recomputeCosts(routeE, defaultVehicle, 0);
+                    // compute from-distance (skip taz-sources and other unreachable edges)
+                    if (edge->getPredecessors().size() > 0 && landmark->getSuccessors().size() > 0) {
+                        if (router->compute(landmark, edge, defaultVehicle, 0, route)) {
+                            distFrom = MAX2(0.0, router->recomputeCosts(route, defaultVehicle, 0) - sourceDestCost);
+                            route.clear();
+                        }
+                    }
+                    // compute to-distance (skip unreachable landmarks)
+                    if (landmark->getPredecessors().size() > 0 && edge->getSuccessors().size() > 0) {
+                        if (router->compute(edge, landmark, defaultVehicle, 0, route)) {
+                            distTo = MAX2(0.0, router->recomputeCosts(route, defaultVehicle, 0) - sourceDestCost);
+                            route.clear();
+                        }
+                    }
+                }
+                from.push_back(distFrom);
+                to.push_back(distTo);
+            }
+        }
+    }
+
+    /** @brief returns the index of the candidate edge which is farthest from the known landmarks (-1 if there is none)
+     *
+     * Without landmarks the edge with the largest beeline distance to the first edge is used.
+     */
+    int selectFarthest(const std::vector<E*>& edges, const std::vector<bool>& candidate,
+                       const std::vector<std::vector<double> >& fromDists, const std::vector<std::vector<double> >& toDists) const {
+        int best = -1;
+        double bestDist = -1;
+        for (int j = 0; j < myNumEdges; ++j) {
+            if (!candidate[j]) {
+                continue;
+            }
+            double dist = std::numeric_limits<double>::max();
+            if (myLandmarks.empty()) {
+                dist = edges[myFirstNonInternal]->getDistanceTo(edges[j + myFirstNonInternal]);
+            } else {
+                for (int i = 0; i < (int)fromDists.size(); ++i) {
+                    if (fromDists[i][j] >= 0 && toDists[i][j] >= 0) {
+                        dist = MIN2(dist, fromDists[i][j] + toDists[i][j]);
+                    }
+                }
+                if (dist == std::numeric_limits<double>::max()) {
+                    // not connected to any landmark
+                    continue;
+                }
+            }
+            if (dist > bestDist) {
+                best = j;
+                bestDist = dist;
+            }
+        }
+        return best;
+    }
+
+    /// @brief returns a hash of the ids of the non-internal edges to validate binary tables
+    unsigned int getEdgeHash(const std::vector<E*>& edges) const {
+        // FNV-1a
+        unsigned int hash = 2166136261u;
+        for (int j = myFirstNonInternal; j < (int)edges.size(); ++j) {
+            const std::string& id = edges[j]->getID();
+            for (std::string::const_iterator it = id.begin(); it != id.end(); ++it) {
+                hash = (hash ^ (unsigned char)*it) * 16777619u;
+            }
+            hash = (hash ^ 0xff) * 16777619u;
+        }
+        return hash;
+    }
+
+    /// @brief maps (or reads) the binary table from the given file, nothing stays mapped if it is invalid
+    void loadBinary(const std::string& filename, const std::vector<E*>& edges) {
+        try {
+            mapBinary(filename, edges);
+        } catch (ProcessError&) {
+            // the destructor does not run if the constructor throws
+            release();
+            myLandmarks.clear();
+            throw;
+        }
+    }
+
+    /// @brief maps (or reads) and validates the binary table, throws a ProcessError if it is invalid
+    void mapBinary(const std::string& filename, const std::vector<E*>& edges) {
+        const char* data = 0;
+        long long size = 0;
+#ifndef WIN32
+        const int fd = open(filename.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* const mapped = mmap(0, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapped != MAP_FAILED) {
+                myMappedData = mapped;
+                myMappedSize = (size_t)st.st_size;
+                data = (const char*)mapped;
+                size = (long long)st.st_size;
+            }
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+#endif
+        if (data == 0) {
+            // no memory mapping available, read the whole file
+            std::ifstream strm(filename.c_str(), std::ios::binary);
+            strm.seekg(0, std::ios::end);
+            size = (long long)strm.tellg();
+            strm.seekg(0);
+            if (size <= 0) {
+                throw ProcessError("Could not load landmark-lookup-table from '" + filename + "'.");
+            }
+            myDists.resize((size_t)(size + sizeof(float) - 1) / sizeof(float));
+            if (!strm.read((char*)&myDists[0], size)) {
+                throw ProcessError("Could not load landmark-lookup-table from '" + filename + "'.");
+            }
+            data = (const char*)&myDists[0];
+        }
+        const int* const header = (const int*)(data + 8);
+        if (size < 24 || header[0] != LANDMARK_VERSION) {
+            throw ProcessError("Unknown version of the binary landmark-lookup-table '" + filename + "'.");
+        }
+        const int numLandmarks = header[1];
+        if (header[2] != myNumEdges || (unsigned int)header[3] != getEdgeHash(edges)) {
+            throw ProcessError("The binary landmark-lookup-table '" + filename + "' was built for a different network.");
+        }
+        // every landmark needs at least the length of its id
+        if (numLandmarks < 0 || numLandmarks > (size - 24) / 4) {
+            throw ProcessError("The binary landmark-lookup-table '" + filename + "' has an invalid number of landmarks (" + toString(numLandmarks) + ").");
+        }
+        long long offset = 24;
+        for (int i = 0; i < numLandmarks; ++i) {
+            const int length = offset + 4 <= size ? *(const int*)(data + offset) : -1;
+            if (length < 0 || offset + 4 + length > size) {
+                throw ProcessError("The binary landmark-lookup-table '" + filename + "' is truncated.");
+            }
+            myLandmarks[std::string(data + offset + 4, length)] = i;
+            offset += 4 + (length + 3) / 4 * 4;
+        }
+        if (offset + 2 * (long long)numLandmarks * myNumEdges * (long long)sizeof(float) > size) {
+            throw ProcessError("The binary landmark-lookup-table '" + filename + "' is truncated.");
+        }
+        myFromLandmarkDists = (const float*)(data + offset);
+        myToLandmarkDists = myFromLandmarkDists + numLandmarks * myNumEdges;
+    }
+
+    /// @brief writes the table to the given file, the binary format is used for files ending with ".bin"
+    void save(const std::string& filename, const std::vector<E*>& edges) const {
+        const bool binary = filename.size() > 4 && filename.substr(filename.size() - 4) == ".bin";
+        std::ofstream strm(filename.c_str(), binary ? std::ios::binary : std::ios::out);
+        if (!strm.good()) {
+            throw ProcessError("Could not open file '" + filename + "' for writing.");
+        }
+        const int numLandmarks = (int)myLandmarks.size();
+        if (binary) {
+            const int header[4] = {LANDMARK_VERSION, numLandmarks, myNumEdges, (int)getEdgeHash(edges)};
+            strm.write(LANDMARK_MAGIC, 8);
+            strm.write((const char*)header, sizeof(header));
+            const char padding[4] = {0, 0, 0, 0};
+            for (int i = 0; i < numLandmarks; ++i) {
+                const std::string id = getLandmark(i);
+                const int length = (int)id.size();
+                strm.write((const char*)&length, 4);
+                strm.write(id.c_str(), length);
+                strm.write(padding, (4 - length % 4) % 4);
+            }
+            strm.write((const char*)myFromLandmarkDists, 2 * numLandmarks * myNumEdges * sizeof(float));
+        } else {
+            for (int i = 0; i < numLandmarks; ++i) {
+                strm << getLandmark(i) << "\n";
+            }
+            for (int i = 0; i < numLandmarks; ++i) {
+                const std::string landmarkID = getLandmark(i);
+                for (int j = 0; j < myNumEdges; ++j) {
+                    strm << landmarkID << " " << edges[j + myFirstNonInternal]->getID() << " "
+                         << myFromLandmarkDists[i * myNumEdges + j] << " " << myToLandmarkDists[i * myNumEdges + j] << "\n";
+                }
+            }
+        }
+    }
+
+    /// @brief unmaps the binary table and frees the distances
+    void release() {
+#ifndef WIN32
+        if (myMappedData != 0) {
+            munmap(myMappedData, myMappedSize);
+        }
+#endif
+        myMappedData = 0;
+        myMappedSize = 0;
+        myDists.clear();
+        myFromLandmarkDists = 0;
+        myToLandmarkDists = 0;
+    }
+
 private:
     std::map<std::string, int> myLandmarks;
-    std::vector<std::vector<double> > myFromLandmarkDists;
-    std::vector<std::vector<double> > myToLandmarkDists;
     int myFirstNonInternal;
 
+    /// @brief the number of non-internal edges (the length of the distance vector of each landmark)
+    int myNumEdges;
+
+    /// @brief the distances from and to the landmarks (landmark-major)
+    const float* myFromLandmarkDists;
+    const float* myToLandmarkDists;
+
+    /// @brief the storage of the distances if they are not mapped from a binary file
+    std::vector<float> myDists;
+
+    /// @brief the memory mapped binary table
+    void* myMappedData;
+    size_t myMappedSize;
+
 #ifdef HAVE_FOX
 private:
     class WorkerThread : public FXWorkerThread {
@@ -384,7 +700,8 @@ private:
 
 
 private:
-    /// @brief for multi threaded routing
+    /// @brief for multi threaded computation of the distances
+    FXWorkerThread::Pool myThreadPool;
 #endif
 
     std::string getLandmark(int i) const {
@@ -52,6 +52,7 @@
 #include <utils/iodevices/OutputDevice.h>
 #include "AStarLookupTable.h"
 #include "SUMOAbstractRouter.h"
+#include "IndexedHeap.h"
 
 #define UNREACHABLE (std::numeric_limits<double>::max() / 1000.0)
 
@@ -105,7 +106,8 @@ public:
             traveltime(std::numeric_limits<double>::max()),
             heuristicTime(std::numeric_limits<double>::max()),
             prev(0),
-            visited(false) {
+            visited(false),
+            heapIndex(-1) {
         }
 
         /// The current edge
@@ -123,6 +125,9 @@ public:
         /// The previous edge
         bool visited;
 
+        /// @brief the position within the frontier heap (-1 if not queued)
+        int heapIndex;
+
         inline void reset() {
             // heuristicTime is set before adding to the frontier, thus no reset is needed
             traveltime = std::numeric_limits<double>::max();
@@ -178,7 +183,7 @@ public:
 
     void init() {
         // all EdgeInfos touched in the previous query are either in myFrontierList or myFound: clean those up
-        for (typename std::vector<EdgeInfo*>::iterator i = myFrontierList.begin(); i != myFrontierList.end(); i++) {
+        for (typename FrontierList::const_iterator i = myFrontierList.begin(); i != myFrontierList.end(); i++) {
             (*i)->reset();
         }
         myFrontierList.clear();
@@ -221,7 +226,7 @@ public:
             EdgeInfo* const fromInfo = &(myEdgeInfos[from->getNumericalID()]);
             fromInfo->traveltime = 0;
             fromInfo->prev = 0;
-            myFrontierList.push_back(fromInfo);
+            myFrontierList.push(fromInfo);
         }
         // loop
         int num_visited = 0;
@@ -230,7 +235,7 @@ public:
         while (!myFrontierList.empty()) {
             num_visited += 1;
             // use the node with the minimal length
-            EdgeInfo* const minimumInfo = myFrontierList.front();
+            EdgeInfo* const minimumInfo = myFrontierList.top();
             const E* const minEdge = minimumInfo->edge;
             // check whether the destination node was already reached
             if (minEdge == to) {
@@ -252,8 +257,7 @@ public:
 #endif
                 return true;
             }
-            pop_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
-            myFrontierList.pop_back();
+            myFrontierList.pop();
             myFound.push_back(minimumInfo);
             minimumInfo->visited = true;
 #ifdef ASTAR_DEBUG_QUERY
@@ -262,7 +266,7 @@ public:
                       << " EF=" << this->getEffort(minEdge, vehicle, time + minimumInfo->traveltime)
                       << " HT=" << minimumInfo->heuristicTime
                       << " Q(TT,HT,Edge)=";
-            for (typename std::vector<EdgeInfo*>::iterator it = myFrontierList.begin(); it != myFrontierList.end(); it++) {
+            for (typename FrontierList::const_iterator it = myFrontierList.begin(); it != myFrontierList.end(); it++) {
                 std::cout << (*it)->traveltime << "," << (*it)->heuristicTime << "," << (*it)->edge->getID() << " ";
             }
             std::cout << "\n";
@@ -303,17 +307,12 @@ public:
 #endif
                     followerInfo->prev = minimumInfo;
                     if (oldEffort == std::numeric_limits<double>::max()) {
-                        myFrontierList.push_back(followerInfo);
-                        push_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
+                        myFrontierList.push(followerInfo);
+                    } else if (!myFrontierList.contains(followerInfo)) {
+                        assert(mayRevisit);
+                        myFrontierList.push(followerInfo);
                     } else {
-                        typename std::vector<EdgeInfo*>::iterator fi = find(myFrontierList.begin(), myFrontierList.end(), followerInfo);
-                        if (fi == myFrontierList.end()) {
-                            assert(mayRevisit);
-                            myFrontierList.push_back(followerInfo);
-                            push_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
-                        } else {
-                            push_heap(myFrontierList.begin(), fi + 1, myComparator);
-                        }
+                        myFrontierList.update(followerInfo);
                     }
                 }
             }
@@ -354,13 +353,12 @@ protected:
     /// The container of edge information
     std::vector<EdgeInfo> myEdgeInfos;
 
+    typedef IndexedHeap<EdgeInfo, EdgeInfoComparator> FrontierList;
     /// A container for reusage of the min edge heap
-    std::vector<EdgeInfo*> myFrontierList;
+    FrontierList myFrontierList;
     /// @brief list of visited Edges (for resetting)
     std::vector<EdgeInfo*> myFound;
 
-    EdgeInfoComparator myComparator;
-
     /// @brief the handler for routing errors
     MsgHandler* const myErrorMsgHandler;
 
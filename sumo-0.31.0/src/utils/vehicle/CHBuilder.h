@@ -36,6 +36,7 @@
 #include <functional>
 #include <vector>
 #include <set>
+#include <map>
 #include <limits>
 #include <algorithm>
 #include <iterator>
@@ -55,18 +56,19 @@
 // class definitions
 // ===========================================================================
 /**
- * @class CHRouter
- * @brief Computes the shortest path through a contracted network
+ * @class CHBuilder
+ * @brief Builds the contraction hierarchy for the CHRouter
  *
  * The template parameters are:
  * @param E The edge class to use (MSEdge/ROEdge)
  * @param V The vehicle class to use (MSVehicle/ROVehicle)
- * @param PF The prohibition function to use (prohibited_withPermissions/noProhibitions)
- *
- * The router is edge-based. It must know the number of edges for internal reasons
- *  and whether a missing connection between two given edges (unbuild route) shall
- *  be reported as an error or as a warning.
  *
+ * Besides the usual contraction (which prunes shortcuts by witness searches
+ *  and thus depends on the edge efforts) the builder can build a
+ *  customizable hierarchy using a nested dissection order. It contains every
+ *  shortcut the order may need, so a change of the efforts only requires to
+ *  recompute the costs of the arcs (customize) instead of contracting the
+ *  network again.
  */
 template<class E, class V>
 class CHBuilder {
@@ -77,16 +79,29 @@ public:
     // backward connections are used only in backwards search
     class Connection {
     public:
-        Connection(int t, double c, SVCPermissions p): target(t), cost(c), permissions(p) {}
+        Connection(int t, double c, SVCPermissions p, int a): target(t), cost(c), permissions(p), arc(a) {}
         int target;
         double cost;
         SVCPermissions permissions;
+        /// @brief the index of the (forward) arc within the hierarchy
+        int arc;
+    };
+
+    /// @brief An arc of the hierarchy, shortcuts are unpacked into the two arcs around the contracted edge
+    class Arc {
+    public:
+        Arc(int v, int f, int s): via(v), first(f), second(s) {}
+        /// @brief the numerical id of the contracted edge (-1 for a connection of the network)
+        int via;
+        /// @brief the arc leading to the contracted edge
+        int first;
+        /// @brief the arc leaving the contracted edge
+        int second;
     };
 
     typedef std::pair<const E*, const E*> ConstEdgePair;
-    typedef std::map<ConstEdgePair, const E*> ShortcutVia;
     struct Hierarchy {
-        ShortcutVia shortcuts;
+        std::vector<Arc> arcs;
         std::vector<std::vector<Connection> > forwardUplinks;
         std::vector<std::vector<Connection> > backwardUplinks;
     };
@@ -103,7 +118,8 @@ public:
         myErrorMsgHandler(unbuildIsWarning ? MsgHandler::getWarningInstance() : MsgHandler::getErrorInstance()),
         mySPTree(new SPTree<CHInfo, CHConnection>(4, validatePermissions)),
         mySVC(svc),
-        myUpdateCount(0) {
+        myUpdateCount(0),
+        myCustomizableHierarchy(0) {
         for (typename std::vector<E*>::const_iterator i = edges.begin(); i != edges.end(); ++i) {
             myCHInfos.push_back(CHInfo(*i));
         }
@@ -118,9 +134,7 @@ public:
     const Hierarchy* buildContractionHierarchy(SUMOTime time, const V* const vehicle, const SUMOAbstractRouter<E, V>* effortProvider) {
         Hierarchy* result = new Hierarchy();
         const int numEdges = (int)myCHInfos.size();
-        const std::string vClass = (mySPTree->validatePermissions() ?
-                                    "all vehicle classes " : "vClass='" + SumoVehicleClassStrings.getString(mySVC) + "' ");
-        PROGRESS_BEGIN_MESSAGE("Building Contraction Hierarchy for " + vClass
+        PROGRESS_BEGIN_MESSAGE("Building Contraction Hierarchy for " + getClassDescription()
                                + "and time=" + time2string(time) + " (" + toString(numEdges) + " edges)\n");
         const long startMillis = SysUtils::getCurrentMillis();
         // init queue
@@ -134,7 +148,7 @@ public:
         // copy connections from the original net
         const double time_seconds = STEPS2TIME(time); // timelines store seconds!
         for (int i = 0; i < numEdges; i++) {
-            synchronize(myCHInfos[i], time_seconds, vehicle, effortProvider);
+            synchronize(myCHInfos[i], time_seconds, vehicle, effortProvider, result->arcs);
         }
         // synchronization is finished. now we can compute priorities for the first time
         for (int i = 0; i < numEdges; i++) {
@@ -143,6 +157,7 @@ public:
         }
         make_heap(queue.begin(), queue.end(), myCmp);
         int contractionRank = 0;
+        int numShortcuts = 0;
         // contraction loop
         while (!queue.empty()) {
             while (tryUpdateFront(queue)) {}
@@ -156,25 +171,27 @@ public:
             const int edgeID = edge->getNumericalID();
             for (typename CHConnections::const_iterator it = max->followers.begin(); it != max->followers.end(); it++) {
                 const CHConnection& con = *it;
-                result->forwardUplinks[edgeID].push_back(Connection(con.target->edge->getNumericalID(), con.cost, con.permissions));
+                result->forwardUplinks[edgeID].push_back(Connection(con.target->edge->getNumericalID(), con.cost, con.permissions, con.arc));
                 disconnect(con.target->approaching, max);
                 con.target->updatePriority(0);
             }
             // add incoming connections to the backward search
             for (typename CHConnections::const_iterator it = max->approaching.begin(); it != max->approaching.end(); it++) {
                 const CHConnection& con = *it;
-                result->backwardUplinks[edgeID].push_back(Connection(con.target->edge->getNumericalID(), con.cost, con.permissions));
+                result->backwardUplinks[edgeID].push_back(Connection(con.target->edge->getNumericalID(), con.cost, con.permissions, con.arc));
                 disconnect(con.target->followers, max);
                 con.target->updatePriority(0);
             }
             // add shortcuts to the net
             for (typename std::vector<Shortcut>::const_iterator it = max->shortcuts.begin(); it != max->shortcuts.end(); it++) {
                 const ConstEdgePair& edgePair = it->edgePair;
-                result->shortcuts[edgePair] = edge;
+                const int arc = (int)result->arcs.size();
+                result->arcs.push_back(Arc(edgeID, it->first, it->second));
+                numShortcuts++;
                 CHInfo* from = getCHInfo(edgePair.first);
                 CHInfo* to = getCHInfo(edgePair.second);
-                from->followers.push_back(CHConnection(to, it->cost, it->permissions, it->underlying));
-                to->approaching.push_back(CHConnection(from, it->cost, it->permissions, it->underlying));
+                from->followers.push_back(CHConnection(to, it->cost, it->permissions, it->underlying, arc));
+                to->approaching.push_back(CHConnection(from, it->cost, it->permissions, it->underlying, arc));
             }
             // if you need to debug the chrouter with MSVC uncomment the following line, hierarchy building will get slower and the hierarchy may change though
             //make_heap(queue.begin(), queue.end(), myCmp);
@@ -194,7 +211,7 @@ public:
         }
         // reporting
         const long duration = SysUtils::getCurrentMillis() - startMillis;
-        WRITE_MESSAGE("Created " + toString(result->shortcuts.size()) + " shortcuts.");
+        WRITE_MESSAGE("Created " + toString(numShortcuts) + " shortcuts.");
         WRITE_MESSAGE("Recomputed priority " + toString(myUpdateCount) + " times.");
         MsgHandler::getMessageInstance()->endProcessMsg("done (" + toString(duration) + "ms).");
         PROGRESS_DONE_MESSAGE();
@@ -202,14 +219,174 @@ public:
         return result;
     }
 
+
+    /** @brief Builds a hierarchy whose costs can be recomputed for new efforts
+     *
+     * The edges are contracted in nested dissection order (see
+     *  computeNestedDissectionOrder) without witness searches, i.e. every pair
+     *  of remaining neighbors (with the same permissions) is connected by an
+     *  arc. The separators are contracted last, so the arcs stay within the
+     *  parts they separate. The builder keeps the hierarchy to customize it
+     *  later, the caller owns it.
+     */
+    const Hierarchy* buildCustomizableHierarchy(SUMOTime time, const V* const vehicle, const SUMOAbstractRouter<E, V>* effortProvider) {
+        Hierarchy* result = new Hierarchy();
+        const int numEdges = (int)myCHInfos.size();
+        PROGRESS_BEGIN_MESSAGE("Building customizable Contraction Hierarchy for " + getClassDescription()
+                               + "(" + toString(numEdges) + " edges)\n");
+        const long startMillis = SysUtils::getCurrentMillis();
+        result->forwardUplinks.resize(numEdges);
+        result->backwardUplinks.resize(numEdges);
+        myArcSources.clear();
+        myArcFroms.clear();
+        myArcTargets.clear();
+        myArcPermissions.clear();
+        myTriangles.clear();
+        // the arcs at each edge (including those to contracted edges)
+        std::vector<std::vector<int> > outArcs(numEdges);
+        std::vector<std::vector<int> > inArcs(numEdges);
+        // the arcs at each edge by target and permissions
+        std::vector<ArcIndex> arcIndex(numEdges);
+        const bool prune = !mySPTree->validatePermissions();
+        for (int i = 0; i < numEdges; i++) {
+            const E* const edge = myCHInfos[i].edge;
+            if (prune && ((edge->getPermissions() & mySVC) != mySVC)) {
+                continue;
+            }
+            const std::vector<E*>& successors = edge->getSuccessors(mySVC);
+            for (typename std::vector<E*>::const_iterator it = successors.begin(); it != successors.end(); ++it) {
+                const E* fEdge = *it;
+                if (prune && ((fEdge->getPermissions() & mySVC) != mySVC)) {
+                    continue;
+                }
+                const int arc = getArc(i, fEdge->getNumericalID(), edge->getPermissions() & fEdge->getPermissions(), outArcs, inArcs, arcIndex);
+                myArcSources[arc] = i;
+            }
+        }
+        // the order only depends on the topology
+        std::vector<std::vector<int> > neighbors(numEdges);
+        for (int i = 0; i < (int)myArcTargets.size(); i++) {
+            neighbors[myArcFroms[i]].push_back(myArcTargets[i]);
+            neighbors[myArcTargets[i]].push_back(myArcFroms[i]);
+        }
+        std::vector<int> byRank;
+        computeNestedDissectionOrder(neighbors, byRank);
+        std::vector<int> rankOf(numEdges);
+        for (int rank = 0; rank < numEdges; rank++) {
+            rankOf[byRank[rank]] = rank;
+        }
+        // contraction loop
+        for (int rank = 0; rank < numEdges; rank++) {
+            const int via = byRank[rank];
+            std::vector<int> upIn;
+            std::vector<int> upOut;
+            for (std::vector<int>::const_iterator it = inArcs[via].begin(); it != inArcs[via].end(); ++it) {
+                if (rankOf[myArcFroms[*it]] > rank) {
+                    upIn.push_back(*it);
+                }
+            }
+            for (std::vector<int>::const_iterator it = outArcs[via].begin(); it != outArcs[via].end(); ++it) {
+                if (rankOf[myArcTargets[*it]] > rank) {
+                    upOut.push_back(*it);
+                }
+            }
+            for (std::vector<int>::const_iterator in = upIn.begin(); in != upIn.end(); ++in) {
+                const int from = myArcFroms[*in];
+                for (std::vector<int>::const_iterator out = upOut.begin(); out != upOut.end(); ++out) {
+                    const int to = myArcTargets[*out];
+                    if (from != to) {
+                        const int arc = getArc(from, to, myArcPermissions[*in] & myArcPermissions[*out], outArcs, inArcs, arcIndex);
+                        myTriangles.push_back(Triangle(arc, *in, *out, via));
+                    }
+                }
+                result->backwardUplinks[via].push_back(Connection(from, 0, myArcPermissions[*in], *in));
+            }
+            for (std::vector<int>::const_iterator out = upOut.begin(); out != upOut.end(); ++out) {
+                result->forwardUplinks[via].push_back(Connection(myArcTargets[*out], 0, myArcPermissions[*out], *out));
+            }
+        }
+        result->arcs.resize(myArcTargets.size(), Arc(-1, -1, -1));
+        WRITE_MESSAGE("Created " + toString(myArcTargets.size()) + " arcs with " + toString(myTriangles.size()) + " shortcut candidates.");
+        MsgHandler::getMessageInstance()->endProcessMsg("done (" + toString(SysUtils::getCurrentMillis() - startMillis) + "ms).");
+        PROGRESS_DONE_MESSAGE();
+        myCustomizableHierarchy = result;
+        customize(time, vehicle, effortProvider);
+        return result;
+    }
+
+
+    /// @brief Returns whether buildCustomizableHierarchy was called
+    bool isCustomizable() const {
+        return myCustomizableHierarchy != 0;
+    }
+
+
+    /** @brief Recomputes the costs of the customizable hierarchy for the efforts at the given time
+     *
+     * The shortcut candidates are processed in the contraction order of their
+     *  contracted edge, so the costs of both of their arcs are final when
+     *  they are evaluated and a single pass suffices.
+     */
+    void customize(SUMOTime time, const V* const vehicle, const SUMOAbstractRouter<E, V>* effortProvider) {
+        assert(myCustomizableHierarchy != 0);
+        PROGRESS_BEGIN_MESSAGE("Customizing Contraction Hierarchy for " + getClassDescription()
+                               + "and time=" + time2string(time) + " (" + toString(myTriangles.size()) + " shortcut candidates)\n");
+        const long startMillis = SysUtils::getCurrentMillis();
+        const double time_seconds = STEPS2TIME(time); // timelines store seconds!
+        const int numEdges = (int)myCHInfos.size();
+        const int numArcs = (int)myArcTargets.size();
+        std::vector<double> efforts(numEdges, -1);
+        std::vector<double> costs(numArcs, std::numeric_limits<double>::max());
+        std::vector<Arc>& arcs = myCustomizableHierarchy->arcs;
+        for (int i = 0; i < numArcs; i++) {
+            arcs[i] = Arc(-1, -1, -1);
+            const int source = myArcSources[i];
+            if (source >= 0) {
+                // connections of the network cost the effort of the approaching edge
+                if (efforts[source] < 0) {
+                    efforts[source] = effortProvider->getEffort(myCHInfos[source].edge, vehicle, time_seconds);
+                }
+                costs[i] = efforts[source];
+            }
+        }
+        for (typename std::vector<Triangle>::const_iterator it = myTriangles.begin(); it != myTriangles.end(); ++it) {
+            const double viaCost = costs[it->first] + costs[it->second];
+            if (viaCost < costs[it->arc]) {
+                costs[it->arc] = viaCost;
+                arcs[it->arc] = Arc(it->via, it->first, it->second);
+            }
+        }
+        for (int i = 0; i < numEdges; i++) {
+            updateCosts(myCustomizableHierarchy->forwardUplinks[i], costs);
+            updateCosts(myCustomizableHierarchy->backwardUplinks[i], costs);
+        }
+        MsgHandler::getMessageInstance()->endProcessMsg("done (" + toString(SysUtils::getCurrentMillis() - startMillis) + "ms).");
+        PROGRESS_DONE_MESSAGE();
+    }
+
 private:
     struct Shortcut {
-        Shortcut(ConstEdgePair e, double c, int u, SVCPermissions p):
-            edgePair(e), cost(c), underlying(u), permissions(p) {}
+        Shortcut(ConstEdgePair e, double c, int u, SVCPermissions p, int f, int s):
+            edgePair(e), cost(c), underlying(u), permissions(p), first(f), second(s) {}
         ConstEdgePair edgePair;
         double cost;
         int underlying;
         SVCPermissions permissions;
+        /// @brief the arcs to and from the contracted edge
+        int first;
+        int second;
+    };
+
+    /// @brief The arcs starting at an edge by their target and permissions
+    typedef std::map<std::pair<int, SVCPermissions>, int> ArcIndex;
+
+    /// @brief A possible path for an arc of the customizable hierarchy via a contracted edge
+    struct Triangle {
+        Triangle(int a, int f, int s, int v): arc(a), first(f), second(s), via(v) {}
+        int arc;
+        int first;
+        int second;
+        int via;
     };
 
 
@@ -218,13 +395,15 @@ private:
     /// @brief Forward/backward connection with associated FORWARD cost
     class CHConnection {
     public:
-        CHConnection(CHInfo* t, double c, SVCPermissions p, int u):
-            target(t), cost(c), permissions(p), underlying(u) {}
+        CHConnection(CHInfo* t, double c, SVCPermissions p, int u, int a):
+            target(t), cost(c), permissions(p), underlying(u), arc(a) {}
         CHInfo* target;
         double cost;
         SVCPermissions permissions;
         /// the number of connections underlying this connection
         int underlying;
+        /// the index of the arc within the hierarchy
+        int arc;
     };
 
     typedef std::vector<CHConnection> CHConnections;
@@ -244,7 +423,8 @@ private:
             level(0),
             underlyingTotal(0),
             visited(false),
-            traveltime(std::numeric_limits<double>::max()) {
+            traveltime(std::numeric_limits<double>::max()),
+            heapIndex(-1) {
         }
 
         /// @brief recompute the contraction priority and report whether it changed
@@ -287,7 +467,7 @@ private:
                         const int underlying = aInfo.underlying + fInfo.underlying;
                         underlyingTotal += underlying;
                         shortcuts.push_back(Shortcut(ConstEdgePair(aInfo.target->edge, fInfo.target->edge),
-                                                     viaCost, underlying, viaPermissions));
+                                                     viaCost, underlying, viaPermissions, aInfo.arc, fInfo.arc));
 
                     } else if (validatePermissions) {
                         if ((fInfo.target->permissions & viaPermissions) != viaPermissions) {
@@ -316,7 +496,7 @@ private:
                     const int underlying = aInfo->underlying + fInfo->underlying;
                     underlyingTotal += underlying;
                     shortcuts.push_back(Shortcut(ConstEdgePair(aInfo->target->edge, fInfo->target->edge),
-                                                 viaCost, underlying, viaPermissions));
+                                                 viaCost, underlying, viaPermissions, aInfo->arc, fInfo->arc));
                 }
             }
         }
@@ -384,6 +564,8 @@ private:
         // @note: we may miss some witness paths by making traveltime the only
         // criteria durinng search
         SVCPermissions permissions;
+        /// the position in the frontier heap of the SPTree (-1 if not queued)
+        int heapIndex;
 
         inline void reset() {
             traveltime = std::numeric_limits<double>::max();
@@ -427,7 +609,7 @@ private:
 
 
     /// @brief copy connections from the original net (modified destructively during contraction)
-    void synchronize(CHInfo& info, double time, const V* const vehicle, const SUMOAbstractRouter<E, V>* effortProvider) {
+    void synchronize(CHInfo& info, double time, const V* const vehicle, const SUMOAbstractRouter<E, V>* effortProvider, std::vector<Arc>& arcs) {
         // forward and backward connections are used only in forward search,
         // thus approaching costs are those of the approaching edge and not of the edge itself
         const bool prune = !mySPTree->validatePermissions();
@@ -445,8 +627,10 @@ private:
             }
             CHInfo* follower = getCHInfo(fEdge);
             SVCPermissions permissions = (edge->getPermissions() & follower->edge->getPermissions());
-            info.followers.push_back(CHConnection(follower, cost, permissions, 1));
-            follower->approaching.push_back(CHConnection(&info, cost, permissions, 1));
+            const int arc = (int)arcs.size();
+            arcs.push_back(Arc(-1, -1, -1));
+            info.followers.push_back(CHConnection(follower, cost, permissions, 1, arc));
+            follower->approaching.push_back(CHConnection(&info, cost, permissions, 1, arc));
         }
 #ifdef CHRouter_DEBUG_WEIGHTS
         std::cout << time << ": " << edge->getID() << " cost: " << cost << "\n";
@@ -455,6 +639,178 @@ private:
     }
 
 
+    /// @brief returns the description of the vehicle classes for messages
+    std::string getClassDescription() const {
+        return (mySPTree->validatePermissions() ?
+                "all vehicle classes " : "vClass='" + SumoVehicleClassStrings.getString(mySVC) + "' ");
+    }
+
+
+    /// @brief returns the customizable arc with the given ends and permissions, creating it if needed
+    int getArc(int from, int to, SVCPermissions permissions, std::vector<std::vector<int> >& outArcs, std::vector<std::vector<int> >& inArcs,
+               std::vector<ArcIndex>& arcIndex) {
+        const std::pair<ArcIndex::iterator, bool> it = arcIndex[from].insert(std::make_pair(std::make_pair(to, permissions), (int)myArcTargets.size()));
+        if (!it.second) {
+            return it.first->second;
+        }
+        const int arc = (int)myArcTargets.size();
+        myArcSources.push_back(-1);
+        myArcTargets.push_back(to);
+        myArcPermissions.push_back(permissions);
+        myArcFroms.push_back(from);
+        outArcs[from].push_back(arc);
+        inArcs[to].push_back(arc);
+        return arc;
+    }
+
+
+    /** @brief Computes a nested dissection order of the edges
+     *
+     * The edges are the nodes of the graph, neighbors are connected edges in
+     *  either direction. Every part is first split into its connected
+     *  components. A connected part is split at one level of a breadth first
+     *  search from a pseudo-peripheral edge. Since such a search only links
+     *  neighboring levels, the edges of this level separate the lower from
+     *  the higher levels. The smallest level which leaves no side with more
+     *  than two thirds of the part is chosen. The separator gets the highest
+     *  ranks of the part, both sides are ordered recursively below it.
+     * @param[in] neighbors The neighbors of every edge
+     * @param[out] byRank The edges in contraction order
+     */
+    static void computeNestedDissectionOrder(const std::vector<std::vector<int> >& neighbors, std::vector<int>& byRank) {
+        const int numEdges = (int)neighbors.size();
+        byRank.assign(numEdges, -1);
+        // the part every edge belongs to and its level in the current search (-1 if not reached)
+        std::vector<int> partOf(numEdges, 0);
+        std::vector<int> level(numEdges, -1);
+        // the parts still to order together with their first rank
+        std::vector<std::pair<std::vector<int>, int> > parts(1);
+        for (int i = 0; i < numEdges; i++) {
+            parts.back().first.push_back(i);
+        }
+        parts.back().second = 0;
+        int numParts = 1;
+        std::vector<int> reached;
+        while (!parts.empty()) {
+            std::vector<int> part;
+            part.swap(parts.back().first);
+            int rank = parts.back().second;
+            parts.pop_back();
+            if (part.empty()) {
+                continue;
+            }
+            const int partID = partOf[part.front()];
+            // split into connected components
+            bfs(part.front(), partID, neighbors, partOf, level, reached);
+            if (reached.size() < part.size()) {
+                for (std::vector<int>::const_iterator it = part.begin(); it != part.end(); ++it) {
+                    if (level[*it] < 0) {
+                        bfs(*it, partID, neighbors, partOf, level, reached);
+                        parts.push_back(std::make_pair(reached, rank));
+                        rank += (int)reached.size();
+                        for (std::vector<int>::const_iterator r = reached.begin(); r != reached.end(); ++r) {
+                            partOf[*r] = numParts;
+                        }
+                        numParts++;
+                    }
+                }
+                for (std::vector<int>::const_iterator it = part.begin(); it != part.end(); ++it) {
+                    level[*it] = -1;
+                }
+                // the first component was reached before the loop and was not assigned yet
+                std::vector<int> first;
+                for (std::vector<int>::const_iterator it = part.begin(); it != part.end(); ++it) {
+                    if (partOf[*it] == partID) {
+                        first.push_back(*it);
+                    }
+                }
+                parts.push_back(std::make_pair(first, rank));
+                continue;
+            }
+            // search again from the edge reached last (pseudo-peripheral)
+            for (std::vector<int>::const_iterator it = part.begin(); it != part.end(); ++it) {
+                level[*it] = -1;
+            }
+            bfs(reached.back(), partID, neighbors, partOf, level, reached);
+            const int numLevels = level[reached.back()] + 1;
+            std::vector<int> levelSize(numLevels, 0);
+            for (std::vector<int>::const_iterator it = part.begin(); it != part.end(); ++it) {
+                levelSize[level[*it]]++;
+            }
+            const int size = (int)part.size();
+            int separator = -1;
+            int below = levelSize[0];
+            for (int l = 1; l < numLevels - 1; l++) {
+                const int above = size - below - levelSize[l];
+                if (3 * MAX2(below, above) <= 2 * size && (separator < 0 || levelSize[l] < levelSize[separator])) {
+                    separator = l;
+                }
+                below += levelSize[l];
+            }
+            if (separator < 0) {
+                // too small or too dense to be split
+                for (std::vector<int>::const_iterator it = part.begin(); it != part.end(); ++it) {
+                    byRank[rank++] = *it;
+                    level[*it] = -1;
+                }
+                continue;
+            }
+            std::vector<int> lower;
+            std::vector<int> higher;
+            int separatorRank = rank + size - levelSize[separator];
+            for (std::vector<int>::const_iterator it = part.begin(); it != part.end(); ++it) {
+                if (level[*it] < separator) {
+                    lower.push_back(*it);
+                    partOf[*it] = numParts;
+                } else if (level[*it] > separator) {
+                    higher.push_back(*it);
+                    partOf[*it] = numParts + 1;
+                } else {
+                    byRank[separatorRank++] = *it;
+                    partOf[*it] = -1;
+                }
+                level[*it] = -1;
+            }
+            numParts += 2;
+            parts.push_back(std::make_pair(lower, rank));
+            parts.push_back(std::make_pair(higher, rank + (int)lower.size()));
+        }
+    }
+
+
+    /** @brief Runs a breadth first search within a part of the edges
+     * @param[in] start The edge to start from
+     * @param[in] partID The part to stay within
+     * @param[in] neighbors The neighbors of every edge
+     * @param[in] partOf The part of every edge
+     * @param[in, out] level The level of every reached edge (has to be -1 for the unreached edges of the part)
+     * @param[out] reached The reached edges in search order
+     */
+    static void bfs(int start, int partID, const std::vector<std::vector<int> >& neighbors, const std::vector<int>& partOf,
+                    std::vector<int>& level, std::vector<int>& reached) {
+        reached.clear();
+        reached.push_back(start);
+        level[start] = 0;
+        for (int i = 0; i < (int)reached.size(); i++) {
+            const int edge = reached[i];
+            for (std::vector<int>::const_iterator it = neighbors[edge].begin(); it != neighbors[edge].end(); ++it) {
+                if (partOf[*it] == partID && level[*it] < 0) {
+                    level[*it] = level[edge] + 1;
+                    reached.push_back(*it);
+                }
+            }
+        }
+    }
+
+
+    /// @brief copies the customized arc costs into the uplinks
+    static void updateCosts(std::vector<Connection>& uplinks, const std::vector<double>& costs) {
+        for (typename std::vector<Connection>::iterator it = uplinks.begin(); it != uplinks.end(); ++it) {
+            it->cost = costs[it->arc];
+        }
+    }
+
+
     /// @brief remove all connections to/from the given edge (assume it exists only once)
     void disconnect(CHConnections& connections, CHInfo* other) {
         for (typename CHConnections::iterator it = connections.begin(); it != connections.end(); it++) {
@@ -516,6 +872,23 @@ private:
     /// @brief counters for performance logging
     int myUpdateCount;
 
+    /// @name the arcs of the customizable hierarchy
+    /// @{
+    /// @brief the edge whose effort is the cost of the arc (-1 for shortcuts)
+    std::vector<int> myArcSources;
+    /// @brief the start of the arc
+    std::vector<int> myArcFroms;
+    /// @brief the end of the arc
+    std::vector<int> myArcTargets;
+    /// @brief the permissions of the arc
+    std::vector<SVCPermissions> myArcPermissions;
+    /// @brief the shortcut candidates in contraction order of their via edge
+    std::vector<Triangle> myTriangles;
+    /// @}
+
+    /// @brief the customizable hierarchy (owned by the router)
+    Hierarchy* myCustomizableHierarchy;
+
 private:
     /// @brief Invalidated assignment operator
     CHBuilder& operator=(const CHBuilder& s);
@@ -43,6 +43,7 @@
 #include <utils/common/MsgHandler.h>
 #include <utils/common/StdDefs.h>
 #include <utils/vehicle/SUMOAbstractRouter.h>
+#include <utils/vehicle/IndexedHeap.h>
 #include "CHBuilder.h"
 
 //#define CHRouter_DEBUG_QUERY
@@ -84,7 +85,9 @@ public:
             edge(e),
             traveltime(std::numeric_limits<double>::max()),
             prev(0),
-            visited(false) {
+            prevArc(-1),
+            visited(false),
+            heapIndex(-1) {
         }
 
         /// The current edge
@@ -96,9 +99,15 @@ public:
         /// The previous edge
         EdgeInfo* prev;
 
+        /// @brief the arc of the hierarchy between the previous edge and this one
+        int prevArc;
+
         /// Whether the shortest path to this edge is already found
         bool visited;
 
+        /// @brief the position within the frontier heap (-1 if not queued)
+        int heapIndex;
+
         inline void reset() {
             traveltime = std::numeric_limits<double>::max();
             visited = false;
@@ -155,7 +164,7 @@ public:
         void init(const E* const start, const V* const vehicle) {
             assert(vehicle != 0);
             // all EdgeInfos touched in the previous query are either in myFrontier or myFound: clean those up
-            for (typename std::vector<EdgeInfo*>::iterator i = myFrontier.begin(); i != myFrontier.end(); i++) {
+            for (typename Frontier::const_iterator i = myFrontier.begin(); i != myFrontier.end(); i++) {
                 (*i)->reset();
             }
             myFrontier.clear();
@@ -167,7 +176,8 @@ public:
             EdgeInfo* startInfo = getEdgeInfo(start);
             startInfo->traveltime = 0;
             startInfo->prev = 0;
-            myFrontier.push_back(startInfo);
+            startInfo->prevArc = -1;
+            myFrontier.push(startInfo);
         }
 
 
@@ -178,14 +188,13 @@ public:
          */
         bool step(const std::vector<ConnectionVector>& uplinks, const Unidirectional& otherSearch, double& minTTSeen, Meeting& meeting) {
             // pop the node with the minimal length
-            EdgeInfo* const minimumInfo = myFrontier.front();
-            pop_heap(myFrontier.begin(), myFrontier.end(), myComparator);
-            myFrontier.pop_back();
+            EdgeInfo* const minimumInfo = myFrontier.top();
+            myFrontier.pop();
             // check for a meeting with the other search
             const E* const minEdge = minimumInfo->edge;
 #ifdef CHRouter_DEBUG_QUERY
             std::cout << "DEBUG: " << (myAmForward ? "Forward" : "Backward") << " hit '" << minEdge->getID() << "' Q: ";
-            for (typename std::vector<EdgeInfo*>::iterator it = myFrontier.begin(); it != myFrontier.end(); it++) {
+            for (typename Frontier::const_iterator it = myFrontier.begin(); it != myFrontier.end(); it++) {
                 std::cout << (*it)->traveltime << "," << (*it)->edge->getID() << " ";
             }
             std::cout << "\n";
@@ -224,13 +233,11 @@ public:
                 if (!upwardInfo->visited && traveltime < oldTraveltime) {
                     upwardInfo->traveltime = traveltime;
                     upwardInfo->prev = minimumInfo;
+                    upwardInfo->prevArc = it->arc;
                     if (oldTraveltime == std::numeric_limits<double>::max()) {
-                        myFrontier.push_back(upwardInfo);
-                        push_heap(myFrontier.begin(), myFrontier.end(), myComparator);
+                        myFrontier.push(upwardInfo);
                     } else {
-                        push_heap(myFrontier.begin(),
-                                  find(myFrontier.begin(), myFrontier.end(), upwardInfo) + 1,
-                                  myComparator);
+                        myFrontier.update(upwardInfo);
                     }
                 }
             }
@@ -239,21 +246,20 @@ public:
             // quadrupled. We could implement a better stopping criterion (Holte)
             // However since the search shall take place in a contracted graph
             // it probably does not matter
-            return !myFrontier.empty() && myFrontier.front()->traveltime < minTTSeen;
+            return !myFrontier.empty() && myFrontier.top()->traveltime < minTTSeen;
         }
 
     private:
         /// @brief the role of this search
         bool myAmForward;
+        typedef IndexedHeap<EdgeInfo, EdgeInfoByTTComparator> Frontier;
         /// @brief the min edge heap
-        std::vector<EdgeInfo*> myFrontier;
+        Frontier myFrontier;
         /// @brief the set of visited (settled) Edges
         std::set<const E*> myFound;
         /// @brief The container of edge information
         std::vector<EdgeInfo> myEdgeInfos;
 
-        EdgeInfoByTTComparator myComparator;
-
         const V* myVehicle;
 
     };
@@ -380,42 +386,35 @@ public:
 
     /// Builds the path from marked edges
     void buildPathFromMeeting(Meeting meeting, std::vector<const E*>& into) const {
-        std::deque<const E*> tmp;
-        const EdgeInfo* backtrack = meeting.first;
-        while (backtrack != 0) {
-            tmp.push_front((E*) backtrack->edge);  // !!!
-            backtrack = backtrack->prev;
-        }
-        backtrack = meeting.second->prev; // don't use central edge twice
-        while (backtrack != 0) {
-            tmp.push_back((E*) backtrack->edge);  // !!!
-            backtrack = backtrack->prev;
+        std::vector<const EdgeInfo*> forward;
+        for (const EdgeInfo* backtrack = meeting.first; backtrack != 0; backtrack = backtrack->prev) {
+            forward.push_back(backtrack);
         }
         // expand shortcuts
-        const E* prev = 0;
-        while (!tmp.empty()) {
-            const E* cur = tmp.front();
-            tmp.pop_front();
-            if (prev == 0) {
-                into.push_back(cur);
-                prev = cur;
-            } else {
-                const E* via = getVia(prev, cur);
-                if (via == 0) {
-                    into.push_back(cur);
-                    prev = cur;
-                } else {
-                    tmp.push_front(cur);
-                    tmp.push_front(via);
-                }
+        for (typename std::vector<const EdgeInfo*>::const_reverse_iterator it = forward.rbegin(); it != forward.rend(); ++it) {
+            if ((*it)->prev != 0) {
+                unpack((*it)->prevArc, into);
             }
+            into.push_back((*it)->edge);
+        }
+        // the arcs of the backward search lead from the edge to its predecessor
+        for (const EdgeInfo* backtrack = meeting.second; backtrack->prev != 0; backtrack = backtrack->prev) {
+            unpack(backtrack->prevArc, into);
+            into.push_back(backtrack->prev->edge);
         }
     }
 
     void buildContractionHierarchy(SUMOTime time, const V* const vehicle) {
         if (myHierarchyBuilder != 0) {
-            delete myHierarchy;
-            myHierarchy = myHierarchyBuilder->buildContractionHierarchy(time, vehicle, this);
+            if (myHierarchy == 0) {
+                myHierarchy = myHierarchyBuilder->buildContractionHierarchy(time, vehicle, this);
+            } else if (myHierarchyBuilder->isCustomizable()) {
+                myHierarchyBuilder->customize(time, vehicle, this);
+            } else {
+                // the weights changed: keep the contraction order and only recompute the costs from now on
+                delete myHierarchy;
+                myHierarchy = myHierarchyBuilder->buildCustomizableHierarchy(time, vehicle, this);
+            }
         }
         // declare new validUntil (prevent overflow)
         if (myWeightPeriod < std::numeric_limits<int>::max()) {
@@ -426,14 +425,13 @@ public:
     }
 
 private:
-    // retrieve the via edge for a shortcut
-    const E* getVia(const E* forwardFrom, const E* forwardTo) const {
-        typename CHBuilder<E, V>::ConstEdgePair forward(forwardFrom, forwardTo);
-        typename CHBuilder<E, V>::ShortcutVia::const_iterator it = myHierarchy->shortcuts.find(forward);
-        if (it != myHierarchy->shortcuts.end()) {
-            return it->second;
-        } else {
-            return 0;
+    /// @brief appends the edges between the ends of the given arc (recursively expanding shortcuts)
+    void unpack(int arc, std::vector<const E*>& into) const {
+        const typename CHBuilder<E, V>::Arc& a = myHierarchy->arcs[arc];
+        if (a.via >= 0) {
+            unpack(a.first, into);
+            into.push_back(myEdges[a.via]);
+            unpack(a.second, into);
         }
     }
 
@@ -30,9 +30,7 @@
 #include <config.h>
 #endif
 
-#ifdef HAVE_FOX
-#include <fx.h>
-#endif
+#include <mutex>
 #include "IntermodalEdge.h"
 
 
@@ -58,9 +56,7 @@ public:
         if (vClass == SVC_IGNORING /* || !RONet::getInstance()->hasPermissions() */) {
             return this->myFollowingEdges;
         }
-#ifdef HAVE_FOX
-        FXMutexLock locker(myLock);
-#endif
+        std::lock_guard<std::mutex> locker(myLock);
         typename std::map<SUMOVehicleClass, std::vector<_IntermodalEdge*> >::const_iterator i = myClassesSuccessorMap.find(vClass);
         if (i != myClassesSuccessorMap.end()) {
             // can use cached value
@@ -103,10 +99,8 @@ private:
     /// @brief The successors available for a given vClass
     mutable std::map<SUMOVehicleClass, std::vector<_IntermodalEdge*> > myClassesSuccessorMap;
 
-#ifdef HAVE_FOX
     /// The mutex used to avoid concurrent updates of myClassesSuccessorMap
-    mutable FXMutex myLock;
-#endif
+    mutable std::mutex myLock;
 };
 
 
@@ -42,6 +42,7 @@
 #include <utils/common/MsgHandler.h>
 #include <utils/common/StdDefs.h>
 #include "SUMOAbstractRouter.h"
+#include "IndexedHeap.h"
 
 
 // ===========================================================================
@@ -77,7 +78,7 @@ public:
     public:
         /// Constructor
         EdgeInfo(const E* e)
-            : edge(e), effort(std::numeric_limits<double>::max()), leaveTime(0), prev(0), visited(false) {}
+            : edge(e), effort(std::numeric_limits<double>::max()), leaveTime(0), prev(0), visited(false), heapIndex(-1) {}
 
         /// The current edge
         const E* edge;
@@ -94,6 +95,9 @@ public:
         /// The previous edge
         bool visited;
 
+        /// @brief the position within the frontier heap (-1 if not queued)
+        int heapIndex;
+
         inline void reset() {
             effort = std::numeric_limits<double>::max();
             visited = false;
@@ -146,7 +150,7 @@ public:
 
     void init() {
         // all EdgeInfos touched in the previous query are either in myFrontierList or myFound: clean those up
-        for (typename std::vector<EdgeInfo*>::iterator i = myFrontierList.begin(); i != myFrontierList.end(); i++) {
+        for (typename FrontierList::const_iterator i = myFrontierList.begin(); i != myFrontierList.end(); i++) {
             (*i)->reset();
         }
         myFrontierList.clear();
@@ -187,17 +191,16 @@ public:
             fromInfo->effort = 0;
             fromInfo->prev = 0;
             fromInfo->leaveTime = STEPS2TIME(msTime);
-            myFrontierList.push_back(fromInfo);
+            myFrontierList.push(fromInfo);
         }
         // loop
         int num_visited = 0;
         while (!myFrontierList.empty()) {
             num_visited += 1;
             // use the node with the minimal length
-            EdgeInfo* const minimumInfo = myFrontierList.front();
+            EdgeInfo* const minimumInfo = myFrontierList.top();
             const E* const minEdge = minimumInfo->edge;
-            pop_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
-            myFrontierList.pop_back();
+            myFrontierList.pop();
             myFound.push_back(minimumInfo);
             // check whether the destination node was already reached
             if (minEdge == to) {
@@ -223,12 +226,9 @@ public:
                     followerInfo->leaveTime = leaveTime;
                     followerInfo->prev = minimumInfo;
                     if (oldEffort == std::numeric_limits<double>::max()) {
-                        myFrontierList.push_back(followerInfo);
-                        push_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
+                        myFrontierList.push(followerInfo);
                     } else {
-                        push_heap(myFrontierList.begin(),
-                                  find(myFrontierList.begin(), myFrontierList.end(), followerInfo) + 1,
-                                  myComparator);
+                        myFrontierList.update(followerInfo);
                     }
                 }
             }
@@ -270,13 +270,12 @@ private:
     /// The container of edge information
     std::vector<EdgeInfo> myEdgeInfos;
 
+    typedef IndexedHeap<EdgeInfo, EdgeInfoByEffortComparator> FrontierList;
     /// A container for reusage of the min edge heap
-    std::vector<EdgeInfo*> myFrontierList;
+    FrontierList myFrontierList;
     /// @brief list of visited Edges (for resetting)
     std::vector<EdgeInfo*> myFound;
 
-    EdgeInfoByEffortComparator myComparator;
-
     /// @brief the handler for routing errors
     MsgHandler* const myErrorMsgHandler;
 
@@ -45,6 +45,7 @@
 #include <utils/common/MsgHandler.h>
 #include <utils/common/StdDefs.h>
 #include "SUMOAbstractRouter.h"
+#include "IndexedHeap.h"
 
 //#define DijkstraRouterTT_DEBUG_QUERY
 //#define DijkstraRouterTT_DEBUG_QUERY_PERF
@@ -82,7 +83,7 @@ public:
     public:
         /// Constructor
         EdgeInfo(const E* e)
-            : edge(e), traveltime(std::numeric_limits<double>::max()), prev(0), visited(false) {}
+            : edge(e), traveltime(std::numeric_limits<double>::max()), prev(0), visited(false), heapIndex(-1) {}
 
         /// The current edge
         const E* edge;
@@ -96,6 +97,9 @@ public:
         /// The previous edge
         bool visited;
 
+        /// @brief the position within the frontier heap (-1 if not queued)
+        int heapIndex;
+
         inline void reset() {
             traveltime = std::numeric_limits<double>::max();
             visited = false;
@@ -143,7 +147,7 @@ public:
 
     void init() {
         // all EdgeInfos touched in the previous query are either in myFrontierList or myFound: clean those up
-        for (typename std::vector<EdgeInfo*>::iterator i = myFrontierList.begin(); i != myFrontierList.end(); i++) {
+        for (typename FrontierList::const_iterator i = myFrontierList.begin(); i != myFrontierList.end(); i++) {
             (*i)->reset();
         }
         myFrontierList.clear();
@@ -187,14 +191,14 @@ public:
             EdgeInfo* const fromInfo = &(myEdgeInfos[from->getNumericalID()]);
             fromInfo->traveltime = 0;
             fromInfo->prev = 0;
-            myFrontierList.push_back(fromInfo);
+            myFrontierList.push(fromInfo);
         }
         // loop
         int num_visited = 0;
         while (!myFrontierList.empty()) {
             num_visited += 1;
             // use the node with the minimal length
-            EdgeInfo* const minimumInfo = myFrontierList.front();
+            EdgeInfo* const minimumInfo = myFrontierList.top();
             const E* const minEdge = minimumInfo->edge;
             // check whether the destination node was already reached
             if (minEdge == to) {
@@ -205,13 +209,12 @@ public:
 #endif
                 return true;
             }
-            pop_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
-            myFrontierList.pop_back();
+            myFrontierList.pop();
             myFound.push_back(minimumInfo);
             minimumInfo->visited = true;
 #ifdef DijkstraRouterTT_DEBUG_QUERY
             std::cout << "DEBUG: hit '" << minEdge->getID() << "' TT: " << minimumInfo->traveltime << " Q: ";
-            for (typename std::vector<EdgeInfo*>::iterator it = myFrontierList.begin(); it != myFrontierList.end(); it++) {
+            for (typename FrontierList::const_iterator it = myFrontierList.begin(); it != myFrontierList.end(); it++) {
                 std::cout << (*it)->traveltime << "," << (*it)->edge->getID() << " ";
             }
             std::cout << "\n";
@@ -231,12 +234,9 @@ public:
                     followerInfo->traveltime = traveltime;
                     followerInfo->prev = minimumInfo;
                     if (oldEffort == std::numeric_limits<double>::max()) {
-                        myFrontierList.push_back(followerInfo);
-                        push_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
+                        myFrontierList.push(followerInfo);
                     } else {
-                        push_heap(myFrontierList.begin(),
-                                  find(myFrontierList.begin(), myFrontierList.end(), followerInfo) + 1,
-                                  myComparator);
+                        myFrontierList.update(followerInfo);
                     }
                 }
             }
@@ -283,13 +283,12 @@ private:
     /// The container of edge information
     std::vector<EdgeInfo> myEdgeInfos;
 
+    typedef IndexedHeap<EdgeInfo, EdgeInfoByTTComparator> FrontierList;
     /// A container for reusage of the min edge heap
-    std::vector<EdgeInfo*> myFrontierList;
+    FrontierList myFrontierList;
     /// @brief list of visited Edges (for resetting)
     std::vector<EdgeInfo*> myFound;
 
-    EdgeInfoByTTComparator myComparator;
-
     /// @brief the handler for routing errors
     MsgHandler* const myErrorMsgHandler;
 };
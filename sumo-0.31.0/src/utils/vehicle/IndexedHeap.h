@@ -0,0 +1,192 @@
+/****************************************************************************/
+/// @file    IndexedHeap.h
+/// @date    Oct 2017
+/// @version $Id$
+///
+// A binary heap of pointers which knows the position of each element
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef IndexedHeap_h
+#define IndexedHeap_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cassert>
+#include <vector>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class IndexedHeap
+ * @brief A binary heap of pointers which knows the position of each element
+ *
+ * The elements store their current position within the heap in a public
+ *  member "heapIndex" which has to be initialized with -1 (not queued).
+ *  This allows to decrease the key of a queued element in logarithmic time
+ *  without searching for it first (as needed by the routers).
+ *
+ * The comparator follows the conventions of std::push_heap, so using a
+ *  "greater" comparison puts the smallest element on top.
+ *
+ * The template parameters are:
+ * @param T The element class (the heap stores T*)
+ * @param C The comparator for two T*
+ */
+template<class T, class C>
+class IndexedHeap {
+public:
+    typedef typename std::vector<T*>::const_iterator const_iterator;
+
+    /// @brief Constructor
+    IndexedHeap(const C& comparator = C()) : myComparator(comparator) {}
+
+    /// @brief Returns whether the heap is empty
+    bool empty() const {
+        return myHeap.empty();
+    }
+
+    /// @brief Returns the number of queued elements
+    int size() const {
+        return (int)myHeap.size();
+    }
+
+    /// @brief Returns the top (minimal) element
+    T* top() const {
+        return myHeap.front();
+    }
+
+    /// @brief Returns whether the given element is queued
+    bool contains(const T* const elem) const {
+        return elem->heapIndex >= 0;
+    }
+
+    /** @brief Adds an element which is not yet queued
+     * @param[in] elem The element to add
+     */
+    void push(T* const elem) {
+        assert(!contains(elem));
+        elem->heapIndex = (int)myHeap.size();
+        myHeap.push_back(elem);
+        siftUp(elem->heapIndex);
+    }
+
+    /// @brief Removes the top element
+    void pop() {
+        assert(!empty());
+        myHeap.front()->heapIndex = -1;
+        T* const last = myHeap.back();
+        myHeap.pop_back();
+        if (!myHeap.empty()) {
+            myHeap.front() = last;
+            last->heapIndex = 0;
+            siftDown(0);
+        }
+    }
+
+    /** @brief Restores the heap order after the key of a queued element was changed
+     *
+     * This is usually a decrease (moving the element towards the top) but
+     *  the A* key may also grow when the heuristic of the new predecessor differs.
+     * @param[in] elem The element whose key was changed
+     */
+    void update(T* const elem) {
+        assert(contains(elem) && myHeap[elem->heapIndex] == elem);
+        const int index = elem->heapIndex;
+        siftUp(index);
+        if (elem->heapIndex == index) {
+            siftDown(index);
+        }
+    }
+
+    /// @brief Removes all elements
+    void clear() {
+        for (typename std::vector<T*>::iterator i = myHeap.begin(); i != myHeap.end(); ++i) {
+            (*i)->heapIndex = -1;
+        }
+        myHeap.clear();
+    }
+
+    /// @brief Iterates over the queued elements (in heap order, not sorted)
+    const_iterator begin() const {
+        return myHeap.begin();
+    }
+
+    /// @brief End of the iteration over the queued elements
+    const_iterator end() const {
+        return myHeap.end();
+    }
+
+private:
+    /// @brief moves the element at the given position towards the top
+    void siftUp(int index) {
+        T* const elem = myHeap[index];
+        while (index > 0) {
+            const int parent = (index - 1) / 2;
+            if (!myComparator(myHeap[parent], elem)) {
+                break;
+            }
+            myHeap[index] = myHeap[parent];
+            myHeap[index]->heapIndex = index;
+            index = parent;
+        }
+        myHeap[index] = elem;
+        elem->heapIndex = index;
+    }
+
+    /// @brief moves the element at the given position towards the bottom
+    void siftDown(int index) {
+        const int size = (int)myHeap.size();
+        T* const elem = myHeap[index];
+        while (true) {
+            int child = 2 * index + 1;
+            if (child >= size) {
+                break;
+            }
+            if (child + 1 < size && myComparator(myHeap[child], myHeap[child + 1])) {
+                child++;
+            }
+            if (!myComparator(elem, myHeap[child])) {
+                break;
+            }
+            myHeap[index] = myHeap[child];
+            myHeap[index]->heapIndex = index;
+            index = child;
+        }
+        myHeap[index] = elem;
+        elem->heapIndex = index;
+    }
+
+private:
+    /// @brief the heap in array representation
+    std::vector<T*> myHeap;
+
+    /// @brief the comparator (true if the first element belongs below the second)
+    C myComparator;
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
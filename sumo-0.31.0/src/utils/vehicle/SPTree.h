@@ -40,6 +40,7 @@
 #include <iterator>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/StdDefs.h>
+#include "IndexedHeap.h"
 
 
 template<class E, class C>
@@ -77,7 +78,7 @@ public:
 
     void init() {
         // all EdgeInfos touched in the previous query are either in myFrontier or myFound: clean those up
-        for (typename std::vector<E*>::iterator i = myFrontier.begin(); i != myFrontier.end(); i++) {
+        for (typename Frontier::const_iterator i = myFrontier.begin(); i != myFrontier.end(); i++) {
             (*i)->reset();
         }
         myFrontier.clear();
@@ -97,12 +98,11 @@ public:
         start->traveltime = 0;
         start->depth = 0;
         start->permissions = start->edge->getPermissions();
-        myFrontier.push_back(start);
+        myFrontier.push(start);
         // build SPT
         while (!myFrontier.empty()) {
-            E* min = myFrontier.front();
-            pop_heap(myFrontier.begin(), myFrontier.end(), myCmp);
-            myFrontier.pop_back();
+            E* min = myFrontier.top();
+            myFrontier.pop();
             myFound.push_back(min);
             min->visited = true;
             if (min->depth < myMaxDepth) {
@@ -119,12 +119,9 @@ public:
                         follower->depth = min->depth + 1;
                         follower->permissions = (min->permissions & con.permissions);
                         if (oldTraveltime == std::numeric_limits<double>::max()) {
-                            myFrontier.push_back(follower);
-                            push_heap(myFrontier.begin(), myFrontier.end(), myCmp);
+                            myFrontier.push(follower);
                         } else {
-                            push_heap(myFrontier.begin(),
-                                      find(myFrontier.begin(), myFrontier.end(), follower) + 1,
-                                      myCmp);
+                            myFrontier.update(follower);
                         }
                     }
                 }
@@ -171,15 +168,14 @@ private:
         init();
         start->traveltime = 0;
         start->depth = 0;
-        myFrontier.push_back(start);
+        myFrontier.push(start);
         // build SPT
         while (!myFrontier.empty()) {
-            E* min = myFrontier.front();
+            E* min = myFrontier.top();
             if (min == dest) {
                 return dest->traveltime;
             }
-            pop_heap(myFrontier.begin(), myFrontier.end(), myCmp);
-            myFrontier.pop_back();
+            myFrontier.pop();
             myFound.push_back(min);
             min->visited = true;
             if (min->depth < myMaxDepth) {
@@ -199,12 +195,9 @@ private:
                         follower->depth = min->depth + 1;
                         follower->permissions = (min->permissions & con.permissions);
                         if (oldTraveltime == std::numeric_limits<double>::max()) {
-                            myFrontier.push_back(follower);
-                            push_heap(myFrontier.begin(), myFrontier.end(), myCmp);
+                            myFrontier.push(follower);
                         } else {
-                            push_heap(myFrontier.begin(),
-                                      find(myFrontier.begin(), myFrontier.end(), follower) + 1,
-                                      myCmp);
+                            myFrontier.update(follower);
                         }
                     }
                 }
@@ -224,14 +217,12 @@ private:
         std::cout << "\n";
     }
 
+    typedef IndexedHeap<E, EdgeByTTComparator> Frontier;
     /// @brief the min edge heap
-    std::vector<E*> myFrontier;
+    Frontier myFrontier;
     /// @brief the list of visited edges (used when resetting)
     std::vector<E*> myFound;
 
-    /// @brief comparator for search queue
-    EdgeByTTComparator myCmp;
-
     /// @brief maximum search depth
     int myMaxDepth;
 
@@ -113,35 +113,20 @@ SUMOSAXReader::parseString(std::string content) {
 }
 
 
+void
+SUMOSAXReader::parseBinaryString(const std::string& content) {
+    myBinaryInput = new BinaryInputDevice(content, true, myValidationScheme == XERCES_CPP_NAMESPACE::SAX2XMLReader::Val_Always, true);
+    if (parseBinaryFirst()) {
+        while (parseNext());
+    }
+}
+
+
 bool
 SUMOSAXReader::parseFirst(std::string systemID) {
     if (systemID.substr(systemID.length() - 4) == ".sbx") {
         myBinaryInput = new BinaryInputDevice(systemID, true, myValidationScheme == XERCES_CPP_NAMESPACE::SAX2XMLReader::Val_Always);
-        *myBinaryInput >> mySbxVersion;
-        if (mySbxVersion < 1 || mySbxVersion > 2) {
-            throw ProcessError("Unknown sbx version");
-        }
-        std::string sumoVer;
-        *myBinaryInput >> sumoVer;
-        std::vector<std::string> elems;
-        *myBinaryInput >> elems;
-        // !!! check elems here
-        elems.clear();
-        *myBinaryInput >> elems;
-        // !!! check attrs here
-        elems.clear();
-        *myBinaryInput >> elems;
-        // !!! check node types here
-        elems.clear();
-        *myBinaryInput >> elems;
-        // !!! check edge types here
-        elems.clear();
-        *myBinaryInput >> elems;
-        // !!! check edges here
-        std::vector< std::vector<int> > followers;
-        *myBinaryInput >> followers;
-        // !!! check followers here
-        return parseNext();
+        return parseBinaryFirst();
     } else {
         if (myXMLReader == 0) {
             myXMLReader = getSAXReader();
@@ -152,6 +137,36 @@ SUMOSAXReader::parseFirst(std::string systemID) {
 }
 
 
+bool
+SUMOSAXReader::parseBinaryFirst() {
+    *myBinaryInput >> mySbxVersion;
+    if (mySbxVersion < 1 || mySbxVersion > 2) {
+        throw ProcessError("Unknown sbx version");
+    }
+    std::string sumoVer;
+    *myBinaryInput >> sumoVer;
+    std::vector<std::string> elems;
+    *myBinaryInput >> elems;
+    // !!! check elems here
+    elems.clear();
+    *myBinaryInput >> elems;
+    // !!! check attrs here
+    elems.clear();
+    *myBinaryInput >> elems;
+    // !!! check node types here
+    elems.clear();
+    *myBinaryInput >> elems;
+    // !!! check edge types here
+    elems.clear();
+    *myBinaryInput >> elems;
+    // !!! check edges here
+    std::vector< std::vector<int> > followers;
+    *myBinaryInput >> followers;
+    // !!! check followers here
+    return parseNext();
+}
+
+
 bool
 SUMOSAXReader::parseNext() {
     if (myBinaryInput != 0) {
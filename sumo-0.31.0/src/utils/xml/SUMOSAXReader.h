@@ -80,6 +80,9 @@ public:
 
     void parseString(std::string content);
 
+    /// @brief parses binary (sbx) content which is held in memory instead of a file
+    void parseBinaryString(const std::string& content);
+
     bool parseFirst(std::string systemID);
 
     bool parseNext();
@@ -103,6 +106,9 @@ private:
      */
     XERCES_CPP_NAMESPACE::SAX2XMLReader* getSAXReader();
 
+    /// @brief reads the header of the binary input and parses the first element
+    bool parseBinaryFirst();
+
 
 private:
     GenericSAXHandler* myHandler;
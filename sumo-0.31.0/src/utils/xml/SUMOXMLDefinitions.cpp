@@ -159,6 +159,10 @@ StringBijection<int>::Entry SUMOXMLDefinitions::tags[] = {
     { "entry",                      SUMO_TAG_ENTRY },
     { "vehicleTransfer",            SUMO_TAG_VEHICLETRANSFER },
     { "device",                     SUMO_TAG_DEVICE },
+    { "flowState",                  SUMO_TAG_FLOWSTATE },
+    { "rngState",                   SUMO_TAG_RNGSTATE },
+    { "detectorState",              SUMO_TAG_DETECTORSTATE },
+    { "eventState",                 SUMO_TAG_EVENTSTATE },
     // Cars
     { "carFollowing-IDM",           SUMO_TAG_CF_IDM },
     { "carFollowing-IDMM",          SUMO_TAG_CF_IDMM },
@@ -498,6 +502,11 @@ StringBijection<int>::Entry SUMOXMLDefinitions::attrs[] = {
     { "actType",                SUMO_ATTR_ACTTYPE },
     { "slope",                  SUMO_ATTR_SLOPE },
     { "version",                SUMO_ATTR_VERSION },
+    { "done",                   SUMO_ATTR_DONE },
+    { "phase",                  SUMO_ATTR_PHASE },
+    { "default",                SUMO_ATTR_RNG_DEFAULT },
+    { "routeHandler",           SUMO_ATTR_RNG_ROUTEHANDLER },
+    { "device",                 SUMO_ATTR_RNG_DEVICE },
     { "junctionCornerDetail",   SUMO_ATTR_CORNERDETAIL },
     { "junctionLinkDetail",     SUMO_ATTR_LINKDETAIL },
     { "rectangularLaneCut",     SUMO_ATTR_RECTANGULAR_LANE_CUT },
@@ -245,6 +245,14 @@ enum SumoXMLTag {
 
     SUMO_TAG_VEHICLETRANSFER,
     SUMO_TAG_DEVICE,
+    /// @brief the state of a flow which is still emitting vehicles
+    SUMO_TAG_FLOWSTATE,
+    /// @brief the internal state of the random number generators
+    SUMO_TAG_RNGSTATE,
+    /// @brief the collected values of a detector or the last output time of a detector interval
+    SUMO_TAG_DETECTORSTATE,
+    /// @brief the execution times of the queued events
+    SUMO_TAG_EVENTSTATE,
 
     /// @name Car-Following models
     /// @{
@@ -726,6 +734,14 @@ enum SumoXMLAttr {
     SUMO_ATTR_ACTTYPE,
     SUMO_ATTR_SLOPE,
     SUMO_ATTR_VERSION,
+    /// @name state saving attributes
+    /// @{
+    SUMO_ATTR_DONE,
+    SUMO_ATTR_PHASE,
+    SUMO_ATTR_RNG_DEFAULT,
+    SUMO_ATTR_RNG_ROUTEHANDLER,
+    SUMO_ATTR_RNG_DEVICE,
+    /// @}
     SUMO_ATTR_CORNERDETAIL,
     SUMO_ATTR_LINKDETAIL,
     SUMO_ATTR_RECTANGULAR_LANE_CUT,
@@ -0,0 +1,94 @@
+#!/usr/bin/env python
+"""
+@file    benchmarkJunctions.py
+@date    2017-10-17
+@version $Id$
+
+Measures the simulation speed on a junction heavy network: a spider network
+with many-armed signalised intersections which is saturated with random
+traffic. The wall clock duration and the number of vehicle updates per second
+are reported for each of the given sumo binaries (e.g. before and after a
+change of the junction model).
+
+SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+
+This file is part of SUMO.
+SUMO is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+"""
+from __future__ import print_function
+from __future__ import absolute_import
+import os
+import sys
+import subprocess
+import time
+import optparse
+
+SUMO_HOME = os.environ.get('SUMO_HOME',
+                           os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+sys.path.append(os.path.join(SUMO_HOME, 'tools'))
+import sumolib  # noqa
+
+
+def get_options(args=None):
+    optParser = optparse.OptionParser()
+    optParser.add_option("-a", "--arms", type="int", default=8,
+                         help="number of arms of the spider network (and of its intersections)")
+    optParser.add_option("-c", "--circles", type="int", default=10,
+                         help="number of circles of the spider network")
+    optParser.add_option("-p", "--period", type="float", default=0.1,
+                         help="insertion period of the random trips")
+    optParser.add_option("-e", "--end", type="int", default=3600,
+                         help="end of the insertion of vehicles")
+    optParser.add_option("-d", "--dir", default="benchmark_junctions",
+                         help="directory for the generated inputs and outputs")
+    optParser.add_option("--sumo", default=sumolib.checkBinary("sumo"),
+                         help="comma separated sumo binaries to compare")
+    options, args = optParser.parse_args(args=args)
+    options.sumo = options.sumo.split(",")
+    return options
+
+
+def generate(options):
+    if not os.path.exists(options.dir):
+        os.makedirs(options.dir)
+    prefix = os.path.join(options.dir, "spider%sx%s" % (options.arms, options.circles))
+    net = prefix + ".net.xml"
+    routes = prefix + ".rou.xml"
+    if not os.path.exists(net):
+        subprocess.check_call([sumolib.checkBinary("netgenerate"), "--spider",
+                               "--spider.arm-number", str(options.arms), "--spider.circle-number", str(options.circles),
+                               "--spider.space-radius", "100", "--default.lanenumber", "2",
+                               "--default-junction-type", "traffic_light", "-o", net])
+    if not os.path.exists(routes):
+        subprocess.check_call([sys.executable, os.path.join(SUMO_HOME, "tools", "randomTrips.py"),
+                               "-n", net, "-r", routes, "-o", prefix + ".trips.xml",
+                               "-p", str(options.period), "-e", str(options.end), "--seed", "42"])
+    return net, routes
+
+
+def run(sumo, net, routes):
+    begin = time.time()
+    output = subprocess.check_output([sumo, "-n", net, "-r", routes, "--no-step-log", "--no-warnings",
+                                      "--duration-log.statistics"], universal_newlines=True)
+    duration = time.time() - begin
+    updates = 0
+    for line in output.splitlines():
+        if "UPS:" in line:
+            updates = float(line.split(":")[1])
+    return duration, updates
+
+
+def main(options):
+    net, routes = generate(options)
+    print("sumo\tduration[s]\tUPS")
+    for sumo in options.sumo:
+        duration, updates = run(sumo, net, routes)
+        print("%s\t%.2f\t%.0f" % (sumo, duration, updates))
+
+
+if __name__ == "__main__":
+    main(get_options())
@@ -0,0 +1,103 @@
+#!/usr/bin/env python
+"""
+@file    benchmarkMeso.py
+@date    2017-10-17
+@version $Id$
+
+Measures the throughput of the mesoscopic simulation on a large grid network
+which is loaded with random trips. For each of the given sumo binaries the
+wall clock duration and the number of vehicle segment transitions per second
+are reported. The transitions are counted from the routes of the arrived
+vehicles and the number of segments of each edge (as built by MELoop).
+
+SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+
+This file is part of SUMO.
+SUMO is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+"""
+from __future__ import print_function
+from __future__ import absolute_import
+import os
+import sys
+import subprocess
+import time
+import optparse
+
+SUMO_HOME = os.environ.get('SUMO_HOME',
+                           os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+sys.path.append(os.path.join(SUMO_HOME, 'tools'))
+import sumolib  # noqa
+
+
+def get_options(args=None):
+    optParser = optparse.OptionParser()
+    optParser.add_option("-g", "--grid-size", type="int", default=50,
+                         help="number of junctions per side of the generated grid")
+    optParser.add_option("-p", "--period", type="float", default=0.05,
+                         help="insertion period of the random trips")
+    optParser.add_option("-e", "--end", type="int", default=3600,
+                         help="end of the insertion of vehicles")
+    optParser.add_option("--meso-edgelength", type="float", default=98.,
+                         help="segment length given to the simulation")
+    optParser.add_option("-d", "--dir", default="benchmark_meso",
+                         help="directory for the generated inputs and outputs")
+    optParser.add_option("--sumo", default=sumolib.checkBinary("sumo"),
+                         help="comma separated sumo binaries to compare")
+    options, args = optParser.parse_args(args=args)
+    options.sumo = options.sumo.split(",")
+    return options
+
+
+def generate(options):
+    if not os.path.exists(options.dir):
+        os.makedirs(options.dir)
+    prefix = os.path.join(options.dir, "grid%s" % options.grid_size)
+    net = prefix + ".net.xml"
+    routes = prefix + ".rou.xml"
+    if not os.path.exists(net):
+        subprocess.check_call([sumolib.checkBinary("netgenerate"), "--grid",
+                               "--grid.number", str(options.grid_size), "--grid.length", "200",
+                               "--default.lanenumber", "2", "-o", net])
+    if not os.path.exists(routes):
+        subprocess.check_call([sys.executable, os.path.join(SUMO_HOME, "tools", "randomTrips.py"),
+                               "-n", net, "-r", routes, "-o", prefix + ".trips.xml",
+                               "-p", str(options.period), "-e", str(options.end), "--seed", "42"])
+    return net, routes
+
+
+def segmentNumbers(net, segmentLength):
+    # mirrors MELoop::numSegmentsFor
+    result = {}
+    for edge in sumolib.net.readNet(net).getEdges():
+        result[edge.getID()] = max(1, int(edge.getLength() / segmentLength + 0.5))
+    return result
+
+
+def run(options, sumo, net, routes, segments):
+    vehroutes = os.path.join(options.dir, "vehroutes.xml")
+    begin = time.time()
+    subprocess.check_call([sumo, "-n", net, "-r", routes, "--mesosim",
+                           "--meso-edgelength", str(options.meso_edgelength),
+                           "--vehroute-output", vehroutes, "--no-step-log", "--no-warnings"])
+    duration = time.time() - begin
+    transitions = 0
+    for route in sumolib.output.parse_fast(vehroutes, "route", ["edges"]):
+        transitions += sum([segments.get(edge, 1) for edge in route.edges.split()])
+    return duration, transitions
+
+
+def main(options):
+    net, routes = generate(options)
+    segments = segmentNumbers(net, options.meso_edgelength)
+    print("sumo\tduration[s]\ttransitions\ttransitions/s")
+    for sumo in options.sumo:
+        duration, transitions = run(options, sumo, net, routes, segments)
+        print("%s\t%.2f\t%s\t%.0f" % (sumo, duration, transitions, transitions / duration))
+
+
+if __name__ == "__main__":
+    main(get_options())
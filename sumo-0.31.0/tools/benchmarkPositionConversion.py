@@ -0,0 +1,84 @@
+#!/usr/bin/env python
+"""
+@file    benchmarkPositionConversion.py
+@date    2017-10-16
+@version $Id$
+
+Measures the latency of converting cartesian coordinates to road positions
+(traci.simulation.convertRoad, the same lookup as used by moveToXY) for
+grid networks of growing size. Random positions within the network boundary
+are converted and the mean duration per query is reported together with the
+number of edges of the network.
+
+SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+
+This file is part of SUMO.
+SUMO is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+"""
+from __future__ import print_function
+from __future__ import absolute_import
+import os
+import sys
+import subprocess
+import random
+import time
+import optparse
+
+SUMO_HOME = os.environ.get('SUMO_HOME',
+                           os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+sys.path.append(os.path.join(SUMO_HOME, 'tools'))
+import sumolib  # noqa
+import traci  # noqa
+
+
+def get_options(args=None):
+    optParser = optparse.OptionParser()
+    optParser.add_option("-q", "--queries", type="int", default=10000,
+                         help="number of measured conversions per network")
+    optParser.add_option("-g", "--grid-sizes", default="5,10,20,40,80",
+                         help="comma separated number of junctions per grid side")
+    optParser.add_option("-d", "--dir", default="benchmark_conversion",
+                         help="directory for the generated networks")
+    optParser.add_option("--sumo", default=sumolib.checkBinary("sumo"), help="the sumo binary to use")
+    options, args = optParser.parse_args(args=args)
+    options.grid_sizes = [int(size) for size in options.grid_sizes.split(",")]
+    return options
+
+
+def generate(options, size):
+    if not os.path.exists(options.dir):
+        os.makedirs(options.dir)
+    net = os.path.join(options.dir, "grid%s.net.xml" % size)
+    if not os.path.exists(net):
+        subprocess.check_call([sumolib.checkBinary("netgenerate"), "--grid", "--grid.number", str(size),
+                               "--grid.length", "100", "-o", net])
+    return net
+
+
+def run(options, net):
+    traci.start([options.sumo, "-n", net, "--no-step-log"])
+    numEdges = traci.edge.getIDCount()
+    (xmin, ymin), (xmax, ymax) = traci.simulation.getNetBoundary()
+    random.seed(42)
+    positions = [(random.uniform(xmin, xmax), random.uniform(ymin, ymax)) for i in range(options.queries)]
+    begin = time.time()
+    for x, y in positions:
+        traci.simulation.convertRoad(x, y)
+    latency = (time.time() - begin) / options.queries
+    traci.close()
+    return numEdges, latency
+
+
+def main(options):
+    print("edges\tconvertRoad[us]")
+    for size in options.grid_sizes:
+        numEdges, latency = run(options, generate(options, size))
+        print("%s\t%.1f" % (numEdges, latency * 1e6))
+
+
+if __name__ == "__main__":
+    main(get_options())
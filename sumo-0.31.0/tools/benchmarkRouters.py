@@ -0,0 +1,148 @@
+#!/usr/bin/env python
+"""
+@file    benchmarkRouters.py
+@date    2017-10-17
+@version $Id$
+
+Measures the query throughput of the routing algorithms of duarouter on a
+large grid network with random origin destination pairs. For every algorithm
+the network loading time (a run without trips) is subtracted from the duration
+of the full run and the number of routing queries per second is reported.
+With --weight-intervals random edge weights for the given number of intervals
+are generated, so the contraction hierarchy is rebuilt (customized) for every
+interval. The time spent contracting and customizing the hierarchy is then
+reported separately and not counted as routing time. For the hierarchies the
+size of the result is reported as well, i.e. the number of shortcuts of the
+contraction hierarchy and the number of arcs and triangles (shortcut
+candidates) of the customizable one.
+
+SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+
+This file is part of SUMO.
+SUMO is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+"""
+from __future__ import print_function
+from __future__ import absolute_import
+import os
+import sys
+import subprocess
+import time
+import optparse
+import random
+
+SUMO_HOME = os.environ.get('SUMO_HOME',
+                           os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+sys.path.append(os.path.join(SUMO_HOME, 'tools'))
+import sumolib  # noqa
+
+
+def get_options(args=None):
+    optParser = optparse.OptionParser()
+    optParser.add_option("-n", "--net-file", help="network to route on (a grid is generated if not given)")
+    optParser.add_option("-g", "--grid-size", type="int", default=100,
+                         help="number of junctions per side of the generated grid")
+    optParser.add_option("-q", "--queries", type="int", default=10000,
+                         help="number of random origin destination pairs")
+    optParser.add_option("-a", "--algorithms", default="dijkstra,astar,CH",
+                         help="comma separated routing algorithms to measure")
+    optParser.add_option("-w", "--weight-intervals", type="int", default=0,
+                         help="number of intervals with random edge weights")
+    optParser.add_option("-d", "--dir", default="benchmark_routers",
+                         help="directory for the generated inputs and outputs")
+    optParser.add_option("--duarouter", default=sumolib.checkBinary("duarouter"),
+                         help="the duarouter binary to use")
+    options, args = optParser.parse_args(args=args)
+    options.algorithms = options.algorithms.split(",")
+    if options.weight_intervals > 0:
+        options.weight_period = (options.queries + options.weight_intervals - 1) // options.weight_intervals
+    return options
+
+
+def generate(options):
+    if not os.path.exists(options.dir):
+        os.makedirs(options.dir)
+    net = options.net_file
+    if net is None:
+        net = os.path.join(options.dir, "grid%s.net.xml" % options.grid_size)
+        if not os.path.exists(net):
+            subprocess.check_call([sumolib.checkBinary("netgenerate"), "--grid",
+                                   "--grid.number", str(options.grid_size), "--grid.length", "100", "-o", net])
+    trips = os.path.join(options.dir, "trips%s.xml" % options.queries)
+    if not os.path.exists(trips):
+        subprocess.check_call([sys.executable, os.path.join(SUMO_HOME, "tools", "randomTrips.py"),
+                               "-n", net, "-o", trips, "-e", str(options.queries), "--seed", "42"])
+    empty = os.path.join(options.dir, "empty.xml")
+    with open(empty, "w") as f:
+        print("<routes/>", file=f)
+    weights = None
+    if options.weight_intervals > 0:
+        weights = os.path.join(options.dir, "weights%s.xml" % options.weight_intervals)
+        random.seed(42)
+        edges = sumolib.net.readNet(net).getEdges()
+        with open(weights, "w") as f:
+            print("<meandata>", file=f)
+            for interval in range(options.weight_intervals):
+                print('    <interval begin="%s" end="%s">' % (interval * options.weight_period,
+                                                             (interval + 1) * options.weight_period), file=f)
+                for edge in edges:
+                    print('        <edge id="%s" traveltime="%.2f"/>' % (
+                        edge.getID(), edge.getLength() / edge.getSpeed() * random.uniform(1, 5)), file=f)
+                print('    </interval>', file=f)
+            print("</meandata>", file=f)
+    return net, trips, empty, weights
+
+
+def run(options, net, trips, algorithm, weights):
+    """runs duarouter and returns the wall clock duration, the milliseconds
+    spent contracting and customizing the hierarchy and a dict with the
+    number of shortcuts, arcs and triangles of the hierarchy"""
+    args = [options.duarouter, "-n", net, "-r", trips, "--routing-algorithm", algorithm,
+            "-o", os.path.join(options.dir, "routes_%s.xml" % algorithm),
+            "--ignore-errors", "--no-step-log", "--no-warnings", "-v"]
+    if weights is not None:
+        args += ["--weight-files", weights, "--weight-period", str(options.weight_period)]
+    begin = time.time()
+    output = subprocess.check_output(args, universal_newlines=True)
+    duration = time.time() - begin
+    millis = {"Building": 0, "Customizing": 0}
+    counts = {"shortcuts": 0, "arcs": 0, "triangles": 0}
+    phase = None
+    for line in output.splitlines():
+        words = line.split()
+        if "Created" in words:
+            created = words[words.index("Created"):]
+            if created[2] == "shortcuts.":
+                counts["shortcuts"] = int(created[1])
+            elif created[2] == "arcs":
+                counts["arcs"] = int(created[1])
+                counts["triangles"] = int(created[4])
+        if "Contraction Hierarchy for" in line:
+            phase = line.split()[0]
+        if phase is not None and "done (" in line:
+            if phase in millis:
+                millis[phase] += int(line.split("done (")[1].split("ms")[0])
+            phase = None
+    return duration, millis["Building"], millis["Customizing"], counts
+
+
+def main(options):
+    net, trips, empty, weights = generate(options)
+    print("algorithm\tload[s]\tcontraction[s]\tcustomization[s]\trouting[s]\tqueries/s\t" +
+          "shortcuts\tarcs\ttriangles")
+    for algorithm in options.algorithms:
+        load = run(options, net, empty, algorithm, weights)[0]
+        duration, contraction, customization, counts = run(options, net, trips, algorithm, weights)
+        contraction /= 1000.
+        customization /= 1000.
+        routing = max(duration - load - contraction - customization, 1e-6)
+        print("%s\t%.2f\t%.2f\t%.2f\t%.2f\t%.0f\t%s\t%s\t%s" % (
+            algorithm, load, contraction, customization, routing, options.queries / routing,
+            counts["shortcuts"], counts["arcs"], counts["triangles"]))
+
+
+if __name__ == "__main__":
+    main(get_options())
@@ -0,0 +1,106 @@
+#!/usr/bin/env python
+"""
+@file    benchmarkSubscriptions.py
+@date    2017-10-16
+@version $Id$
+
+Compares the time the TraCI server needs to answer vehicle subscriptions
+when evaluating them natively and when dispatching a get command for
+every subscribed variable (sumo option --remote-legacy-subscriptions).
+A grid network with random trips is generated and simulated until the given
+number of vehicles is running. Then every vehicle gets subscribed (or a single
+context subscription covering the whole network is added) and the duration
+of the following simulation steps is measured.
+
+SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+
+This file is part of SUMO.
+SUMO is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+"""
+from __future__ import print_function
+from __future__ import absolute_import
+import os
+import sys
+import subprocess
+import time
+import optparse
+
+SUMO_HOME = os.environ.get('SUMO_HOME',
+                           os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+sys.path.append(os.path.join(SUMO_HOME, 'tools'))
+import sumolib  # noqa
+import traci  # noqa
+import traci.constants as tc  # noqa
+
+VARIABLES = (tc.VAR_POSITION, tc.VAR_ANGLE, tc.VAR_SPEED, tc.VAR_LANE_ID, tc.VAR_ROUTE_ID)
+
+
+def get_options(args=None):
+    optParser = optparse.OptionParser()
+    optParser.add_option("-n", "--vehicles", default="1000,10000",
+                         help="comma separated numbers of subscribed vehicles")
+    optParser.add_option("-s", "--steps", type="int", default=100,
+                         help="number of measured simulation steps")
+    optParser.add_option("-c", "--context", action="store_true", default=False,
+                         help="use a single context subscription instead of one subscription per vehicle")
+    optParser.add_option("-d", "--dir", default="benchmark_subscriptions",
+                         help="directory for the generated network and trips")
+    optParser.add_option("--sumo", default=sumolib.checkBinary("sumo"), help="the sumo binary to use")
+    options, args = optParser.parse_args(args=args)
+    options.vehicles = [int(n) for n in options.vehicles.split(",")]
+    return options
+
+
+def generate(options, numVehicles):
+    if not os.path.exists(options.dir):
+        os.makedirs(options.dir)
+    net = os.path.join(options.dir, "grid.net.xml")
+    if not os.path.exists(net):
+        subprocess.check_call([sumolib.checkBinary("netgenerate"), "--grid", "--grid.number", "20",
+                               "--grid.length", "200", "--default.lanenumber", "3", "-o", net])
+    trips = os.path.join(options.dir, "trips%s.trips.xml" % numVehicles)
+    if not os.path.exists(trips):
+        subprocess.check_call([sys.executable, os.path.join(SUMO_HOME, "tools", "randomTrips.py"),
+                               "-n", net, "-o", trips, "-s", "42", "--min-distance", "2000",
+                               "-e", str(numVehicles / 20.), "-p", "0.05"])
+    return net, trips
+
+
+def run(options, net, trips, numVehicles, legacy):
+    cmd = [options.sumo, "-n", net, "-r", trips, "--no-step-log", "--no-warnings",
+           "--ignore-route-errors", "--seed", "42"]
+    if legacy:
+        cmd.append("--remote-legacy-subscriptions")
+    traci.start(cmd)
+    while traci.vehicle.getIDCount() < numVehicles and traci.simulation.getMinExpectedNumber() > 0:
+        traci.simulationStep()
+    if options.context:
+        junction = traci.junction.getIDList()[0]
+        traci.junction.subscribeContext(junction, tc.CMD_GET_VEHICLE_VARIABLE, 1e6, VARIABLES)
+    else:
+        for vehID in traci.vehicle.getIDList()[:numVehicles]:
+            traci.vehicle.subscribe(vehID, VARIABLES)
+    subscribed = min(numVehicles, traci.vehicle.getIDCount())
+    begin = time.time()
+    for step in range(options.steps):
+        traci.simulationStep()
+    duration = time.time() - begin
+    traci.close()
+    return subscribed, duration
+
+
+def main(options):
+    print("vehicles\tsubscribed\tlegacy[s]\tnative[s]\tspeedup")
+    for numVehicles in options.vehicles:
+        net, trips = generate(options, numVehicles)
+        subscribed, legacy = run(options, net, trips, numVehicles, True)
+        subscribed, native = run(options, net, trips, numVehicles, False)
+        print("%s\t%s\t%.3f\t%.3f\t%.2f" % (numVehicles, subscribed, legacy, native, legacy / max(native, 1e-9)))
+
+
+if __name__ == "__main__":
+    main(get_options())
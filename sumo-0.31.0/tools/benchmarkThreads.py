@@ -0,0 +1,93 @@
+#!/usr/bin/env python
+"""
+@file    benchmarkThreads.py
+@date    2017-10-17
+@version $Id$
+
+Measures the scaling of the simulation with the number of threads planning
+the vehicle movements (option --threads) on a large grid network with random
+traffic. For every number of threads the wall clock duration of the run and
+the speedup against the single threaded run are reported. The tripinfo output
+of all runs is compared to the single threaded one as the results have to be
+identical.
+
+SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+
+This file is part of SUMO.
+SUMO is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+"""
+from __future__ import print_function
+from __future__ import absolute_import
+import os
+import sys
+import subprocess
+import filecmp
+import time
+import optparse
+
+SUMO_HOME = os.environ.get('SUMO_HOME',
+                           os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+sys.path.append(os.path.join(SUMO_HOME, 'tools'))
+import sumolib  # noqa
+
+
+def get_options(args=None):
+    optParser = optparse.OptionParser()
+    optParser.add_option("-g", "--grid-size", type="int", default=100,
+                         help="number of junctions per grid side")
+    optParser.add_option("-p", "--period", type="float", default=0.05,
+                         help="insertion period of the random trips")
+    optParser.add_option("-e", "--end", type="int", default=3600,
+                         help="end of the insertion of vehicles")
+    optParser.add_option("-t", "--threads", default="1,2,4,8,16",
+                         help="comma separated numbers of threads to measure")
+    optParser.add_option("-d", "--dir", default="benchmark_threads",
+                         help="directory for the generated inputs and outputs")
+    optParser.add_option("--sumo", default=sumolib.checkBinary("sumo"), help="the sumo binary to use")
+    options, args = optParser.parse_args(args=args)
+    options.threads = [int(threads) for threads in options.threads.split(",")]
+    return options
+
+
+def generate(options):
+    if not os.path.exists(options.dir):
+        os.makedirs(options.dir)
+    net = os.path.join(options.dir, "grid%s.net.xml" % options.grid_size)
+    routes = os.path.join(options.dir, "grid%s.rou.xml" % options.grid_size)
+    if not os.path.exists(net):
+        subprocess.check_call([sumolib.checkBinary("netgenerate"), "--grid", "--grid.number", str(options.grid_size),
+                               "--grid.length", "100", "--default.lanenumber", "2", "-o", net])
+    if not os.path.exists(routes):
+        subprocess.check_call([sys.executable, os.path.join(SUMO_HOME, "tools", "randomTrips.py"),
+                               "-n", net, "-r", routes, "-o", os.path.join(options.dir, "trips.xml"),
+                               "-p", str(options.period), "-e", str(options.end), "--seed", "42",
+                               "--fringe-factor", "10"])
+    return net, routes
+
+
+def run(options, net, routes, threads):
+    tripinfo = os.path.join(options.dir, "tripinfo%s.xml" % threads)
+    begin = time.time()
+    subprocess.check_call([options.sumo, "-n", net, "-r", routes, "--threads", str(threads),
+                           "--tripinfo-output", tripinfo, "--no-step-log", "--no-warnings"])
+    return time.time() - begin, tripinfo
+
+
+def main(options):
+    net, routes = generate(options)
+    print("threads\tduration[s]\tspeedup\tidentical")
+    reference = None
+    for threads in options.threads:
+        duration, tripinfo = run(options, net, routes, threads)
+        if reference is None:
+            reference = duration, tripinfo
+        print("%s\t%.2f\t%.2f\t%s" % (threads, duration, reference[0] / duration,
+                                      filecmp.cmp(reference[1], tripinfo, shallow=False)))
+
+
+if __name__ == "__main__":
+    main(get_options())
@@ -0,0 +1,93 @@
+#!/usr/bin/env python
+"""
+@file    benchmarkTraCITransport.py
+@date    2017-10-16
+@version $Id$
+
+Compares the round trip latency of TraCI over a TCP socket and over
+shared memory (sumo option --remote-shm). A grid network with random
+trips is generated, one vehicle gets subscribed and the duration of
+simulationStep calls (including the subscription results) as well as of
+single get commands is measured for both transports.
+
+SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+
+This file is part of SUMO.
+SUMO is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+"""
+from __future__ import print_function
+from __future__ import absolute_import
+import os
+import sys
+import subprocess
+import time
+import optparse
+
+SUMO_HOME = os.environ.get('SUMO_HOME',
+                           os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+sys.path.append(os.path.join(SUMO_HOME, 'tools'))
+import sumolib  # noqa
+import traci  # noqa
+import traci.constants as tc  # noqa
+
+
+def get_options(args=None):
+    optParser = optparse.OptionParser()
+    optParser.add_option("-s", "--steps", type="int", default=1000,
+                         help="number of measured simulation steps")
+    optParser.add_option("-g", "--gets", type="int", default=10000,
+                         help="number of measured get commands")
+    optParser.add_option("-d", "--dir", default="benchmark_transport",
+                         help="directory for the generated network and trips")
+    optParser.add_option("--sumo", default=sumolib.checkBinary("sumo"), help="the sumo binary to use")
+    options, args = optParser.parse_args(args=args)
+    return options
+
+
+def generate(options):
+    if not os.path.exists(options.dir):
+        os.makedirs(options.dir)
+    net = os.path.join(options.dir, "grid.net.xml")
+    if not os.path.exists(net):
+        subprocess.check_call([sumolib.checkBinary("netgenerate"), "--grid", "--grid.number", "5",
+                               "--grid.length", "200", "-o", net])
+    trips = os.path.join(options.dir, "grid.trips.xml")
+    if not os.path.exists(trips):
+        subprocess.check_call([sys.executable, os.path.join(SUMO_HOME, "tools", "randomTrips.py"),
+                               "-n", net, "-o", trips, "-s", "42", "-e", "3600", "-p", "2"])
+    return net, trips
+
+
+def run(options, net, trips, shm):
+    traci.start([options.sumo, "-n", net, "-r", trips, "--no-step-log", "--no-warnings",
+                 "--ignore-route-errors", "--seed", "42"], shm=shm)
+    while traci.vehicle.getIDCount() == 0:
+        traci.simulationStep()
+    vehID = traci.vehicle.getIDList()[0]
+    traci.vehicle.subscribe(vehID, (tc.VAR_POSITION, tc.VAR_SPEED, tc.VAR_ANGLE))
+    begin = time.time()
+    for step in range(options.steps):
+        traci.simulationStep()
+    stepLatency = (time.time() - begin) / options.steps
+    begin = time.time()
+    for i in range(options.gets):
+        traci.simulation.getCurrentTime()
+    getLatency = (time.time() - begin) / options.gets
+    traci.close()
+    return stepLatency, getLatency
+
+
+def main(options):
+    net, trips = generate(options)
+    print("transport\tstep[us]\tget[us]")
+    for name, shm in (("tcp", False), ("shm", True)):
+        stepLatency, getLatency = run(options, net, trips, shm)
+        print("%s\t%.1f\t%.1f" % (name, stepLatency * 1e6, getLatency * 1e6))
+
+
+if __name__ == "__main__":
+    main(get_options())
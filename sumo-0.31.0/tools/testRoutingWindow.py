@@ -0,0 +1,115 @@
+#!/usr/bin/env python
+"""
+@file    testRoutingWindow.py
+@date    2017-10-17
+@version $Id$
+
+Checks that the streaming mode of duarouter (option --routing-window) writes
+the same routes in the same order as the non-streaming run. Random trips on a
+grid network are routed once without streaming and once for every given
+combination of window size and number of routing threads. The route and the
+alternatives output of every streaming run are compared to the reference
+ignoring the generated header comment. The script exits with a non-zero
+status if any of the outputs differs.
+
+SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+
+This file is part of SUMO.
+SUMO is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+"""
+from __future__ import print_function
+from __future__ import absolute_import
+import os
+import sys
+import subprocess
+import optparse
+
+SUMO_HOME = os.environ.get('SUMO_HOME',
+                           os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+sys.path.append(os.path.join(SUMO_HOME, 'tools'))
+import sumolib  # noqa
+
+
+def get_options(args=None):
+    optParser = optparse.OptionParser()
+    optParser.add_option("-g", "--grid-size", type="int", default=20,
+                         help="number of junctions per grid side")
+    optParser.add_option("-p", "--period", type="float", default=0.5,
+                         help="insertion period of the random trips")
+    optParser.add_option("-e", "--end", type="int", default=3600,
+                         help="end of the insertion of vehicles")
+    optParser.add_option("-s", "--route-steps", type="int", default=60,
+                         help="loading step of duarouter in seconds")
+    optParser.add_option("-w", "--windows", default="1,10,1000",
+                         help="comma separated routing window sizes to check")
+    optParser.add_option("-t", "--threads", default="1,4",
+                         help="comma separated numbers of routing threads to check")
+    optParser.add_option("-d", "--dir", default="test_routing_window",
+                         help="directory for the generated inputs and outputs")
+    optParser.add_option("--duarouter", default=sumolib.checkBinary("duarouter"),
+                         help="the duarouter binary to use")
+    options, args = optParser.parse_args(args=args)
+    options.windows = [int(window) for window in options.windows.split(",")]
+    options.threads = [int(threads) for threads in options.threads.split(",")]
+    return options
+
+
+def generate(options):
+    if not os.path.exists(options.dir):
+        os.makedirs(options.dir)
+    net = os.path.join(options.dir, "grid%s.net.xml" % options.grid_size)
+    trips = os.path.join(options.dir, "trips.xml")
+    if not os.path.exists(net):
+        subprocess.check_call([sumolib.checkBinary("netgenerate"), "--grid", "--grid.number", str(options.grid_size),
+                               "--grid.length", "100", "-o", net])
+    if not os.path.exists(trips):
+        subprocess.check_call([sys.executable, os.path.join(SUMO_HOME, "tools", "randomTrips.py"),
+                               "-n", net, "-o", trips, "-p", str(options.period), "-e", str(options.end),
+                               "--seed", "42", "--fringe-factor", "10"])
+    return net, trips
+
+
+def run(options, net, trips, name, extra):
+    routes = os.path.join(options.dir, "%s.rou.xml" % name)
+    subprocess.check_call([options.duarouter, "-n", net, "-t", trips, "-o", routes,
+                           "--route-steps", str(options.route_steps),
+                           "--no-step-log", "--no-warnings"] + extra)
+    return routes, routes[:-4] + ".alt.xml"
+
+
+def content(fileName):
+    """returns the lines of the given output without the generated header comment"""
+    lines = []
+    inHeader = False
+    with open(fileName) as f:
+        for line in f:
+            if line.startswith("<!-- generated on"):
+                inHeader = True
+            if not inHeader:
+                lines.append(line)
+            elif line.rstrip().endswith("-->"):
+                inHeader = False
+    return lines
+
+
+def main(options):
+    net, trips = generate(options)
+    reference = [content(f) for f in run(options, net, trips, "reference", [])]
+    print("window\tthreads\tidentical")
+    failed = False
+    for window in options.windows:
+        for threads in options.threads:
+            outputs = run(options, net, trips, "window%s_threads%s" % (window, threads),
+                          ["--routing-window", str(window), "--routing-threads", str(threads)])
+            identical = [content(f) for f in outputs] == reference
+            failed |= not identical
+            print("%s\t%s\t%s" % (window, threads, identical))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(get_options()))
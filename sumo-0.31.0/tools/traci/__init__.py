@@ -22,6 +22,7 @@ the Free Software Foundation; either version 3 of the License, or
 """
 from __future__ import print_function
 from __future__ import absolute_import
+import os
 import socket
 import time
 import subprocess
@@ -45,19 +46,24 @@ def _STEPS2TIME(step):
     return step / 1000.
 
 
-def connect(port=8813, numRetries=10, host="localhost", proc=None):
+def connect(port=8813, numRetries=10, host="localhost", proc=None, shm=None):
     """
     Establish a connection to a TraCI-Server and return the
     connection object. The connection is not saved in the pool and not
     accessible via traci.switch. It should be safe to use different
     connections established by this method in different threads.
+    If shm is given, the server on the local host is reached through
+    the shared memory segment of that name instead of the port.
     """
     for wait in range(1, numRetries + 2):
         try:
-            return Connection(host, port, proc)
-        except socket.error as e:
-            print("Could not connect to TraCI server at %s:%s" %
-                  (host, port), e)
+            return Connection(host, port, proc, shm)
+        except (socket.error, IOError) as e:
+            if shm is None:
+                print("Could not connect to TraCI server at %s:%s" %
+                      (host, port), e)
+            else:
+                print("Could not connect to TraCI server through shared memory %s" % shm, e)
             if wait < numRetries + 1:
                 print(" Retrying in %s seconds" % wait)
                 time.sleep(wait)
@@ -75,15 +81,24 @@ def init(port=8813, numRetries=10, host="localhost", label="default"):
     return getVersion()
 
 
-def start(cmd, port=None, numRetries=10, label="default"):
+def start(cmd, port=None, numRetries=10, label="default", shm=False):
     """
     Start a sumo server using cmd, establish a connection to it and
     store it under the given label. This method is not thread-safe.
+    If shm is True (or a segment name), the connection uses shared memory
+    instead of a TCP socket.
     """
-    if port is None:
-        port = sumolib.miscutils.getFreeSocketPort()
-    sumoProcess = subprocess.Popen(cmd + ["--remote-port", str(port)])
-    _connections[label] = connect(port, numRetries, "localhost", sumoProcess)
+    if shm:
+        if shm is True:
+            shm = "traci_%s_%s" % (os.getpid(), label)
+        remote = ["--remote-shm", shm]
+    else:
+        shm = None
+        if port is None:
+            port = sumolib.miscutils.getFreeSocketPort()
+        remote = ["--remote-port", str(port)]
+    sumoProcess = subprocess.Popen(cmd + remote)
+    _connections[label] = connect(port, numRetries, "localhost", sumoProcess, shm)
     switch(label)
     return getVersion()
 
@@ -115,6 +130,17 @@ def simulationStep(step=0):
     return responses
 
 
+def multiStep(steps, controls=(), watched=(), perStep=False):
+    """multiStep(int, list((string, int, value)), list(string), bool) -> (int, int, list(string), list(dict))
+
+    Performs up to the given number of simulation steps in a single request,
+    applying the vehicle controls (vehID, varID, value) before each step and
+    stopping early when one of the watched vehicles collides or arrives.
+    See Connection.multiStep for the returned values.
+    """
+    return _connections[""].multiStep(steps, controls, watched, perStep)
+
+
 class StepListener(object):
     __metaclass__ = abc.ABCMeta
 
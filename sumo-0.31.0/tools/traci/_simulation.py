@@ -327,6 +327,47 @@ class SimulationDomain(Domain):
         self._connection._packString(fileName)
         self._connection._sendExact()
 
+    def saveSnapshot(self, snapshotID):
+        """saveSnapshot(string) -> None
+
+        Keeps a copy of the current simulation state in the memory of the server.
+        """
+        self._connection._beginMessage(tc.CMD_SET_SIM_VARIABLE, tc.CMD_SAVE_SNAPSHOT, "",
+                                       1 + 4 + len(snapshotID))
+        self._connection._packString(snapshotID)
+        self._connection._sendExact()
+
+    def loadSnapshot(self, snapshotID):
+        """loadSnapshot(string) -> None
+
+        Replaces the simulation state by a snapshot taken earlier with saveSnapshot.
+        """
+        self._connection._beginMessage(tc.CMD_SET_SIM_VARIABLE, tc.CMD_LOAD_SNAPSHOT, "",
+                                       1 + 4 + len(snapshotID))
+        self._connection._packString(snapshotID)
+        self._connection._sendExact()
+
+    def setSubscriptionDelta(self, keyframePeriod, epsilon=0., epsilons=None):
+        """setSubscriptionDelta(integer, double, dict(integer: double)) -> None
+
+        Lets the server transmit only the changes of context subscription results
+        to this connection: objects which entered the range, values which changed by
+        more than epsilon (or the variable specific value in epsilons) and objects
+        which left the range. Other clients still receive the full results.
+        Every keyframePeriod results the full results are sent, 0 switches back to full results.
+        The results returned by getContextSubscriptionResults stay complete.
+        """
+        if epsilons is None:
+            epsilons = {}
+        self._connection._beginMessage(tc.CMD_SET_SIM_VARIABLE, tc.CMD_SUBSCRIPTION_DELTA, "",
+                                       1 + 4 + 1 + 4 + 1 + 8 + len(epsilons) * (1 + 1 + 1 + 8))
+        self._connection._string += struct.pack("!BiBiBd", tc.TYPE_COMPOUND, 2 + 2 * len(epsilons),
+                                                tc.TYPE_INTEGER, keyframePeriod, tc.TYPE_DOUBLE, epsilon)
+        for varID, eps in sorted(epsilons.items()):
+            self._connection._string += struct.pack("!BBBd", tc.TYPE_UBYTE, varID, tc.TYPE_DOUBLE, eps)
+        self._connection._sendExact()
+        self._connection._contextDelta = keyframePeriod > 0
+
     def subscribe(self, varIDs=(tc.VAR_DEPARTED_VEHICLES_IDS,), begin=0, end=2**31 - 1):
         """subscribe(list(integer), double, double) -> None
 
@@ -69,6 +69,51 @@ def _readNextTLS(result):
     return nextTLS
 
 
+def _readOccupancyGrid(result):
+    result.read("!iB")  # numCompounds, TYPE_INT
+    width, height, numChannels = result.read("!iBiBi")[::2]
+    result.read("!B")
+    length = result.read("!i")[0]
+    values = result.read("!%sf" % (length // 4))
+    return width, height, numChannels, values
+
+
+def _readNearestVehicles(result):
+    result.read("!iB")  # numCompounds, TYPE_INT
+    numVehicles = result.read("!i")[0]
+    nearest = []
+    for i in range(numVehicles):
+        result.read("!B")
+        vehID = result.readString()
+        dist, relSpeed, bearing, ttc, drac = result.read("!BdBdBdBdBd")[1::2]
+        nearest.append((vehID, dist, relSpeed, bearing, ttc, drac))
+    return nearest
+
+
+def _readPackedColumn(result, fmt):
+    result.read("!B")
+    length = result.read("!i")[0]
+    return result.read("!%s%s" % (length // struct.calcsize(fmt), fmt))
+
+
+def _readColumns(result, varIDs):
+    result.read("!iB")  # numCompounds, TYPE_STRINGLIST
+    vehIDs = result.readStringList()
+    columns = {}
+    for varID in varIDs:
+        if varID in (tc.VAR_POSITION, tc.VAR_POSITION3D):
+            dims = 2 if varID == tc.VAR_POSITION else 3
+            columns[varID] = tuple([_readPackedColumn(result, "d") for d in range(dims)])
+        elif varID in (tc.VAR_LANE_INDEX, tc.VAR_ROUTE_INDEX, tc.VAR_SIGNALS):
+            columns[varID] = _readPackedColumn(result, "i")
+        elif varID in (tc.VAR_ROAD_ID, tc.VAR_LANE_ID, tc.VAR_TYPE, tc.VAR_ROUTE_ID):
+            result.read("!B")
+            columns[varID] = tuple(result.readStringList())
+        else:
+            columns[varID] = _readPackedColumn(result, "d")
+    return vehIDs, columns
+
+
 _RETURN_VALUE_FUNC = {tc.VAR_SPEED: Storage.readDouble,
                       tc.VAR_SPEED_WITHOUT_TRACI: Storage.readDouble,
                       tc.VAR_POSITION: lambda result: result.read("!dd"),
@@ -122,6 +167,7 @@ _RETURN_VALUE_FUNC = {tc.VAR_SPEED: Storage.readDouble,
                       tc.VAR_BEST_LANES: _readBestLanes,
                       tc.VAR_LEADER: _readLeader,
                       tc.VAR_NEXT_TLS: _readNextTLS,
+                      tc.VAR_NEAREST_VEHICLES: _readNearestVehicles,
                       tc.VAR_LANEPOSITION_LAT: Storage.readDouble,
                       tc.VAR_MAXSPEED_LAT: Storage.readDouble,
                       tc.VAR_MINGAP_LAT: Storage.readDouble,
@@ -576,6 +622,61 @@ class VehicleDomain(Domain):
         """
         return self._getUniversal(tc.VAR_NEXT_TLS, vehID)
 
+    def getColumns(self, varIDs=(tc.VAR_POSITION, tc.VAR_ANGLE, tc.VAR_SPEED)):
+        """getColumns(list(integer)) -> (list(string), dict)
+
+        Return the ids of all vehicles in the network together with a dictionary
+        mapping each of the given variables to a tuple holding its values for all
+        vehicles in the same order. For VAR_POSITION and VAR_POSITION3D the
+        value is a tuple of the x, y (and z) columns.
+        Supported are VAR_SPEED, VAR_ANGLE, VAR_SLOPE, VAR_LANEPOSITION,
+        VAR_LANEPOSITION_LAT, VAR_WAITING_TIME, VAR_ACCUMULATED_WAITING_TIME,
+        VAR_SPEED_FACTOR, VAR_LANE_INDEX, VAR_ROUTE_INDEX, VAR_SIGNALS,
+        VAR_ROAD_ID, VAR_LANE_ID, VAR_TYPE, VAR_ROUTE_ID and the positions.
+        """
+        self._connection._beginMessage(tc.CMD_GET_VEHICLE_VARIABLE, tc.VAR_COLUMNS,
+                                       "", 1 + 4 + 2 * len(varIDs))
+        self._connection._string += struct.pack("!Bi", tc.TYPE_COMPOUND, len(varIDs))
+        for varID in varIDs:
+            self._connection._string += struct.pack("!BB", tc.TYPE_UBYTE, varID)
+        return _readColumns(self._connection._checkResult(tc.CMD_GET_VEHICLE_VARIABLE, tc.VAR_COLUMNS, ""), varIDs)
+
+    def getOccupancyGrid(self, vehID, width=84, height=84, resolution=1., egoAligned=True):
+        """getOccupancyGrid(string, integer, integer, double, bool) -> (integer, integer, integer, tuple(double))
+
+        Return an occupancy grid of the vehicles around the given vehicle as
+        (width, height, numChannels, values). The channels (occupancy, speed,
+        heading relative to the upward direction of the grid) are stored one after
+        another, each row by row starting with the upmost row. The vehicle itself
+        is located in the center of the grid, which points into its direction if
+        egoAligned is set and north otherwise. The resolution is given in m per cell.
+        """
+        self._connection._beginMessage(tc.CMD_GET_VEHICLE_VARIABLE, tc.VAR_OCCUPANCY_GRID,
+                                       vehID, 1 + 4 + 1 + 4 + 1 + 4 + 1 + 8 + 1 + 1)
+        self._connection._string += struct.pack("!BiBiBiBdBB", tc.TYPE_COMPOUND, 4, tc.TYPE_INTEGER, width,
+                                                tc.TYPE_INTEGER, height, tc.TYPE_DOUBLE, resolution,
+                                                tc.TYPE_UBYTE, 1 if egoAligned else 0)
+        return _readOccupancyGrid(self._connection._checkResult(tc.CMD_GET_VEHICLE_VARIABLE,
+                                                                tc.VAR_OCCUPANCY_GRID, vehID))
+
+    def getNearestVehicles(self, vehID, k=8, maxDist=-1.):
+        """getNearestVehicles(string, integer, double) -> list((string, double, double, double, double, double))
+
+        Return up to k vehicles closest to the given vehicle as
+        [(vehID, distance, relativeSpeed, bearing, ttc, drac), ...] sorted by
+        distance. The relative speed is the change rate of the distance (negative
+        if approaching), the bearing is given in degrees clockwise from the heading
+        of the vehicle. Time to collision and deceleration rate to avoid a crash
+        are INVALID_DOUBLE_VALUE if the vehicles do not approach each other.
+        A non-positive maxDist does not limit the search radius.
+        """
+        self._connection._beginMessage(tc.CMD_GET_VEHICLE_VARIABLE, tc.VAR_NEAREST_VEHICLES,
+                                       vehID, 1 + 4 + 1 + 4 + 1 + 8)
+        self._connection._string += struct.pack("!BiBiBd", tc.TYPE_COMPOUND, 2, tc.TYPE_INTEGER, k,
+                                                tc.TYPE_DOUBLE, maxDist)
+        return _readNearestVehicles(self._connection._checkResult(tc.CMD_GET_VEHICLE_VARIABLE,
+                                                                  tc.VAR_NEAREST_VEHICLES, vehID))
+
     def subscribeLeader(self, vehID, dist=0., begin=0, end=2**31 - 1):
         """subscribeLeader(string, double) -> None
 
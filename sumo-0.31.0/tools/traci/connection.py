@@ -25,6 +25,7 @@ from __future__ import absolute_import
 import socket
 import struct
 import sys
+import copy
 
 try:
     import traciemb
@@ -35,6 +36,7 @@ from . import constants as tc
 from .exceptions import TraCIException, FatalTraCIError
 from .domain import _defaultDomains
 from .storage import Storage
+from .shmsocket import ShmSocket
 
 _RESULTS = {0x00: "OK", 0x01: "Not implemented", 0xFF: "Error"}
 
@@ -45,20 +47,24 @@ class Connection:
     together with a list of TraCI commands which are inside.
     """
 
-    def __init__(self, host, port, process):
+    def __init__(self, host, port, process, shm=None):
         if not _embedded:
-            if sys.platform.startswith('java'):
-                # working around jython 2.7.0 bug #2273
-                self._socket = socket.socket(
-                    socket.AF_INET, socket.SOCK_STREAM, socket.IPPROTO_TCP)
+            if shm is not None:
+                self._socket = ShmSocket(shm)
             else:
-                self._socket = socket.socket()
-            self._socket.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
-            self._socket.connect((host, port))
+                if sys.platform.startswith('java'):
+                    # working around jython 2.7.0 bug #2273
+                    self._socket = socket.socket(
+                        socket.AF_INET, socket.SOCK_STREAM, socket.IPPROTO_TCP)
+                else:
+                    self._socket = socket.socket()
+                self._socket.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+                self._socket.connect((host, port))
             self._process = process
         self._string = bytes()
         self._queue = []
         self._subscriptionMapping = {}
+        self._contextDelta = False
         for domain in _defaultDomains:
             domain._register(self, self._subscriptionMapping)
 
@@ -86,7 +92,7 @@ class Connection:
                     return None
                 result += t
             return Storage(result)
-        except socket.error:
+        except (socket.error, IOError):
             return None
 
     def _sendExact(self):
@@ -190,13 +196,17 @@ class Connection:
                         "Cannot handle subscription response %02x for %s." % (response, objectID))
                 numVars -= 1
         else:
+            if self._contextDelta and result.read("!B")[0]:
+                # keyframe, all objects in range follow
+                self._subscriptionMapping[response].resetContext(objectID)
             objectNo = result.read("!i")[0]
             for o in range(objectNo):
                 oid = result.readString()
-                if numVars == 0:
+                numChanged = result.read("!B")[0] if self._contextDelta else numVars
+                if numChanged == 0:
                     self._subscriptionMapping[response].addContext(
                         objectID, self._subscriptionMapping[domain], oid)
-                for v in range(numVars):
+                for v in range(numChanged):
                     varID = result.read("!B")[0]
                     status, varType = result.read("!BB")
                     if status:
@@ -207,6 +217,9 @@ class Connection:
                     else:
                         raise FatalTraCIError(
                             "Cannot handle subscription response %02x for %s." % (response, objectID))
+            if self._contextDelta:
+                for oid in result.readStringList():
+                    self._subscriptionMapping[response].removeContext(objectID, oid)
         return objectID, response
 
     def _subscribe(self, cmdID, begin, end, objID, varIDs, parameters=None):
@@ -279,14 +292,97 @@ class Connection:
                                     1 + 4, tc.CMD_SIMSTEP, step)
         result = self._sendExact()
         for subscriptionResults in self._subscriptionMapping.values():
-            subscriptionResults.reset()
+            subscriptionResults.reset(self._contextDelta)
         numSubs = result.readInt()
         responses = []
         while numSubs > 0:
             responses.append(self._readSubscription(result))
             numSubs -= 1
+        self._pruneContextResults(responses)
         return responses
 
+    def _pruneContextResults(self, responses):
+        """Drops the kept context results of subscriptions which were not reported
+        (because they were removed or expired). In delta mode the server reports
+        every active context subscription in each step."""
+        if not self._contextDelta:
+            return
+        received = {}
+        for objectID, response in responses:
+            received.setdefault(response, set()).add(objectID)
+        for response, subscriptionResults in self._subscriptionMapping.items():
+            subscriptionResults.pruneContext(received.get(response, ()))
+
+    def _packTypedValue(self, value):
+        if isinstance(value, tuple):
+            data = struct.pack("!Bi", tc.TYPE_COMPOUND, len(value))
+            for item in value:
+                data += self._packTypedValue(item)
+            return data
+        if isinstance(value, float):
+            return struct.pack("!Bd", tc.TYPE_DOUBLE, value)
+        if isinstance(value, int):
+            return struct.pack("!Bi", tc.TYPE_INTEGER, value)
+        if isinstance(value, list):
+            data = struct.pack("!Bi", tc.TYPE_STRINGLIST, len(value))
+            for s in value:
+                data += struct.pack("!i", len(s)) + s.encode("latin1")
+            return data
+        return struct.pack("!Bi", tc.TYPE_STRING, len(value)) + value.encode("latin1")
+
+    def multiStep(self, steps, controls=(), watched=(), perStep=False):
+        """
+        Performs the given number of simulation steps and applies the vehicle
+        controls before each of them. A control is a triple (vehID, varID, value)
+        as used by the vehicle set commands, e.g. (vehID, tc.VAR_SPEED, 10.)
+        for setSpeed. Floats are sent as doubles, ints as integers, lists as
+        string lists and tuples as compound objects.
+        The stepping stops early when one of the watched vehicles collides or arrives.
+        Returns the number of performed steps, the termination flags
+        (tc.MULTISTEP_COLLISION, tc.MULTISTEP_ARRIVED), the watched vehicles
+        which caused the termination and, if perStep is set, a list with the
+        subscription results of each step (a dict from subscription response id
+        to the results of that domain). The results of the last step are
+        always available from getSubscriptionResults.
+        """
+        content = struct.pack("!BiBiBB", tc.TYPE_COMPOUND, 4, tc.TYPE_INTEGER, steps,
+                              tc.TYPE_UBYTE, 1 if perStep else 0)
+        content += struct.pack("!Bi", tc.TYPE_STRINGLIST, len(watched))
+        for vehID in watched:
+            content += struct.pack("!i", len(vehID)) + vehID.encode("latin1")
+        content += struct.pack("!Bi", tc.TYPE_COMPOUND, 3 * len(controls))
+        for vehID, varID, value in controls:
+            content += struct.pack("!Bi", tc.TYPE_STRING, len(vehID)) + vehID.encode("latin1")
+            content += struct.pack("!BB", tc.TYPE_UBYTE, varID)
+            content += self._packTypedValue(value)
+        self._queue.append(tc.CMD_MULTISTEP)
+        length = 1 + 1 + len(content)
+        if length <= 255:
+            self._string += struct.pack("!BB", length, tc.CMD_MULTISTEP)
+        else:
+            self._string += struct.pack("!BiB", 0, length + 4, tc.CMD_MULTISTEP)
+        self._string += content
+        result = self._sendExact()
+        done = result.readInt()
+        flags = result.read("!B")[0]
+        stopIDs = result.readStringList()
+        stepResults = []
+        for block in range(result.readInt()):
+            for subscriptionResults in self._subscriptionMapping.values():
+                subscriptionResults.reset(self._contextDelta)
+            received = [self._readSubscription(result) for sub in range(result.readInt())]
+            self._pruneContextResults(received)
+            responses = set([response for objectID, response in received])
+            if perStep:
+                stepResult = {}
+                for response in responses:
+                    if response >= tc.RESPONSE_SUBSCRIBE_INDUCTIONLOOP_VARIABLE and response <= tc.RESPONSE_SUBSCRIBE_PERSON_VARIABLE:
+                        stepResult[response] = copy.deepcopy(self._subscriptionMapping[response].get())
+                    else:
+                        stepResult[response] = copy.deepcopy(self._subscriptionMapping[response].getContext())
+                stepResults.append(stepResult)
+        return done, flags, stopIDs, stepResults
+
     def getVersion(self):
         command = tc.CMD_GETVERSION
         self._queue.append(command)
@@ -37,6 +37,9 @@ CMD_SIMSTEP = 0x02
 #  command: set connection priority (execution order)
 CMD_SETORDER = 0x03
 
+#  command: several simulation steps with repeated vehicle controls
+CMD_MULTISTEP = 0x04
+
 #  command: stop node
 CMD_STOP = 0x12
 
@@ -402,6 +405,14 @@ STOP_CONTAINER_STOP = 0x10
 STOP_CHARGING_STATION = 0x20
 STOP_PARKING_AREA = 0x40
 
+#  ****************************************
+#  Multi step termination flags
+#  ****************************************
+#  a watched vehicle was involved in a collision
+MULTISTEP_COLLISION = 0x01
+#  a watched vehicle arrived
+MULTISTEP_ARRIVED = 0x02
+
 #  ****************************************
 #  Departure Flags
 #  ****************************************
@@ -686,6 +697,15 @@ VAR_LINE = 0xbd
 #  get/set vehicle via
 VAR_VIA = 0xbe
 
+#  occupancy grid of the surrounding vehicles (get: vehicle)
+VAR_OCCUPANCY_GRID = 0x21
+
+#  values of the given variables for all vehicles, column by column (get: vehicle)
+VAR_COLUMNS = 0x25
+
+#  nearest vehicles with distance, relative speed, bearing and time to collision (get: vehicle)
+VAR_NEAREST_VEHICLES = 0x2f
+
 #  current CO2 emission of a node (get: vehicle, lane, edge)
 VAR_CO2EMISSION = 0x60
 
@@ -803,6 +823,15 @@ CMD_CLEAR_PENDING_VEHICLES = 0x94
 #  triggers saving simulation state (set: simulation)
 CMD_SAVE_SIMSTATE = 0x95
 
+#  takes an in-memory snapshot of the simulation state (set: simulation)
+CMD_SAVE_SNAPSHOT = 0x96
+
+#  replaces the simulation state by an in-memory snapshot (set: simulation)
+CMD_LOAD_SNAPSHOT = 0x97
+
+#  configures delta encoding of context subscription results (set: simulation)
+CMD_SUBSCRIPTION_DELTA = 0x98
+
 #  sets/retrieves abstract parameter
 VAR_PARAMETER = 0x7e
 
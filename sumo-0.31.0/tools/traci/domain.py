@@ -46,9 +46,10 @@ class SubscriptionResults:
             raise FatalTraCIError("Unknown variable %02x." % varID)
         return self._valueFunc[varID](data)
 
-    def reset(self):
+    def reset(self, keepContext=False):
         self._results.clear()
-        self._contextResults.clear()
+        if not keepContext:
+            self._contextResults.clear()
 
     def add(self, refID, varID, data):
         if refID not in self._results:
@@ -69,6 +70,18 @@ class SubscriptionResults:
             self._contextResults[refID][objID][
                 varID] = domain._parse(varID, data)
 
+    def resetContext(self, refID):
+        self._contextResults.pop(refID, None)
+
+    def removeContext(self, refID, objID):
+        if refID in self._contextResults:
+            self._contextResults[refID].pop(objID, None)
+
+    def pruneContext(self, refIDs):
+        for refID in list(self._contextResults):
+            if refID not in refIDs:
+                del self._contextResults[refID]
+
     def getContext(self, refID=None):
         if refID is None:
             return self._contextResults
@@ -183,6 +196,8 @@ class Domain:
     def unsubscribeContext(self, objectID, domain, dist):
         self._connection._subscribeContext(
             self._contextID, 0, 2**31 - 1, objectID, domain, dist, [])
+        # the results are kept between the steps when using delta encoding
+        self._connection._getSubscriptionResults(self._contextResponseID).resetContext(objectID)
 
     def getContextSubscriptionResults(self, objectID=None):
         return self._connection._getSubscriptionResults(self._contextResponseID).getContext(objectID)
@@ -0,0 +1,125 @@
+# -*- coding: utf-8 -*-
+"""
+@file    shmsocket.py
+@date    2017-10-16
+@version $Id$
+
+Client side of the shared memory transport of the TraCI server
+(sumo option --remote-shm). The class mimics the parts of a socket used
+by the connection, the layout of the segment is described in
+src/foreign/tcpip/shmsocket.h.
+
+SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+
+This file is part of SUMO.
+SUMO is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 3 of the License, or
+(at your option) any later version.
+"""
+from __future__ import absolute_import
+import os
+import mmap
+import struct
+import time
+import multiprocessing
+
+_MAGIC = 0x53554d4f
+_VERSION = 1
+_CLIENT_ATTACHED = 16
+_CLOSED = 20
+_SERVER_PID = 24
+_CLIENT_PID = 28
+_TO_SERVER_WRITTEN = 64
+_TO_SERVER_READ = 128
+_TO_CLIENT_WRITTEN = 192
+_TO_CLIENT_READ = 256
+_DATA = 320
+# number of unsuccessful polls before yielding and sleeping
+_SPIN_TRIES = 2000 if multiprocessing.cpu_count() > 1 else 0
+_YIELD_TRIES = 20000
+_yield = getattr(os, "sched_yield", lambda: time.sleep(0))
+
+
+class ShmSocket:
+
+    """Exchanges the TraCI messages with a local sumo through the
+    shared memory segment with the given name.
+    """
+
+    def __init__(self, name):
+        path = os.path.join("/dev/shm", name.lstrip("/"))
+        with open(path, "r+b") as f:
+            try:
+                self._mem = mmap.mmap(f.fileno(), 0)
+            except ValueError:
+                raise IOError("shared memory segment %s is not initialized" % name)
+        magic, version, self._capacity = struct.unpack_from("=IIQ", self._mem, 0)
+        if magic != _MAGIC or version != _VERSION:
+            self._mem.close()
+            raise IOError("shared memory segment %s is not initialized" % name)
+        self._serverPid = struct.unpack_from("=I", self._mem, _SERVER_PID)[0]
+        struct.pack_into("=I", self._mem, _CLIENT_PID, os.getpid())
+        struct.pack_into("=I", self._mem, _CLIENT_ATTACHED, 1)
+
+    def _counter(self, offset):
+        return struct.unpack_from("=Q", self._mem, offset)[0]
+
+    def _wait(self, tries):
+        if tries < _SPIN_TRIES:
+            return
+        if struct.unpack_from("=I", self._mem, _CLOSED)[0]:
+            raise IOError("connection closed by SUMO")
+        if tries < _YIELD_TRIES:
+            _yield()
+            return
+        try:
+            os.kill(self._serverPid, 0)
+        except OSError:
+            raise IOError("SUMO vanished")
+        time.sleep(0.00005)
+
+    def send(self, data):
+        pos = 0
+        tries = 0
+        while pos < len(data):
+            written = self._counter(_TO_SERVER_WRITTEN)
+            space = self._capacity - (written - self._counter(_TO_SERVER_READ))
+            if space == 0:
+                tries += 1
+                self._wait(tries)
+                continue
+            tries = 0
+            offset = written % self._capacity
+            n = min(space, len(data) - pos, self._capacity - offset)
+            start = _DATA + offset
+            self._mem[start:start + n] = data[pos:pos + n]
+            struct.pack_into("=Q", self._mem, _TO_SERVER_WRITTEN, written + n)
+            pos += n
+        return pos
+
+    def recv(self, bufsize):
+        tries = 0
+        while True:
+            read = self._counter(_TO_CLIENT_READ)
+            available = self._counter(_TO_CLIENT_WRITTEN) - read
+            if available > 0:
+                break
+            tries += 1
+            try:
+                self._wait(tries)
+            except IOError:
+                return bytes()
+        offset = read % self._capacity
+        n = min(available, bufsize, self._capacity - offset)
+        start = _DATA + self._capacity + offset
+        data = self._mem[start:start + n]
+        struct.pack_into("=Q", self._mem, _TO_CLIENT_READ, read + n)
+        return data
+
+    def close(self):
+        if self._mem is not None:
+            struct.pack_into("=I", self._mem, _CLOSED, 1)
+            self._mem.close()
+            self._mem = None
@@ -21,10 +21,68 @@
 /****************************************************************************/
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
 #include <microsim/MSEventControl.h>
 #include "../utils/common/CommandMock.h"
 
 
+/* A command which records its executions and repeats itself a given number of times.*/
+class RecordingCommand : public Command {
+public:
+    RecordingCommand(int id, SUMOTime period, int repetitions, std::vector<std::pair<int, SUMOTime> >& log) :
+        myID(id), myPeriod(period), myRepetitions(repetitions), myLog(log) {}
+
+    SUMOTime execute(SUMOTime currentTime) {
+        myLog.push_back(std::make_pair(myID, currentTime));
+        return myRepetitions-- > 0 ? myPeriod : 0;
+    }
+
+private:
+    int myID;
+    SUMOTime myPeriod;
+    int myRepetitions;
+    std::vector<std::pair<int, SUMOTime> >& myLog;
+};
+
+
+/* The scheduled events of the reference model: time, insertion index, id, period, repetitions.*/
+struct ReferenceEvent {
+    SUMOTime time;
+    int index;
+    int id;
+    SUMOTime period;
+    int repetitions;
+};
+
+
+/* Runs the reference model: all events due before the end of the step in (time, insertion) order.*/
+static void
+executeReference(std::vector<ReferenceEvent>& events, SUMOTime step, std::vector<std::pair<int, SUMOTime> >& log) {
+    while (true) {
+        std::vector<ReferenceEvent>::iterator next = events.end();
+        for (std::vector<ReferenceEvent>::iterator i = events.begin(); i != events.end(); ++i) {
+            if (i->time < 0) {
+                i->time = step;
+            }
+            if (i->time < step + DELTA_T && (next == events.end() || i->time < next->time
+                                             || (i->time == next->time && i->index < next->index))) {
+                next = i;
+            }
+        }
+        if (next == events.end()) {
+            return;
+        }
+        log.push_back(std::make_pair(next->id, step));
+        if (next->repetitions-- > 0) {
+            next->time += next->period;
+        } else {
+            events.erase(next);
+        }
+    }
+}
+
+
 /* Test the method 'execute'. Tests if the execute method from the Command Class is called.*/
 
 TEST(MSEventControl, test_method_execute) {
@@ -38,3 +96,94 @@ TEST(MSEventControl, test_method_execute) {
     eventControl.execute(5);
     EXPECT_TRUE(mock->isExecuteCalled());
 }
+
+
+/* Test that events are executed in the order of their time and of their insertion,
+   including events beyond the range of the timing wheel and recurring events.*/
+TEST(MSEventControl, test_method_execute_order) {
+    const SUMOTime far = (MSEventControl::WHEEL_SIZE + 10) * DELTA_T;
+    const SUMOTime times[] = {5 * DELTA_T, 3 * DELTA_T, 5 * DELTA_T, -1, far, 0, 2 * far + 7, far, 5 * DELTA_T + 1, 3 * far};
+    const SUMOTime periods[] = {DELTA_T, 7 * DELTA_T, far, DELTA_T, 3, 5 * DELTA_T, DELTA_T, 2 * DELTA_T, far / 3, DELTA_T};
+    const int repetitions[] = {20, 3, 2, 5, 4, 0, 1, 3, 6, 0};
+    std::vector<std::pair<int, SUMOTime> > log;
+    std::vector<std::pair<int, SUMOTime> > expected;
+    std::vector<ReferenceEvent> reference;
+    MSEventControl eventControl;
+    for (int i = 0; i < 10; i++) {
+        eventControl.addEvent(new RecordingCommand(i, periods[i], repetitions[i], log), times[i]);
+        ReferenceEvent event = {times[i], i, i, periods[i], repetitions[i]};
+        reference.push_back(event);
+    }
+    for (SUMOTime step = 0; step < 4 * far; step += DELTA_T) {
+        eventControl.execute(step);
+        executeReference(reference, step, expected);
+    }
+    EXPECT_TRUE(reference.empty());
+    EXPECT_TRUE(eventControl.isEmpty());
+    EXPECT_EQ(expected.size(), log.size());
+    EXPECT_TRUE(expected == log);
+}
+
+
+/* Test that events added while executing are executed in the same step if they are due.*/
+TEST(MSEventControl, test_method_add_while_executing) {
+    std::vector<std::pair<int, SUMOTime> > log;
+    MSEventControl eventControl;
+    eventControl.addEvent(new RecordingCommand(0, 0, 0, log), 10 * DELTA_T);
+    eventControl.execute(10 * DELTA_T);
+    eventControl.addEvent(new RecordingCommand(1, 0, 0, log), 10 * DELTA_T);
+    eventControl.addEvent(new RecordingCommand(2, 0, 0, log), 11 * DELTA_T);
+    eventControl.execute(10 * DELTA_T);
+    ASSERT_EQ(2, (int)log.size());
+    EXPECT_EQ(1, log.back().first);
+    eventControl.execute(11 * DELTA_T);
+    ASSERT_EQ(3, (int)log.size());
+    EXPECT_EQ(2, log.back().first);
+    EXPECT_TRUE(eventControl.isEmpty());
+}
+
+
+/* Test that restoring the saved event times repeats the same executions,
+   also for events which were moved into the wheel or added after saving.*/
+TEST(MSEventControl, test_method_set_event_times) {
+    const SUMOTime far = (MSEventControl::WHEEL_SIZE + 10) * DELTA_T;
+    const SUMOTime times[] = {5 * DELTA_T, 3 * DELTA_T, 2 * far, -1, far + 7};
+    const SUMOTime periods[] = {DELTA_T, 7 * DELTA_T, far / 2, 3 * DELTA_T, far};
+    std::vector<std::pair<int, SUMOTime> > log;
+    MSEventControl eventControl;
+    for (int i = 0; i < 5; i++) {
+        eventControl.addEvent(new RecordingCommand(i, periods[i], 1000000, log), times[i]);
+    }
+    const SUMOTime saveTime = 100 * DELTA_T;
+    for (SUMOTime step = 0; step < saveTime; step += DELTA_T) {
+        eventControl.execute(step);
+    }
+    const std::map<long long, SUMOTime> saved = eventControl.getEventTimes();
+    EXPECT_EQ(5, (int)saved.size());
+    log.clear();
+    eventControl.addEvent(new RecordingCommand(5, 0, 0, log), 4 * far);
+    for (SUMOTime step = saveTime; step < 3 * far; step += DELTA_T) {
+        eventControl.execute(step);
+    }
+    const std::vector<std::pair<int, SUMOTime> > first = log;
+    log.clear();
+    eventControl.setEventTimes(saved, saveTime);
+    const std::map<long long, SUMOTime> restored = eventControl.getEventTimes();
+    EXPECT_EQ(6, (int)restored.size());
+    for (std::map<long long, SUMOTime>::const_iterator i = saved.begin(); i != saved.end(); ++i) {
+        ASSERT_TRUE(restored.find(i->first) != restored.end());
+        EXPECT_EQ(i->second, restored.find(i->first)->second);
+    }
+    for (SUMOTime step = saveTime; step < 3 * far; step += DELTA_T) {
+        eventControl.execute(step);
+    }
+    EXPECT_FALSE(first.empty());
+    EXPECT_TRUE(first == log);
+    // the event added after saving keeps its time
+    eventControl.setEventTimes(saved, saveTime);
+    log.clear();
+    for (SUMOTime step = saveTime; step <= 4 * far; step += DELTA_T) {
+        eventControl.execute(step);
+    }
+    EXPECT_EQ(1, (int)std::count(log.begin(), log.end(), std::make_pair(5, 4 * far)));
+}
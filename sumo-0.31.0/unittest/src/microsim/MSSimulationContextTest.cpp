@@ -0,0 +1,172 @@
+/****************************************************************************/
+/// @file    MSSimulationContextTest.cpp
+/// @date    Oct 2017
+/// @version $Id$
+///
+// Tests running several simulations side by side using MSSimulationContext
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <utils/common/SUMOTime.h>
+#include <utils/options/OptionsIO.h>
+#include <utils/xml/XMLSubSys.h>
+#include <microsim/MSNet.h>
+#include <microsim/MSVehicleControl.h>
+#include <microsim/MSSimulationContext.h>
+#include <netload/NLBuilder.h>
+
+
+// ===========================================================================
+// test fixture
+// ===========================================================================
+class MSSimulationContextTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        static char* argv[] = {(char*)"sumo"};
+        OptionsIO::setArgs(1, argv);
+        XMLSubSys::init();
+        std::ofstream net(NET_FILE);
+        net << "<net version=\"0.27\">\n"
+            << "    <location netOffset=\"0.00,0.00\" convBoundary=\"0.00,0.00,501.00,0.00\" origBoundary=\"0.00,0.00,501.00,0.00\" projParameter=\"!\"/>\n"
+            << "    <edge id=\":2_0\" function=\"internal\">\n"
+            << "        <lane id=\":2_0_0\" index=\"0\" speed=\"13.90\" length=\"0.10\" shape=\"500.00,-1.65 500.00,-1.65\"/>\n"
+            << "    </edge>\n"
+            << "    <edge id=\"1to2\" from=\"1\" to=\"2\" priority=\"-1\">\n"
+            << "        <lane id=\"1to2_0\" index=\"0\" speed=\"13.90\" length=\"500.00\" shape=\"0.00,-1.65 500.00,-1.65\"/>\n"
+            << "    </edge>\n"
+            << "    <edge id=\"out\" from=\"2\" to=\"3\" priority=\"-1\">\n"
+            << "        <lane id=\"out_0\" index=\"0\" speed=\"13.90\" length=\"1.00\" shape=\"500.00,-1.65 501.00,-1.65\"/>\n"
+            << "    </edge>\n"
+            << "    <junction id=\"1\" type=\"dead_end\" x=\"0.00\" y=\"0.00\" incLanes=\"\" intLanes=\"\" shape=\"0.00,-0.05 0.00,-3.25\"/>\n"
+            << "    <junction id=\"2\" type=\"priority\" x=\"500.00\" y=\"0.00\" incLanes=\"1to2_0\" intLanes=\":2_0_0\" shape=\"500.00,-0.05 500.00,-3.25 500.00,-0.05\">\n"
+            << "        <request index=\"0\" response=\"0\" foes=\"0\" cont=\"0\"/>\n"
+            << "    </junction>\n"
+            << "    <junction id=\"3\" type=\"dead_end\" x=\"501.00\" y=\"0.00\" incLanes=\"out_0\" intLanes=\"\" shape=\"501.00,-3.25 501.00,-0.05\"/>\n"
+            << "    <connection from=\"1to2\" to=\"out\" fromLane=\"0\" toLane=\"0\" via=\":2_0_0\" dir=\"s\" state=\"M\"/>\n"
+            << "    <connection from=\":2_0\" to=\"out\" fromLane=\"0\" toLane=\"0\" dir=\"s\" state=\"M\"/>\n"
+            << "</net>\n";
+        std::ofstream routes(ROUTE_FILE);
+        routes << "<routes>\n"
+               << "    <vType id=\"t\" sigma=\"0.5\"/>\n"
+               << "    <route id=\"r\" edges=\"1to2 out\"/>\n"
+               << "    <flow id=\"f\" type=\"t\" route=\"r\" begin=\"0\" end=\"100\" probability=\"0.3\" departSpeed=\"random\"/>\n"
+               << "</routes>\n";
+    }
+
+    virtual void TearDown() {
+        std::remove(NET_FILE);
+        std::remove(ROUTE_FILE);
+    }
+
+    /// @brief loads a simulation of the test scenario with the given seed and step length
+    static MSSimulationContext* load(const std::string& seed, const std::string& stepLength) {
+        std::vector<std::string> args;
+        args.push_back("-n");
+        args.push_back(NET_FILE);
+        args.push_back("-r");
+        args.push_back(ROUTE_FILE);
+        args.push_back("--end");
+        args.push_back("200");
+        args.push_back("--seed");
+        args.push_back(seed);
+        args.push_back("--step-length");
+        args.push_back(stepLength);
+        args.push_back("--no-step-log");
+        return NLBuilder::loadContext(args);
+    }
+
+    /// @brief performs a step in the given context and records the vehicle counts
+    static MSNet::SimulationState step(MSSimulationContext& context, std::vector<int>& trace) {
+        const MSNet::SimulationState state = context.step(TIME2STEPS(200));
+        MSSimulationContext::Activation activation(context);
+        const MSVehicleControl& vc = MSNet::getInstance()->getVehicleControl();
+        trace.push_back(vc.getDepartedVehicleNo());
+        trace.push_back(vc.getRunningVehicleNo());
+        return state;
+    }
+
+    static const char* const NET_FILE;
+    static const char* const ROUTE_FILE;
+};
+
+
+const char* const MSSimulationContextTest::NET_FILE = "MSSimulationContextTest.net.xml";
+const char* const MSSimulationContextTest::ROUTE_FILE = "MSSimulationContextTest.rou.xml";
+
+
+// ===========================================================================
+// test definitions
+// ===========================================================================
+/* Test that two interleaved simulations behave like the same simulations run one after the other.*/
+TEST_F(MSSimulationContextTest, test_side_by_side) {
+    const SUMOTime processDeltaT = DELTA_T;
+    // reference runs
+    std::vector<int> soloTrace1;
+    MSSimulationContext* context = load("23", "1");
+    while (step(*context, soloTrace1) == MSNet::SIMSTATE_RUNNING) {}
+    delete context;
+    std::vector<int> soloTrace2;
+    context = load("42", "0.5");
+    while (step(*context, soloTrace2) == MSNet::SIMSTATE_RUNNING) {}
+    delete context;
+    EXPECT_EQ(processDeltaT, DELTA_T);
+    EXPECT_NE(soloTrace1, soloTrace2);
+    // interleaved runs
+    std::vector<int> trace1;
+    std::vector<int> trace2;
+    MSSimulationContext* context1 = load("23", "1");
+    MSSimulationContext* context2 = load("42", "0.5");
+    MSNet::SimulationState state1 = MSNet::SIMSTATE_RUNNING;
+    MSNet::SimulationState state2 = MSNet::SIMSTATE_RUNNING;
+    while (state1 == MSNet::SIMSTATE_RUNNING || state2 == MSNet::SIMSTATE_RUNNING) {
+        if (state1 == MSNet::SIMSTATE_RUNNING) {
+            state1 = step(*context1, trace1);
+            {
+                MSSimulationContext::Activation activation(*context1);
+                EXPECT_EQ(TIME2STEPS(1), DELTA_T);
+            }
+        }
+        if (state2 == MSNet::SIMSTATE_RUNNING) {
+            // the second simulation makes two steps per step of the first one
+            state2 = step(*context2, trace2);
+            if (state2 == MSNet::SIMSTATE_RUNNING) {
+                state2 = step(*context2, trace2);
+            }
+            {
+                MSSimulationContext::Activation activation(*context2);
+                EXPECT_EQ(TIME2STEPS(0.5), DELTA_T);
+            }
+        }
+    }
+    delete context1;
+    delete context2;
+    EXPECT_EQ(soloTrace1, trace1);
+    EXPECT_EQ(soloTrace2, trace2);
+    EXPECT_EQ(processDeltaT, DELTA_T);
+    EXPECT_EQ(0, MSSimulationContext::getActive());
+}
@@ -0,0 +1,201 @@
+/****************************************************************************/
+/// @file    SUMOWorkerThreadTest.cpp
+/// @date    Oct 2017
+/// @version $Id$
+///
+// Tests the class SUMOWorkerThread
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <utils/common/SUMOWorkerThread.h>
+
+
+// ===========================================================================
+// helper classes
+// ===========================================================================
+class CountingTask : public SUMOWorkerThread::Task {
+public:
+    CountingTask(std::atomic<int>& counter) : myCounter(counter) {}
+    void run(SUMOWorkerThread* /* context */) {
+        myCounter++;
+    }
+    std::atomic<int>& myCounter;
+};
+
+
+class ContextTask : public SUMOWorkerThread::Task {
+public:
+    ContextTask(std::vector<SUMOWorkerThread*>& contexts, const int index) : myContexts(contexts), myIndex(index) {}
+    void run(SUMOWorkerThread* context) {
+        myContexts[myIndex] = context;
+    }
+    std::vector<SUMOWorkerThread*>& myContexts;
+    const int myIndex;
+};
+
+
+class RecordingTask : public SUMOWorkerThread::Task {
+public:
+    RecordingTask(std::vector<int>& record, const int value) : myRecord(record), myValue(value) {}
+    void run(SUMOWorkerThread* /* context */) {
+        // only safe because all recording tasks are assigned to the same worker
+        myRecord.push_back(myValue);
+    }
+    std::vector<int>& myRecord;
+    const int myValue;
+};
+
+
+class CheckingTask : public SUMOWorkerThread::Task {
+public:
+    CheckingTask(std::atomic<int>& failures) : myFailures(failures) {}
+    void run(SUMOWorkerThread* context);
+    std::atomic<int>& myFailures;
+};
+
+
+class SlowWorker : public SUMOWorkerThread {
+public:
+    SlowWorker(SUMOWorkerThread::Pool& pool) : SUMOWorkerThread(pool), myValue(init()) {}
+    ~SlowWorker() {
+        stop();
+    }
+    static int init() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return 42;
+    }
+    const int myValue;
+};
+
+
+void
+CheckingTask::run(SUMOWorkerThread* context) {
+    if (static_cast<SlowWorker*>(context)->myValue != 42) {
+        myFailures++;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+}
+
+
+// ===========================================================================
+// test definitions
+// ===========================================================================
+/* Test that all tasks without a worker index are run exactly once.*/
+TEST(SUMOWorkerThread, test_shared_tasks) {
+    std::atomic<int> counter(0);
+    SUMOWorkerThread::Pool pool(4);
+    EXPECT_EQ(4, pool.size());
+    for (int i = 0; i < 1000; i++) {
+        pool.add(new CountingTask(counter));
+    }
+    pool.waitAll();
+    EXPECT_EQ(1000, counter.load());
+    EXPECT_FALSE(pool.isFull());
+    // the pool is reusable after waiting
+    for (int i = 0; i < 10; i++) {
+        pool.add(new CountingTask(counter));
+    }
+    pool.waitAll();
+    EXPECT_EQ(1010, counter.load());
+}
+
+
+/* Test that tasks with a worker index are run by this worker in the order they were added.*/
+TEST(SUMOWorkerThread, test_assigned_tasks) {
+    SUMOWorkerThread::Pool pool;
+    std::vector<SUMOWorkerThread*> workers;
+    for (int i = 0; i < 3; i++) {
+        workers.push_back(new SUMOWorkerThread(pool));
+    }
+    std::atomic<int> counter(0);
+    std::vector<SUMOWorkerThread*> contexts(100, (SUMOWorkerThread*)0);
+    std::vector<int> record;
+    for (int i = 0; i < 100; i++) {
+        pool.add(new ContextTask(contexts, i), 1);
+        pool.add(new RecordingTask(record, i), 1);
+        pool.add(new CountingTask(counter));
+    }
+    pool.waitAll();
+    EXPECT_EQ(100, counter.load());
+    ASSERT_EQ(100, (int)record.size());
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(i, record[i]);
+        EXPECT_EQ(workers[1], contexts[i]);
+    }
+    EXPECT_GE(workers[1]->getCounter(), 200);
+    EXPECT_EQ(300, workers[0]->getCounter() + workers[1]->getCounter() + workers[2]->getCounter());
+}
+
+
+/* Test that clearing a pool with pending tasks stops all workers.*/
+TEST(SUMOWorkerThread, test_clear) {
+    std::atomic<int> counter(0);
+    SUMOWorkerThread::Pool pool(2);
+    for (int i = 0; i < 100; i++) {
+        pool.add(new CountingTask(counter), i % 2);
+    }
+    pool.clear();
+    EXPECT_EQ(0, pool.size());
+    EXPECT_LE(counter.load(), 100);
+}
+
+
+/* Test waiting for single tasks which are then owned by the caller.*/
+TEST(SUMOWorkerThread, test_wait_for) {
+    std::atomic<int> counter(0);
+    SUMOWorkerThread::Pool pool(3);
+    std::vector<CountingTask*> tasks;
+    for (int i = 0; i < 100; i++) {
+        tasks.push_back(new CountingTask(counter));
+        pool.add(tasks.back());
+    }
+    for (int i = 0; i < 50; i++) {
+        pool.waitFor(tasks[i]);
+        delete tasks[i];
+    }
+    EXPECT_GE(counter.load(), 50);
+    // the remaining tasks are still deleted by the pool
+    pool.waitAll();
+    EXPECT_EQ(100, counter.load());
+}
+
+
+/* Test that a worker added while tasks are pending does not run them before it is completely constructed.*/
+TEST(SUMOWorkerThread, test_add_worker_while_busy) {
+    std::atomic<int> failures(0);
+    SUMOWorkerThread::Pool pool;
+    new SlowWorker(pool);
+    for (int i = 0; i < 1000; i++) {
+        pool.add(new CheckingTask(failures));
+    }
+    EXPECT_TRUE(pool.isFull());
+    new SlowWorker(pool);
+    EXPECT_EQ(2, pool.size());
+    pool.waitAll();
+    EXPECT_EQ(0, failures.load());
+}
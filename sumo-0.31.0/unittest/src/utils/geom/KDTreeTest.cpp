@@ -0,0 +1,93 @@
+/****************************************************************************/
+/// @file    KDTreeTest.cpp
+/// @date    Oct 2017
+/// @version $Id$
+///
+// Tests the class KDTree
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <utils/geom/Position.h>
+#include <utils/geom/KDTree.h>
+
+using namespace std;
+
+
+/* Test an empty tree and k = 0.*/
+TEST(KDTree, test_method_nearest_empty) {
+    KDTree<int> tree;
+    tree.build();
+    vector<KDTree<int>::Neighbor> result;
+    tree.nearest(Position(0, 0), 3, 100, -1, result);
+    EXPECT_EQ(0, (int)result.size());
+    tree.add(Position(1, 1), 1);
+    tree.build();
+    tree.nearest(Position(0, 0), 0, 100, -1, result);
+    EXPECT_EQ(0, (int)result.size());
+}
+
+
+/* Test the sorting, the excluded item and the search radius.*/
+TEST(KDTree, test_method_nearest) {
+    KDTree<int> tree;
+    for (int i = 0; i < 10; i++) {
+        tree.add(Position(i * 10, 0), i);
+    }
+    tree.build();
+    EXPECT_EQ(10, tree.size());
+    vector<KDTree<int>::Neighbor> result;
+    tree.nearest(Position(41, 0), 3, 100, 4, result);
+    ASSERT_EQ(3, (int)result.size());
+    EXPECT_EQ(5, result[0].second);
+    EXPECT_DOUBLE_EQ(9., result[0].first);
+    EXPECT_EQ(3, result[1].second);
+    EXPECT_DOUBLE_EQ(11., result[1].first);
+    EXPECT_EQ(6, result[2].second);
+    tree.nearest(Position(41, 0), 5, 10, -1, result);
+    ASSERT_EQ(2, (int)result.size());
+    EXPECT_EQ(4, result[0].second);
+    EXPECT_EQ(5, result[1].second);
+}
+
+
+/* Compare random queries with a linear search.*/
+TEST(KDTree, test_method_nearest_random) {
+    KDTree<int> tree;
+    vector<Position> positions;
+    srand(42);
+    for (int i = 0; i < 500; i++) {
+        positions.push_back(Position(rand() % 1000, rand() % 1000));
+        tree.add(positions.back(), i);
+    }
+    tree.build();
+    vector<KDTree<int>::Neighbor> result;
+    for (int q = 0; q < 50; q++) {
+        const Position pos(rand() % 1000, rand() % 1000);
+        vector<double> expected;
+        for (int i = 0; i < (int)positions.size(); i++) {
+            const double dist = pos.distanceTo2D(positions[i]);
+            if (dist <= 150) {
+                expected.push_back(dist);
+            }
+        }
+        sort(expected.begin(), expected.end());
+        tree.nearest(pos, 7, 150, -1, result);
+        ASSERT_EQ(min(7, (int)expected.size()), (int)result.size());
+        for (int i = 0; i < (int)result.size(); i++) {
+            EXPECT_DOUBLE_EQ(expected[i], result[i].first);
+            EXPECT_DOUBLE_EQ(result[i].first, pos.distanceTo2D(positions[result[i].second]));
+        }
+    }
+}
@@ -0,0 +1,200 @@
+/****************************************************************************/
+/// @file    AStarLookupTableTest.cpp
+/// @date    Oct 2017
+/// @version $Id$
+///
+// Tests the class LandmarkLookupTable
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <cstdio>
+#include <fstream>
+#include <cmath>
+#include <utils/common/SUMOVehicleClass.h>
+#include <utils/common/ToString.h>
+#include <utils/common/UtilExceptions.h>
+#include <utils/vehicle/SUMOAbstractRouter.h>
+#include <utils/vehicle/AStarRouter.h>
+#include <utils/vehicle/DijkstraRouterTT.h>
+
+using namespace std;
+
+
+class LMVehicle {
+public:
+    SUMOVehicleClass getVClass() const {
+        return SVC_PASSENGER;
+    }
+    const std::string& getID() const {
+        return myID;
+    }
+private:
+    std::string myID;
+};
+
+
+class LMEdge {
+public:
+    LMEdge(int numericalID, int from, int to, int size) :
+        myNumericalID(numericalID), myID(toString(from) + "_" + toString(to)),
+        myX((from / size + to / size) * 50.), myY((from % size + to % size) * 50.) {}
+    int getNumericalID() const {
+        return myNumericalID;
+    }
+    const std::string& getID() const {
+        return myID;
+    }
+    bool isInternal() const {
+        return false;
+    }
+    const std::vector<LMEdge*>& getSuccessors(SUMOVehicleClass = SVC_IGNORING) const {
+        return mySuccessors;
+    }
+    const std::vector<LMEdge*>& getPredecessors() const {
+        return myPredecessors;
+    }
+    bool prohibits(const LMVehicle* const) const {
+        return false;
+    }
+    double getDistanceTo(const LMEdge* other) const {
+        return sqrt((myX - other->myX) * (myX - other->myX) + (myY - other->myY) * (myY - other->myY));
+    }
+    std::vector<LMEdge*> mySuccessors;
+    std::vector<LMEdge*> myPredecessors;
+private:
+    int myNumericalID;
+    std::string myID;
+    double myX;
+    double myY;
+};
+
+
+static double getLMWeight(const LMEdge* const edge, const LMVehicle* const, double) {
+    return 10. + edge->getNumericalID() % 7;
+}
+
+typedef DijkstraRouterTT<LMEdge, LMVehicle, noProhibitions<LMEdge, LMVehicle> > LMRouter;
+typedef LandmarkLookupTable<LMEdge, LMVehicle> LMLT;
+
+
+class AStarLookupTableTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // a grid of junctions connected in both directions
+        const int size = 6;
+        vector<pair<int, int> > connections;
+        for (int x = 0; x < size; x++) {
+            for (int y = 0; y < size; y++) {
+                const int node = x * size + y;
+                if (x + 1 < size) {
+                    connections.push_back(make_pair(node, node + size));
+                    connections.push_back(make_pair(node + size, node));
+                }
+                if (y + 1 < size) {
+                    connections.push_back(make_pair(node, node + 1));
+                    connections.push_back(make_pair(node + 1, node));
+                }
+            }
+        }
+        for (int i = 0; i < (int)connections.size(); i++) {
+            edges.push_back(new LMEdge(i, connections[i].first, connections[i].second, size));
+        }
+        for (int i = 0; i < (int)connections.size(); i++) {
+            for (int j = 0; j < (int)connections.size(); j++) {
+                if (connections[i].second == connections[j].first && connections[i].first != connections[j].second) {
+                    edges[i]->mySuccessors.push_back(edges[j]);
+                    edges[j]->myPredecessors.push_back(edges[i]);
+                }
+            }
+        }
+    }
+
+    virtual void TearDown() {
+        for (vector<LMEdge*>::iterator i = edges.begin(); i != edges.end(); ++i) {
+            delete *i;
+        }
+        remove("lmlt_test.bin");
+        remove("lmlt_test.txt");
+    }
+
+    /// @brief checks that both tables give the same bounds
+    void compare(const LMLT& table, const LMLT& other) {
+        for (int i = 0; i < (int)edges.size(); i++) {
+            for (int j = 0; j < (int)edges.size(); j += 7) {
+                EXPECT_DOUBLE_EQ(table.lowerBound(edges[i], edges[j], 1000., 1., 10., 10.),
+                                 other.lowerBound(edges[i], edges[j], 1000., 1., 10., 10.));
+            }
+        }
+    }
+
+    vector<LMEdge*> edges;
+    LMVehicle vehicle;
+};
+
+
+/* Test the automatic selection of landmarks and that the bounds are admissible.*/
+TEST_F(AStarLookupTableTest, test_method_auto_landmarks) {
+    LMRouter router(edges, true, &getLMWeight);
+    LMLT table("", edges, &router, &vehicle, "lmlt_test.txt", 0, 4);
+    vector<const LMEdge*> route;
+    for (int i = 0; i < (int)edges.size(); i += 3) {
+        for (int j = 0; j < (int)edges.size(); j += 5) {
+            if (i != j && router.compute(edges[i], edges[j], &vehicle, 0, route)) {
+                // the bound excludes the effort of the start and the end
+                const double cost = router.recomputeCosts(route, &vehicle, 0) - getLMWeight(edges[i], 0, 0) - getLMWeight(edges[j], 0, 0);
+                EXPECT_LE(table.lowerBound(edges[i], edges[j], 1e9, 1., getLMWeight(edges[i], 0, 0), getLMWeight(edges[j], 0, 0)), cost + 1e-4);
+                route.clear();
+            }
+        }
+    }
+    // the selected landmarks are written to the text file
+    LMLT text("lmlt_test.txt", edges, 0, &vehicle, "", 0);
+    compare(table, text);
+}
+
+
+/* Test writing and mapping the binary format.*/
+TEST_F(AStarLookupTableTest, test_method_binary) {
+    LMRouter router(edges, true, &getLMWeight);
+    LMLT table("", edges, &router, &vehicle, "lmlt_test.bin", 0, 3);
+    LMLT binary("lmlt_test.bin", edges, 0, &vehicle, "", 0);
+    compare(table, binary);
+    // extending a binary table keeps the known landmarks
+    LMLT extended("lmlt_test.bin", edges, &router, &vehicle, "lmlt_test.txt", 0, 4);
+    LMLT text("lmlt_test.txt", edges, 0, &vehicle, "", 0);
+    compare(extended, text);
+    // the table does not fit to a different network
+    edges.back()->mySuccessors.clear();
+    LMEdge* const last = edges.back();
+    edges.pop_back();
+    EXPECT_THROW(LMLT("lmlt_test.bin", edges, 0, &vehicle, "", 0), ProcessError);
+    edges.push_back(last);
+}
+
+
+/* Test that corrupt binary tables are rejected.*/
+TEST_F(AStarLookupTableTest, test_method_binary_corrupt) {
+    LMRouter router(edges, true, &getLMWeight);
+    LMLT table("", edges, &router, &vehicle, "lmlt_test.bin", 0, 3);
+    const int counts[] = {-1, 1 << 30, 4};
+    for (int i = 0; i < 3; i++) {
+        // overwrite the number of landmarks in the header
+        std::fstream strm("lmlt_test.bin", std::ios::in | std::ios::out | std::ios::binary);
+        strm.seekp(12);
+        strm.write((const char*)&counts[i], sizeof(int));
+        strm.close();
+        EXPECT_THROW(LMLT("lmlt_test.bin", edges, 0, &vehicle, "", 0), ProcessError);
+    }
+}
@@ -0,0 +1,171 @@
+/****************************************************************************/
+/// @file    CHRouterTest.cpp
+/// @date    Oct 2017
+/// @version $Id$
+///
+// Tests the class CHRouter
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <algorithm>
+#include <utils/common/SUMOVehicleClass.h>
+#include <utils/common/ToString.h>
+#include <utils/vehicle/CHRouter.h>
+#include <utils/vehicle/DijkstraRouterTT.h>
+
+using namespace std;
+
+
+class TestVehicle {
+public:
+    SUMOVehicleClass getVClass() const {
+        return SVC_PASSENGER;
+    }
+    const std::string& getID() const {
+        return myID;
+    }
+private:
+    std::string myID;
+};
+
+
+class TestEdge {
+public:
+    TestEdge(int numericalID, int from, int to) : myNumericalID(numericalID), myID(toString(from) + "_" + toString(to)), from(from), to(to) {}
+    int getNumericalID() const {
+        return myNumericalID;
+    }
+    const std::string& getID() const {
+        return myID;
+    }
+    SVCPermissions getPermissions() const {
+        return SVCAll;
+    }
+    const std::vector<TestEdge*>& getSuccessors(SUMOVehicleClass) const {
+        return mySuccessors;
+    }
+    bool prohibits(const TestVehicle* const) const {
+        return false;
+    }
+    std::vector<TestEdge*> mySuccessors;
+private:
+    int myNumericalID;
+    std::string myID;
+public:
+    int from;
+    int to;
+};
+
+
+static std::vector<double> weights;
+
+static double getWeight(const TestEdge* const edge, const TestVehicle* const, double) {
+    return weights[edge->getNumericalID()];
+}
+
+
+class CHRouterTest : public testing::Test {
+protected:
+    virtual void SetUp() {
+        // a grid of junctions connected in both directions
+        const int size = 7;
+        for (int x = 0; x < size; x++) {
+            for (int y = 0; y < size; y++) {
+                const int node = x * size + y;
+                if (x + 1 < size) {
+                    addEdge(node, node + size);
+                    addEdge(node + size, node);
+                }
+                if (y + 1 < size) {
+                    addEdge(node, node + 1);
+                    addEdge(node + 1, node);
+                }
+            }
+        }
+        for (vector<TestEdge*>::iterator i = edges.begin(); i != edges.end(); ++i) {
+            for (vector<TestEdge*>::iterator j = edges.begin(); j != edges.end(); ++j) {
+                if ((*i)->to == (*j)->from && (*i)->from != (*j)->to) {
+                    (*i)->mySuccessors.push_back(*j);
+                }
+            }
+        }
+        weights.resize(edges.size());
+        seed = 42;
+    }
+
+    virtual void TearDown() {
+        for (vector<TestEdge*>::iterator i = edges.begin(); i != edges.end(); ++i) {
+            delete *i;
+        }
+    }
+
+    void addEdge(int from, int to) {
+        edges.push_back(new TestEdge((int)edges.size(), from, to));
+    }
+
+    void randomizeWeights() {
+        for (int i = 0; i < (int)weights.size(); i++) {
+            seed = seed * 1103515245 + 12345;
+            weights[i] = 1. + (double)((seed / 65536) % 100);
+        }
+    }
+
+    /// @brief compares the costs of the routes of the contraction hierarchy with those of dijkstra
+    void checkRoutes(CHRouter<TestEdge, TestVehicle, prohibited_withPermissions<TestEdge, TestVehicle> >& router, SUMOTime time) {
+        DijkstraRouterTT<TestEdge, TestVehicle, prohibited_withPermissions<TestEdge, TestVehicle> > dijkstra(edges, true, &getWeight);
+        TestVehicle vehicle;
+        for (int i = 0; i < (int)edges.size(); i += 5) {
+            for (int j = 0; j < (int)edges.size(); j += 3) {
+                vector<const TestEdge*> route;
+                vector<const TestEdge*> reference;
+                EXPECT_TRUE(router.compute(edges[i], edges[j], &vehicle, time, route));
+                EXPECT_TRUE(dijkstra.compute(edges[i], edges[j], &vehicle, time, reference));
+                ASSERT_FALSE(route.empty());
+                EXPECT_EQ(edges[i], route.front());
+                EXPECT_EQ(edges[j], route.back());
+                for (int k = 1; k < (int)route.size(); k++) {
+                    const vector<TestEdge*>& succ = route[k - 1]->mySuccessors;
+                    EXPECT_TRUE(find(succ.begin(), succ.end(), route[k]) != succ.end());
+                }
+                EXPECT_DOUBLE_EQ(dijkstra.recomputeCosts(reference, &vehicle, time), router.recomputeCosts(route, &vehicle, time));
+            }
+        }
+    }
+
+    vector<TestEdge*> edges;
+    unsigned int seed;
+};
+
+
+/* Test the routes of the contracted network.*/
+TEST_F(CHRouterTest, test_method_compute) {
+    randomizeWeights();
+    CHRouter<TestEdge, TestVehicle, prohibited_withPermissions<TestEdge, TestVehicle> > router(
+        edges, true, &getWeight, SVC_PASSENGER, SUMOTime_MAX, false);
+    checkRoutes(router, 0);
+}
+
+
+/* Test the routes after the hierarchy was customized for changed weights.*/
+TEST_F(CHRouterTest, test_method_customize) {
+    randomizeWeights();
+    CHRouter<TestEdge, TestVehicle, prohibited_withPermissions<TestEdge, TestVehicle> > router(
+        edges, true, &getWeight, SVC_PASSENGER, 1000, false);
+    checkRoutes(router, 0);
+    for (int period = 1; period < 4; period++) {
+        randomizeWeights();
+        checkRoutes(router, period * 1000);
+    }
+}
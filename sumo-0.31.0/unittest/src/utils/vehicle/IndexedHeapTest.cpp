@@ -0,0 +1,109 @@
+/****************************************************************************/
+/// @file    IndexedHeapTest.cpp
+/// @date    Oct 2017
+/// @version $Id$
+///
+// Tests the class IndexedHeap
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.dlr.de/
+// Copyright (C) 2017-2017 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This file is part of SUMO.
+//   SUMO is free software: you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation, either version 3 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <utils/vehicle/IndexedHeap.h>
+
+using namespace std;
+
+
+struct Item {
+    Item(int _id, double _key) : id(_id), key(_key), heapIndex(-1) {}
+    int id;
+    double key;
+    int heapIndex;
+};
+
+struct ItemComparator {
+    bool operator()(const Item* i1, const Item* i2) const {
+        if (i1->key == i2->key) {
+            return i1->id > i2->id;
+        }
+        return i1->key > i2->key;
+    }
+};
+
+typedef IndexedHeap<Item, ItemComparator> Heap;
+
+
+/* Test pushing and popping in key order with the id as tie breaker.*/
+TEST(IndexedHeap, test_method_push_pop) {
+    vector<Item> items;
+    const double keys[] = {5., 3., 8., 1., 3., 9., 0., 7.};
+    for (int i = 0; i < 8; i++) {
+        items.push_back(Item(i, keys[i]));
+    }
+    Heap heap;
+    EXPECT_TRUE(heap.empty());
+    for (vector<Item>::iterator i = items.begin(); i != items.end(); ++i) {
+        heap.push(&*i);
+    }
+    EXPECT_EQ(8, heap.size());
+    const int expected[] = {6, 3, 1, 4, 0, 7, 2, 5};
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(expected[i], heap.top()->id);
+        EXPECT_TRUE(heap.contains(heap.top()));
+        Item* const top = heap.top();
+        heap.pop();
+        EXPECT_FALSE(heap.contains(top));
+    }
+    EXPECT_TRUE(heap.empty());
+}
+
+
+/* Test changing the key of queued elements in both directions.*/
+TEST(IndexedHeap, test_method_update) {
+    vector<Item> items;
+    for (int i = 0; i < 10; i++) {
+        items.push_back(Item(i, 10. * i));
+    }
+    Heap heap;
+    for (vector<Item>::iterator i = items.begin(); i != items.end(); ++i) {
+        heap.push(&*i);
+    }
+    items[7].key = 5.;
+    heap.update(&items[7]);
+    EXPECT_EQ(0, heap.top()->id);
+    items[0].key = 85.;
+    heap.update(&items[0]);
+    EXPECT_EQ(7, heap.top()->id);
+    const int expected[] = {7, 1, 2, 3, 4, 5, 6, 8, 0, 9};
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(expected[i], heap.top()->id);
+        EXPECT_EQ(0, heap.top()->heapIndex);
+        heap.pop();
+    }
+}
+
+
+/* Test that clearing marks all elements as not queued.*/
+TEST(IndexedHeap, test_method_clear) {
+    Item a(0, 1.);
+    Item b(1, 2.);
+    Heap heap;
+    heap.push(&a);
+    heap.push(&b);
+    heap.clear();
+    EXPECT_TRUE(heap.empty());
+    EXPECT_EQ(-1, a.heapIndex);
+    EXPECT_EQ(-1, b.heapIndex);
+    heap.push(&b);
+    EXPECT_EQ(&b, heap.top());
+}